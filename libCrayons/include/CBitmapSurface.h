@@ -30,7 +30,8 @@ extern "C" {
 
 struct _tagCBitmapSurface
 {
-	CBitmap *image;
+	CSurface  _base;
+	CBitmap  *image;
 };
 
 static CStatus
@@ -54,6 +55,11 @@ CBitmapSurface_GetDpiX(CSurface *_this,
 static CStatus
 CBitmapSurface_GetDpiY(CSurface *_this,
                        CFloat   *dpiY);
+static CStatus
+CBitmapSurface_LockImage(CSurface        *_this,
+                         pixman_image_t **image);
+static void
+CBitmapSurface_UnlockImage(CSurface *_this);
 static void
 CBitmapSurface_Finalize(CSurface *_this);
 
@@ -65,6 +71,8 @@ static const CSurfaceClass CBitmapSurface_Class =
 	CBitmapSurface_Flush,
 	CBitmapSurface_GetDpiX,
 	CBitmapSurface_GetDpiY,
+	CBitmapSurface_LockImage,
+	CBitmapSurface_UnlockImage,
 	CBitmapSurface_Finalize,
 	"sentinel"
 };
@@ -0,0 +1,63 @@
+/*
+ * CDisplayList.h - Display list header.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _C_DISPLAYLIST_H_
+#define _C_DISPLAYLIST_H_
+
+#include "CrayonsInternal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef CUInt32 CDisplayItemType;
+#define CDisplayItemType_Fill   0
+#define CDisplayItemType_Stroke 1
+
+typedef struct _tagCDisplayItem CDisplayItem;
+struct _tagCDisplayItem
+{
+	CDisplayItemType   type;
+	CPath             *path;
+	CBrush            *brush;
+	CPen              *pen;
+	CAffineTransformF  transform;
+	CRasterizer        rasterizer;
+	CBool              cached;
+};
+
+struct _tagCDisplayList
+{
+	CUInt32       count;
+	CUInt32       capacity;
+	CDisplayItem *items;
+};
+
+CINTERNAL CStatus
+CDisplayItem_GetGeometry(CDisplayItem       *_this,
+                         CAffineTransformF  *transform,
+                         CPath              *scratch,
+                         CRasterizer       **rasterizer);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _C_DISPLAYLIST_H_ */
@@ -34,6 +34,7 @@ struct _tagCFiller
 	CPointArrayX      array;
 	CPolygonX         polygon;
 	CTrapezoids      *trapezoids;
+	CRasterizer      *rasterizer;
 	CFillMode         fillMode;
 };
 
@@ -56,6 +57,13 @@ CFiller_ToTrapezoids(CFiller       *_this,
                      const CByte   *types,
                      CUInt32        count,
                      CFillMode      fillMode);
+CINTERNAL CStatus
+CFiller_ToRasterizer(CFiller       *_this,
+                     CRasterizer   *rasterizer,
+                     const CPointF *points,
+                     const CByte   *types,
+                     CUInt32        count,
+                     CFillMode      fillMode);
 
 #ifdef __cplusplus
 };
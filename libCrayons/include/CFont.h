@@ -59,7 +59,9 @@ CFont_DrawString(CFont              *_this,
                  CAffineTransformF  *device,
                  CTextRenderingHint  hint,
                  pixman_image_t     *clip,
-                 pixman_image_t     *mask);
+                 pixman_image_t     *mask,
+                 CPointI            *min,
+                 CPointI            *max);
 
 #ifdef __cplusplus
 };
@@ -56,6 +56,7 @@ struct _tagCFontFace
 	CUnicodeHashTable *unicode;
 	CGlyphCache       *cache;
 	CGlyphShape       *current;
+	CGlyphAtlas        atlas;
 	CMutex            *lock;
 };
 
@@ -67,6 +68,10 @@ extern CUInt32 CGlyphEntry_NullMaskObject;
 #define CGlyphEntry_NullMask \
 	((pixman_image_t *)((void *)&CGlyphEntry_NullMaskObject))
 
+extern CUInt32 CGlyphEntry_AtlasMaskObject;
+#define CGlyphEntry_AtlasMask \
+	((pixman_image_t *)((void *)&CGlyphEntry_AtlasMaskObject))
+
 CINTERNAL CStatus
 CFontFace_Create(CFontFace   **_this,
                  CFontFamily  *family,
@@ -77,6 +82,7 @@ CINTERNAL CStatus
 CFontFace_GetGlyphEntry(CFontFace    *_this,
                         CChar32       unicode,
                         CGlyphFlag    flags,
+                        CUInt32       subpixel,
                         CBool         render,
                         CGlyphEntry **entry);
 CINTERNAL CStatus
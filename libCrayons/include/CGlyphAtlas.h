@@ -0,0 +1,77 @@
+/*
+ * CGlyphAtlas.h - Glyph atlas header.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _C_GLYPHATLAS_H_
+#define _C_GLYPHATLAS_H_
+
+#include "CrayonsInternal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| Gray glyph masks are packed into square pages of this size, of which
+|*| there are at most the given number; horizontal glyph positions are
+|*| quantized to the given number of subpixel phases.
+\*/
+#define CGlyphAtlas_PageSize  256
+#define CGlyphAtlas_MaxPages  4
+#define CGlyphAtlas_Subpixels 4
+
+typedef struct _tagCGlyphSlot CGlyphSlot;
+struct _tagCGlyphSlot
+{
+	CByte   *data;
+	CUInt16  width;
+	CUInt16  height;
+	CUInt32  generation;
+};
+
+typedef struct _tagCGlyphAtlas CGlyphAtlas;
+struct _tagCGlyphAtlas
+{
+	CByte   *pages[CGlyphAtlas_MaxPages];
+	CUInt32  pageCount;
+	CUInt32  page;
+	CUInt32  shelfX;
+	CUInt32  shelfY;
+	CUInt32  shelfHeight;
+	CUInt32  generation;
+};
+
+CINTERNAL void
+CGlyphAtlas_Initialize(CGlyphAtlas *_this);
+CINTERNAL void
+CGlyphAtlas_Finalize(CGlyphAtlas *_this);
+CINTERNAL CStatus
+CGlyphAtlas_Allocate(CGlyphAtlas *_this,
+                     CUInt32      width,
+                     CUInt32      height,
+                     CGlyphSlot  *slot);
+CINTERNAL CBool
+CGlyphAtlas_IsCurrent(CGlyphAtlas *_this,
+                      CGlyphSlot  *slot);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _C_GLYPHATLAS_H_ */
@@ -25,6 +25,7 @@
 #include "CUnicodeHashTable.h"
 #include "CHashTable.h"
 #include "CCache.h"
+#include "CGlyphAtlas.h"
 #include "CFont.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -69,6 +70,7 @@ struct _tagCGlyphKey
 	CCacheEntry  _base;
 	CGlyphIndex  index;
 	CGlyphFlag   flags;
+	CUInt32      subpixel;
 	CGlyphShape *shape;
 };
 
@@ -80,6 +82,7 @@ struct _tagCGlyphEntry
 	CVectorF        xbearing;
 	CVectorF        xadvance;
 	pixman_image_t *mask;
+	CGlyphSlot      slot;
 };
 
 CINTERNAL CStatus
@@ -36,6 +36,8 @@ struct _tagCGraphics
 	CFloat               pageScale;
 	CInterpolationMode   interpolationMode;
 	CPixelOffsetMode     pixelOffsetMode;
+	CRasterizerMode      rasterizerMode;
+	CRenderingMode       renderingMode;
 	CPointI              renderingOrigin;
 	CSmoothingMode       smoothingMode;
 	CUInt32              textContrast;
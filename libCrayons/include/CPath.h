@@ -142,6 +142,9 @@ CPath_Stroke(CPath    *_this,
 CINTERNAL CStatus
 CPath_Fill(CPath       *_this,
            CTrapezoids *trapezoids);
+CINTERNAL CStatus
+CPath_Rasterize(CPath       *_this,
+                CRasterizer *rasterizer);
 
 #ifdef __cplusplus
 };
@@ -0,0 +1,73 @@
+/*
+ * CRasterizer.h - Scanline rasterizer header.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _C_RASTERIZER_H_
+#define _C_RASTERIZER_H_
+
+#include "CrayonsInternal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+CINTERNAL void
+CRasterizer_Initialize(CRasterizer *_this);
+CINTERNAL void
+CRasterizer_Finalize(CRasterizer *_this);
+CINTERNAL void
+CRasterizer_Reset(CRasterizer *_this);
+CINTERNAL CStatus
+CRasterizer_AddPolygon(CRasterizer *_this,
+                       CPolygonX   *polygon);
+CINTERNAL CStatus
+CRasterizer_Fill(CRasterizer *_this,
+                 CPointF     *points,
+                 CByte       *types,
+                 CUInt32      count,
+                 CFillMode    fillMode);
+CINTERNAL CStatus
+CRasterizer_Copy(CRasterizer *_this,
+                 CRasterizer *other);
+CINTERNAL void
+CRasterizer_Translate(CRasterizer *_this,
+                      CInt32       dx,
+                      CInt32       dy);
+CINTERNAL void
+CRasterizer_GetRows(CRasterizer *_this,
+                    CInt32      *top,
+                    CInt32      *bottom);
+CINTERNAL CStatus
+CRasterizer_Composite(CRasterizer    *_this,
+                      pixman_image_t *clip,
+                      pixman_image_t *mask);
+CINTERNAL CStatus
+CRasterizer_CompositeRows(CRasterizer    *_this,
+                          pixman_image_t *clip,
+                          pixman_image_t *mask,
+                          CInt32          top,
+                          CInt32          bottom,
+                          CPointI        *min,
+                          CPointI        *max);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _C_RASTERIZER_H_ */
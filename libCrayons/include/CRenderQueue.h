@@ -0,0 +1,130 @@
+/*
+ * CRenderQueue.h - Deferred rendering queue header.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _C_RENDERQUEUE_H_
+#define _C_RENDERQUEUE_H_
+
+#include "CrayonsInternal.h"
+
+#if HAVE_PTHREAD_H
+	#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| The queue defers gray path fills, renders them in bands of this many
+|*| scanlines, and holds at most the given number of fills and clip masks;
+|*| all the queues share one pool of at most the given number of workers.
+\*/
+#define CRenderQueue_TileRows    64
+#define CRenderQueue_MaxCommands 256
+#define CRenderQueue_MaxClips    8
+#define CRenderQueue_MaxThreads  16
+
+typedef struct _tagCRenderCommand CRenderCommand;
+struct _tagCRenderCommand
+{
+	CRasterizer        rasterizer;
+	CBrush            *brush;
+	pixman_image_t    *pattern;
+	pixman_image_t    *clip;
+	pixman_operator_t  op;
+	CInt32             top;
+	CInt32             bottom;
+	pixman_transform_t transform;
+	CBool              transformed;
+	CInterpolationMode interpolationMode;
+#if HAVE_PTHREAD_H
+	CBrush            *clones[CRenderQueue_MaxThreads];
+	pixman_image_t    *sources[CRenderQueue_MaxThreads];
+#endif
+};
+
+typedef struct _tagCRenderClip CRenderClip;
+struct _tagCRenderClip
+{
+	void              *owner;
+	CAffineTransformF  transform;
+	pixman_image_t    *image;
+};
+
+struct _tagCRenderQueue
+{
+	CInt32             x;
+	CInt32             y;
+	CUInt32            width;
+	CUInt32            height;
+	pixman_image_t    *mask;
+	pixman_image_t    *target;
+	CRenderCommand    *commands;
+	CUInt32            commandCount;
+	CRenderClip        clips[CRenderQueue_MaxClips];
+	CUInt32            clipCount;
+	CUInt32            tileCount;
+	CUInt32            nextTile;
+	CStatus            status;
+#if HAVE_PTHREAD_H
+	CBool              shared;
+#endif
+};
+
+CINTERNAL CStatus
+CRenderQueue_Create(CRenderQueue **_this,
+                    CInt32         x,
+                    CInt32         y,
+                    CUInt32        width,
+                    CUInt32        height);
+CINTERNAL void
+CRenderQueue_Destroy(CRenderQueue **_this);
+CINTERNAL CBool
+CRenderQueue_IsEmpty(CRenderQueue *_this);
+CINTERNAL CBool
+CRenderQueue_IsFull(CRenderQueue *_this);
+CINTERNAL void
+CRenderQueue_Reset(CRenderQueue *_this);
+CINTERNAL CStatus
+CRenderQueue_GetClip(CRenderQueue       *_this,
+                     void               *owner,
+                     CRegion            *region,
+                     CAffineTransformF  *transform,
+                     pixman_image_t    **clip);
+CINTERNAL void
+CRenderQueue_InvalidateClip(CRenderQueue *_this,
+                            void         *owner);
+CINTERNAL CStatus
+CRenderQueue_AddFill(CRenderQueue       *_this,
+                     CRasterizer        *rasterizer,
+                     CBrush             *brush,
+                     pixman_transform_t *transform,
+                     CInterpolationMode  interpolationMode,
+                     pixman_image_t     *clip,
+                     pixman_operator_t   op);
+CINTERNAL CStatus
+CRenderQueue_Flush(CRenderQueue   *_this,
+                   pixman_image_t *target);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _C_RENDERQUEUE_H_ */
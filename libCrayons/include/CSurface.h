@@ -42,6 +42,7 @@ struct _tagCSurface
 	pixman_image_t      *clip;
 	pixman_image_t      *comp;
 	CUInt32              maskFlags;
+	CRenderQueue        *queue;
 };
 
 struct _tagCSurfaceClass
@@ -113,6 +114,24 @@ struct _tagCSurfaceClass
 	CStatus (*GetDpiY)(CSurface *_this,
 	                   CFloat   *dpiY);
 
+	/*\
+	|*| Lock the backing image of the surface for direct rendering.
+	|*|
+	|*|   _this - this surface
+	|*|   image - backing image
+	|*|
+	|*|  Returns status code (not supported if there is no backing image).
+	\*/
+	CStatus (*LockImage)(CSurface        *_this,
+	                     pixman_image_t **image);
+
+	/*\
+	|*| Unlock the backing image of the surface.
+	|*|
+	|*|   _this - this surface
+	\*/
+	void (*UnlockImage)(CSurface *_this);
+
 	/*\
 	|*| Finalize the surface.
 	|*|
@@ -163,6 +182,16 @@ CINTERNAL CStatus
 CSurface_GetDpiY(CSurface *_this,
                  CFloat   *dpiY);
 CINTERNAL CStatus
+CSurface_GetRenderQueue(CSurface      *_this,
+                        CRenderQueue **queue);
+CINTERNAL CStatus
+CSurface_FlushRenderQueue(CSurface *_this);
+CINTERNAL pixman_operator_t
+CSurface_GetOperator(CCompositingMode compositingMode);
+CINTERNAL void
+CSurface_SetFilter(pixman_image_t     *src,
+                   CInterpolationMode  interpolationMode);
+CINTERNAL CStatus
 CSurface_Initialize(CSurface            *_this,
                     const CSurfaceClass *_class,
                     CUInt32              x,
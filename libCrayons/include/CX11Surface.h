@@ -62,6 +62,11 @@ CX11Surface_GetDpiX(CSurface *_this,
 static CStatus
 CX11Surface_GetDpiY(CSurface *_this,
                     CFloat   *dpiY);
+static CStatus
+CX11Surface_LockImage(CSurface        *_this,
+                      pixman_image_t **image);
+static void
+CX11Surface_UnlockImage(CSurface *_this);
 static void
 CX11Surface_Finalize(CSurface *_this);
 
@@ -73,6 +78,8 @@ static const CSurfaceClass CX11Surface_Class =
 	CX11Surface_Flush,
 	CX11Surface_GetDpiX,
 	CX11Surface_GetDpiY,
+	CX11Surface_LockImage,
+	CX11Surface_UnlockImage,
 	CX11Surface_Finalize,
 	"sentinel"
 };
@@ -90,6 +90,7 @@ typedef struct _tagCImage              CBitmap;
 typedef struct _tagCBitmapSurface      CBitmapSurface;
 typedef struct _tagCBrush              CBrush;
 typedef struct _tagCCustomLineCap      CCustomLineCap;
+typedef struct _tagCDisplayList        CDisplayList;
 typedef struct _tagCFont               CFont;
 typedef struct _tagCFontFamily         CFontFamily;
 typedef struct _tagCFontCollection     CFontCollection;
@@ -410,6 +411,15 @@ typedef CUInt32 CPixelOffsetMode;
 #define CPixelOffsetMode_None        3
 #define CPixelOffsetMode_Half        4
 
+typedef CUInt32 CRasterizerMode;
+#define CRasterizerMode_Default    0
+#define CRasterizerMode_Trapezoids 1
+#define CRasterizerMode_Scanline   2
+
+typedef CUInt32 CRenderingMode;
+#define CRenderingMode_Immediate 0
+#define CRenderingMode_Deferred  1
+
 typedef CUInt32 CRotateFlipType;
 #define CRotateFlipType_RotateNoneFlipNone 0
 #define CRotateFlipType_Rotate90FlipNone   1
@@ -761,6 +771,29 @@ CColorPalette_Destroy(CColorPalette **_this);
 
 
 
+/******************************************************************************/
+#define CRAYONS_DISPLAYLIST_METHODS
+#ifdef CRAYONS_DISPLAYLIST_METHODS
+/* Declare public display list methods. */
+CStatus
+CDisplayList_Create(CDisplayList **_this);
+CStatus
+CDisplayList_Destroy(CDisplayList **_this);
+CStatus
+CDisplayList_Clear(CDisplayList *_this);
+CStatus
+CDisplayList_DrawPath(CDisplayList *_this,
+                      CPen         *pen,
+                      CPath        *path);
+CStatus
+CDisplayList_FillPath(CDisplayList *_this,
+                      CBrush       *brush,
+                      CPath        *path);
+#endif
+/******************************************************************************/
+
+
+
 /******************************************************************************/
 #define CRAYONS_FONTCOLLECTION_METHODS
 #ifdef CRAYONS_FONTCOLLECTION_METHODS
@@ -992,6 +1025,18 @@ CStatus
 CGraphics_SetPixelOffsetMode(CGraphics        *_this,
                              CPixelOffsetMode  pixelOffsetMode);
 CStatus
+CGraphics_GetRasterizerMode(CGraphics       *_this,
+                            CRasterizerMode *rasterizerMode);
+CStatus
+CGraphics_SetRasterizerMode(CGraphics       *_this,
+                            CRasterizerMode  rasterizerMode);
+CStatus
+CGraphics_GetRenderingMode(CGraphics      *_this,
+                           CRenderingMode *renderingMode);
+CStatus
+CGraphics_SetRenderingMode(CGraphics      *_this,
+                           CRenderingMode  renderingMode);
+CStatus
 CGraphics_GetRenderingOrigin(CGraphics *_this,
                              CPointI   *renderingOrigin);
 CStatus
@@ -1095,6 +1140,9 @@ CGraphics_DrawCurve(CGraphics *_this,
                     CUInt32    numberOfSegments,
                     CFloat     tension);
 CStatus
+CGraphics_DrawDisplayList(CGraphics    *_this,
+                          CDisplayList *displayList);
+CStatus
 CGraphics_DrawEllipse(CGraphics   *_this,
                       CPen        *pen,
                       CRectangleF  rect);
@@ -143,6 +143,26 @@ struct _tagCTrapezoids
 	CTrapezoidX *trapezoids;
 };
 
+typedef struct _tagCRasterLine CRasterLine;
+struct _tagCRasterLine
+{
+	CInt32 x1;
+	CInt32 y1;
+	CInt32 x2;
+	CInt32 y2;
+	CInt64 slope;
+	CInt32 direction;
+};
+
+typedef struct _tagCRasterizer CRasterizer;
+struct _tagCRasterizer
+{
+	CUInt32      count;
+	CUInt32      capacity;
+	CRasterLine *lines;
+	CFillMode    fillMode;
+};
+
 typedef struct _tagCAffineTransformF CAffineTransformF;
 struct _tagCAffineTransformF
 {
@@ -195,10 +215,11 @@ struct _tagCBezierF
 	CPointF d;
 };
 
-typedef struct _tagCFiller   CFiller;
-typedef struct _tagCPolygonX CPolygonX;
-typedef struct _tagCStroker  CStroker;
-typedef CPointF              CVectorF;
+typedef struct _tagCFiller      CFiller;
+typedef struct _tagCPolygonX    CPolygonX;
+typedef struct _tagCRenderQueue CRenderQueue;
+typedef struct _tagCStroker     CStroker;
+typedef CPointF                 CVectorF;
 
 
 
@@ -0,0 +1,911 @@
+/*
+ * benchmark.c - Crayons offscreen rendering benchmark.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <Crayons.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "CrayonsConfig.h"
+#if STDC_HEADERS
+	#include <stdlib.h>
+	#include <stddef.h>
+#elif HAVE_STDLIB_H
+	#include <stdlib.h>
+#endif
+#if TIME_WITH_SYS_TIME
+	#include <sys/time.h>
+	#include <time.h>
+#elif HAVE_SYS_TIME_H
+	#include <sys/time.h>
+#else
+	#include <time.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| Each scene is drawn, from a cleared surface, as many times as fits in
+|*| the given time, and the rates are reported along with a checksum of the
+|*| pixels of a single frame. Geometry comes from a fixed pseudo-random
+|*| sequence, so the checksums are stable from run to run; comparing them
+|*| against those of an earlier build catches rendering changes. The text
+|*| scene depends on the installed fonts, so its checksum is only stable on
+|*| the same machine.
+\*/
+
+#define BenchShapes  64
+#define BenchDefault 1.0
+
+typedef struct _tagBenchContext BenchContext;
+struct _tagBenchContext
+{
+	CBitmap   *bitmap;
+	CSurface  *surface;
+	CGraphics *gc;
+	CBitmap   *texture;
+	CPath     *shapes[BenchShapes];
+	CFont     *font;
+	CUInt32    width;
+	CUInt32    height;
+	CUInt32    seed;
+};
+
+typedef struct _tagBenchScene BenchScene;
+struct _tagBenchScene
+{
+	const char *name;
+	CStatus   (*draw)(BenchContext *_this);
+	CUInt32     paths;
+};
+
+static CStatus
+BenchContext_Initialize(BenchContext *_this,
+                        CUInt32       width,
+                        CUInt32       height);
+static void
+BenchContext_Finalize(BenchContext *_this);
+static CStatus
+Bench_FillPaths(BenchContext *_this);
+static CStatus
+Bench_StrokePaths(BenchContext *_this);
+static CStatus
+Bench_LineGradient(BenchContext *_this);
+static CStatus
+Bench_PathGradient(BenchContext *_this);
+static CStatus
+Bench_Hatch(BenchContext *_this);
+static CStatus
+Bench_Texture(BenchContext *_this);
+static CStatus
+Bench_Text(BenchContext *_this);
+static CStatus
+Bench_ClipRegion(BenchContext *_this);
+
+/* Scenes, in the order they're run. */
+static const BenchScene BenchScenes[] =
+{
+	{ "fill",          Bench_FillPaths,    BenchShapes },
+	{ "stroke",        Bench_StrokePaths,  BenchShapes },
+	{ "line-gradient", Bench_LineGradient, BenchShapes },
+	{ "path-gradient", Bench_PathGradient, BenchShapes },
+	{ "hatch",         Bench_Hatch,        BenchShapes },
+	{ "texture",       Bench_Texture,      BenchShapes },
+	{ "text",          Bench_Text,         BenchShapes },
+	{ "clip",          Bench_ClipRegion,   BenchShapes },
+	{ 0,               0,                  0 }
+};
+
+/* Get the current time, in seconds. */
+static double
+Bench_GetTime(void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+	/* declarations */
+	struct timeval tv;
+
+	/* get the time information */
+	gettimeofday(&tv, 0);
+
+	/* return the time */
+	return (tv.tv_sec + (tv.tv_usec / 1000000.0));
+#else
+	/* return the fallback time (better than nothing) */
+	return (double)time(0);
+#endif
+}
+
+/* Get the next pseudo-random number in the range [0, limit). */
+static CUInt32
+BenchContext_Random(BenchContext *_this,
+                    CUInt32       limit)
+{
+	/* advance the sequence */
+	_this->seed = ((_this->seed * 1103515245) + 12345);
+
+	/* return the next number */
+	return (((_this->seed >> 16) & 0x7FFF) % limit);
+}
+
+/* Get a pseudo-random opaque color. */
+static CColor
+BenchContext_Color(BenchContext *_this)
+{
+	return (0xFF000000 |
+	        (BenchContext_Random(_this, 256) << 16) |
+	        (BenchContext_Random(_this, 256) <<  8) |
+	        (BenchContext_Random(_this, 256) <<  0));
+}
+
+/* Get a pseudo-random rectangle within the surface. */
+static CRectangleF
+BenchContext_Rectangle(BenchContext *_this)
+{
+	/* declarations */
+	CRectangleF rect;
+
+	/* calculate the rectangle */
+	rect.width  = (CFloat)(16 + BenchContext_Random(_this, _this->width  / 4));
+	rect.height = (CFloat)(16 + BenchContext_Random(_this, _this->height / 4));
+	rect.x      = (CFloat)BenchContext_Random(_this, _this->width);
+	rect.y      = (CFloat)BenchContext_Random(_this, _this->height);
+	rect.x     -= (rect.width  / 2);
+	rect.y     -= (rect.height / 2);
+
+	/* return the rectangle */
+	return rect;
+}
+
+/* Add a pseudo-random shape to the given path. */
+static CStatus
+BenchContext_AddShape(BenchContext *_this,
+                      CPath        *path)
+{
+	/* declarations */
+	CRectangleF rect;
+
+	/* get the bounds of the shape */
+	rect = BenchContext_Rectangle(_this);
+
+	/* add the shape */
+	switch(BenchContext_Random(_this, 3))
+	{
+		case 0:
+		{
+			return CPath_AddEllipse
+				(path, rect.x, rect.y, rect.width, rect.height);
+		}
+
+		case 1:
+		{
+			/* declarations */
+			CPointF points[5];
+			CUInt32 i;
+
+			/* calculate the points of a star */
+			for(i = 0; i < 5; ++i)
+			{
+				/* declarations */
+				CUInt32 j;
+
+				/* get the next point, skipping every other one */
+				j = ((i * 2) % 5);
+
+				/* calculate the point */
+				points[i].x = (rect.x + (rect.width  * ((j * 37) % 101) / 100.0f));
+				points[i].y = (rect.y + (rect.height * ((j * 59) % 101) / 100.0f));
+			}
+
+			/* add the star */
+			return CPath_AddPolygon(path, points, 5);
+		}
+
+		default:
+		{
+			return CPath_AddBezier
+				(path,
+				 rect.x,                rect.y,
+				 rect.x + rect.width,   rect.y,
+				 rect.x,                rect.y + rect.height,
+				 rect.x + rect.width,   rect.y + rect.height);
+		}
+	}
+}
+
+/* Entry point. */
+int
+main(int argc, char *argv[])
+{
+	/* declarations */
+	BenchContext      ctx;
+	const BenchScene *scene;
+	FILE             *reference;
+	CUInt32           width;
+	CUInt32           height;
+	CBool             deferred;
+	double            duration;
+	int               failures;
+	int               first;
+	int               i;
+
+	/* set the options to the defaults */
+	width     = 512;
+	height    = 512;
+	deferred  = 0;
+	duration  = BenchDefault;
+	reference = 0;
+	failures  = 0;
+
+	/* parse the options */
+	for(i = 1; i < argc && argv[i][0] == '-'; ++i)
+	{
+		if(strcmp(argv[i], "-d") == 0)
+		{
+			deferred = 1;
+		}
+		else if(strcmp(argv[i], "-s") == 0 && (i + 1) < argc)
+		{
+			width  = (CUInt32)atoi(argv[++i]);
+			height = width;
+		}
+		else if(strcmp(argv[i], "-t") == 0 && (i + 1) < argc)
+		{
+			duration = atof(argv[++i]);
+		}
+		else if(strcmp(argv[i], "-c") == 0 && (i + 1) < argc)
+		{
+			if(!(reference = fopen(argv[++i], "r")))
+			{
+				fprintf(stderr, "ERROR: unable to open %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else
+		{
+			fprintf
+				(stderr,
+				 "usage: %s [-d] [-s size] [-t seconds] [-c checksums] "
+				 "[scene ...]\n"
+				 "  -d  defer fills (CRenderingMode_Deferred)\n"
+				 "  -s  width and height of the surface (512)\n"
+				 "  -t  minimum time to spend on each scene (1.0)\n"
+				 "  -c  compare against the checksums of an earlier run\n",
+				 argv[0]);
+			return 1;
+		}
+	}
+	first = i;
+
+	/* ensure we have a sensible surface size */
+	if(width < 64 || width > 8192)
+	{
+		fprintf(stderr, "ERROR: surface size must be between 64 and 8192\n");
+		return 1;
+	}
+
+	/* initialize the context */
+	if(BenchContext_Initialize(&ctx, width, height) != CStatus_OK)
+	{
+		fprintf(stderr, "ERROR: benchmark context creation failed\n");
+		return 2;
+	}
+
+	/* set the rendering mode */
+	if(deferred)
+	{
+		CGraphics_SetRenderingMode(ctx.gc, CRenderingMode_Deferred);
+	}
+
+	/* print the header */
+	printf
+		("%-14s %8s %12s %12s  %s\n",
+		 "scene", "frames", "paths/s", "Mpixels/s", "checksum");
+
+	/* run the scenes */
+	for(scene = BenchScenes; scene->name != 0; ++scene)
+	{
+		/* declarations */
+		CBitmapData data;
+		CStatus     status;
+		CUInt32     checksum;
+		CUInt32     frames;
+		CUInt32     row;
+		double      start;
+		double      elapsed;
+
+		/* skip scenes which weren't asked for */
+		if(first < argc)
+		{
+			for(i = first; i < argc; ++i)
+			{
+				if(strcmp(argv[i], scene->name) == 0) { break; }
+			}
+			if(i == argc) { continue; }
+		}
+
+		/* draw the reference frame */
+		ctx.seed = 1;
+		status = CGraphics_Clear(ctx.gc, 0xFFFFFFFF);
+		if(status == CStatus_OK) { status = scene->draw(&ctx); }
+		if(status == CStatus_OK)
+		{
+			status = CGraphics_Flush(ctx.gc, CFlushIntention_Sync);
+		}
+
+		/* skip scenes which can't be drawn here */
+		if(status != CStatus_OK)
+		{
+			printf("%-14s %8s (status %d)\n", scene->name, "skipped", status);
+			continue;
+		}
+
+		/* calculate the checksum (FNV-1a) of the frame */
+		status =
+			CBitmap_LockBits
+				(ctx.bitmap, 0, 0, width, height, CImageLockMode_ReadOnly,
+				 CPixelFormat_32bppArgb, &data);
+		if(status != CStatus_OK)
+		{
+			fprintf(stderr, "ERROR: unable to lock the bitmap\n");
+			failures = 1;
+			break;
+		}
+		checksum = 2166136261U;
+		for(row = 0; row < data.height; ++row)
+		{
+			/* declarations */
+			const CByte *p;
+			const CByte *end;
+
+			/* hash the row */
+			p   = (data.scan0 + (row * data.stride));
+			end = (p + (data.width * 4));
+			for(; p != end; ++p)
+			{
+				checksum = ((checksum ^ *p) * 16777619U);
+			}
+		}
+		CBitmap_UnlockBits(ctx.bitmap, &data);
+
+		/* draw the scene for the given time */
+		frames  = 0;
+		start   = Bench_GetTime();
+		elapsed = 0;
+		do
+		{
+			/* draw the frame */
+			ctx.seed = 1;
+			CGraphics_Clear(ctx.gc, 0xFFFFFFFF);
+			scene->draw(&ctx);
+			CGraphics_Flush(ctx.gc, CFlushIntention_Sync);
+
+			/* update the frame count and the elapsed time */
+			++frames;
+			elapsed = (Bench_GetTime() - start);
+		}
+		while(elapsed < duration);
+
+		/* print the results */
+		printf
+			("%-14s %8u %12.0f %12.2f  %08x\n",
+			 scene->name, frames,
+			 ((frames * (double)scene->paths) / elapsed),
+			 ((frames * (double)width * height) / elapsed / 1000000.0),
+			 checksum);
+
+		/* compare against the reference checksum, as needed */
+		if(reference != 0)
+		{
+			/* declarations */
+			char         line[256];
+			char         name[64];
+			unsigned int expected;
+			CBool        found;
+
+			/* find the reference checksum, skipping any other lines */
+			rewind(reference);
+			found = 0;
+			while(!found && fgets(line, sizeof(line), reference) != 0)
+			{
+				found =
+					(sscanf
+						(line, "%63s %*s %*s %*s %x", name, &expected) == 2 &&
+					 strcmp(name, scene->name) == 0);
+			}
+
+			/* report any mismatch */
+			if(found && expected != checksum)
+			{
+				printf
+					("%-14s checksum mismatch (expected %08x)\n",
+					 scene->name, expected);
+				failures = 1;
+			}
+		}
+	}
+
+	/* finalize the context */
+	BenchContext_Finalize(&ctx);
+
+	/* close the reference file, as needed */
+	if(reference != 0) { fclose(reference); }
+
+	/* exit */
+	return failures;
+}
+
+/* Initialize a benchmark context. */
+static CStatus
+BenchContext_Initialize(BenchContext *_this,
+                        CUInt32       width,
+                        CUInt32       height)
+{
+	/* declarations */
+	CFontFamily *family;
+	CStatus      status;
+	CUInt32      i;
+
+	/* clear the context */
+	memset(_this, 0, sizeof(BenchContext));
+
+	/* initialize the size and seed */
+	_this->width  = width;
+	_this->height = height;
+	_this->seed   = 1;
+
+	/* create the bitmap */
+	if((status = CBitmap_Create
+		(&(_this->bitmap), width, height, CPixelFormat_32bppArgb)) != CStatus_OK)
+	{
+		return status;
+	}
+
+	/* create the surface */
+	if((status = CBitmapSurface_Create
+		((CBitmapSurface **)&(_this->surface), _this->bitmap)) != CStatus_OK)
+	{
+		BenchContext_Finalize(_this);
+		return status;
+	}
+
+	/* create the graphics context */
+	if((status = CGraphics_Create(&(_this->gc), _this->surface)) != CStatus_OK)
+	{
+		BenchContext_Finalize(_this);
+		return status;
+	}
+
+	/* draw smooth shapes and text */
+	CGraphics_SetSmoothingMode(_this->gc, CSmoothingMode_AntiAlias);
+	CGraphics_SetTextRenderingHint(_this->gc, CTextRenderingHint_AntiAlias);
+
+	/* create the texture, a small checkerboard */
+	if((status = CBitmap_Create
+		(&(_this->texture), 16, 16, CPixelFormat_32bppArgb)) != CStatus_OK)
+	{
+		BenchContext_Finalize(_this);
+		return status;
+	}
+	for(i = 0; i < (16 * 16); ++i)
+	{
+		CBitmap_SetPixel
+			(_this->texture, (i % 16), (i / 16),
+			 ((((i % 16) ^ (i / 16)) & 4) ? 0xFF2040C0 : 0xFFF0C020));
+	}
+
+	/* create the shapes */
+	for(i = 0; i < BenchShapes; ++i)
+	{
+		if((status = CPath_Create(&(_this->shapes[i]))) != CStatus_OK ||
+		   (status = BenchContext_AddShape(_this, _this->shapes[i])) != CStatus_OK)
+		{
+			BenchContext_Finalize(_this);
+			return status;
+		}
+	}
+
+	/* create the font, if any font is available */
+	if(CFontFamily_CreateGeneric
+		(&family, CFontFamilyGeneric_SansSerif) == CStatus_OK)
+	{
+		if(CFont_Create
+			(&(_this->font), family, CFontStyle_Regular, 14,
+			 CGraphicsUnit_Pixel) != CStatus_OK)
+		{
+			_this->font = 0;
+		}
+		CFontFamily_Destroy(&family);
+	}
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Finalize a benchmark context. */
+static void
+BenchContext_Finalize(BenchContext *_this)
+{
+	/* declarations */
+	CUInt32 i;
+
+	/* destroy the resources, as needed */
+	if(_this->font    != 0) { CFont_Destroy(&(_this->font)); }
+	for(i = 0; i < BenchShapes; ++i)
+	{
+		if(_this->shapes[i] != 0) { CPath_Destroy(&(_this->shapes[i])); }
+	}
+	if(_this->texture != 0) { CBitmap_Destroy(&(_this->texture)); }
+	if(_this->gc      != 0) { CGraphics_Destroy(&(_this->gc)); }
+	if(_this->surface != 0) { CSurface_Destroy(&(_this->surface)); }
+	if(_this->bitmap  != 0) { CBitmap_Destroy(&(_this->bitmap)); }
+}
+
+/* Fill every shape with the given brush, or with solid colors. */
+static CStatus
+BenchContext_FillShapes(BenchContext *_this,
+                        CBrush       *brush)
+{
+	/* declarations */
+	CStatus status;
+	CUInt32 i;
+
+	/* fill the shapes */
+	for(i = 0; i < BenchShapes; ++i)
+	{
+		/* fill the shape with the given brush, as needed */
+		if(brush != 0)
+		{
+			status = CGraphics_FillPath(_this->gc, brush, _this->shapes[i]);
+		}
+		else
+		{
+			/* declarations */
+			CBrush *solid;
+
+			/* create a solid brush */
+			if((status = CSolidBrush_Create
+				((CSolidBrush **)(void *)&solid,
+				 (BenchContext_Color(_this) & 0xC0FFFFFF))) != CStatus_OK)
+			{
+				return status;
+			}
+
+			/* fill the shape */
+			status = CGraphics_FillPath(_this->gc, solid, _this->shapes[i]);
+
+			/* destroy the brush */
+			CBrush_Destroy(&solid);
+		}
+
+		/* handle fill failures */
+		if(status != CStatus_OK) { return status; }
+	}
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Draw translucent solid fills. */
+static CStatus
+Bench_FillPaths(BenchContext *_this)
+{
+	return BenchContext_FillShapes(_this, 0);
+}
+
+/* Draw wide, dashed, and hairline strokes. */
+static CStatus
+Bench_StrokePaths(BenchContext *_this)
+{
+	/* declarations */
+	CBrush  *brush;
+	CPen    *pens[3];
+	CStatus  status;
+	CUInt32  i;
+
+	/* create the brush */
+	if((status = CSolidBrush_Create
+		((CSolidBrush **)(void *)&brush, 0xFF203060)) != CStatus_OK)
+	{
+		return status;
+	}
+
+	/* create the pens */
+	pens[0] = pens[1] = pens[2] = 0;
+	if((status = CPen_Create(&pens[0], brush, 6))  != CStatus_OK ||
+	   (status = CPen_Create(&pens[1], brush, 2))  != CStatus_OK ||
+	   (status = CPen_Create(&pens[2], brush, -1)) != CStatus_OK ||
+	   (status = CPen_SetDashStyle(pens[1], CDashStyle_Dash)) != CStatus_OK)
+	{
+		goto GOTO_Cleanup;
+	}
+
+	/* stroke the shapes */
+	for(i = 0; i < BenchShapes; ++i)
+	{
+		status = CGraphics_DrawPath(_this->gc, pens[i % 3], _this->shapes[i]);
+		if(status != CStatus_OK) { break; }
+	}
+
+GOTO_Cleanup:
+	/* destroy the pens and brush */
+	for(i = 0; i < 3; ++i)
+	{
+		if(pens[i] != 0) { CPen_Destroy(&pens[i]); }
+	}
+	CBrush_Destroy(&brush);
+
+	/* return status */
+	return status;
+}
+
+/* Draw fills with a linear gradient. */
+static CStatus
+Bench_LineGradient(BenchContext *_this)
+{
+	/* declarations */
+	CBrush      *brush;
+	CRectangleF  rect;
+	CStatus      status;
+
+	/* get the gradient bounds */
+	rect.x      = 0;
+	rect.y      = 0;
+	rect.width  = (CFloat)(_this->width  / 3);
+	rect.height = (CFloat)(_this->height / 3);
+
+	/* create the brush */
+	if((status = CLineBrush_Create
+		((CLineBrush **)(void *)&brush, rect, 0xFFC02020, 0xFF2020C0,
+		 30.0f, 0, CWrapMode_TileFlipXY)) != CStatus_OK)
+	{
+		return status;
+	}
+
+	/* fill the shapes */
+	status = BenchContext_FillShapes(_this, brush);
+
+	/* destroy the brush */
+	CBrush_Destroy(&brush);
+
+	/* return status */
+	return status;
+}
+
+/* Draw fills with a radial path gradient. */
+static CStatus
+Bench_PathGradient(BenchContext *_this)
+{
+	/* declarations */
+	CBrush  *brush;
+	CPath   *path;
+	CColor   surround;
+	CStatus  status;
+
+	/* create the gradient path */
+	if((status = CPath_Create(&path)) != CStatus_OK) { return status; }
+	if((status = CPath_AddEllipse
+		(path, 0, 0, (CFloat)_this->width, (CFloat)_this->height)) != CStatus_OK)
+	{
+		CPath_Destroy(&path);
+		return status;
+	}
+
+	/* create the brush */
+	status = CPathBrush_Create((CPathBrush **)(void *)&brush, path);
+	CPath_Destroy(&path);
+	if(status != CStatus_OK) { return status; }
+
+	/* set the colors */
+	surround = 0xFF102040;
+	if((status = CPathBrush_SetCenterColor
+		((CPathBrush *)brush, 0xFFF0F0A0)) != CStatus_OK ||
+	   (status = CPathBrush_SetSurroundColors
+		((CPathBrush *)brush, &surround, 1)) != CStatus_OK)
+	{
+		CBrush_Destroy(&brush);
+		return status;
+	}
+
+	/* fill the shapes */
+	status = BenchContext_FillShapes(_this, brush);
+
+	/* destroy the brush */
+	CBrush_Destroy(&brush);
+
+	/* return status */
+	return status;
+}
+
+/* Draw fills with a hatch pattern. */
+static CStatus
+Bench_Hatch(BenchContext *_this)
+{
+	/* declarations */
+	CBrush  *brush;
+	CStatus  status;
+
+	/* create the brush */
+	if((status = CHatchBrush_Create
+		((CHatchBrush **)(void *)&brush, CHatchStyle_DiagonalCross,
+		 0xFF000000, 0x80FFC000)) != CStatus_OK)
+	{
+		return status;
+	}
+
+	/* fill the shapes */
+	status = BenchContext_FillShapes(_this, brush);
+
+	/* destroy the brush */
+	CBrush_Destroy(&brush);
+
+	/* return status */
+	return status;
+}
+
+/* Draw fills with a tiled texture. */
+static CStatus
+Bench_Texture(BenchContext *_this)
+{
+	/* declarations */
+	CBrush      *brush;
+	CRectangleF  rect;
+	CStatus      status;
+
+	/* get the texture bounds */
+	rect.x      = 0;
+	rect.y      = 0;
+	rect.width  = 16;
+	rect.height = 16;
+
+	/* create the brush */
+	if((status = CTextureBrush_Create
+		((CTextureBrush **)(void *)&brush, (CImage *)_this->texture, rect,
+		 CWrapMode_Tile)) != CStatus_OK)
+	{
+		return status;
+	}
+
+	/* fill the shapes */
+	status = BenchContext_FillShapes(_this, brush);
+
+	/* destroy the brush */
+	CBrush_Destroy(&brush);
+
+	/* return status */
+	return status;
+}
+
+/* Draw lines of text. */
+static CStatus
+Bench_Text(BenchContext *_this)
+{
+	/* declarations */
+	CBrush  *brush;
+	CChar16  text[64];
+	CStatus  status;
+	CUInt32  length;
+	CUInt32  i;
+
+	/* sample text */
+	static const char sample[] =
+		"The quick brown fox jumps over the lazy dog 0123456789";
+
+	/* bail out now if there's no font */
+	if(_this->font == 0) { return CStatus_Argument_FontFamilyNotFound; }
+
+	/* convert the sample text */
+	for(length = 0; sample[length] != '\0'; ++length)
+	{
+		text[length] = (CChar16)sample[length];
+	}
+
+	/* create the brush */
+	if((status = CSolidBrush_Create
+		((CSolidBrush **)(void *)&brush, 0xFF000000)) != CStatus_OK)
+	{
+		return status;
+	}
+
+	/* draw the lines, at fractional positions */
+	for(i = 0; i < BenchShapes; ++i)
+	{
+		/* declarations */
+		CRectangleF rect;
+
+		/* get the layout rectangle */
+		rect.x      = (4 + (i * 0.25f));
+		rect.y      = (CFloat)((i * _this->height) / BenchShapes);
+		rect.width  = 0;
+		rect.height = 0;
+
+		/* draw the line */
+		status =
+			CGraphics_DrawStringSimple
+				(_this->gc, brush, text, length, _this->font, rect);
+		if(status != CStatus_OK) { break; }
+	}
+
+	/* destroy the brush */
+	CBrush_Destroy(&brush);
+
+	/* return status */
+	return status;
+}
+
+/* Draw solid fills through a complex clip region. */
+static CStatus
+Bench_ClipRegion(BenchContext *_this)
+{
+	/* declarations */
+	CRegion     *region;
+	CPath       *hole;
+	CRectangleF  rect;
+	CStatus      status;
+
+	/* get the region bounds */
+	rect.x      = (CFloat)(_this->width  / 8);
+	rect.y      = (CFloat)(_this->height / 8);
+	rect.width  = (CFloat)((_this->width  * 3) / 4);
+	rect.height = (CFloat)((_this->height * 3) / 4);
+
+	/* create the region, a rectangle with an elliptical hole */
+	if((status = CRegion_CreateRectangle(&region, rect)) != CStatus_OK)
+	{
+		return status;
+	}
+	if((status = CPath_Create(&hole)) != CStatus_OK)
+	{
+		CRegion_Destroy(&region);
+		return status;
+	}
+	if((status = CPath_AddEllipse
+		(hole, rect.x + (rect.width / 4), rect.y + (rect.height / 4),
+		 (rect.width / 2), (rect.height / 2))) == CStatus_OK)
+	{
+		status = CRegion_CombinePath(region, hole, CCombineMode_Exclude);
+	}
+	CPath_Destroy(&hole);
+
+	/* set the clip */
+	if(status == CStatus_OK)
+	{
+		status =
+			CGraphics_SetClipRegion(_this->gc, region, CCombineMode_Replace);
+	}
+	CRegion_Destroy(&region);
+
+	/* fill the shapes */
+	if(status == CStatus_OK)
+	{
+		status = BenchContext_FillShapes(_this, 0);
+	}
+
+	/* reset the clip */
+	CGraphics_ResetClip(_this->gc);
+
+	/* return status */
+	return status;
+}
+
+
+#ifdef __cplusplus
+};
+#endif
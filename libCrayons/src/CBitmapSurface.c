@@ -220,6 +220,48 @@ CBitmapSurface_GetDpiY(CSurface *_this,
 	return CStatus_OK;
 }
 
+static CStatus
+CBitmapSurface_LockImage(CSurface        *_this,
+                         pixman_image_t **image)
+{
+	/* declarations */
+	CBitmap *bitmap;
+
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((image != 0));
+
+	/* get the bitmap */
+	bitmap = ((CBitmapSurface *)_this)->image;
+
+	/* lock the bitmap */
+	CMutex_Lock(bitmap->lock);
+
+	/* ensure the image data isn't locked */
+	if(bitmap->locked)
+	{
+		CMutex_Unlock(bitmap->lock);
+		*image = 0;
+		return CStatus_InvalidOperation_ImageLocked;
+	}
+
+	/* get the image */
+	*image = bitmap->image;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+static void
+CBitmapSurface_UnlockImage(CSurface *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* unlock the bitmap */
+	CMutex_Unlock(((CBitmapSurface *)_this)->image->lock);
+}
+
 static void
 CBitmapSurface_Finalize(CSurface *_this)
 {
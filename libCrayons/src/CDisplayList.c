@@ -0,0 +1,401 @@
+/*
+ * CDisplayList.c - Display list implementation.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CDisplayList.h"
+#include "CPath.h"
+#include "CRasterizer.h"
+#include "CStroker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| A display list records path fills and strokes, along with snapshots of
+|*| their brushes and pens, so they can be drawn again and again. Each item
+|*| keeps the scanline rasterizer lines of its last replay, along with the
+|*| device transformation they were generated for; when the next replay
+|*| differs from it by a translation only, the lines are simply moved, so
+|*| flattening, stroking, and line setup are all skipped.
+\*/
+
+/* Add an item to this display list, taking ownership of its resources. */
+static CStatus
+CDisplayList_AddItem(CDisplayList     *_this,
+                     CDisplayItemType  type,
+                     CPath            *path,
+                     CBrush           *brush,
+                     CPen             *pen)
+{
+	/* declarations */
+	CDisplayItem *item;
+
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((path  != 0));
+
+	/* ensure the capacity of the item list */
+	if(_this->count == _this->capacity)
+	{
+		/* declarations */
+		CDisplayItem *tmp;
+		CUInt32       capacity;
+
+		/* calculate the new capacity */
+		capacity = ((_this->capacity == 0) ? 8 : (_this->capacity << 1));
+
+		/* reallocate the item list */
+		tmp =
+			(CDisplayItem *)CRealloc
+				(_this->items, (capacity * sizeof(CDisplayItem)));
+
+		/* ensure we have an item list */
+		CStatus_Require((tmp != 0), CStatus_OutOfMemory);
+
+		/* set the item list */
+		_this->items    = tmp;
+		_this->capacity = capacity;
+	}
+
+	/* get the item */
+	item = &(_this->items[_this->count++]);
+
+	/* initialize the item */
+	item->type   = type;
+	item->path   = path;
+	item->brush  = brush;
+	item->pen    = pen;
+	item->cached = 0;
+	CRasterizer_Initialize(&(item->rasterizer));
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Create a display list. */
+CStatus
+CDisplayList_Create(CDisplayList **_this)
+{
+	/* ensure we have a this pointer pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* allocate the display list */
+	if(!(*_this = (CDisplayList *)CMalloc(sizeof(CDisplayList))))
+	{
+		return CStatus_OutOfMemory;
+	}
+
+	/* initialize the members */
+	(*_this)->count    = 0;
+	(*_this)->capacity = 0;
+	(*_this)->items    = 0;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Destroy a display list. */
+CStatus
+CDisplayList_Destroy(CDisplayList **_this)
+{
+	/* ensure we have a this pointer pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a this pointer */
+	CStatus_Require((*_this != 0), CStatus_ArgumentNull);
+
+	/* dispose of the items */
+	CDisplayList_Clear(*_this);
+
+	/* free the item list, as needed */
+	if((*_this)->items != 0)
+	{
+		CFree((*_this)->items);
+	}
+
+	/* dispose of the display list */
+	CFree(*_this);
+
+	/* null the this pointer */
+	*_this = 0;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Remove all the items from this display list. */
+CStatus
+CDisplayList_Clear(CDisplayList *_this)
+{
+	/* declarations */
+	CDisplayItem *item;
+	CDisplayItem *end;
+
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* get the item pointers */
+	item = _this->items;
+	end  = (item + _this->count);
+
+	/* dispose of the items */
+	for(; item != end; ++item)
+	{
+		CRasterizer_Finalize(&(item->rasterizer));
+		CPath_Destroy(&(item->path));
+		if(item->brush != 0) { CBrush_Destroy(&(item->brush)); }
+		if(item->pen   != 0) { CPen_Destroy(&(item->pen)); }
+	}
+
+	/* reset the count */
+	_this->count = 0;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Record the stroke of a path. */
+CStatus
+CDisplayList_DrawPath(CDisplayList *_this,
+                      CPen         *pen,
+                      CPath        *path)
+{
+	/* declarations */
+	CPath   *pathClone;
+	CPen    *penClone;
+	CStatus  status;
+
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a pen pointer */
+	CStatus_Require((pen != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a path pointer */
+	CStatus_Require((path != 0), CStatus_ArgumentNull);
+
+	/* take a snapshot of the path */
+	CStatus_Check
+		(CPath_Clone
+			(path, &pathClone));
+
+	/* take a snapshot of the pen */
+	if((status = CPen_Clone(pen, &penClone)) != CStatus_OK)
+	{
+		CPath_Destroy(&pathClone);
+		return status;
+	}
+
+	/* add the item */
+	status =
+		CDisplayList_AddItem
+			(_this, CDisplayItemType_Stroke, pathClone, 0, penClone);
+
+	/* handle item failures */
+	if(status != CStatus_OK)
+	{
+		CPen_Destroy(&penClone);
+		CPath_Destroy(&pathClone);
+	}
+
+	/* return status */
+	return status;
+}
+
+/* Record the fill of a path. */
+CStatus
+CDisplayList_FillPath(CDisplayList *_this,
+                      CBrush       *brush,
+                      CPath        *path)
+{
+	/* declarations */
+	CPath   *pathClone;
+	CBrush  *brushClone;
+	CStatus  status;
+
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a brush pointer */
+	CStatus_Require((brush != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a path pointer */
+	CStatus_Require((path != 0), CStatus_ArgumentNull);
+
+	/* take a snapshot of the path */
+	CStatus_Check
+		(CPath_Clone
+			(path, &pathClone));
+
+	/* take a snapshot of the brush */
+	if((status = CBrush_Clone(brush, &brushClone)) != CStatus_OK)
+	{
+		CPath_Destroy(&pathClone);
+		return status;
+	}
+
+	/* add the item */
+	status =
+		CDisplayList_AddItem
+			(_this, CDisplayItemType_Fill, pathClone, brushClone, 0);
+
+	/* handle item failures */
+	if(status != CStatus_OK)
+	{
+		CBrush_Destroy(&brushClone);
+		CPath_Destroy(&pathClone);
+	}
+
+	/* return status */
+	return status;
+}
+
+/* Convert a distance to the nearest whole number of rasterizer subpixels. */
+static CInt32
+CDisplayItem_ToSubpixel(CFloat value)
+{
+	/* scale the value to subpixels */
+	value *= 256.0f;
+
+	/* round the value to the nearest subpixel */
+	return (CInt32)((value < 0) ? (value - 0.5f) : (value + 0.5f));
+}
+
+/*\
+|*| Get the rasterized geometry of this item for the given device
+|*| transformation, using the scratch path to generate it if needed.
+\*/
+CINTERNAL CStatus
+CDisplayItem_GetGeometry(CDisplayItem       *_this,
+                         CAffineTransformF  *transform,
+                         CPath              *scratch,
+                         CRasterizer       **rasterizer)
+{
+	/* declarations */
+	CStatus status;
+
+	/* assertions */
+	CASSERT((_this      != 0));
+	CASSERT((transform  != 0));
+	CASSERT((scratch    != 0));
+	CASSERT((rasterizer != 0));
+
+	/* get the rasterizer */
+	*rasterizer = &(_this->rasterizer);
+
+	/* move the cached geometry, if only the translation has changed */
+	if(_this->cached &&
+	   _this->transform.m11 == transform->m11 &&
+	   _this->transform.m12 == transform->m12 &&
+	   _this->transform.m21 == transform->m21 &&
+	   _this->transform.m22 == transform->m22)
+	{
+		/* declarations */
+		CInt32 dx;
+		CInt32 dy;
+
+		/* get the translation, in subpixels */
+		dx = CDisplayItem_ToSubpixel(transform->dx - _this->transform.dx);
+		dy = CDisplayItem_ToSubpixel(transform->dy - _this->transform.dy);
+
+		/* translate the geometry, as needed */
+		if(dx != 0 || dy != 0)
+		{
+			/* move the lines */
+			CRasterizer_Translate(&(_this->rasterizer), dx, dy);
+
+			/* track the translation actually applied, so errors don't add up */
+			_this->transform.dx += (dx / 256.0f);
+			_this->transform.dy += (dy / 256.0f);
+		}
+
+		/* return successfully */
+		return CStatus_OK;
+	}
+
+	/* the cached geometry is about to be replaced */
+	_this->cached = 0;
+	CRasterizer_Reset(&(_this->rasterizer));
+
+	/* generate the device space path */
+	if(_this->type == CDisplayItemType_Stroke)
+	{
+		/* declarations */
+		CStroker stroker;
+
+		/* reset the scratch path */
+		CStatus_Check
+			(CPath_Reset
+				(scratch));
+
+		/* initialize the stroker */
+		CStatus_Check
+			(CStroker_Initialize
+				(&stroker, _this->pen, transform));
+
+		/* stroke the path */
+		status =
+			CPath_Stroke
+				(_this->path, scratch, &stroker);
+
+		/* finalize the stroker */
+		CStroker_Finalize(&stroker);
+
+		/* handle stroke failures */
+		CStatus_Check(status);
+	}
+	else
+	{
+		/* reset the scratch path */
+		CStatus_Check
+			(CPath_Reset
+				(scratch));
+
+		/* copy the path */
+		CStatus_Check
+			(CPath_AddPath
+				(scratch, _this->path, 0));
+
+		/* set the fill mode */
+		CStatus_Check
+			(CPath_SetFillMode
+				(scratch, CFillMode_Alternate));
+	}
+
+	/* transform the path */
+	CPath_TransformAffine(scratch, transform);
+
+	/* fill the path */
+	CStatus_Check
+		(CPath_Rasterize
+			(scratch, &(_this->rasterizer)));
+
+	/* cache the geometry */
+	_this->transform = *transform;
+	_this->cached    = 1;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+
+#ifdef __cplusplus
+};
+#endif
@@ -20,6 +20,7 @@
 
 #include "CFiller.h"
 #include "CBezier.h"
+#include "CRasterizer.h"
 #include "CTrapezoids.h"
 
 #ifdef __cplusplus
@@ -216,6 +217,16 @@ CFiller_Close(CPathInterpreter *_this)
 		/* reset the polygon */
 		CPolygonX_Reset(polygon);
 	}
+	else if(filler->rasterizer != 0)
+	{
+		/* add the polygon to the rasterizer */
+		CStatus_Check
+			(CRasterizer_AddPolygon
+				(filler->rasterizer, polygon));
+
+		/* reset the polygon */
+		CPolygonX_Reset(polygon);
+	}
 
 	/* return successfully */
 	return CStatus_OK;
@@ -325,6 +336,60 @@ CFiller_ToTrapezoids(CFiller       *_this,
 	return CStatus_OK;
 }
 
+CINTERNAL CStatus
+CFiller_ToRasterizer(CFiller       *_this,
+                     CRasterizer   *rasterizer,
+                     const CPointF *points,
+                     const CByte   *types,
+                     CUInt32        count,
+                     CFillMode      fillMode)
+{
+	/* declarations */
+	CPathInterpreter *interpreter;
+	CStatus           status;
+
+	/* assertions */
+	CASSERT((_this      != 0));
+	CASSERT((points     != 0));
+	CASSERT((types      != 0));
+	CASSERT((rasterizer != 0));
+
+	/* get this as a path interpreter */
+	interpreter = ((CPathInterpreter *)_this);
+
+	/* set the rasterizer */
+	_this->rasterizer = rasterizer;
+
+	/* set the fill mode (applied across all the figures of the path) */
+	rasterizer->fillMode = fillMode;
+
+	/* interpret the path */
+	status = CPathInterpreter_Interpret(interpreter, points, types, count);
+
+	/* reset the rasterizer */
+	_this->rasterizer = 0;
+
+	/* handle path interpretation failures */
+	CStatus_Check(status);
+
+	/* finish rasterization, as needed */
+	if(CPolygonX_HasCurrentPoint(&(_this->polygon)))
+	{
+		/* ensure the polygon is closed */
+		CStatus_Check
+			(CPolygonX_Close
+				(&(_this->polygon)));
+
+		/* add the polygon to the rasterizer */
+		return
+			CRasterizer_AddPolygon
+				(rasterizer, &(_this->polygon));
+	}
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
 static const CPathInterpreterClass CFiller_Class =
 {
 	CFiller_Move,
@@ -351,6 +416,9 @@ CFiller_Initialize(CFiller *_this)
 
 	/* set the trapezoids to the default */
 	_this->trapezoids = 0;
+
+	/* set the rasterizer to the default */
+	_this->rasterizer = 0;
 }
 
 CINTERNAL void
@@ -362,6 +430,9 @@ CFiller_Finalize(CFiller *_this)
 	/* reset the trapezoids */
 	_this->trapezoids = 0;
 
+	/* reset the rasterizer */
+	_this->rasterizer = 0;
+
 	/* finalize the point array */
 	CPointArrayX_Finalize(&(_this->array));
 
@@ -381,6 +452,9 @@ CFiller_Reset(CFiller *_this)
 	/* reset the trapezoids */
 	_this->trapezoids = 0;
 
+	/* reset the rasterizer */
+	_this->rasterizer = 0;
+
 	/* reset the polygon */
 	CPolygonX_Reset(&(_this->polygon));
 
@@ -200,7 +200,7 @@ CFont_MeasureString(CFont              *_this,
 				/* get the current glyph entry */
 				CStatus_CheckGOTO
 					(CFontFace_GetGlyphEntry
-						(face, unicode, flags, 0, &entry),
+						(face, unicode, flags, 0, 0, &entry),
 					 status,
 					 GOTO_FailC);
 			}
@@ -294,14 +294,140 @@ CFont_MeasureString(CFont              *_this,
 }
 
 /*\
-|*| Measure a string.
+|*| Split a position into whole pixels and the nearest of the given number
+|*| of subpixel phases.
+\*/
+static void
+_SplitPosition(CFloat   value,
+               CInt32   phases,
+               CInt32  *pixel,
+               CUInt32 *phase)
+{
+	/* declarations */
+	CInt32 v;
+
+	/* round the value to the nearest phase */
+	value *= phases;
+	v = (CInt32)((value < 0) ? (value - 0.5f) : (value + 0.5f));
+
+	/* split the value, rounding the pixel toward negative infinity */
+	*pixel = ((v >= 0) ? (v / phases) : -((phases - 1 - v) / phases));
+	*phase = (CUInt32)(v - (*pixel * phases));
+}
+
+/* Include the given rectangle, clipped to the mask, in the given bounds. */
+static CBool
+_AddBounds(pixman_image_t *mask,
+           CInt32         *x,
+           CInt32         *y,
+           CInt32         *width,
+           CInt32         *height,
+           CPointI        *min,
+           CPointI        *max)
+{
+	/* declarations */
+	CInt32 x1, y1;
+	CInt32 x2, y2;
+
+	/* clip the rectangle to the mask */
+	x1 = ((*x < 0) ? 0 : *x);
+	y1 = ((*y < 0) ? 0 : *y);
+	x2 = (*x + *width);
+	y2 = (*y + *height);
+	if(x2 > pixman_image_get_width(mask))  { x2 = pixman_image_get_width(mask); }
+	if(y2 > pixman_image_get_height(mask)) { y2 = pixman_image_get_height(mask); }
+
+	/* bail out now if there's nothing to do */
+	if(x1 >= x2 || y1 >= y2) { return 0; }
+
+	/* update the bounds */
+	if(CPoint_X(*min) > x1) { CPoint_X(*min) = x1; }
+	if(CPoint_Y(*min) > y1) { CPoint_Y(*min) = y1; }
+	if(CPoint_X(*max) < x2) { CPoint_X(*max) = x2; }
+	if(CPoint_Y(*max) < y2) { CPoint_Y(*max) = y2; }
+
+	/* return the clipped rectangle */
+	*x      = x1;
+	*y      = y1;
+	*width  = (x2 - x1);
+	*height = (y2 - y1);
+	return 1;
+}
+
+/* Add the atlas mask of a glyph to the gray mask at the given position. */
+static void
+_AddAtlasGlyph(CGlyphEntry    *entry,
+               pixman_image_t *mask,
+               CInt32          x,
+               CInt32          y,
+               CPointI        *min,
+               CPointI        *max)
+{
+	/* declarations */
+	const CByte *src;
+	CByte       *dst;
+	CUInt32      stride;
+	CInt32       width;
+	CInt32       height;
+	CInt32       x1;
+	CInt32       y1;
+
+	/* get the glyph rectangle */
+	x1     = x;
+	y1     = y;
+	width  = entry->slot.width;
+	height = entry->slot.height;
+
+	/* clip the glyph rectangle to the mask and update the bounds */
+	if(!_AddBounds(mask, &x1, &y1, &width, &height, min, max)) { return; }
+
+	/* get the mask information */
+	stride = (CUInt32)pixman_image_get_stride(mask);
+
+	/* get the first rows */
+	src =
+		(entry->slot.data + ((y1 - y) * CGlyphAtlas_PageSize) + (x1 - x));
+	dst = ((CByte *)pixman_image_get_data(mask) + (y1 * stride) + x1);
+
+	/* add the glyph coverage to the mask, with saturation */
+	while(height > 0)
+	{
+		/* declarations */
+		CInt32 i;
+
+		/* add the row */
+		for(i = 0; i < width; ++i)
+		{
+			CUInt32 v = (dst[i] + src[i]);
+			dst[i] = (CByte)((v > 255) ? 255 : v);
+		}
+
+		/* move to the next row */
+		src += CGlyphAtlas_PageSize;
+		dst += stride;
+		--height;
+	}
+}
+
+/*\
+|*| Draw a string.
 |*|
 |*|     _this - this font
-|*|    string - string to measure
+|*|    string - string to draw
 |*|    length - length of string
+|*|         x - horizontal position of string
+|*|         y - vertical position of string
 |*|    device - device transformation
 |*|      hint - text rendering hint
-|*|   metrics - metrics of string (returned)
+|*|      clip - clipping mask
+|*|      mask - compositing mask
+|*|       min - top left of the drawn pixels (returned)
+|*|       max - bottom right of the drawn pixels (returned)
+|*|
+|*| The glyph masks of the whole string are added to the compositing mask
+|*| first, and the clip is applied to the drawn pixels once, so only those
+|*| need be composited. Gray glyphs are copied straight from the atlas, and,
+|*| if they're not grid fitted, placed at quarter pixel positions.
 |*|
 |*|  Returns status code.
 \*/
@@ -314,7 +440,9 @@ CFont_DrawString(CFont              *_this,
                  CAffineTransformF  *device,
                  CTextRenderingHint  hint,
                  pixman_image_t     *clip,
-                 pixman_image_t     *mask)
+                 pixman_image_t     *mask,
+                 CPointI            *min,
+                 CPointI            *max)
 {
 	/* declarations */
 	CFontFace   *face;
@@ -325,11 +453,20 @@ CFont_DrawString(CFont              *_this,
 	CStatus      status;
 	CFloat       posX;
 	CFloat       posY;
+	CInt32       phases;
 
 	/* assertions */
 	CASSERT((_this != 0));
 	CASSERT((clip  != 0));
 	CASSERT((mask  != 0));
+	CASSERT((min   != 0));
+	CASSERT((max   != 0));
+
+	/* start with empty bounds */
+	CPoint_X(*min) = pixman_image_get_width(mask);
+	CPoint_Y(*min) = pixman_image_get_height(mask);
+	CPoint_X(*max) = 0;
+	CPoint_Y(*max) = 0;
 
 	/* bail out now if there's nothing to do */
 	CStatus_Require((string != 0 && length != 0), CStatus_OK);
@@ -337,18 +474,23 @@ CFont_DrawString(CFont              *_this,
 	/* get the depth and hinting */
 	flags = _GetGlyphFlags(hint);
 
+	/* only unhinted gray glyphs are positioned to subpixels */
+	phases = ((flags == CGlyphFlag_AntiAlias) ? CGlyphAtlas_Subpixels : 1);
+
 	/* get the font face */
 	face = _this->face;
 
 	/* initialize the position and move to the baseline */
-	posX = (x + 0.5);
-	posY = (y + 0.5) + _CalcBaseline(_this, face->face);
+	posX = x;
+	posY = y + _CalcBaseline(_this, face->face);
 
 	/* draw the string, synchronously */
 	CMutex_Lock(face->lock);
 	{
 		/* declarations */
-		CChar32 prev;
+		CGlyphEntry *entry;
+		CChar32      prev;
+		CUInt32      prevPhase;
 
 		/* set the shape of the face */
 		CStatus_CheckGOTO
@@ -367,16 +509,18 @@ CFont_DrawString(CFont              *_this,
 		CFontFace_DisableMemoryManagement(face);
 
 		/* initialize the previous character */
-		prev = ((CChar32)-1);
+		entry     = 0;
+		prev      = ((CChar32)-1);
+		prevPhase = 0;
 
 		/* draw the string */
 		while(length > 0)
 		{
 			/* declarations */
-			CGlyphEntry *entry;
-			CChar32      unicode;
-			CUInt32      len;
-			int          gX, gY;
+			CChar32 unicode;
+			CUInt32 len;
+			CUInt32 phase;
+			CInt32  gX, gY;
 
 			/* skip encoding errors */
 			if((len = CUtils_Char16ToChar32(string, &unicode, length)) == 0)
@@ -391,39 +535,73 @@ CFont_DrawString(CFont              *_this,
 				length -= len;
 			}
 
+			/* calculate the pixel position and phase of the glyph origin */
+			_SplitPosition(posY, 1,      &gY, &phase);
+			_SplitPosition(posX, phases, &gX, &phase);
+
 			/* get the current glyph entry, as needed */
-			if(unicode != prev)
+			if(entry == 0 || unicode != prev || phase != prevPhase)
 			{
 				/* get the current glyph entry */
 				CStatus_CheckGOTO
 					(CFontFace_GetGlyphEntry
-						(face, unicode, flags, 1, &entry),
+						(face, unicode, flags, phase, 1, &entry),
 					 status,
 					 GOTO_CleanupB);
 			}
 
-			/* skip this character, as needed */
-			if(entry->mask == CGlyphEntry_NullMask)
+			/* update the previous character */
+			prev      = unicode;
+			prevPhase = phase;
+
+			/* add the glyph to the mask, as needed */
+			if(entry->mask != CGlyphEntry_NullMask)
 			{
-				prev = unicode;
-				continue;
+				/* calculate the pixel position of the glyph mask */
+				gX += (CInt32)CVector_X(entry->xbearing);
+				gY += (CInt32)CVector_Y(entry->xbearing);
+
+				/* add the glyph mask */
+				if(entry->mask == CGlyphEntry_AtlasMask)
+				{
+					_AddAtlasGlyph(entry, mask, gX, gY, min, max);
+				}
+				else
+				{
+					/* declarations */
+					CInt32 mX, mY;
+					CInt32 w, h;
+
+					/* get the glyph mask rectangle */
+					mX = gX;
+					mY = gY;
+					w  = pixman_image_get_width(entry->mask);
+					h  = pixman_image_get_height(entry->mask);
+
+					/* add the glyph mask within the bounds of the mask */
+					if(_AddBounds(mask, &mX, &mY, &w, &h, min, max))
+					{
+						pixman_composite
+							(PIXMAN_OPERATOR_ADD, entry->mask, 0, mask,
+							 (mX - gX), (mY - gY), 0, 0, mX, mY, w, h);
+					}
+				}
 			}
 
-			/* calculate the pixel position of the glyph */
-			gX = (int)(posX + CVector_X(entry->xbearing));
-			gY = (int)(posY + CVector_Y(entry->xbearing));
-
-			/* add the glyph to the mask */
-			pixman_composite
-				(PIXMAN_OPERATOR_ADD, entry->mask, clip, mask, 0, 0, 0, 0,
-				 gX, gY, 32767, 32767);
-
 			/* update the current position */
 			posX += CVector_X(entry->xadvance);
 			posY += CVector_Y(entry->xadvance);
+		}
 
-			/* update the previous character */
-			prev = unicode;
+		/* clip the drawn pixels */
+		if(CPoint_X(*min) < CPoint_X(*max))
+		{
+			pixman_composite
+				(PIXMAN_OPERATOR_IN, clip, 0, mask,
+				 CPoint_X(*min), CPoint_Y(*min), 0, 0,
+				 CPoint_X(*min), CPoint_Y(*min),
+				 (CPoint_X(*max) - CPoint_X(*min)),
+				 (CPoint_Y(*max) - CPoint_Y(*min)));
 		}
 
 	GOTO_CleanupB:
@@ -36,6 +36,9 @@ CUInt32 CFontFace_UnavailableObject = 0;
 /* marker object for null masks */
 CUInt32 CGlyphEntry_NullMaskObject = 0;
 
+/* marker object for masks held in the glyph atlas */
+CUInt32 CGlyphEntry_AtlasMaskObject = 0;
+
 /* freetype identity matrix */
 static const FT_Matrix CFreeTypeMatrix_Identity =
 {
@@ -189,16 +192,18 @@ CGlyphShape_Reference(CGlyphShape *_this)
 /*\
 |*| Initialize a glyph entry search key.
 |*|
-|*|   _this - this glyph key
-|*|   shape - shape of the glyph
-|*|   index - index of the glyph
-|*|   flags - glyph flags
+|*|      _this - this glyph key
+|*|      shape - shape of the glyph
+|*|      index - index of the glyph
+|*|      flags - glyph flags
+|*|   subpixel - horizontal subpixel phase of the glyph
 \*/
 static void
 CGlyphKey_Initialize(CGlyphKey   *_this,
                      CGlyphShape *shape,
                      CGlyphIndex  index,
-                     CGlyphFlag   flags)
+                     CGlyphFlag   flags,
+                     CUInt32      subpixel)
 {
 	/* assertions */
 	CASSERT((_this != 0));
@@ -206,14 +211,15 @@ CGlyphKey_Initialize(CGlyphKey   *_this,
 
 	/* initialize the members */
 	_this->shape = shape;
-	_this->index = index;
-	_this->flags = flags;
+	_this->index    = index;
+	_this->flags    = flags;
+	_this->subpixel = subpixel;
 
 	/* initialize the base */
 	{
 		/* declarations */
 		CUInt32 hash;
-		CUInt32 tmp[2];
+		CUInt32 tmp[3];
 
 		/* get the initial hash value */
 		hash = ((CHashEntry *)shape)->hash;
@@ -221,6 +227,7 @@ CGlyphKey_Initialize(CGlyphKey   *_this,
 		/* initialize the data */
 		tmp[0] = index;
 		tmp[1] = flags;
+		tmp[2] = subpixel;
 
 		/* hash the data */
 		hash = CUtils_HashBest(((CByte *)tmp), sizeof(tmp), hash);
@@ -261,7 +268,14 @@ CFontFace_MeasureGlyph(CFontFace   *_this,
 	CVector_Y(entry->metrics.advance) = 0;
 }
 
-/* Render the current glyph into the given entry. */
+/*\
+|*| Render the current glyph into the given entry.
+|*|
+|*| Gray masks are rendered straight into the glyph atlas of the face, if
+|*| they fit, so no per glyph image is needed and the memory they use is
+|*| bounded by the atlas; any other mask gets an image of its own, which
+|*| counts against the cache memory.
+\*/
 static CStatus
 CFontFace_RenderGlyph(CFontFace   *_this,
                       CGlyphEntry *entry,
@@ -290,6 +304,10 @@ CFontFace_RenderGlyph(CFontFace   *_this,
 	/* get the antialias flag */
 	antialias = ((entry->_base.flags & CGlyphFlag_AntiAlias) != 0);
 
+	/* set the transformed advance */
+	CVector_X(entry->xadvance) =  CF26Dot6_ToFloat(glyph->advance.x);
+	CVector_Y(entry->xadvance) = -CF26Dot6_ToFloat(glyph->advance.y);
+
 	/* ensure we have an outline */
 	if(glyph->format != FT_GLYPH_FORMAT_OUTLINE)
 	{
@@ -302,21 +320,28 @@ CFontFace_RenderGlyph(CFontFace   *_this,
 	/* get the outline */
 	outline = &(glyph->outline);
 
+	/* move the outline to its subpixel phase */
+	if(entry->_base.subpixel != 0)
+	{
+		FT_Outline_Translate
+			(outline,
+			 ((entry->_base.subpixel * CF26Dot6_One) / CGlyphAtlas_Subpixels),
+			 0);
+	}
+
 	/* get the control box of the outline */
 	FT_Outline_Get_CBox(outline, &cbox);
 
-	/* set the transformed metrics */
-	CVector_X(entry->xbearing) =  CF26Dot6_ToFloat(cbox.xMin);
-	CVector_Y(entry->xbearing) = -CF26Dot6_ToFloat(cbox.yMin);
-	CVector_X(entry->xadvance) =  CF26Dot6_ToFloat(glyph->advance.x);
-	CVector_Y(entry->xadvance) = -CF26Dot6_ToFloat(glyph->advance.y);
-
 	/* grid fit the control box */
 	cbox.xMin = CF26Dot6_Floor(cbox.xMin);
 	cbox.yMin = CF26Dot6_Floor(cbox.yMin);
 	cbox.xMax = CF26Dot6_Ceil(cbox.xMax);
 	cbox.yMax = CF26Dot6_Ceil(cbox.yMax);
 
+	/* set the offset of the mask from the glyph origin */
+	CVector_X(entry->xbearing) =  CF26Dot6_ToFloat(cbox.xMin);
+	CVector_Y(entry->xbearing) = -CF26Dot6_ToFloat(cbox.yMax);
+
 	/* calculate the width and height */
 	width  = (int)CF26Dot6_Trunc(cbox.xMax - cbox.xMin);
 	height = (int)CF26Dot6_Trunc(cbox.yMax - cbox.yMin);
@@ -329,6 +354,48 @@ CFontFace_RenderGlyph(CFontFace   *_this,
 		return CStatus_OK;
 	}
 
+	/* reposition the outline to the origin */
+	FT_Outline_Translate(outline, -cbox.xMin, -cbox.yMin);
+
+	/* set the bitmap width and height */
+	bitmap.width = width;
+	bitmap.rows  = height;
+
+	/* render gray glyphs into the atlas, as needed */
+	if(antialias)
+	{
+		/* allocate a slot in the atlas */
+		CStatus_Check
+			(CGlyphAtlas_Allocate
+				(&(_this->atlas), (CUInt32)width, (CUInt32)height,
+				 &(entry->slot)));
+
+		/* render into the slot, if we have one */
+		if(entry->slot.data != 0)
+		{
+			/* set up the bitmap */
+			bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+			bitmap.num_grays  = 256;
+			bitmap.pitch      = CGlyphAtlas_PageSize;
+			bitmap.buffer     = (unsigned char *)entry->slot.data;
+
+			/* rasterize the outline */
+			if((error = FT_Outline_Get_Bitmap(_this->library, outline, &bitmap)))
+			{
+				entry->slot.data = 0;
+				*memory = 0;
+				return CStatus_OutOfMemory;
+			}
+
+			/* the mask is in the atlas */
+			entry->mask = CGlyphEntry_AtlasMask;
+			*memory     = 0;
+
+			/* return successfully */
+			return CStatus_OK;
+		}
+	}
+
 	/* set up the bitmap and mask formats */
 	if(antialias)
 	{
@@ -368,10 +435,6 @@ CFontFace_RenderGlyph(CFontFace   *_this,
 	/* calculate the memory usage */
 	*memory = (bitmap.pitch * height);
 
-	/* set the bitmap width and height */
-	bitmap.width = width;
-	bitmap.rows  = height;
-
 	/* allocate the buffer */
 	if(!(bitmap.buffer = (unsigned char*)CCalloc(1, *memory)))
 	{
@@ -380,9 +443,6 @@ CFontFace_RenderGlyph(CFontFace   *_this,
 		return CStatus_OutOfMemory;
 	}
 
-	/* reposition the outline to the origin */
-	FT_Outline_Translate(outline, -cbox.xMin, -cbox.yMin);
-
 	/* rasterize the outline */
 	if((error = FT_Outline_Get_Bitmap(_this->library, outline, &bitmap)))
 	{
@@ -548,6 +608,9 @@ CFontFace_Create(CFontFace   **_this,
 	/* initialize the current glyph shape */
 	ff->current = 0;
 
+	/* initialize the glyph atlas */
+	CGlyphAtlas_Initialize(&(ff->atlas));
+
 	/* return successfully */
 	return CStatus_OK;
 
@@ -620,6 +683,9 @@ CFontFace_Destroy(CFontFace **_this)
 	/* destroy the glyph cache */
 	CGlyphCache_Destroy(&(face->cache));
 
+	/* finalize the glyph atlas */
+	CGlyphAtlas_Finalize(&(face->atlas));
+
 	/* destroy the unicode hash table */
 	CUnicodeHashTable_Destroy(&(face->unicode));
 
@@ -639,11 +705,15 @@ CFontFace_Destroy(CFontFace **_this)
 /*\
 |*| Get a glyph entry for the current shape of a font face.
 |*|
-|*|     _this - this font face (must be locked)
-|*|   unicode - unicode character
-|*|     flags - glyph measuring and rendering flags
-|*|    render - rendering flag
-|*|     entry - glyph entry (returned)
+|*|      _this - this font face (must be locked)
+|*|    unicode - unicode character
+|*|      flags - glyph measuring and rendering flags
+|*|   subpixel - horizontal subpixel phase, in CGlyphAtlas_Subpixels
+|*|     render - rendering flag
+|*|      entry - glyph entry (returned)
+|*|
+|*|  NOTE: rendering a glyph may invalidate the atlas masks of other
+|*|        glyphs, so those should be used before the next call
 |*|
 |*|  Returns status code.
 \*/
@@ -651,6 +721,7 @@ CINTERNAL CStatus
 CFontFace_GetGlyphEntry(CFontFace    *_this,
                         CChar32       unicode,
                         CGlyphFlag    flags,
+                        CUInt32       subpixel,
                         CBool         render,
                         CGlyphEntry **entry)
 {
@@ -663,7 +734,7 @@ CFontFace_GetGlyphEntry(CFontFace    *_this,
 
 	/* initialize the key */
 	CGlyphKey_Initialize
-		(&key, _this->current, index, flags);
+		(&key, _this->current, index, flags, subpixel);
 
 	/* get the entry */
 	if((*entry = CGlyphCache_GetEntry(_this->cache, &key)) != 0)
@@ -680,8 +751,17 @@ CFontFace_GetGlyphEntry(CFontFace    *_this,
 		/* get the entry */
 		e = *entry;
 
-		/* bail out now if we have what we need */
-		CStatus_Require((e->mask == CGlyphEntry_NullMask), CStatus_OK);
+		/* bail out now if the mask is rendered and still in place */
+		if(e->mask == CGlyphEntry_AtlasMask)
+		{
+			CStatus_Require
+				((!CGlyphAtlas_IsCurrent(&(_this->atlas), &(e->slot))),
+				 CStatus_OK);
+		}
+		else
+		{
+			CStatus_Require((e->mask == 0), CStatus_OK);
+		}
 
 		/* load the glyph */
 		if((error = FT_Load_Glyph(_this->face, index, _GetLoadFlags(flags))))
@@ -740,6 +820,9 @@ CFontFace_GetGlyphEntry(CFontFace    *_this,
 		/* initialize the base */
 		e->_base = key;
 
+		/* initialize the atlas slot */
+		e->slot.data = 0;
+
 		/* load the glyph */
 		if((error = FT_Load_Glyph(_this->face, index, _GetLoadFlags(flags))))
 		{
@@ -1011,7 +1094,9 @@ CGlyphEntry_Destroy(CGlyphEntry **_this)
 	entry = *_this;
 
 	/* free the mask, as needed */
-	if(entry->mask != 0 && entry->mask != CGlyphEntry_NullMask)
+	if(entry->mask != 0 &&
+	   entry->mask != CGlyphEntry_NullMask &&
+	   entry->mask != CGlyphEntry_AtlasMask)
 	{
 		CFree(pixman_image_get_data(entry->mask));
 		pixman_image_destroy(entry->mask);
@@ -0,0 +1,191 @@
+/*
+ * CGlyphAtlas.c - Glyph atlas implementation.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CGlyphAtlas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| The atlas packs glyph masks into rows, or shelves, left to right, and
+|*| the shelves into pages top to bottom. Space is never reclaimed glyph by
+|*| glyph; once every page is full, the atlas starts over at the top of the
+|*| first page and bumps its generation, which marks every slot handed out
+|*| before as stale, so the glyphs are rendered again as they're next used.
+\*/
+
+/* Initialize this glyph atlas. */
+CINTERNAL void
+CGlyphAtlas_Initialize(CGlyphAtlas *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* initialize the members */
+	CMemSet(_this, 0x00, sizeof(CGlyphAtlas));
+}
+
+/* Finalize this glyph atlas. */
+CINTERNAL void
+CGlyphAtlas_Finalize(CGlyphAtlas *_this)
+{
+	/* declarations */
+	CUInt32 i;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* free the pages */
+	for(i = 0; i < _this->pageCount; ++i)
+	{
+		CFree(_this->pages[i]);
+		_this->pages[i] = 0;
+	}
+
+	/* reset the members */
+	_this->pageCount = 0;
+}
+
+/*\
+|*| Allocate a cleared slot of the given size from this glyph atlas.
+|*|
+|*|    _this - this glyph atlas
+|*|    width - width of the glyph mask
+|*|   height - height of the glyph mask
+|*|     slot - slot of the glyph mask (returned)
+|*|
+|*|  NOTE: the slot data is null if the glyph mask won't fit on a page,
+|*|        and allocating may invalidate all the slots allocated before
+|*|
+|*|  Returns status code.
+\*/
+CINTERNAL CStatus
+CGlyphAtlas_Allocate(CGlyphAtlas *_this,
+                     CUInt32      width,
+                     CUInt32      height,
+                     CGlyphSlot  *slot)
+{
+	/* declarations */
+	CByte   *data;
+	CUInt32  row;
+
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((slot  != 0));
+	CASSERT((width != 0 && height != 0));
+
+	/* bail out now if the glyph mask can't be placed */
+	if(width > CGlyphAtlas_PageSize || height > CGlyphAtlas_PageSize)
+	{
+		slot->data = 0;
+		return CStatus_OK;
+	}
+
+	/* move to the next shelf, as needed */
+	if((_this->shelfX + width) > CGlyphAtlas_PageSize)
+	{
+		_this->shelfY      += _this->shelfHeight;
+		_this->shelfX       = 0;
+		_this->shelfHeight  = 0;
+	}
+
+	/* move to the next page, as needed */
+	if(_this->pageCount == 0 ||
+	   (_this->shelfY + height) > CGlyphAtlas_PageSize)
+	{
+		if(_this->pageCount != 0 && (_this->page + 1) < _this->pageCount)
+		{
+			/* reuse the next page */
+			++(_this->page);
+		}
+		else if(_this->pageCount < CGlyphAtlas_MaxPages)
+		{
+			/* declarations */
+			CByte *page;
+
+			/* allocate the page */
+			page =
+				(CByte *)CMalloc
+					(CGlyphAtlas_PageSize * CGlyphAtlas_PageSize);
+
+			/* ensure we have a page */
+			CStatus_Require((page != 0), CStatus_OutOfMemory);
+
+			/* add the page */
+			_this->page                    = _this->pageCount;
+			_this->pages[_this->pageCount] = page;
+			++(_this->pageCount);
+		}
+		else
+		{
+			/* start over, invalidating all existing slots */
+			_this->page = 0;
+			++(_this->generation);
+		}
+
+		/* start at the top of the page */
+		_this->shelfX      = 0;
+		_this->shelfY      = 0;
+		_this->shelfHeight = 0;
+	}
+
+	/* get the slot data */
+	data =
+		(_this->pages[_this->page] +
+		 (_this->shelfY * CGlyphAtlas_PageSize) + _this->shelfX);
+
+	/* clear the slot data */
+	for(row = 0; row < height; ++row)
+	{
+		CMemSet((data + (row * CGlyphAtlas_PageSize)), 0x00, width);
+	}
+
+	/* initialize the slot */
+	slot->data       = data;
+	slot->width      = (CUInt16)width;
+	slot->height     = (CUInt16)height;
+	slot->generation = _this->generation;
+
+	/* update the shelf */
+	_this->shelfX += width;
+	if(_this->shelfHeight < height) { _this->shelfHeight = height; }
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Determine if the given slot still holds the glyph mask it was given. */
+CINTERNAL CBool
+CGlyphAtlas_IsCurrent(CGlyphAtlas *_this,
+                      CGlyphSlot  *slot)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((slot  != 0));
+
+	/* determine and return if the slot is current */
+	return (slot->data != 0 && slot->generation == _this->generation);
+}
+
+
+#ifdef __cplusplus
+};
+#endif
@@ -20,13 +20,16 @@
 
 #include "CGraphics.h"
 #include "CBrush.h"
+#include "CDisplayList.h"
 #include "CFiller.h"
 #include "CFont.h"
 #include "CImage.h"
 #include "CMatrix.h"
 #include "CPath.h"
 #include "CPen.h"
+#include "CRasterizer.h"
 #include "CRegion.h"
+#include "CRenderQueue.h"
 #include "CStroker.h"
 #include "CSurface.h"
 #include "CTrapezoids.h"
@@ -111,6 +114,8 @@ CGraphics_Create(CGraphics **_this,
 		gc->pageScale                  = 1.0;
 		gc->interpolationMode          = CInterpolationMode_Default;
 		gc->pixelOffsetMode            = CPixelOffsetMode_Default;
+		gc->rasterizerMode             = CRasterizerMode_Default;
+		gc->renderingMode              = CRenderingMode_Immediate;
 		CPoint_X(gc->renderingOrigin)  = 0;
 		CPoint_Y(gc->renderingOrigin)  = 0;
 		gc->smoothingMode              = CSmoothingMode_Default;
@@ -140,6 +145,17 @@ CGraphics_Destroy(CGraphics **_this)
 		/* finalize, as needed */
 		if(gc->surface != 0)
 		{
+			/* render any deferred drawing, synchronously */
+			CSurface_Lock(gc->surface);
+			{
+				if(gc->surface->queue != 0)
+				{
+					CSurface_FlushRenderQueue(gc->surface);
+					CRenderQueue_InvalidateClip(gc->surface->queue, gc);
+				}
+			}
+			CSurface_Unlock(gc->surface);
+
 			/* destroy the surface */
 			CSurface_Destroy(&(gc->surface));
 
@@ -458,6 +474,20 @@ CGraphics_EnumerateMetafile(CGraphics             *_this,
 /******************************************************************************/
 #define CGraphics_CLIP
 #ifdef CGraphics_CLIP
+/* Invalidate the deferred drawing snapshots of the clipping region. */
+static void
+CGraphics_InvalidateClip(CGraphics *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* invalidate the snapshots, as needed */
+	if(_this->surface->queue != 0)
+	{
+		CRenderQueue_InvalidateClip(_this->surface->queue, _this);
+	}
+}
+
 /* Get the clipping region of this graphics context. */
 CStatus
 CGraphics_GetClip(CGraphics *_this,
@@ -671,6 +701,7 @@ CGraphics_ResetClip(CGraphics *_this)
 	CSurface_Lock(_this->surface);
 	{
 		status = CRegion_MakeInfinite(_this->clip);
+		CGraphics_InvalidateClip(_this);
 	}
 	CSurface_Unlock(_this->surface);
 
@@ -709,6 +740,7 @@ CGraphics_SetClipGraphics(CGraphics    *_this,
 				status =
 					CRegion_CombineRegion
 						(_this->clip, graphics->clip, combineMode);
+				CGraphics_InvalidateClip(_this);
 			}
 			CSurface_Unlock(_this->surface);
 		}
@@ -721,6 +753,7 @@ CGraphics_SetClipGraphics(CGraphics    *_this,
 			status =
 				CRegion_CombineRegion
 					(_this->clip, graphics->clip, combineMode);
+			CGraphics_InvalidateClip(_this);
 		}
 		CSurface_Lock(graphics->surface);
 		CSurface_Unlock(_this->surface);
@@ -749,6 +782,7 @@ CGraphics_SetClipPath(CGraphics    *_this,
 	CSurface_Lock(_this->surface);
 	{
 		status = CRegion_CombinePath(_this->clip, path, combineMode);
+		CGraphics_InvalidateClip(_this);
 	}
 	CSurface_Unlock(_this->surface);
 
@@ -775,6 +809,7 @@ CGraphics_SetClipRegion(CGraphics    *_this,
 	CSurface_Lock(_this->surface);
 	{
 		status = CRegion_CombineRegion(_this->clip, region, combineMode);
+		CGraphics_InvalidateClip(_this);
 	}
 	CSurface_Unlock(_this->surface);
 
@@ -798,6 +833,7 @@ CGraphics_SetClipRectangle(CGraphics    *_this,
 	CSurface_Lock(_this->surface);
 	{
 		status = CRegion_CombineRectangle(_this->clip, rect, combineMode);
+		CGraphics_InvalidateClip(_this);
 	}
 	CSurface_Unlock(_this->surface);
 
@@ -821,6 +857,7 @@ CGraphics_TranslateClip(CGraphics *_this,
 	CSurface_Lock(_this->surface);
 	{
 		status = CRegion_Translate(_this->clip, dx, dy);
+		CGraphics_InvalidateClip(_this);
 	}
 	CSurface_Unlock(_this->surface);
 
@@ -1304,6 +1341,102 @@ CGraphics_SetPixelOffsetMode(CGraphics        *_this,
 	return CStatus_OK;
 }
 
+/* Get the rasterizer mode of this graphics context. */
+CStatus
+CGraphics_GetRasterizerMode(CGraphics       *_this,
+                            CRasterizerMode *rasterizerMode)
+{
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a rasterizer mode pointer */
+	CStatus_Require((rasterizerMode != 0), CStatus_ArgumentNull);
+
+	/* get the rasterizer mode, synchronously */
+	CSurface_Lock(_this->surface);
+	{
+		*rasterizerMode = _this->rasterizerMode;
+	}
+	CSurface_Unlock(_this->surface);
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Set the rasterizer mode of this graphics context. */
+CStatus
+CGraphics_SetRasterizerMode(CGraphics       *_this,
+                            CRasterizerMode  rasterizerMode)
+{
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* set the rasterizer mode, synchronously */
+	CSurface_Lock(_this->surface);
+	{
+		_this->rasterizerMode = rasterizerMode;
+	}
+	CSurface_Unlock(_this->surface);
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Get the rendering mode of this graphics context. */
+CStatus
+CGraphics_GetRenderingMode(CGraphics      *_this,
+                           CRenderingMode *renderingMode)
+{
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a rendering mode pointer */
+	CStatus_Require((renderingMode != 0), CStatus_ArgumentNull);
+
+	/* get the rendering mode, synchronously */
+	CSurface_Lock(_this->surface);
+	{
+		*renderingMode = _this->renderingMode;
+	}
+	CSurface_Unlock(_this->surface);
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Set the rendering mode of this graphics context. */
+CStatus
+CGraphics_SetRenderingMode(CGraphics      *_this,
+                           CRenderingMode  renderingMode)
+{
+	/* declarations */
+	CStatus status;
+
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* set the rendering mode, synchronously */
+	CSurface_Lock(_this->surface);
+	{
+		/* render any deferred drawing when going back to immediate mode */
+		if(renderingMode == CRenderingMode_Immediate)
+		{
+			status = CSurface_FlushRenderQueue(_this->surface);
+		}
+		else
+		{
+			status = CStatus_OK;
+		}
+
+		/* set the rendering mode */
+		_this->renderingMode = renderingMode;
+	}
+	CSurface_Unlock(_this->surface);
+
+	/* return status */
+	return status;
+}
+
 /* Get the rendering origin of this graphics context. */
 CStatus
 CGraphics_GetRenderingOrigin(CGraphics *_this,
@@ -1797,10 +1930,214 @@ CGraphics_Composite(CGraphics      *_this,
 	return status;
 }
 
+/* Determine if fills should use the scanline rasterizer. */
+static CBool
+CGraphics_UseScanline(CGraphics *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* the scanline rasterizer only produces gray masks */
+	if(!CUtils_UseGray(_this->smoothingMode, _this->pixelOffsetMode))
+	{
+		return 0;
+	}
+
+	/* use the scanline rasterizer unless told otherwise */
+	return (_this->rasterizerMode != CRasterizerMode_Trapezoids);
+}
+
+/*\
+|*| Record a fill of the rasterized geometry for deferred rendering, if the
+|*| graphics context is in deferred mode and its surface allows it.
+|*|
+|*| The lines of the rasterizer are taken by the queue, unless they are to
+|*| be kept, in which case a copy is recorded. The brush is cloned so the
+|*| fill is unaffected by later changes to it, or to its cached pattern.
+\*/
+static CStatus
+CGraphics_DeferFill(CGraphics   *_this,
+                    CRasterizer *rasterizer,
+                    CBool        keep,
+                    CBrush      *brush,
+                    CBool       *deferred)
+{
+	/* declarations */
+	CRenderQueue       *queue;
+	CBrush             *clone;
+	CPattern            pattern;
+	CRasterizer         copy;
+	pixman_image_t     *clip;
+	pixman_transform_t  transform;
+	CStatus             status;
+
+	/* assertions */
+	CASSERT((_this      != 0));
+	CASSERT((rasterizer != 0));
+	CASSERT((brush      != 0));
+	CASSERT((deferred   != 0));
+
+	/* assume we can't defer the fill */
+	*deferred = 0;
+
+	/* bail out now if drawing is immediate */
+	CStatus_Require
+		((_this->renderingMode == CRenderingMode_Deferred), CStatus_OK);
+
+	/* get the render queue */
+	CStatus_Check
+		(CSurface_GetRenderQueue
+			(_this->surface, &queue));
+
+	/* bail out now if the surface can't defer drawing */
+	CStatus_Require((queue != 0), CStatus_OK);
+
+	/* make room in the queue, as needed */
+	if(CRenderQueue_IsFull(queue))
+	{
+		CStatus_Check
+			(CSurface_FlushRenderQueue
+				(_this->surface));
+	}
+
+	/* get the clipping mask */
+	CStatus_Check
+		(CRenderQueue_GetClip
+			(queue, _this, _this->clip,
+			 &CGraphicsPipeline_Device(_this->pipeline), &clip));
+
+	/* initialize the copy of the lines */
+	CRasterizer_Initialize(&copy);
+
+	/* copy the lines, as needed */
+	if(keep)
+	{
+		CStatus_Check
+			(CRasterizer_Copy
+				(&copy, rasterizer));
+		rasterizer = &copy;
+	}
+
+	/* clone the brush */
+	status = CBrush_Clone(brush, &clone);
+
+	/* get the source pattern of the clone */
+	if(status == CStatus_OK)
+	{
+		if((status = CBrush_GetPattern(clone, &pattern)) != CStatus_OK)
+		{
+			CBrush_Destroy(&clone);
+		}
+	}
+
+	/* handle failures */
+	if(status != CStatus_OK)
+	{
+		CRasterizer_Finalize(&copy);
+		return status;
+	}
+
+	/* get the transformation, as needed */
+	if(pattern.transform != 0)
+	{
+		/* declarations */
+		CAffineTransformF affine;
+
+		/* get the pattern transformation */
+		affine = *(pattern.transform);
+
+		/* apply the device transformation */
+		CAffineTransformF_Multiply
+			(&affine, &CGraphicsPipeline_DeviceInverse(_this->pipeline),
+			 CMatrixOrder_Append);
+
+		/* get the pixman transformation */
+		transform = CUtils_ToPixmanTransform(&affine);
+	}
+
+	/* record the fill, which takes the lines and the clone */
+	status =
+		CRenderQueue_AddFill
+			(queue, rasterizer, clone,
+			 ((pattern.transform != 0) ? &transform : 0),
+			 _this->interpolationMode, clip,
+			 CSurface_GetOperator(_this->compositingMode));
+
+	/* finalize the copy of the lines */
+	CRasterizer_Finalize(&copy);
+
+	/* handle recording failures */
+	CStatus_Check(status);
+
+	/* the fill has been deferred */
+	*deferred = 1;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/*\
+|*| Fill the device space geometry of the scanline rasterizer, whose lines
+|*| may be taken for deferred rendering unless they are to be kept.
+\*/
+static CStatus
+CGraphics_FillRasterizer(CGraphics   *_this,
+                         CRasterizer *rasterizer,
+                         CBool        keep,
+                         CBrush      *brush,
+                         CPattern    *pattern)
+{
+	/* declarations */
+	CUInt32         width;
+	CUInt32         height;
+	CBool           deferred;
+	pixman_image_t *clip;
+	pixman_image_t *mask;
+
+	/* assertions */
+	CASSERT((_this      != 0));
+	CASSERT((rasterizer != 0));
+	CASSERT((brush      != 0));
+	CASSERT((pattern    != 0));
+
+	/* defer the fill, if we can */
+	CStatus_Check
+		(CGraphics_DeferFill
+			(_this, rasterizer, keep, brush, &deferred));
+
+	/* bail out now if the fill has been deferred */
+	CStatus_Require((!deferred), CStatus_OK);
+
+	/* get the clipping mask */
+	CStatus_Check
+		(CGraphics_GetClipMask
+			(_this, &clip));
+
+	/* get the compositing mask */
+	CStatus_Check
+		(CGraphics_GetCompositingMask
+			(_this, &mask));
+
+	/* composite the coverage */
+	CStatus_Check
+		(CRasterizer_Composite
+			(rasterizer, clip, mask));
+
+	/* get the mask dimensions */
+	width = pixman_image_get_width(mask);
+	height = pixman_image_get_height(mask);
+
+	/* composite the image */
+	return
+		CGraphics_Composite
+			(_this, 0, 0, width, height, pattern, mask);
+}
+
 /* Fill the given path. */
 static CStatus
 CGraphics_Fill2(CGraphics *_this,
                 CPath     *path,
+                CBrush    *brush,
                 CPattern  *pattern)
 {
 	/* declarations */
@@ -1809,8 +2146,46 @@ CGraphics_Fill2(CGraphics *_this,
 	/* assertions */
 	CASSERT((_this   != 0));
 	CASSERT((path    != 0));
+	CASSERT((brush   != 0));
 	CASSERT((pattern != 0));
 
+	/*\
+	|*| TODO: special case identity transformation
+	\*/
+
+	/* transform the path */
+	CPath_TransformAffine
+		(path, &CGraphicsPipeline_Device(_this->pipeline));
+
+	/* fill with the scanline rasterizer, as needed */
+	if(CGraphics_UseScanline(_this))
+	{
+		/* declarations */
+		CRasterizer rasterizer;
+
+		/* initialize the rasterizer */
+		CRasterizer_Initialize(&rasterizer);
+
+		/* fill the path */
+		status =
+			CPath_Rasterize
+				(path, &rasterizer);
+
+		/* fill the coverage */
+		if(status == CStatus_OK)
+		{
+			status =
+				CGraphics_FillRasterizer
+					(_this, &rasterizer, 0, brush, pattern);
+		}
+
+		/* finalize the rasterizer */
+		CRasterizer_Finalize(&rasterizer);
+
+		/* return status */
+		return status;
+	}
+
 	/* fill the given path */
 	{
 		/* declarations */
@@ -1833,14 +2208,6 @@ CGraphics_Fill2(CGraphics *_this,
 		/* initialize the trapezoids */
 		CTrapezoids_Initialize(&trapezoids);
 
-		/*\
-		|*| TODO: special case identity transformation
-		\*/
-
-		/* transform the path */
-		CPath_TransformAffine
-			(path, &CGraphicsPipeline_Device(_this->pipeline));
-
 		/* fill the path */
 		status =
 			CPath_Fill
@@ -1925,7 +2292,7 @@ CGraphics_Stroke(CGraphics *_this,
 		/* fill the path */
 		CStatus_Check
 			(CGraphics_Fill2
-				(_this, _this->stroke, &pattern));
+				(_this, _this->stroke, pen->brush, &pattern));
 	}
 
 	/* return successfully */
@@ -2207,6 +2574,119 @@ CGraphics_DrawCurve(CGraphics *_this,
 	return status;
 }
 
+/*\
+|*| Draw the items of a display list.
+|*|
+|*| With the scanline rasterizer, each item reuses the geometry cached from
+|*| its last replay when the device transformation has only been translated
+|*| since; otherwise items are drawn as by CGraphics_DrawPath/FillPath.
+\*/
+CStatus
+CGraphics_DrawDisplayList(CGraphics    *_this,
+                          CDisplayList *displayList)
+{
+	/* declarations */
+	CDisplayItem *item;
+	CDisplayItem *end;
+	CStatus       status;
+
+	/* ensure we have a this pointer */
+	CStatus_Require((_this != 0), CStatus_ArgumentNull);
+
+	/* ensure we have a display list pointer */
+	CStatus_Require((displayList != 0), CStatus_ArgumentNull);
+
+	/* get the item pointers */
+	item = displayList->items;
+	end  = (item + displayList->count);
+
+	/* draw the items synchronously */
+	CSurface_Lock(_this->surface);
+	for(status = CStatus_OK; status == CStatus_OK && item != end; ++item)
+	{
+		/* declarations */
+		CBrush   *brush;
+		CPattern  pattern;
+
+		/* get the brush */
+		if(item->type == CDisplayItemType_Stroke)
+		{
+			brush = item->pen->brush;
+		}
+		else
+		{
+			brush = item->brush;
+		}
+
+		/* get the source pattern */
+		if((status = CBrush_GetPattern(brush, &pattern)) != CStatus_OK)
+		{
+			break;
+		}
+
+		/* draw the item */
+		if(CGraphics_UseScanline(_this))
+		{
+			/* declarations */
+			CRasterizer *rasterizer;
+
+			/* get the device space geometry */
+			status =
+				CDisplayItem_GetGeometry
+					(item, &CGraphicsPipeline_Device(_this->pipeline),
+					 _this->path, &rasterizer);
+
+			/* fill the geometry, keeping it for the next replay */
+			if(status == CStatus_OK)
+			{
+				status =
+					CGraphics_FillRasterizer
+						(_this, rasterizer, 1, brush, &pattern);
+			}
+		}
+		else
+		{
+			/* reset the path */
+			status = CPath_Reset(_this->path);
+
+			/* add the item's path to the path */
+			if(status == CStatus_OK)
+			{
+				status =
+					CPath_AddPath
+						(_this->path, item->path, 0);
+			}
+
+			/* set the fill mode, as needed */
+			if(status == CStatus_OK && item->type == CDisplayItemType_Fill)
+			{
+				status =
+					CPath_SetFillMode
+						(_this->path, CFillMode_Alternate);
+			}
+
+			/* stroke or fill the path */
+			if(status == CStatus_OK)
+			{
+				if(item->type == CDisplayItemType_Stroke)
+				{
+					status = CGraphics_Stroke(_this, item->pen);
+				}
+				else
+				{
+					status =
+						CGraphics_Fill2
+							(_this, _this->path, brush, &pattern);
+				}
+			}
+		}
+	}
+	CSurface_Unlock(_this->surface);
+
+	/* return status */
+	return status;
+}
+
 /* Draw an ellipse. */
 CStatus
 CGraphics_DrawEllipse(CGraphics   *_this,
@@ -2676,7 +3156,7 @@ CGraphics_Fill(CGraphics *_this,
 		/* fill the path */
 		CStatus_Check
 			(CGraphics_Fill2
-				(_this, _this->path, &pattern));
+				(_this, _this->path, brush, &pattern));
 	}
 
 	/* return successfully */
@@ -3403,8 +3883,8 @@ CGraphics_DrawStringSimple(CGraphics     *_this,
 		/* declarations */
 		pixman_image_t *clip;
 		pixman_image_t *mask;
-		CUInt32         width;
-		CUInt32         height;
+		CPointI         min;
+		CPointI         max;
 
 		/* get the clipping mask */
 		CStatus_CheckGOTO
@@ -3425,22 +3905,20 @@ CGraphics_DrawStringSimple(CGraphics     *_this,
 				 CRectangle_X(layoutRect),
 				 CRectangle_Y(layoutRect),
 				 &CGraphicsPipeline_Device(_this->pipeline),
-				 _this->textRenderingHint, clip, mask),
+				 _this->textRenderingHint, clip, mask, &min, &max),
 			 status,
 			 GOTO_Cleanup);
 
-		/* get the layout bounds */
-		width  = (CUInt32)CRectangle_X(layoutRect);
-		height = (CUInt32)CRectangle_X(layoutRect);
-
-		/* ensure that the bounds are non-zero */
-		if(width  == 0) { width  = 32767; }
-		if(height == 0) { height = 32767; }
-
-		/* composite the string */
-		status =
-			CGraphics_Composite
-				(_this, 0, 0, width, height, &pattern, mask);
+		/* composite the drawn pixels of the string, as needed */
+		if(CPoint_X(min) < CPoint_X(max) && CPoint_Y(min) < CPoint_Y(max))
+		{
+			status =
+				CGraphics_Composite
+					(_this, CPoint_X(min), CPoint_Y(min),
+					 (CUInt32)(CPoint_X(max) - CPoint_X(min)),
+					 (CUInt32)(CPoint_Y(max) - CPoint_Y(min)),
+					 &pattern, mask);
+		}
 	}
 GOTO_Cleanup:
 	CSurface_Unlock(_this->surface);
@@ -22,6 +22,7 @@
 #include "CFiller.h"
 #include "CFlattener.h"
 #include "CMatrix.h"
+#include "CRasterizer.h"
 #include "CStroker.h"
 #include "CTrapezoids.h"
 
@@ -1420,6 +1421,30 @@ CPath_Fill(CPath       *_this,
 	return CStatus_OK;
 }
 
+/* Fill this path to the scanline rasterizer. */
+CINTERNAL CStatus
+CPath_Rasterize(CPath       *_this,
+                CRasterizer *rasterizer)
+{
+	/* declarations */
+	CFillMode fillMode;
+
+	/* assertions */
+	CASSERT((_this      != 0));
+	CASSERT((rasterizer != 0));
+
+	/* get the fill mode */
+	fillMode = (_this->winding ? CFillMode_Winding : CFillMode_Alternate);
+
+	/* fill the path */
+	CStatus_Check
+		(CRasterizer_Fill
+			(rasterizer, _this->points, _this->types, _this->count, fillMode));
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
 
 #ifdef __cplusplus
 };
@@ -0,0 +1,1040 @@
+/*
+ * CRasterizer.c - Scanline rasterizer implementation.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CRasterizer.h"
+#include "CFiller.h"
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| The rasterizer works on a grid with 8 bits of subpixel precision. Each
+|*| line deposits, into the cells of the scanline it crosses, the signed area
+|*| it covers to the right of itself; a running sum along the scanline then
+|*| yields the coverage of each pixel. Only the cells actually touched on a
+|*| scanline are visited, and lines are bucketed by their starting scanline
+|*| so no sorting is required.
+|*|
+|*| Area is accumulated in units of 1/(256 * 512) of a pixel, so a pixel
+|*| which is fully covered accumulates CRasterizer_FullCoverage.
+\*/
+#define CRasterizer_Shift            8
+#define CRasterizer_One              (1 << CRasterizer_Shift)
+#define CRasterizer_FullCoverage     (1 << ((2 * CRasterizer_Shift) + 1))
+#define CRasterizer_ToSubpixel(f)    ((CInt32)(((f) + 128) >> 8))
+#define CRasterizer_Row(y)           ((y) >> CRasterizer_Shift)
+
+/* Initialize this rasterizer. */
+CINTERNAL void
+CRasterizer_Initialize(CRasterizer *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* initialize the rasterizer */
+	_this->count    = 0;
+	_this->capacity = 0;
+	_this->lines    = 0;
+	_this->fillMode = CFillMode_Alternate;
+}
+
+/* Finalize this rasterizer. */
+CINTERNAL void
+CRasterizer_Finalize(CRasterizer *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* finalize the rasterizer */
+	{
+		/* get the line list */
+		CRasterLine *lines = _this->lines;
+
+		/* finalize, as needed */
+		if(lines)
+		{
+			/* reset the members */
+			_this->count    = 0;
+			_this->capacity = 0;
+			_this->lines    = 0;
+
+			/* free the line list */
+			CFree(lines);
+		}
+	}
+}
+
+/* Reset this rasterizer. */
+CINTERNAL void
+CRasterizer_Reset(CRasterizer *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* reset the rasterizer */
+	_this->count = 0;
+}
+
+/* Add the edges of the given polygon. */
+CINTERNAL CStatus
+CRasterizer_AddPolygon(CRasterizer *_this,
+                       CPolygonX   *polygon)
+{
+	/* declarations */
+	CEdgeX      *edge;
+	CEdgeX      *end;
+	CRasterLine *line;
+	CUInt32      edgeCount;
+
+	/* assertions */
+	CASSERT((_this   != 0));
+	CASSERT((polygon != 0));
+
+	/* get the edge count */
+	edgeCount = CPolygon_EdgeCount(*polygon);
+
+	/* bail out now if there's nothing to do */
+	CStatus_Require((edgeCount != 0), CStatus_OK);
+
+	/* ensure the capacity of the line list */
+	if((_this->count + edgeCount) > _this->capacity)
+	{
+		/* declarations */
+		CRasterLine *tmp;
+		CUInt32      newSize;
+		CUInt32      newCapacity;
+
+		/* get the capacity */
+		const CUInt32 capacity = _this->capacity;
+
+		/* calculate the new capacity */
+		newCapacity = ((_this->count + edgeCount + 31) & ~31);
+
+		/* use the doubled capacity, if it is larger */
+		if(newCapacity < (capacity << 1))
+		{
+			newCapacity = (capacity << 1);
+		}
+
+		/* calculate the new lines size */
+		newSize = (newCapacity * sizeof(CRasterLine));
+
+		/* create the new line list */
+		if(!(tmp = (CRasterLine *)CRealloc(_this->lines, newSize)))
+		{
+			return CStatus_OutOfMemory;
+		}
+
+		/* update the capacity */
+		_this->capacity = newCapacity;
+
+		/* set the line list */
+		_this->lines = tmp;
+	}
+
+	/* get the edge pointer */
+	edge = CPolygon_Edges(*polygon);
+
+	/* get the end of input pointer */
+	end = (edge + edgeCount);
+
+	/* get the line pointer */
+	line = (_this->lines + _this->count);
+
+	/* convert the edges to subpixel lines */
+	for(; edge != end; ++edge)
+	{
+		/* get the subpixel y positions */
+		const CInt32 y1 = CRasterizer_ToSubpixel(CEdge_Y1(*edge));
+		const CInt32 y2 = CRasterizer_ToSubpixel(CEdge_Y2(*edge));
+
+		/* skip lines which cover no area */
+		if(y1 == y2) { continue; }
+
+		/* set the line */
+		line->x1        = CRasterizer_ToSubpixel(CEdge_X1(*edge));
+		line->y1        = y1;
+		line->x2        = CRasterizer_ToSubpixel(CEdge_X2(*edge));
+		line->y2        = y2;
+		line->slope     = ((((CInt64)(line->x2 - line->x1)) << 16) / (y2 - y1));
+		line->direction = (CEdge_Clockwise(*edge) ? 1 : -1);
+
+		/* move to the next line */
+		++line;
+	}
+
+	/* update the line count */
+	_this->count = (line - _this->lines);
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Fill the given path to this rasterizer. */
+CINTERNAL CStatus
+CRasterizer_Fill(CRasterizer *_this,
+                 CPointF     *points,
+                 CByte       *types,
+                 CUInt32      count,
+                 CFillMode    fillMode)
+{
+	/* declarations */
+	CStatus status;
+	CFiller filler;
+
+	/* bail out now if there's nothing to do */
+	CStatus_Require((count != 0), CStatus_OK);
+
+	/* assertions */
+	CASSERT((_this  != 0));
+	CASSERT((points != 0));
+	CASSERT((types  != 0));
+
+	/* initialize the filler */
+	CFiller_Initialize(&filler);
+
+	/* fill to the rasterizer */
+	status =
+		CFiller_ToRasterizer
+			(&filler, _this, points, types, count, fillMode);
+
+	/* finalize the filler */
+	CFiller_Finalize(&filler);
+
+	/* return status */
+	return status;
+}
+
+/* Deposit the area of a line segment lying within a single scanline. */
+static void
+CRasterizer_AddCells(CInt32  *cells,
+                     CInt32   xa,
+                     CInt32   xb,
+                     CInt32   dy,
+                     CInt32  *lo,
+                     CInt32  *hi)
+{
+	/* declarations */
+	CInt32 first;
+	CInt32 last;
+
+	/* order the end points from left to right */
+	if(xa > xb)
+	{
+		const CInt32 tmp = xa;
+		xa = xb;
+		xb = tmp;
+	}
+
+	/* get the first and last columns touched by the segment */
+	first = (xa >> CRasterizer_Shift);
+	last  = ((xa == xb) ? first : ((xb - 1) >> CRasterizer_Shift));
+
+	/* handle the single column case */
+	if(first == last)
+	{
+		/* get the subpixel positions within the column */
+		const CInt32 fa = (xa - (first << CRasterizer_Shift));
+		const CInt32 fb = (xb - (first << CRasterizer_Shift));
+
+		/* deposit the area */
+		cells[first]     += (dy * ((2 * CRasterizer_One) - fa - fb));
+		cells[first + 1] += (dy * (fa + fb));
+	}
+	else
+	{
+		/* declarations */
+		CInt32 column;
+		CInt32 x;
+		CInt32 used;
+
+		/* get the horizontal extent of the segment */
+		const CInt64 dx = (xb - xa);
+
+		/* split the segment at each column boundary */
+		for(column = first, x = xa, used = 0; column <= last; ++column)
+		{
+			/* declarations */
+			CInt32 next;
+			CInt32 total;
+			CInt32 part;
+			CInt32 fa;
+			CInt32 fb;
+
+			/* get the end of this piece */
+			if(column == last)
+			{
+				next  = xb;
+				total = dy;
+			}
+			else
+			{
+				next  = ((column + 1) << CRasterizer_Shift);
+				total = (CInt32)((((CInt64)dy) * (next - xa)) / dx);
+			}
+
+			/* get the vertical extent of this piece */
+			part = (total - used);
+			used = total;
+
+			/* get the subpixel positions within the column */
+			fa = (x    - (column << CRasterizer_Shift));
+			fb = (next - (column << CRasterizer_Shift));
+
+			/* deposit the area */
+			cells[column]     += (part * ((2 * CRasterizer_One) - fa - fb));
+			cells[column + 1] += (part * (fa + fb));
+
+			/* move to the next piece */
+			x = next;
+		}
+	}
+
+	/* update the touched range */
+	if(first    < *lo) { *lo = first; }
+	if(last + 1 > *hi) { *hi = (last + 1); }
+}
+
+/* Deposit the part of a line lying within the given scanline. */
+static void
+CRasterizer_AddLine(const CRasterLine *line,
+                    CInt32            *cells,
+                    CInt32             top,
+                    CInt32             limit,
+                    CInt32            *lo,
+                    CInt32            *hi)
+{
+	/* declarations */
+	CInt32 ya;
+	CInt32 yb;
+	CInt32 xa;
+	CInt32 xb;
+
+	/* clip the line to the scanline */
+	ya = ((line->y1 > top) ? line->y1 : top);
+	yb = (top + CRasterizer_One);
+	if(line->y2 < yb) { yb = line->y2; }
+
+	/* calculate the x positions, using the exact end points if possible */
+	if(ya == line->y1)
+	{
+		xa = line->x1;
+	}
+	else
+	{
+		xa = (line->x1 + (CInt32)(((CInt64)(ya - line->y1) * line->slope) >> 16));
+	}
+	if(yb == line->y2)
+	{
+		xb = line->x2;
+	}
+	else
+	{
+		xb = (line->x1 + (CInt32)(((CInt64)(yb - line->y1) * line->slope) >> 16));
+	}
+
+	/* clamp the x positions to the mask (keeps the winding intact) */
+	CCLAMP(xa, 0, limit);
+	CCLAMP(xb, 0, limit);
+
+	/* deposit the area */
+	CRasterizer_AddCells
+		(cells, xa, xb, ((yb - ya) * line->direction), lo, hi);
+}
+
+/* Convert accumulated cells to alpha values (clears the cells). */
+static void
+CRasterizer_Coverage(CInt32    *cells,
+                     CByte     *alpha,
+                     CUInt32    count,
+                     CFillMode  fillMode)
+{
+	/* declarations */
+	CInt32 acc;
+
+	/* get the even-odd flag */
+	const CBool alternate = (fillMode == CFillMode_Alternate);
+
+	/* start with no accumulated coverage */
+	acc = 0;
+
+#if defined(__SSE2__)
+	/* convert blocks of eight cells */
+	if(count >= 8)
+	{
+		/* declarations */
+		__m128i carry;
+
+		/* get the constants */
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i full = _mm_set1_epi32(CRasterizer_FullCoverage);
+		const __m128i wrap = _mm_set1_epi32((2 * CRasterizer_FullCoverage) - 1);
+
+		/* start with no carried coverage */
+		carry = zero;
+
+		/* convert the blocks */
+		do
+		{
+			/* declarations */
+			__m128i v[2];
+			int     i;
+
+			/* calculate the running sums */
+			for(i = 0; i < 2; ++i)
+			{
+				/* declarations */
+				__m128i a;
+				__m128i s;
+
+				/* load and clear the cells */
+				a = _mm_loadu_si128((const __m128i *)(cells + (i * 4)));
+				_mm_storeu_si128((__m128i *)(cells + (i * 4)), zero);
+
+				/* calculate the prefix sum of the block */
+				a = _mm_add_epi32(a, _mm_slli_si128(a, 4));
+				a = _mm_add_epi32(a, _mm_slli_si128(a, 8));
+				a = _mm_add_epi32(a, carry);
+
+				/* carry the last sum into the next block */
+				carry = _mm_shuffle_epi32(a, 0xFF);
+
+				/* get the absolute coverage */
+				s = _mm_srai_epi32(a, 31);
+				a = _mm_sub_epi32(_mm_xor_si128(a, s), s);
+
+				/* apply the fill rule */
+				if(alternate)
+				{
+					/* fold the coverage into [0, full] */
+					a = _mm_and_si128(a, wrap);
+					a = _mm_sub_epi32(a, full);
+					s = _mm_srai_epi32(a, 31);
+					a = _mm_sub_epi32(_mm_xor_si128(a, s), s);
+					a = _mm_sub_epi32(full, a);
+				}
+				else
+				{
+					/* saturate the coverage at full */
+					s = _mm_cmpgt_epi32(a, full);
+					a = _mm_or_si128
+						(_mm_andnot_si128(s, a), _mm_and_si128(s, full));
+				}
+
+				/* scale the coverage to [0, 255] */
+				v[i] =
+					_mm_srli_epi32
+						(_mm_sub_epi32(a, _mm_srli_epi32(a, 8)), 9);
+			}
+
+			/* pack and store the alpha values */
+			v[0] = _mm_packs_epi32(v[0], v[1]);
+			v[0] = _mm_packus_epi16(v[0], v[0]);
+			_mm_storel_epi64((__m128i *)alpha, v[0]);
+
+			/* move to the next block */
+			cells += 8;
+			alpha += 8;
+			count -= 8;
+		}
+		while(count >= 8);
+
+		/* get the carried coverage */
+		acc = _mm_cvtsi128_si32(carry);
+	}
+#endif
+
+	/* convert the remaining cells */
+	while(count != 0)
+	{
+		/* declarations */
+		CInt32 a;
+
+		/* accumulate and clear the cell */
+		acc += *cells;
+		*cells = 0;
+
+		/* get the absolute coverage */
+		a = ((acc < 0) ? -acc : acc);
+
+		/* apply the fill rule */
+		if(alternate)
+		{
+			a &= ((2 * CRasterizer_FullCoverage) - 1);
+			if(a > CRasterizer_FullCoverage)
+			{
+				a = ((2 * CRasterizer_FullCoverage) - a);
+			}
+		}
+		else if(a > CRasterizer_FullCoverage)
+		{
+			a = CRasterizer_FullCoverage;
+		}
+
+		/* scale the coverage to [0, 255] */
+		*alpha = (CByte)((a - (a >> 8)) >> 9);
+
+		/* move to the next cell */
+		++cells;
+		++alpha;
+		--count;
+	}
+}
+
+/* Add the alpha values of a span to the mask. */
+static void
+CRasterizer_AddSpan(CByte       *mask,
+                    const CByte *alpha,
+                    CUInt32      count)
+{
+#if defined(__SSE2__)
+	/* add blocks of sixteen pixels, with saturation */
+	while(count >= 16)
+	{
+		/* declarations */
+		__m128i m;
+
+		/* add the alpha values to the mask */
+		m = _mm_loadu_si128((const __m128i *)mask);
+		m = _mm_adds_epu8(m, _mm_loadu_si128((const __m128i *)alpha));
+		_mm_storeu_si128((__m128i *)mask, m);
+
+		/* move to the next block */
+		mask  += 16;
+		alpha += 16;
+		count -= 16;
+	}
+#endif
+
+	/* add the remaining pixels, with saturation */
+	while(count != 0)
+	{
+		/* add to the mask */
+		const CUInt32 v = (*mask + *alpha);
+		*mask = (CByte)((v > 255) ? 255 : v);
+
+		/* move to the next pixel */
+		++mask;
+		++alpha;
+		--count;
+	}
+}
+
+/* Add the clipped alpha values of a span to the mask. */
+static void
+CRasterizer_CompositeSpan(CByte       *mask,
+                          const CByte *clip,
+                          const CByte *alpha,
+                          CUInt32      count)
+{
+#if defined(__SSE2__)
+	/* composite blocks of sixteen pixels */
+	if(count >= 16)
+	{
+		/* get the constants */
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i half = _mm_set1_epi16(128);
+
+		/* composite the blocks */
+		do
+		{
+			/* declarations */
+			__m128i c;
+			__m128i a;
+			__m128i m;
+			__m128i l;
+			__m128i h;
+
+			/* load the pixels */
+			c = _mm_loadu_si128((const __m128i *)clip);
+			a = _mm_loadu_si128((const __m128i *)alpha);
+			m = _mm_loadu_si128((const __m128i *)mask);
+
+			/* multiply the clip by the alpha (low half) */
+			l = _mm_mullo_epi16
+				(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(a, zero));
+			l = _mm_add_epi16(l, half);
+			l = _mm_srli_epi16(_mm_add_epi16(l, _mm_srli_epi16(l, 8)), 8);
+
+			/* multiply the clip by the alpha (high half) */
+			h = _mm_mullo_epi16
+				(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(a, zero));
+			h = _mm_add_epi16(h, half);
+			h = _mm_srli_epi16(_mm_add_epi16(h, _mm_srli_epi16(h, 8)), 8);
+
+			/* add to the mask, with saturation */
+			m = _mm_adds_epu8(m, _mm_packus_epi16(l, h));
+			_mm_storeu_si128((__m128i *)mask, m);
+
+			/* move to the next block */
+			mask  += 16;
+			clip  += 16;
+			alpha += 16;
+			count -= 16;
+		}
+		while(count >= 16);
+	}
+#endif
+
+	/* composite the remaining pixels */
+	while(count != 0)
+	{
+		/* multiply the clip by the alpha */
+		CUInt32 v = ((*clip * *alpha) + 128);
+		v = ((v + (v >> 8)) >> 8);
+
+		/* add to the mask, with saturation */
+		v += *mask;
+		*mask = (CByte)((v > 255) ? 255 : v);
+
+		/* move to the next pixel */
+		++mask;
+		++clip;
+		++alpha;
+		--count;
+	}
+}
+
+/* Determine if the given line lies within the given scanlines. */
+#define CRasterizer_IsVisible(line, top, bottom) \
+	((line)->y2 > ((top)    << CRasterizer_Shift) && \
+	 (line)->y1 < ((bottom) << CRasterizer_Shift))
+
+/* Get the first visible scanline of the given line. */
+#define CRasterizer_FirstRow(line, top) \
+	(((line)->y1 > ((top) << CRasterizer_Shift)) ? \
+	 CRasterizer_Row((line)->y1) : (top))
+
+/* Copy the lines of another rasterizer into this rasterizer. */
+CINTERNAL CStatus
+CRasterizer_Copy(CRasterizer *_this,
+                 CRasterizer *other)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((other != 0));
+
+	/* ensure the capacity of the line list */
+	if(other->count > _this->capacity)
+	{
+		/* declarations */
+		CRasterLine *tmp;
+
+		/* allocate the new line list */
+		if(!(tmp = (CRasterLine *)CMalloc(other->count * sizeof(CRasterLine))))
+		{
+			return CStatus_OutOfMemory;
+		}
+
+		/* free the old line list, as needed */
+		if(_this->lines != 0) { CFree(_this->lines); }
+
+		/* set the line list */
+		_this->lines    = tmp;
+		_this->capacity = other->count;
+	}
+
+	/* copy the lines */
+	if(other->count != 0)
+	{
+		CMemCopy
+			(_this->lines, other->lines, (other->count * sizeof(CRasterLine)));
+	}
+
+	/* copy the remaining members */
+	_this->count    = other->count;
+	_this->fillMode = other->fillMode;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Translate the lines of this rasterizer by the given subpixel amounts. */
+CINTERNAL void
+CRasterizer_Translate(CRasterizer *_this,
+                      CInt32       dx,
+                      CInt32       dy)
+{
+	/* declarations */
+	CRasterLine *line;
+	CRasterLine *end;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* get the line pointers */
+	line = _this->lines;
+	end  = (line + _this->count);
+
+	/* translate the lines, whose slopes are unaffected */
+	for(; line != end; ++line)
+	{
+		line->x1 += dx;
+		line->y1 += dy;
+		line->x2 += dx;
+		line->y2 += dy;
+	}
+}
+
+/* Get the range of scanlines touched by this rasterizer. */
+CINTERNAL void
+CRasterizer_GetRows(CRasterizer *_this,
+                    CInt32      *top,
+                    CInt32      *bottom)
+{
+	/* declarations */
+	CRasterLine *line;
+	CRasterLine *end;
+	CInt32       y1;
+	CInt32       y2;
+
+	/* assertions */
+	CASSERT((_this  != 0));
+	CASSERT((top    != 0));
+	CASSERT((bottom != 0));
+
+	/* get the line pointers */
+	line = _this->lines;
+	end  = (line + _this->count);
+
+	/* start with an empty range */
+	y1 = 0x7FFFFFFF;
+	y2 = 0;
+
+	/* find the extent of the lines */
+	for(; line != end; ++line)
+	{
+		if(line->y1 < y1) { y1 = line->y1; }
+		if(line->y2 > y2) { y2 = line->y2; }
+	}
+
+	/* get the scanline range */
+	if(y1 < y2)
+	{
+		*top    = CRasterizer_Row(y1);
+		*bottom = CRasterizer_Row(y2 - 1) + 1;
+	}
+	else
+	{
+		*top    = 0;
+		*bottom = 0;
+	}
+}
+
+/* Composite the coverage of this rasterizer, through the clip, to the mask. */
+CINTERNAL CStatus
+CRasterizer_Composite(CRasterizer    *_this,
+                      pixman_image_t *clip,
+                      pixman_image_t *mask)
+{
+	/* declarations */
+	CPointI min;
+	CPointI max;
+
+	/* composite all the scanlines of the mask */
+	return
+		CRasterizer_CompositeRows
+			(_this, clip, mask, 0, pixman_image_get_height(mask), &min, &max);
+}
+
+/*\
+|*| Composite the coverage within the given scanlines, through the clip (if
+|*| any), to the mask, and report the bounds of the touched pixels.
+|*|
+|*| Each scanline is rasterized independently of the others, so compositing
+|*| a range of scanlines produces exactly the same pixels as compositing the
+|*| whole mask would within that range; this is what allows the scanlines of
+|*| a mask to be rendered in separate tiles, even concurrently.
+\*/
+CINTERNAL CStatus
+CRasterizer_CompositeRows(CRasterizer    *_this,
+                          pixman_image_t *clip,
+                          pixman_image_t *mask,
+                          CInt32          top,
+                          CInt32          bottom,
+                          CPointI        *min,
+                          CPointI        *max)
+{
+	/* declarations */
+	CRasterLine *line;
+	CRasterLine *end;
+	CByte       *block;
+	CInt32      *cells;
+	CByte       *alpha;
+	CUInt32     *starts;
+	CUInt32     *order;
+	CUInt32     *active;
+	CByte       *clipData;
+	CByte       *maskData;
+	CUInt32      clipStride;
+	CUInt32      maskStride;
+	CInt32       width;
+	CInt32       height;
+	CInt32       minRow;
+	CInt32       maxRow;
+	CInt32       row;
+	CUInt32      rows;
+	CUInt32      visible;
+	CUInt32      activeCount;
+
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((mask  != 0));
+	CASSERT((min   != 0));
+	CASSERT((max   != 0));
+
+	/* get the mask information */
+	width      = (CInt32)pixman_image_get_width(mask);
+	height     = (CInt32)pixman_image_get_height(mask);
+	maskData   = (CByte *)pixman_image_get_data(mask);
+	maskStride = (CUInt32)pixman_image_get_stride(mask);
+
+	/* get the clip information, as needed */
+	if(clip != 0)
+	{
+		clipData   = (CByte *)pixman_image_get_data(clip);
+		clipStride = (CUInt32)pixman_image_get_stride(clip);
+	}
+	else
+	{
+		clipData   = 0;
+		clipStride = 0;
+	}
+
+	/* start with empty bounds */
+	CPoint_X(*min) = width;
+	CPoint_Y(*min) = height;
+	CPoint_X(*max) = 0;
+	CPoint_Y(*max) = 0;
+
+	/* clamp the scanline range to the mask */
+	if(top    < 0)      { top    = 0; }
+	if(bottom > height) { bottom = height; }
+
+	/* bail out now if there's nothing to do */
+	CStatus_Require((_this->count != 0), CStatus_OK);
+	CStatus_Require((width > 0 && top < bottom), CStatus_OK);
+
+	/* get the line pointers */
+	line = _this->lines;
+	end  = (line + _this->count);
+
+	/* find the visible scanline range */
+	minRow  = bottom;
+	maxRow  = -1;
+	visible = 0;
+	for(; line != end; ++line)
+	{
+		/* declarations */
+		CInt32 first;
+		CInt32 last;
+
+		/* skip lines outside the scanlines */
+		if(!CRasterizer_IsVisible(line, top, bottom)) { continue; }
+
+		/* get the scanline range of the line */
+		first = CRasterizer_FirstRow(line, top);
+		last  = CRasterizer_Row(line->y2 - 1);
+		if(last >= bottom) { last = (bottom - 1); }
+
+		/* update the visible range */
+		if(first < minRow) { minRow = first; }
+		if(last  > maxRow) { maxRow = last; }
+
+		/* update the visible line count */
+		++visible;
+	}
+
+	/* bail out now if nothing is visible */
+	CStatus_Require((visible != 0), CStatus_OK);
+
+	/* get the scanline count */
+	rows = (CUInt32)(maxRow - minRow + 1);
+
+	/* allocate the working storage in a single block */
+	{
+		/* calculate the block size */
+		const CUInt32 size =
+			(((width + 2) * sizeof(CInt32)) +
+			 ((rows + 1)  * sizeof(CUInt32)) +
+			 (visible     * sizeof(CUInt32) * 2) +
+			 (width + 16));
+
+		/* allocate the block */
+		if(!(block = (CByte *)CMalloc(size)))
+		{
+			return CStatus_OutOfMemory;
+		}
+
+		/* carve the block into the working arrays */
+		cells  = (CInt32  *)block;
+		starts = (CUInt32 *)(cells  + (width + 2));
+		order  = (CUInt32 *)(starts + (rows + 1));
+		active = (CUInt32 *)(order  + visible);
+		alpha  = (CByte   *)(active + visible);
+
+		/* clear the cells and scanline buckets */
+		CMemSet(cells,  0, ((width + 2) * sizeof(CInt32)));
+		CMemSet(starts, 0, ((rows + 1)  * sizeof(CUInt32)));
+	}
+
+	/* bucket the visible lines by their first scanline */
+	{
+		/* declarations */
+		CUInt32 i;
+		CUInt32 sum;
+
+		/* count the lines starting on each scanline */
+		for(line = _this->lines; line != end; ++line)
+		{
+			if(CRasterizer_IsVisible(line, top, bottom))
+			{
+				++starts[CRasterizer_FirstRow(line, top) - minRow];
+			}
+		}
+
+		/* calculate the end of each bucket */
+		for(i = 0, sum = 0; i < rows; ++i)
+		{
+			sum += starts[i];
+			starts[i] = sum;
+		}
+		starts[rows] = sum;
+
+		/* fill the buckets, leaving each start at the beginning of its bucket */
+		for(i = _this->count; i != 0; --i)
+		{
+			/* get the line */
+			line = (_this->lines + (i - 1));
+
+			/* add the line to its bucket, if visible */
+			if(CRasterizer_IsVisible(line, top, bottom))
+			{
+				order[--starts[CRasterizer_FirstRow(line, top) - minRow]] =
+					(i - 1);
+			}
+		}
+	}
+
+	/* start with no active lines */
+	activeCount = 0;
+
+	/* sweep the scanlines */
+	for(row = minRow; row <= maxRow; ++row)
+	{
+		/* declarations */
+		CUInt32 i;
+		CUInt32 keep;
+		CInt32  lo;
+		CInt32  hi;
+
+		/* get the subpixel top and bottom of the scanline */
+		const CInt32 rowTop    = (row << CRasterizer_Shift);
+		const CInt32 rowBottom = (rowTop + CRasterizer_One);
+
+		/* get the bucket of this scanline */
+		const CUInt32 first = starts[row - minRow];
+		const CUInt32 last  = starts[row - minRow + 1];
+
+		/* activate the lines starting on this scanline */
+		for(i = first; i != last; ++i)
+		{
+			active[activeCount++] = order[i];
+		}
+
+		/* start with an empty touched range */
+		lo = width + 1;
+		hi = -1;
+
+		/* deposit the active lines, dropping those which end here */
+		for(i = 0, keep = 0; i < activeCount; ++i)
+		{
+			/* get the line */
+			line = (_this->lines + active[i]);
+
+			/* deposit the line */
+			CRasterizer_AddLine
+				(line, cells, rowTop, (width << CRasterizer_Shift), &lo, &hi);
+
+			/* keep the line active, as needed */
+			if(line->y2 > rowBottom) { active[keep++] = active[i]; }
+		}
+		activeCount = keep;
+
+		/* composite the touched span, as needed */
+		if(lo <= hi)
+		{
+			/* get the end of the visible span */
+			const CInt32 stop = ((hi < width) ? (hi + 1) : width);
+
+			/* composite the visible span */
+			if(lo < stop)
+			{
+				/* convert the cells to alpha values */
+				CRasterizer_Coverage
+					(cells + lo, alpha, (stop - lo), _this->fillMode);
+
+				/* add the (clipped) alpha values to the mask */
+				if(clipData != 0)
+				{
+					CRasterizer_CompositeSpan
+						(maskData + (row * maskStride) + lo,
+						 clipData + (row * clipStride) + lo,
+						 alpha, (stop - lo));
+				}
+				else
+				{
+					CRasterizer_AddSpan
+						(maskData + (row * maskStride) + lo,
+						 alpha, (stop - lo));
+				}
+
+				/* update the bounds */
+				if(lo   < CPoint_X(*min)) { CPoint_X(*min) = lo; }
+				if(stop > CPoint_X(*max)) { CPoint_X(*max) = stop; }
+				if(row  < CPoint_Y(*min)) { CPoint_Y(*min) = row; }
+				CPoint_Y(*max) = (row + 1);
+			}
+
+			/* clear the cells beyond the visible span */
+			if(stop <= hi)
+			{
+				CMemSet
+					(cells + stop, 0, ((hi - stop + 1) * sizeof(CInt32)));
+			}
+		}
+	}
+
+	/* free the working storage */
+	CFree(block);
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,920 @@
+/*
+ * CRenderQueue.c - Deferred rendering queue implementation.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CRenderQueue.h"
+#include "CAffineTransform.h"
+#include "CBrush.h"
+#include "CRasterizer.h"
+#include "CRegion.h"
+#include "CSurface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*\
+|*| The queue records gray path fills, rather than rendering them at once,
+|*| and renders the whole batch when it is flushed. The surface is split into
+|*| horizontal bands of CRenderQueue_TileRows scanlines, and each band plays
+|*| back every recorded fill, in order, against its own rows of the shared
+|*| coverage mask and the target; since no two bands touch the same pixels,
+|*| the bands can be handed out to a pool of worker threads, with the thread
+|*| doing the flush pitching in as well.
+|*|
+|*| The rasterizer produces the same coverage for a band as it does for the
+|*| whole surface, so the result is identical to immediate rendering.
+|*|
+|*| There is one pool of workers for the whole process, started on the first
+|*| flush which can use it; a queue flushed while another queue has the pool
+|*| just renders all of its bands itself. Pixman doesn't promise that one
+|*| source image can be composited from several threads at once, so each
+|*| worker composites from its own clone of the brush of a fill.
+\*/
+#if HAVE_PTHREAD_H
+	typedef struct _tagCRenderPool CRenderPool;
+	struct _tagCRenderPool
+	{
+		pthread_mutex_t  mutex;
+		pthread_cond_t   start;
+		pthread_cond_t   done;
+		pthread_t        threads[CRenderQueue_MaxThreads];
+		CUInt32          threadCount;
+		CUInt32          busyCount;
+		CUInt32          generation;
+		CBool            started;
+		CRenderQueue    *queue;
+	};
+	static CRenderPool CRenderQueue_Pool =
+	{
+		PTHREAD_MUTEX_INITIALIZER,
+		PTHREAD_COND_INITIALIZER,
+		PTHREAD_COND_INITIALIZER
+	};
+	#define CRenderQueue_Lock()   pthread_mutex_lock(&(CRenderQueue_Pool.mutex))
+	#define CRenderQueue_Unlock() pthread_mutex_unlock(&(CRenderQueue_Pool.mutex))
+	#define CRenderQueue_LockTiles(q) \
+		do { if((q)->shared) { CRenderQueue_Lock(); } } while(0)
+	#define CRenderQueue_UnlockTiles(q) \
+		do { if((q)->shared) { CRenderQueue_Unlock(); } } while(0)
+#else
+	#define CRenderQueue_LockTiles(q)
+	#define CRenderQueue_UnlockTiles(q)
+#endif
+
+/* Get the number of processors available to render with. */
+static CUInt32
+CRenderQueue_GetProcessorCount(void)
+{
+#if HAVE_UNISTD_H && defined(_SC_NPROCESSORS_ONLN)
+	/* declarations */
+	long count;
+
+	/* get the number of online processors */
+	count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	/* return the processor count, if we have one */
+	if(count > 0)
+	{
+		return (CUInt32)count;
+	}
+#endif
+
+	/* assume a single processor */
+	return 1;
+}
+
+/* Apply the transformation and filter of the command to a pattern. */
+static void
+CRenderQueue_SetUpPattern(CRenderCommand *cmd,
+                          pixman_image_t *pattern)
+{
+	/* assertions */
+	CASSERT((cmd     != 0));
+	CASSERT((pattern != 0));
+
+	/* set the image transformation, as needed */
+	if(cmd->transformed)
+	{
+		pixman_image_set_transform(pattern, &(cmd->transform));
+	}
+
+	/* set the filter */
+	CSurface_SetFilter(pattern, cmd->interpolationMode);
+}
+
+/*\
+|*| Get the source pattern of the command for the given rendering slot.
+|*|
+|*| Slot zero is the flushing thread, which uses the recorded pattern; each
+|*| worker gets a pattern of its own, from a clone of the recorded brush,
+|*| the first time it renders the command.
+\*/
+static CStatus
+CRenderQueue_GetSource(CRenderCommand  *cmd,
+                       CUInt32          slot,
+                       pixman_image_t **source)
+{
+	/* assertions */
+	CASSERT((cmd    != 0));
+	CASSERT((source != 0));
+
+	/* handle the flushing thread */
+	if(slot == 0)
+	{
+		*source = cmd->pattern;
+		return CStatus_OK;
+	}
+
+#if HAVE_PTHREAD_H
+	/* get the index of the worker */
+	--slot;
+
+	/* create the pattern of the worker, as needed */
+	if(cmd->sources[slot] == 0)
+	{
+		/* declarations */
+		CBrush   *clone;
+		CPattern  pattern;
+		CStatus   status;
+
+		/* clone the brush and get its pattern, one worker at a time */
+		CRenderQueue_Lock();
+		{
+			status = CBrush_Clone(cmd->brush, &clone);
+			if(status == CStatus_OK)
+			{
+				if((status = CBrush_GetPattern(clone, &pattern)) != CStatus_OK)
+				{
+					CBrush_Destroy(&clone);
+				}
+			}
+		}
+		CRenderQueue_Unlock();
+
+		/* handle failures */
+		CStatus_Check(status);
+
+		/* set up the pattern like the recorded one */
+		CRenderQueue_SetUpPattern(cmd, pattern.image);
+
+		/* keep the clone until the queue is reset */
+		cmd->clones[slot]  = clone;
+		cmd->sources[slot] = pattern.image;
+	}
+
+	/* get the pattern of the worker */
+	*source = cmd->sources[slot];
+
+	/* return successfully */
+	return CStatus_OK;
+#else
+	/* there are no workers without threads */
+	return CStatus_InvalidOperation;
+#endif
+}
+
+/* Render the given band of the target from the given rendering slot. */
+static CStatus
+CRenderQueue_RenderTile(CRenderQueue *_this,
+                        CUInt32       tile,
+                        CUInt32       slot)
+{
+	/* declarations */
+	CRenderCommand *cmd;
+	CRenderCommand *end;
+	CByte          *maskData;
+	CUInt32         maskStride;
+	CInt32          top;
+	CInt32          bottom;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* get the scanline range of the band */
+	top    = (CInt32)(tile * CRenderQueue_TileRows);
+	bottom = (top + CRenderQueue_TileRows);
+	if(bottom > (CInt32)_this->height) { bottom = (CInt32)_this->height; }
+
+	/* get the mask information */
+	maskData   = (CByte *)pixman_image_get_data(_this->mask);
+	maskStride = (CUInt32)pixman_image_get_stride(_this->mask);
+
+	/* get the command pointers */
+	cmd = _this->commands;
+	end = (cmd + _this->commandCount);
+
+	/* play back the commands, in order */
+	for(; cmd != end; ++cmd)
+	{
+		/* declarations */
+		pixman_image_t *source;
+		CPointI min;
+		CPointI max;
+		CInt32  x1;
+		CInt32  y1;
+		CInt32  x2;
+		CInt32  y2;
+
+		/* skip fills which don't reach this band */
+		if(cmd->op != PIXMAN_OPERATOR_SRC &&
+		   (cmd->bottom <= top || cmd->top >= bottom))
+		{
+			continue;
+		}
+
+		/* rasterize the band of the fill to the mask */
+		CStatus_Check
+			(CRasterizer_CompositeRows
+				(&(cmd->rasterizer), cmd->clip, _this->mask, top, bottom,
+				 &min, &max));
+
+		/* get the bounds of the composite */
+		if(cmd->op == PIXMAN_OPERATOR_SRC)
+		{
+			/* copying clears the pixels outside the fill, so do the band */
+			x1 = 0;
+			y1 = top;
+			x2 = (CInt32)_this->width;
+			y2 = bottom;
+		}
+		else
+		{
+			/* skip fills which didn't touch any pixels */
+			if(CPoint_X(min) >= CPoint_X(max) || CPoint_Y(min) >= CPoint_Y(max))
+			{
+				continue;
+			}
+
+			/* composite only the touched pixels */
+			x1 = CPoint_X(min);
+			y1 = CPoint_Y(min);
+			x2 = CPoint_X(max);
+			y2 = CPoint_Y(max);
+		}
+
+		/* get the source pattern for this slot */
+		CStatus_Check
+			(CRenderQueue_GetSource
+				(cmd, slot, &source));
+
+		/* composite the pattern through the mask */
+		pixman_composite
+			(cmd->op, source, _this->mask, _this->target,
+			 x1, y1, x1, y1, (x1 + _this->x), (y1 + _this->y),
+			 (x2 - x1), (y2 - y1));
+
+		/* clear the touched pixels of the mask */
+		if(CPoint_X(min) < CPoint_X(max))
+		{
+			/* declarations */
+			CByte   *row;
+			CUInt32  count;
+			CInt32   y;
+
+			/* get the first row and the row length */
+			row   = (maskData + (CPoint_Y(min) * maskStride) + CPoint_X(min));
+			count = (CUInt32)(CPoint_X(max) - CPoint_X(min));
+
+			/* clear the rows */
+			for(y = CPoint_Y(min); y < CPoint_Y(max); ++y, row += maskStride)
+			{
+				CMemSet(row, 0x00, count);
+			}
+		}
+	}
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Render bands, from the given rendering slot, until none are left. */
+static void
+CRenderQueue_RenderTiles(CRenderQueue *_this,
+                         CUInt32       slot)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* render the bands */
+	for(;;)
+	{
+		/* declarations */
+		CStatus status;
+		CUInt32 tile;
+
+		/* claim the next band */
+		CRenderQueue_LockTiles(_this);
+		{
+			tile = _this->nextTile++;
+		}
+		CRenderQueue_UnlockTiles(_this);
+
+		/* bail out now if we're done */
+		if(tile >= _this->tileCount) { break; }
+
+		/* render the band */
+		status = CRenderQueue_RenderTile(_this, tile, slot);
+
+		/* record failures */
+		if(status != CStatus_OK)
+		{
+			CRenderQueue_LockTiles(_this);
+			{
+				_this->status = status;
+			}
+			CRenderQueue_UnlockTiles(_this);
+		}
+	}
+}
+
+#if HAVE_PTHREAD_H
+/* Render bands of the queue which has the pool as each flush is signaled. */
+static void *
+CRenderQueue_Worker(void *arg)
+{
+	/* declarations */
+	CRenderQueue *queue;
+	CUInt32       generation;
+	CUInt32       slot;
+
+	/* get the rendering slot of this worker */
+	slot = (CUInt32)(size_t)arg;
+
+	/* the pool is started before its first flush */
+	generation = 0;
+
+	/* handle flushes, synchronously, for the life of the process */
+	CRenderQueue_Lock();
+	for(;;)
+	{
+		/* wait for a flush */
+		while(CRenderQueue_Pool.generation == generation)
+		{
+			pthread_cond_wait
+				(&(CRenderQueue_Pool.start), &(CRenderQueue_Pool.mutex));
+		}
+
+		/* update the generation */
+		generation = CRenderQueue_Pool.generation;
+
+		/* get the queue being flushed */
+		queue = CRenderQueue_Pool.queue;
+
+		/* render bands, asynchronously */
+		CRenderQueue_Unlock();
+		{
+			CRenderQueue_RenderTiles(queue, slot);
+		}
+		CRenderQueue_Lock();
+
+		/* signal the flushing thread if we're the last one done */
+		if(--(CRenderQueue_Pool.busyCount) == 0)
+		{
+			pthread_cond_signal(&(CRenderQueue_Pool.done));
+		}
+	}
+
+	/* not reached */
+	return 0;
+}
+
+/* Start the worker threads of the pool, once; the pool lock must be held. */
+static void
+CRenderQueue_StartPool(void)
+{
+	/* declarations */
+	CUInt32 count;
+
+	/* bail out now if we've already tried */
+	if(CRenderQueue_Pool.started) { return; }
+
+	/* don't try again */
+	CRenderQueue_Pool.started = 1;
+
+	/* the flushing thread renders too, so one fewer worker is needed */
+	count = (CRenderQueue_GetProcessorCount() - 1);
+	if(count > CRenderQueue_MaxThreads) { count = CRenderQueue_MaxThreads; }
+
+	/* start as many workers as we can */
+	while(CRenderQueue_Pool.threadCount < count)
+	{
+		/* start a worker, in the next slot, bailing out on failure */
+		if(pthread_create
+			(&(CRenderQueue_Pool.threads[CRenderQueue_Pool.threadCount]), 0,
+			 CRenderQueue_Worker,
+			 (void *)(size_t)(CRenderQueue_Pool.threadCount + 1)) != 0)
+		{
+			break;
+		}
+
+		/* the workers live as long as the process */
+		pthread_detach(CRenderQueue_Pool.threads[CRenderQueue_Pool.threadCount]);
+
+		/* update the thread count */
+		++(CRenderQueue_Pool.threadCount);
+	}
+}
+
+/* Hand the queue to the workers, returning false if they aren't available. */
+static CBool
+CRenderQueue_ClaimPool(CRenderQueue *_this)
+{
+	/* declarations */
+	CBool claimed;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* claim the pool, if it's idle */
+	CRenderQueue_Lock();
+	{
+		/* start the workers, as needed */
+		CRenderQueue_StartPool();
+
+		/* wake the workers, if we have any and nobody else has them */
+		claimed =
+			(CRenderQueue_Pool.threadCount != 0 && CRenderQueue_Pool.queue == 0);
+		if(claimed)
+		{
+			_this->shared = 1;
+			CRenderQueue_Pool.queue     = _this;
+			CRenderQueue_Pool.busyCount = CRenderQueue_Pool.threadCount;
+			++(CRenderQueue_Pool.generation);
+			pthread_cond_broadcast(&(CRenderQueue_Pool.start));
+		}
+	}
+	CRenderQueue_Unlock();
+
+	/* return the claimed flag */
+	return claimed;
+}
+
+/* Wait for the workers to finish with the queue, then release the pool. */
+static void
+CRenderQueue_ReleasePool(CRenderQueue *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* wait for the workers, then release the pool */
+	CRenderQueue_Lock();
+	{
+		while(CRenderQueue_Pool.busyCount != 0)
+		{
+			pthread_cond_wait
+				(&(CRenderQueue_Pool.done), &(CRenderQueue_Pool.mutex));
+		}
+		CRenderQueue_Pool.queue = 0;
+		_this->shared = 0;
+	}
+	CRenderQueue_Unlock();
+}
+#endif
+
+/* Create a render queue for a target of the given bounds. */
+CINTERNAL CStatus
+CRenderQueue_Create(CRenderQueue **_this,
+                    CInt32         x,
+                    CInt32         y,
+                    CUInt32        width,
+                    CUInt32        height)
+{
+	/* declarations */
+	pixman_format_t *format;
+	CRenderQueue    *queue;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* allocate the queue */
+	if(!(queue = (CRenderQueue *)CMalloc(sizeof(CRenderQueue))))
+	{
+		return CStatus_OutOfMemory;
+	}
+
+	/* allocate the command list */
+	queue->commands =
+		(CRenderCommand *)CMalloc
+			(CRenderQueue_MaxCommands * sizeof(CRenderCommand));
+
+	/* ensure we have a command list */
+	if(queue->commands == 0)
+	{
+		CFree(queue);
+		return CStatus_OutOfMemory;
+	}
+
+	/* create the pixman format */
+	if(!(format = pixman_format_create(PIXMAN_FORMAT_NAME_A8)))
+	{
+		CFree(queue->commands);
+		CFree(queue);
+		return CStatus_OutOfMemory;
+	}
+
+	/* create the coverage mask */
+	queue->mask = pixman_image_create(format, width, height);
+
+	/* dispose of the format */
+	pixman_format_destroy(format);
+
+	/* ensure we have a coverage mask */
+	if(queue->mask == 0)
+	{
+		CFree(queue->commands);
+		CFree(queue);
+		return CStatus_OutOfMemory;
+	}
+
+	/* clear the coverage mask */
+	CMemSet
+		(pixman_image_get_data(queue->mask), 0x00,
+		 (height * pixman_image_get_stride(queue->mask)));
+
+	/* initialize the remaining members */
+	queue->x            = x;
+	queue->y            = y;
+	queue->width        = width;
+	queue->height       = height;
+	queue->target       = 0;
+	queue->commandCount = 0;
+	queue->clipCount    = 0;
+	queue->nextTile     = 0;
+	queue->status       = CStatus_OK;
+	queue->tileCount    =
+		((height + CRenderQueue_TileRows - 1) / CRenderQueue_TileRows);
+#if HAVE_PTHREAD_H
+	queue->shared       = 0;
+#endif
+
+	/* set the queue */
+	*_this = queue;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Destroy a render queue, discarding any deferred drawing. */
+CINTERNAL void
+CRenderQueue_Destroy(CRenderQueue **_this)
+{
+	/* assertions */
+	CASSERT((_this  != 0));
+	CASSERT((*_this != 0));
+
+	/* discard any deferred drawing */
+	CRenderQueue_Reset(*_this);
+
+	/* dispose of the coverage mask */
+	pixman_image_destroy((*_this)->mask);
+
+	/* free the command list */
+	CFree((*_this)->commands);
+
+	/* free the queue */
+	CFree(*_this);
+
+	/* null the this pointer */
+	*_this = 0;
+}
+
+/* Determine if any drawing has been deferred. */
+CINTERNAL CBool
+CRenderQueue_IsEmpty(CRenderQueue *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* return the empty flag */
+	return (_this->commandCount == 0);
+}
+
+/* Determine if the queue must be flushed before recording more drawing. */
+CINTERNAL CBool
+CRenderQueue_IsFull(CRenderQueue *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* return the full flag */
+	return ((_this->commandCount >= CRenderQueue_MaxCommands) ||
+	        (_this->clipCount    >= CRenderQueue_MaxClips));
+}
+
+/* Discard any deferred drawing. */
+CINTERNAL void
+CRenderQueue_Reset(CRenderQueue *_this)
+{
+	/* declarations */
+	CRenderCommand *cmd;
+	CRenderCommand *end;
+	CRenderClip    *clip;
+	CRenderClip    *last;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* get the command pointers */
+	cmd = _this->commands;
+	end = (cmd + _this->commandCount);
+
+	/* dispose of the commands */
+	for(; cmd != end; ++cmd)
+	{
+	#if HAVE_PTHREAD_H
+		/* declarations */
+		CUInt32 i;
+
+		/* dispose of the clones of the workers */
+		for(i = 0; i < CRenderQueue_MaxThreads; ++i)
+		{
+			if(cmd->clones[i] != 0) { CBrush_Destroy(&(cmd->clones[i])); }
+		}
+	#endif
+
+		CRasterizer_Finalize(&(cmd->rasterizer));
+		CBrush_Destroy(&(cmd->brush));
+	}
+
+	/* get the clip pointers */
+	clip = _this->clips;
+	last = (clip + _this->clipCount);
+
+	/* dispose of the clip masks */
+	for(; clip != last; ++clip)
+	{
+		pixman_image_destroy(clip->image);
+	}
+
+	/* reset the counts */
+	_this->commandCount = 0;
+	_this->clipCount    = 0;
+}
+
+/*\
+|*| Get the clip mask for the given region, as seen through the given
+|*| transformation, by its owner.
+|*|
+|*| The mask is a snapshot, shared by all the fills recorded with the same
+|*| clip, so later changes to the region don't affect them; the owner must
+|*| invalidate its snapshots when the region changes. An infinite region
+|*| gets a null mask, which means no clipping at all.
+\*/
+CINTERNAL CStatus
+CRenderQueue_GetClip(CRenderQueue       *_this,
+                     void               *owner,
+                     CRegion            *region,
+                     CAffineTransformF  *transform,
+                     pixman_image_t    **clip)
+{
+	/* declarations */
+	pixman_format_t *format;
+	pixman_image_t  *image;
+	CRenderClip     *curr;
+	CRenderClip     *last;
+	CStatus          status;
+
+	/* assertions */
+	CASSERT((_this     != 0));
+	CASSERT((owner     != 0));
+	CASSERT((region    != 0));
+	CASSERT((transform != 0));
+	CASSERT((clip      != 0));
+
+	/* handle the unclipped case */
+	if(CRegionNode_Type(region->head) == CRegionType_Infinite)
+	{
+		*clip = 0;
+		return CStatus_OK;
+	}
+
+	/* get the clip pointers */
+	curr = _this->clips;
+	last = (curr + _this->clipCount);
+
+	/* look for an existing snapshot */
+	for(; curr != last; ++curr)
+	{
+		if(curr->owner == owner &&
+		   CAffineTransformF_Equals(&(curr->transform), transform))
+		{
+			*clip = curr->image;
+			return CStatus_OK;
+		}
+	}
+
+	/* ensure there's room for another snapshot */
+	CStatus_Require
+		((_this->clipCount < CRenderQueue_MaxClips),
+		 CStatus_InvalidOperation);
+
+	/* create the pixman format */
+	format = pixman_format_create(PIXMAN_FORMAT_NAME_A8);
+
+	/* ensure we have a format */
+	CStatus_Require((format != 0), CStatus_OutOfMemory);
+
+	/* create the pixman image */
+	image = pixman_image_create(format, _this->width, _this->height);
+
+	/* dispose of the format */
+	pixman_format_destroy(format);
+
+	/* ensure we have an image */
+	CStatus_Require((image != 0), CStatus_OutOfMemory);
+
+	/* get the clip mask */
+	status = CRegion_GetMask(region, transform, image);
+
+	/* handle mask failures */
+	if(status != CStatus_OK)
+	{
+		pixman_image_destroy(image);
+		return status;
+	}
+
+	/* add the snapshot */
+	curr            = &(_this->clips[_this->clipCount++]);
+	curr->owner     = owner;
+	curr->transform = *transform;
+	curr->image     = image;
+
+	/* get the clip mask */
+	*clip = image;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Stop handing out the current clip snapshots of the given owner. */
+CINTERNAL void
+CRenderQueue_InvalidateClip(CRenderQueue *_this,
+                            void         *owner)
+{
+	/* declarations */
+	CRenderClip *curr;
+	CRenderClip *last;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* get the clip pointers */
+	curr = _this->clips;
+	last = (curr + _this->clipCount);
+
+	/* orphan the snapshots, which recorded fills may still be using */
+	for(; curr != last; ++curr)
+	{
+		if(curr->owner == owner) { curr->owner = 0; }
+	}
+}
+
+/*\
+|*| Record a fill of the rasterized path with the pattern of the brush, as
+|*| seen through the given pixman transformation, if any, and filtered with
+|*| the given interpolation mode, through the clip.
+|*|
+|*| The queue takes ownership of the lines of the rasterizer, which is left
+|*| empty, and of the brush; the clip must come from this queue.
+\*/
+CINTERNAL CStatus
+CRenderQueue_AddFill(CRenderQueue       *_this,
+                     CRasterizer        *rasterizer,
+                     CBrush             *brush,
+                     pixman_transform_t *transform,
+                     CInterpolationMode  interpolationMode,
+                     pixman_image_t     *clip,
+                     pixman_operator_t   op)
+{
+	/* declarations */
+	CRenderCommand *cmd;
+	CPattern        pattern;
+	CStatus         status;
+
+	/* assertions */
+	CASSERT((_this      != 0));
+	CASSERT((rasterizer != 0));
+	CASSERT((brush      != 0));
+
+	/* ensure there's room for another command */
+	if(_this->commandCount >= CRenderQueue_MaxCommands)
+	{
+		CBrush_Destroy(&brush);
+		return CStatus_InvalidOperation;
+	}
+
+	/* get the command */
+	cmd = &(_this->commands[_this->commandCount]);
+
+	/* get the scanline range of the fill */
+	CRasterizer_GetRows(rasterizer, &(cmd->top), &(cmd->bottom));
+
+	/* drop fills which can't change anything */
+	if(op != PIXMAN_OPERATOR_SRC && cmd->top >= cmd->bottom)
+	{
+		CBrush_Destroy(&brush);
+		return CStatus_OK;
+	}
+
+	/* get the pattern of the brush */
+	if((status = CBrush_GetPattern(brush, &pattern)) != CStatus_OK)
+	{
+		CBrush_Destroy(&brush);
+		return status;
+	}
+
+	/* take the lines of the rasterizer */
+	cmd->rasterizer = *rasterizer;
+	CRasterizer_Initialize(rasterizer);
+
+	/* set the remaining members */
+	cmd->brush             = brush;
+	cmd->pattern           = pattern.image;
+	cmd->clip              = clip;
+	cmd->op                = op;
+	cmd->transformed       = (transform != 0);
+	cmd->interpolationMode = interpolationMode;
+	if(transform != 0) { cmd->transform = *transform; }
+#if HAVE_PTHREAD_H
+	CMemSet(cmd->clones,  0x00, sizeof(cmd->clones));
+	CMemSet(cmd->sources, 0x00, sizeof(cmd->sources));
+#endif
+
+	/* set up the recorded pattern */
+	CRenderQueue_SetUpPattern(cmd, cmd->pattern);
+
+	/* update the command count */
+	++(_this->commandCount);
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Render the deferred drawing to the target, then discard it. */
+CINTERNAL CStatus
+CRenderQueue_Flush(CRenderQueue   *_this,
+                   pixman_image_t *target)
+{
+	/* declarations */
+	CStatus status;
+
+	/* assertions */
+	CASSERT((_this  != 0));
+	CASSERT((target != 0));
+
+	/* bail out now if there's nothing to do */
+	CStatus_Require((_this->commandCount != 0), CStatus_OK);
+
+	/* set up the flush */
+	_this->target   = target;
+	_this->nextTile = 0;
+	_this->status   = CStatus_OK;
+
+#if HAVE_PTHREAD_H
+	/* render the bands, with the workers' help where we can get it */
+	if(_this->tileCount > 1 && CRenderQueue_ClaimPool(_this))
+	{
+		/* render bands alongside the workers */
+		CRenderQueue_RenderTiles(_this, 0);
+
+		/* wait for the workers to finish */
+		CRenderQueue_ReleasePool(_this);
+	}
+	else
+#endif
+	{
+		CRenderQueue_RenderTiles(_this, 0);
+	}
+
+	/* get the status */
+	status = _this->status;
+
+	/* discard the deferred drawing */
+	_this->target = 0;
+	CRenderQueue_Reset(_this);
+
+	/* return status */
+	return status;
+}
+
+
+#ifdef __cplusplus
+};
+#endif
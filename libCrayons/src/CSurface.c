@@ -19,6 +19,7 @@
  */
 
 #include "CSurface.h"
+#include "CRenderQueue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,6 +74,13 @@ CSurface_Destroy(CSurface **_this)
 			/* set the lock ownership flag */
 			lockOwner = 1;
 
+			/* render and dispose of any deferred drawing, as needed */
+			if((*_this)->queue != 0)
+			{
+				CSurface_FlushRenderQueue(*_this);
+				CRenderQueue_Destroy(&((*_this)->queue));
+			}
+
 			/* finalize the clip mask, as needed */
 			if((*_this)->clip != 0)
 			{
@@ -175,6 +183,13 @@ CSurface_SetBounds(CSurface *_this,
 			goto GOTO_Cleanup;
 		}
 
+		/* render and dispose of any deferred drawing, as needed */
+		if(_this->queue != 0)
+		{
+			CSurface_FlushRenderQueue(_this);
+			CRenderQueue_Destroy(&(_this->queue));
+		}
+
 		/* set the width and height */
 		_this->x      = x;
 		_this->y      = y;
@@ -402,42 +417,16 @@ CSurface_Composite(CSurface           *_this,
 		height = (y2 - y1);
 	}
 
-	/* set the filter */
-	switch(interpolationMode)
-	{
-		case CInterpolationMode_Bicubic:
-		case CInterpolationMode_HighQuality:
-		case CInterpolationMode_HighQualityBilinear:
-		case CInterpolationMode_HighQualityBicubic:
-			{ pixman_image_set_filter(src, PIXMAN_FILTER_BEST); } break;
-
-		case CInterpolationMode_NearestNeighbor:
-			{ pixman_image_set_filter(src, PIXMAN_FILTER_NEAREST); } break;
-
-		case CInterpolationMode_Bilinear:
-			{ pixman_image_set_filter(src, PIXMAN_FILTER_BILINEAR); } break;
-
-		case CInterpolationMode_LowQuality:
-			{ pixman_image_set_filter(src, PIXMAN_FILTER_FAST); } break;
-
-		case CInterpolationMode_Default:
-		default:
-			{ pixman_image_set_filter(src, PIXMAN_FILTER_GOOD); } break;
-	}
-
-	/* set the operator */
-	switch(compositingMode)
-	{
-		case CCompositingMode_SourceCopy:
-			{ op = PIXMAN_OPERATOR_SRC; } break;
+	/* render any deferred drawing first */
+	CStatus_Check
+		(CSurface_FlushRenderQueue
+			(_this));
 
-		case CCompositingMode_Xor:
-			{ op = PIXMAN_OPERATOR_XOR; } break;
+	/* set the filter */
+	CSurface_SetFilter(src, interpolationMode);
 
-		case CCompositingMode_SourceOver:
-		default:
-			{ op = PIXMAN_OPERATOR_OVER; } break;
-	}
+	/* get the operator */
+	op = CSurface_GetOperator(compositingMode);
 
 	/* perform the compositing operation */
 	CStatus_Check
@@ -455,6 +444,11 @@ CSurface_Clear(CSurface *_this,
 	/* ensure we have a this pointer */
 	CStatus_Require((_this != 0), CStatus_ArgumentNull);
 
+	/* render any deferred drawing first */
+	CStatus_Check
+		(CSurface_FlushRenderQueue
+			(_this));
+
 	/* clear the surface */
 	CStatus_Check
 		(_this->_class->Clear
@@ -471,6 +465,11 @@ CSurface_Flush(CSurface        *_this,
 	/* ensure we have a this pointer */
 	CStatus_Require((_this != 0), CStatus_ArgumentNull);
 
+	/* render any deferred drawing first */
+	CStatus_Check
+		(CSurface_FlushRenderQueue
+			(_this));
+
 	/* flush the surface */
 	CStatus_Check
 		(_this->_class->Flush
@@ -518,6 +517,131 @@ CSurface_GetDpiY(CSurface *_this,
 	return CStatus_OK;
 }
 
+CINTERNAL pixman_operator_t
+CSurface_GetOperator(CCompositingMode compositingMode)
+{
+	/* get the operator */
+	switch(compositingMode)
+	{
+		case CCompositingMode_SourceCopy:
+			{ return PIXMAN_OPERATOR_SRC; }
+
+		case CCompositingMode_Xor:
+			{ return PIXMAN_OPERATOR_XOR; }
+
+		case CCompositingMode_SourceOver:
+		default:
+			{ return PIXMAN_OPERATOR_OVER; }
+	}
+}
+
+CINTERNAL void
+CSurface_SetFilter(pixman_image_t     *src,
+                   CInterpolationMode  interpolationMode)
+{
+	/* assertions */
+	CASSERT((src != 0));
+
+	/* set the filter */
+	switch(interpolationMode)
+	{
+		case CInterpolationMode_Bicubic:
+		case CInterpolationMode_HighQuality:
+		case CInterpolationMode_HighQualityBilinear:
+		case CInterpolationMode_HighQualityBicubic:
+			{ pixman_image_set_filter(src, PIXMAN_FILTER_BEST); } break;
+
+		case CInterpolationMode_NearestNeighbor:
+			{ pixman_image_set_filter(src, PIXMAN_FILTER_NEAREST); } break;
+
+		case CInterpolationMode_Bilinear:
+			{ pixman_image_set_filter(src, PIXMAN_FILTER_BILINEAR); } break;
+
+		case CInterpolationMode_LowQuality:
+			{ pixman_image_set_filter(src, PIXMAN_FILTER_FAST); } break;
+
+		case CInterpolationMode_Default:
+		default:
+			{ pixman_image_set_filter(src, PIXMAN_FILTER_GOOD); } break;
+	}
+}
+
+/* Get the deferred drawing queue, or null if direct rendering isn't possible. */
+CINTERNAL CStatus
+CSurface_GetRenderQueue(CSurface      *_this,
+                        CRenderQueue **queue)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((queue != 0));
+
+	/* create the queue, as needed */
+	if(_this->queue == 0)
+	{
+		/* declarations */
+		pixman_image_t *image;
+
+		/* bail out now if the surface can't be rendered to directly */
+		if(_this->_class->LockImage(_this, &image) != CStatus_OK)
+		{
+			*queue = 0;
+			return CStatus_OK;
+		}
+		_this->_class->UnlockImage(_this);
+
+		/* create the queue */
+		CStatus_Check
+			(CRenderQueue_Create
+				(&(_this->queue), _this->x, _this->y,
+				 _this->width, _this->height));
+	}
+
+	/* get the queue */
+	*queue = _this->queue;
+
+	/* return successfully */
+	return CStatus_OK;
+}
+
+/* Render any deferred drawing to this surface. */
+CINTERNAL CStatus
+CSurface_FlushRenderQueue(CSurface *_this)
+{
+	/* declarations */
+	pixman_image_t *image;
+	CStatus         status;
+
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* bail out now if there's nothing to do */
+	CStatus_Require((_this->queue != 0), CStatus_OK);
+
+	/* bail out now if there's nothing to render, dropping unused clips */
+	if(CRenderQueue_IsEmpty(_this->queue))
+	{
+		CRenderQueue_Reset(_this->queue);
+		return CStatus_OK;
+	}
+
+	/* lock the backing image */
+	status = _this->_class->LockImage(_this, &image);
+
+	/* render the deferred drawing, or discard it on failure */
+	if(status == CStatus_OK)
+	{
+		status = CRenderQueue_Flush(_this->queue, image);
+		_this->_class->UnlockImage(_this);
+	}
+	else
+	{
+		CRenderQueue_Reset(_this->queue);
+	}
+
+	/* return status */
+	return status;
+}
+
 CINTERNAL CStatus
 CSurface_Initialize(CSurface            *_this,
                     const CSurfaceClass *_class,
@@ -546,6 +670,9 @@ CSurface_Initialize(CSurface            *_this,
 	_this->comp      = 0;
 	_this->maskFlags = 0;
 
+	/* set the deferred drawing queue */
+	_this->queue = 0;
+
 	/* create the lock */
 	return CMutex_Create(&(_this->lock));
 }
@@ -287,6 +287,30 @@ CX11Surface_GetDpiY(CSurface *_this,
 	return CStatus_OK;
 }
 
+static CStatus
+CX11Surface_LockImage(CSurface        *_this,
+                      pixman_image_t **image)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+	CASSERT((image != 0));
+
+	/* the drawable lives on the server, so there is no image to lock */
+	*image = 0;
+
+	/* return not supported */
+	return CStatus_NotSupported;
+}
+
+static void
+CX11Surface_UnlockImage(CSurface *_this)
+{
+	/* assertions */
+	CASSERT((_this != 0));
+
+	/* nothing to do here */
+}
+
 static void
 CX11Surface_Finalize(CSurface *_this)
 {
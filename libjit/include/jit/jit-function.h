@@ -63,6 +63,10 @@ jit_function_t jit_function_from_closure
 	(jit_context_t context, void *closure) JIT_NOTHROW;
 jit_function_t jit_function_from_pc
 	(jit_context_t context, void *pc, void **handler) JIT_NOTHROW;
+unsigned int jit_function_get_bytecode_offset
+	(jit_function_t func, void *pc) JIT_NOTHROW;
+unsigned long jit_function_get_code_size(jit_function_t func) JIT_NOTHROW;
+void *jit_function_get_code_start(jit_function_t func) JIT_NOTHROW;
 void *jit_function_to_vtable_pointer(jit_function_t func) JIT_NOTHROW;
 jit_function_t jit_function_from_vtable_pointer
 	(jit_context_t context, void *vtable_pointer) JIT_NOTHROW;
@@ -78,6 +82,13 @@ void jit_function_set_optimization_level
 unsigned int jit_function_get_optimization_level
 	(jit_function_t func) JIT_NOTHROW;
 unsigned int jit_function_get_max_optimization_level(void) JIT_NOTHROW;
+void jit_function_collect_branch_counts
+	(jit_function_t func, int flag) JIT_NOTHROW;
+unsigned int jit_function_get_num_branch_counts
+	(jit_function_t func) JIT_NOTHROW;
+int jit_function_get_branch_counts
+	(jit_function_t func, unsigned int branch,
+	 jit_ulong *taken, jit_ulong *not_taken) JIT_NOTHROW;
 jit_label_t jit_function_reserve_label(jit_function_t func) JIT_NOTHROW;
 int jit_function_labels_equal(jit_function_t func, jit_label_t label, jit_label_t label2);
 
@@ -211,6 +211,12 @@ int jit_insn_branch_if
 	(jit_function_t func, jit_value_t value, jit_label_t *label) JIT_NOTHROW;
 int jit_insn_branch_if_not
 	(jit_function_t func, jit_value_t value, jit_label_t *label) JIT_NOTHROW;
+int jit_insn_branch_if_weighted
+	(jit_function_t func, jit_value_t value, jit_label_t *label,
+	 unsigned int taken, unsigned int not_taken) JIT_NOTHROW;
+int jit_insn_branch_if_not_weighted
+	(jit_function_t func, jit_value_t value, jit_label_t *label,
+	 unsigned int taken, unsigned int not_taken) JIT_NOTHROW;
 int jit_insn_jump_table
 	(jit_function_t func, jit_value_t value,
 	 jit_label_t *labels, unsigned int num_labels) JIT_NOTHROW;
@@ -43,6 +43,14 @@ typedef void *jit_memory_context_t;
 
 typedef struct jit_memory_manager const* jit_memory_manager_t;
 
+/*
+ * The memory manager is called with the context's memory lock held,
+ * but the lock is released between "start_function" and "end_function"
+ * while the code is generated.  Several threads may have a function
+ * started at the same time, so the state of the function being written
+ * ("get_limit", "get_break", "set_break", "alloc_data") has to be kept
+ * per calling thread.
+ */
 struct jit_memory_manager
 {
 	jit_memory_context_t (*create)(jit_context_t context);
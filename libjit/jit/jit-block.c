@@ -66,6 +66,18 @@ create_edge(jit_function_t func, jit_block_t src, jit_block_t dst, int flags, in
 	++(dst->num_preds);
 }
 
+/* Get the catcher block, if the function has one.  The catcher label
+   is meaningful only if the function uses a catcher. */
+static jit_block_t
+get_catcher(jit_function_t func)
+{
+	if(!func->has_try)
+	{
+		return 0;
+	}
+	return jit_block_from_label(func, func->builder->catcher_label);
+}
+
 static void
 build_edges(jit_function_t func, int create)
 {
@@ -110,7 +122,7 @@ build_edges(jit_function_t func, int create)
 		else if(opcode == JIT_OP_THROW || opcode == JIT_OP_RETHROW)
 		{
 			flags = _JIT_EDGE_EXCEPT;
-			dst = jit_block_from_label(func, func->builder->catcher_label);
+			dst = get_catcher(func);
 			if(!dst)
 			{
 				dst = func->builder->exit_block;
@@ -129,7 +141,7 @@ build_edges(jit_function_t func, int create)
 		else if(opcode >= JIT_OP_CALL && opcode <= JIT_OP_CALL_EXTERNAL_TAIL)
 		{
 			flags = _JIT_EDGE_EXCEPT;
-			dst = jit_block_from_label(func, func->builder->catcher_label);
+			dst = get_catcher(func);
 			if(!dst)
 			{
 				dst = func->builder->exit_block;
@@ -702,6 +714,379 @@ free_order(jit_function_t func)
 	func->builder->num_block_order = 0;
 }
 
+/* Get the opcode of the conditional branch that is taken when the given
+   one is not, or zero if the opcode is not a conditional branch */
+static int
+invert_branch(int opcode)
+{
+	switch(opcode)
+	{
+	case JIT_OP_BR_IFALSE:		return JIT_OP_BR_ITRUE;
+	case JIT_OP_BR_ITRUE:		return JIT_OP_BR_IFALSE;
+	case JIT_OP_BR_IEQ:		return JIT_OP_BR_INE;
+	case JIT_OP_BR_INE:		return JIT_OP_BR_IEQ;
+	case JIT_OP_BR_ILT:		return JIT_OP_BR_IGE;
+	case JIT_OP_BR_ILT_UN:		return JIT_OP_BR_IGE_UN;
+	case JIT_OP_BR_ILE:		return JIT_OP_BR_IGT;
+	case JIT_OP_BR_ILE_UN:		return JIT_OP_BR_IGT_UN;
+	case JIT_OP_BR_IGT:		return JIT_OP_BR_ILE;
+	case JIT_OP_BR_IGT_UN:		return JIT_OP_BR_ILE_UN;
+	case JIT_OP_BR_IGE:		return JIT_OP_BR_ILT;
+	case JIT_OP_BR_IGE_UN:		return JIT_OP_BR_ILT_UN;
+	case JIT_OP_BR_LFALSE:		return JIT_OP_BR_LTRUE;
+	case JIT_OP_BR_LTRUE:		return JIT_OP_BR_LFALSE;
+	case JIT_OP_BR_LEQ:		return JIT_OP_BR_LNE;
+	case JIT_OP_BR_LNE:		return JIT_OP_BR_LEQ;
+	case JIT_OP_BR_LLT:		return JIT_OP_BR_LGE;
+	case JIT_OP_BR_LLT_UN:		return JIT_OP_BR_LGE_UN;
+	case JIT_OP_BR_LLE:		return JIT_OP_BR_LGT;
+	case JIT_OP_BR_LLE_UN:		return JIT_OP_BR_LGT_UN;
+	case JIT_OP_BR_LGT:		return JIT_OP_BR_LLE;
+	case JIT_OP_BR_LGT_UN:		return JIT_OP_BR_LLE_UN;
+	case JIT_OP_BR_LGE:		return JIT_OP_BR_LLT;
+	case JIT_OP_BR_LGE_UN:		return JIT_OP_BR_LLT_UN;
+	case JIT_OP_BR_FEQ:		return JIT_OP_BR_FNE;
+	case JIT_OP_BR_FNE:		return JIT_OP_BR_FEQ;
+	case JIT_OP_BR_FLT:		return JIT_OP_BR_FGE_INV;
+	case JIT_OP_BR_FLE:		return JIT_OP_BR_FGT_INV;
+	case JIT_OP_BR_FGT:		return JIT_OP_BR_FLE_INV;
+	case JIT_OP_BR_FGE:		return JIT_OP_BR_FLT_INV;
+	case JIT_OP_BR_FLT_INV:		return JIT_OP_BR_FGE;
+	case JIT_OP_BR_FLE_INV:		return JIT_OP_BR_FGT;
+	case JIT_OP_BR_FGT_INV:		return JIT_OP_BR_FLE;
+	case JIT_OP_BR_FGE_INV:		return JIT_OP_BR_FLT;
+	case JIT_OP_BR_DEQ:		return JIT_OP_BR_DNE;
+	case JIT_OP_BR_DNE:		return JIT_OP_BR_DEQ;
+	case JIT_OP_BR_DLT:		return JIT_OP_BR_DGE_INV;
+	case JIT_OP_BR_DLE:		return JIT_OP_BR_DGT_INV;
+	case JIT_OP_BR_DGT:		return JIT_OP_BR_DLE_INV;
+	case JIT_OP_BR_DGE:		return JIT_OP_BR_DLT_INV;
+	case JIT_OP_BR_DLT_INV:		return JIT_OP_BR_DGE;
+	case JIT_OP_BR_DLE_INV:		return JIT_OP_BR_DGT;
+	case JIT_OP_BR_DGT_INV:		return JIT_OP_BR_DLE;
+	case JIT_OP_BR_DGE_INV:		return JIT_OP_BR_DLT;
+	case JIT_OP_BR_NFEQ:		return JIT_OP_BR_NFNE;
+	case JIT_OP_BR_NFNE:		return JIT_OP_BR_NFEQ;
+	case JIT_OP_BR_NFLT:		return JIT_OP_BR_NFGE_INV;
+	case JIT_OP_BR_NFLE:		return JIT_OP_BR_NFGT_INV;
+	case JIT_OP_BR_NFGT:		return JIT_OP_BR_NFLE_INV;
+	case JIT_OP_BR_NFGE:		return JIT_OP_BR_NFLT_INV;
+	case JIT_OP_BR_NFLT_INV:	return JIT_OP_BR_NFGE;
+	case JIT_OP_BR_NFLE_INV:	return JIT_OP_BR_NFGT;
+	case JIT_OP_BR_NFGT_INV:	return JIT_OP_BR_NFLE;
+	case JIT_OP_BR_NFGE_INV:	return JIT_OP_BR_NFLT;
+	}
+	return 0;
+}
+
+/* Get a label that branches may use to reach the block, creating
+   one if the block has only address_of labels or none at all */
+static jit_label_t
+get_branch_label(jit_function_t func, jit_block_t block)
+{
+	jit_label_t label;
+
+	label = block->label;
+	while(label != jit_label_undefined)
+	{
+		if((func->builder->label_info[label].flags & JIT_LABEL_ADDRESS_OF) == 0)
+		{
+			return label;
+		}
+		label = func->builder->label_info[label].alias;
+	}
+
+	label = (func->builder->next_label)++;
+	if(!_jit_block_record_label(block, label))
+	{
+		jit_exception_builtin(JIT_RESULT_OUT_OF_MEMORY);
+	}
+	return label;
+}
+
+/* Find the fallthrough edge and a branch edge of the block */
+static void
+find_exit_edges(jit_block_t block, _jit_edge_t *fallthru, _jit_edge_t *branch)
+{
+	int index;
+
+	*fallthru = 0;
+	*branch = 0;
+	for(index = 0; index < block->num_succs; index++)
+	{
+		if(block->succs[index]->flags == _JIT_EDGE_FALLTHRU)
+		{
+			*fallthru = block->succs[index];
+		}
+		else if(block->succs[index]->flags == _JIT_EDGE_BRANCH)
+		{
+			*branch = block->succs[index];
+		}
+	}
+}
+
+/* Check if the block ends with a conditional branch that has weights */
+static int
+has_branch_weights(jit_block_t block)
+{
+	jit_insn_t insn;
+
+	if(block->num_succs != 2
+	   || (block->taken_weight == 0 && block->not_taken_weight == 0))
+	{
+		return 0;
+	}
+	insn = _jit_block_get_last(block);
+	return insn && invert_branch(insn->opcode) != 0;
+}
+
+/* Check if the weights of the source block say that the edge is cold */
+static int
+is_cold_edge(_jit_edge_t edge)
+{
+	if(!has_branch_weights(edge->src))
+	{
+		return 0;
+	}
+	if(edge->flags == _JIT_EDGE_BRANCH)
+	{
+		return edge->src->taken_weight == 0;
+	}
+	if(edge->flags == _JIT_EDGE_FALLTHRU)
+	{
+		return edge->src->not_taken_weight == 0;
+	}
+	return 0;
+}
+
+/* Check if the block ends by throwing an exception, either directly
+   or by calling a function that does not return */
+static int
+ends_in_throw(jit_block_t block)
+{
+	jit_insn_t insn;
+
+	insn = _jit_block_get_last(block);
+	if(!insn)
+	{
+		return 0;
+	}
+	switch(insn->opcode)
+	{
+	case JIT_OP_THROW:
+	case JIT_OP_RETHROW:
+		return 1;
+
+	case JIT_OP_CALL:
+	case JIT_OP_CALL_INDIRECT:
+	case JIT_OP_CALL_VTABLE_PTR:
+	case JIT_OP_CALL_EXTERNAL:
+		/* Only calls that do not return end a block in dead code,
+		   apart from tail calls that have opcodes of their own */
+		return block->ends_in_dead;
+	}
+	return 0;
+}
+
+/* Mark the blocks that are expected to run rarely.  These are the blocks
+   that end with a throw, the catcher block, the targets of cold edges,
+   and the blocks that are reached only from cold blocks or lead only
+   to cold blocks. */
+static void
+mark_cold(jit_function_t func)
+{
+	jit_block_t block;
+	int index, changed, cold;
+	_jit_edge_t edge;
+
+	for(block = func->builder->entry_block; block; block = block->next)
+	{
+		block->cold = ends_in_throw(block);
+	}
+	block = get_catcher(func);
+	if(block)
+	{
+		block->cold = 1;
+	}
+	func->builder->entry_block->cold = 0;
+
+	do
+	{
+		changed = 0;
+		for(block = func->builder->entry_block->next;
+		    block != func->builder->exit_block;
+		    block = block->next)
+		{
+			if(block->cold)
+			{
+				continue;
+			}
+
+			/* Check whether all incoming edges are cold */
+			cold = (block->num_preds > 0);
+			for(index = 0; cold && index < block->num_preds; index++)
+			{
+				edge = block->preds[index];
+				cold = (edge->src->cold || is_cold_edge(edge));
+			}
+
+			/* Check whether the only way out leads to a cold block */
+			if(!cold && block->num_succs == 1)
+			{
+				cold = block->succs[0]->dst->cold;
+			}
+
+			if(cold)
+			{
+				block->cold = 1;
+				changed = 1;
+			}
+		}
+	}
+	while(changed);
+}
+
+/* Choose the block that should follow the given one on a hot path.
+   This is the target of the branch that ends the block if the weights
+   say that it is taken more often than not, otherwise the fallthrough
+   block.  Returns NULL if neither of them may be placed next. */
+static jit_block_t
+next_hot_block(jit_function_t func, jit_block_t block)
+{
+	_jit_edge_t fallthru, branch;
+	jit_block_t next;
+
+	find_exit_edges(block, &fallthru, &branch);
+
+	next = 0;
+	if(branch && has_branch_weights(block)
+	   && block->taken_weight > block->not_taken_weight)
+	{
+		next = branch->dst;
+	}
+	if(!next || next->visited || next->cold)
+	{
+		next = fallthru ? fallthru->dst : 0;
+	}
+	if(!next || next->visited || next->cold
+	   || next == func->builder->exit_block)
+	{
+		return 0;
+	}
+	return next;
+}
+
+/* Add a new edge between two blocks of a built control flow graph */
+static void
+add_edge(jit_function_t func, jit_block_t src, jit_block_t dst, int flags)
+{
+	_jit_edge_t edge;
+	_jit_edge_t *succs;
+
+	succs = jit_realloc(src->succs, (src->num_succs + 1) * sizeof(_jit_edge_t));
+	if(!succs)
+	{
+		jit_exception_builtin(JIT_RESULT_OUT_OF_MEMORY);
+	}
+	src->succs = succs;
+
+	edge = jit_memory_pool_alloc(&func->builder->edge_pool, struct _jit_edge);
+	if(!edge)
+	{
+		jit_exception_builtin(JIT_RESULT_OUT_OF_MEMORY);
+	}
+	edge->src = src;
+	edge->flags = flags;
+	src->succs[src->num_succs++] = edge;
+	attach_edge_dst(edge, dst);
+}
+
+/* Append an unconditional branch to the end of the block */
+static void
+append_branch(jit_function_t func, jit_block_t block, jit_block_t dst)
+{
+	jit_label_t label;
+	jit_insn_t insn;
+
+	label = get_branch_label(func, dst);
+	insn = _jit_block_add_insn(block);
+	if(!insn)
+	{
+		jit_exception_builtin(JIT_RESULT_OUT_OF_MEMORY);
+	}
+	insn->opcode = JIT_OP_BR;
+	insn->flags = JIT_INSN_DEST_IS_LABEL;
+	insn->dest = (jit_value_t) label;
+	insn->value1 = 0;
+	insn->value2 = 0;
+	block->ends_in_dead = 1;
+}
+
+/* Restore the control flow of a block that was moved away from the
+   block it used to fall through to, and turn branches to the block
+   that now follows it into fallthroughs where possible. */
+static void
+fix_block_exit(jit_function_t func, jit_block_t block)
+{
+	_jit_edge_t fallthru, branch;
+	jit_block_t jump;
+	jit_insn_t insn;
+	jit_uint weight;
+
+	find_exit_edges(block, &fallthru, &branch);
+	insn = _jit_block_get_last(block);
+
+	if(!fallthru)
+	{
+		/* An unconditional branch to the next block is useless */
+		if(branch && branch->dst == block->next && insn->opcode == JIT_OP_BR)
+		{
+			insn->opcode = JIT_OP_NOP;
+			block->ends_in_dead = 0;
+			branch->flags = _JIT_EDGE_FALLTHRU;
+		}
+		return;
+	}
+	if(fallthru->dst == block->next)
+	{
+		return;
+	}
+
+	if(!branch)
+	{
+		/* Turn the fallthrough into a branch */
+		append_branch(func, block, fallthru->dst);
+		fallthru->flags = _JIT_EDGE_BRANCH;
+	}
+	else if(branch->dst == block->next && invert_branch(insn->opcode))
+	{
+		/* Invert the conditional branch so that it falls through
+		   to the block that follows it now */
+		insn->opcode = invert_branch(insn->opcode);
+		insn->dest = (jit_value_t) get_branch_label(func, fallthru->dst);
+		fallthru->flags = _JIT_EDGE_BRANCH;
+		branch->flags = _JIT_EDGE_FALLTHRU;
+		weight = block->taken_weight;
+		block->taken_weight = block->not_taken_weight;
+		block->not_taken_weight = weight;
+	}
+	else
+	{
+		/* Fall through to a new block that branches to the old
+		   fallthrough block */
+		jump = _jit_block_create(func);
+		if(!jump)
+		{
+			jit_exception_builtin(JIT_RESULT_OUT_OF_MEMORY);
+		}
+		_jit_block_attach_after(block, jump, jump);
+		append_branch(func, jump, fallthru->dst);
+		add_edge(func, jump, fallthru->dst, _JIT_EDGE_BRANCH);
+		detach_edge_dst(fallthru);
+		attach_edge_dst(fallthru, jump);
+	}
+}
+
 int
 _jit_block_init(jit_function_t func)
 {
@@ -900,6 +1285,126 @@ _jit_block_clean_cfg(jit_function_t func)
 	}
 }
 
+void
+_jit_block_layout(jit_function_t func)
+{
+	jit_block_t block, next, pinned_first, pinned_last;
+	jit_block_t *order;
+	int num_blocks, num, index;
+
+	/*
+	 * Blocks are placed in chains that follow the hot paths through
+	 * the function, starting each chain at the first block that is
+	 * not yet placed, in the original order.  Cold blocks are placed
+	 * after all the other blocks.  Without branch weights or cold
+	 * blocks the original order is kept.
+	 *
+	 * The address of a block may be taken to check whether an
+	 * exception was thrown within a range of blocks.  So the blocks
+	 * from the first such block to the last one are kept together in
+	 * their original order.  They are marked as visited up front so
+	 * that no chain runs into them.
+	 */
+
+	/* A block that falls through to the exit block must stay last */
+	block = func->builder->exit_block->prev;
+	if(block != func->builder->entry_block && !block->ends_in_dead)
+	{
+		return;
+	}
+
+	mark_cold(func);
+	clear_visited(func);
+
+	/* Find the range of blocks that must stay in place */
+	pinned_first = 0;
+	pinned_last = 0;
+	for(block = func->builder->entry_block; block; block = block->next)
+	{
+		if(block->address_of)
+		{
+			if(!pinned_first)
+			{
+				pinned_first = block;
+			}
+			pinned_last = block;
+		}
+	}
+	for(block = pinned_first; block; block = block->next)
+	{
+		block->cold = 0;
+		block->visited = 1;
+		if(block == pinned_last)
+		{
+			break;
+		}
+	}
+
+	num_blocks = count_blocks(func);
+	order = (jit_block_t *) jit_malloc(num_blocks * sizeof(jit_block_t));
+	if(!order)
+	{
+		jit_exception_builtin(JIT_RESULT_OUT_OF_MEMORY);
+	}
+
+	/* Place the hot blocks */
+	num = 0;
+	for(block = func->builder->entry_block;
+	    block != func->builder->exit_block;
+	    block = block->next)
+	{
+		if(block == pinned_first)
+		{
+			for(next = pinned_first; next != pinned_last->next; next = next->next)
+			{
+				order[num++] = next;
+			}
+			continue;
+		}
+		if(block->visited || block->cold)
+		{
+			continue;
+		}
+		for(next = block; next; next = next_hot_block(func, next))
+		{
+			next->visited = 1;
+			order[num++] = next;
+		}
+	}
+
+	/* Place the cold blocks */
+	for(block = func->builder->entry_block;
+	    block != func->builder->exit_block;
+	    block = block->next)
+	{
+		if(!block->visited)
+		{
+			block->visited = 1;
+			order[num++] = block;
+		}
+	}
+
+	/* Relink the blocks in the new order */
+	for(index = 1; index < num; index++)
+	{
+		order[index - 1]->next = order[index];
+		order[index]->prev = order[index - 1];
+	}
+	order[num - 1]->next = func->builder->exit_block;
+	func->builder->exit_block->prev = order[num - 1];
+	jit_free(order);
+
+	/* Repair the control flow that was broken by the reordering */
+	for(block = func->builder->entry_block;
+	    block != func->builder->exit_block;
+	    block = block->next)
+	{
+		fix_block_exit(func, block);
+	}
+
+	clear_visited(func);
+}
+
 int
 _jit_block_compute_postorder(jit_function_t func)
 {
@@ -76,6 +76,9 @@ optimize(jit_function_t func)
 	/* Eliminate useless control flow */
 	_jit_block_clean_cfg(func);
 
+	/* Move cold code out of line and make hot paths fall through */
+	_jit_block_layout(func);
+
 	/* Optimization is done */
 	func->is_optimized = 1;
 }
@@ -411,6 +414,20 @@ memory_release(_jit_compile_t *state)
 	}
 }
 
+/*
+ * Reacquire the memory context lock after it was released for the
+ * duration of code generation.
+ */
+static void
+memory_relock(_jit_compile_t *state)
+{
+	if(!state->memory_locked)
+	{
+		_jit_memory_lock(state->gen.context);
+		state->memory_locked = 1;
+	}
+}
+
 /*
  * Align the method code on a particular boundary if the
  * difference between the current position and the aligned
@@ -511,6 +528,9 @@ memory_flush(_jit_compile_t *state)
 		/* Reset the memory state */
 		state->memory_started = 0;
 
+		/* Publishing the function needs the memory context lock */
+		memory_relock(state);
+
 		/* Let the memory context know the address we ended at */
 		_jit_memory_set_break(state->gen.context, state->gen.code_end);
 
@@ -559,6 +579,7 @@ memory_abort(_jit_compile_t *state)
 		state->memory_started = 0;
 
 		/* Release the code space */
+		memory_relock(state);
 		_jit_memory_end_function(state->gen.context, JIT_MEMORY_RESTART);
 
 		/* Free encoded bytecode offset data */
@@ -576,6 +597,7 @@ memory_realloc(_jit_compile_t *state)
 
 	/* Release the previously allocated code space */
 	memory_abort(state);
+	memory_relock(state);
 
 	/* Request to extend memory limit and retry space allocation */
 	_jit_memory_extend_limit(state->gen.context, state->page_factor++);
@@ -746,6 +768,11 @@ compile(_jit_compile_t *state, jit_function_t func)
 		memory_realloc(state);
 	}
 
+	/* The code is written to the calling thread's own region of the
+	   memory context, so other threads may use the context while the
+	   code is being generated */
+	memory_release(state);
+
 #ifdef _JIT_COMPILE_DEBUG
 	if(state->restart == 0)
 	{
@@ -968,19 +995,38 @@ jit_function_compile_entry(jit_function_t func, void **entry_point)
 void *
 _jit_function_compile_on_demand(jit_function_t func)
 {
+	jit_context_t context = func->context;
 	_jit_compile_t state;
 	int result;
 
-	/* Lock down the context */
-	jit_context_build_start(func->context);
+	/* Claim the function, waiting if another thread is compiling it */
+	jit_monitor_lock(&context->on_demand_monitor);
+	while(func->is_compiling)
+	{
+		if(!jit_monitor_wait(&context->on_demand_monitor, -1))
+		{
+			break;
+		}
+	}
 
 	/* Fast return if we are already compiled */
 	if(func->is_compiled)
 	{
-		jit_context_build_end(func->context);
+		jit_monitor_unlock(&context->on_demand_monitor);
 		return func->entry_point;
 	}
 
+	/* If the wait failed while the function is still being compiled,
+	   then report an error rather than compiling it a second time */
+	if(func->is_compiling)
+	{
+		jit_monitor_unlock(&context->on_demand_monitor);
+		jit_exception_builtin(JIT_RESULT_COMPILE_ERROR);
+		return 0;
+	}
+	func->is_compiling = 1;
+	jit_monitor_unlock(&context->on_demand_monitor);
+
 	if(!func->on_demand)
 	{
 		/* Bail out with an error if the user didn't supply an
@@ -1004,8 +1050,13 @@ _jit_function_compile_on_demand(jit_function_t func)
 		_jit_function_free_builder(func);
 	}
 
-	/* Unlock the context and report the result */
-	jit_context_build_end(func->context);
+	/* Release the function and wake up any threads waiting for it */
+	jit_monitor_lock(&context->on_demand_monitor);
+	func->is_compiling = 0;
+	jit_monitor_signal_all(&context->on_demand_monitor);
+	jit_monitor_unlock(&context->on_demand_monitor);
+
+	/* Report the result */
 	if(result != JIT_RESULT_OK)
 	{
 		jit_exception_builtin(result);
@@ -40,15 +40,20 @@ of threads itself.  It is up to the front-end environment to take
 care of that.  But the library is thread-aware, as long as you take
 some very simple steps.
 
-In a multi-threaded environment, you must ensure that only one
-thread can build functions at any one time.  Otherwise the
-JIT's context may become corrupted.  To protect the system,
-you should call @code{jit_context_build_start} before
-creating the function.  And then call @code{jit_context_build_end}
-once the function has been fully compiled.
-
-You can compile multiple functions during the one build process
-if you wish, which is the normal case when compiling a class.
+Several threads may build and compile functions within the same
+context at the same time.  Each thread translates into a code region
+of its own, and only the final step that makes the compiled code
+visible to the rest of the context is serialized.  The only rule
+is that a particular function must not be built or compiled by
+more than one thread at once.  Functions that are compiled on demand
+are handled automatically: if two threads call a function that is
+not yet compiled, then one of them compiles it while the other waits.
+
+If the front end has data structures of its own that must not be
+accessed by more than one builder at a time, then it may call
+@code{jit_context_build_start} before creating the function, and
+@code{jit_context_build_end} once the function has been fully compiled.
+This lock is not used by the JIT itself.
 
 It is usually a good idea to suspend the finalization of
 garbage-collected objects while function building is in progress.
@@ -88,6 +93,7 @@ jit_context_create(void)
 	/* Initialize the context and return it */
 	jit_mutex_create(&context->memory_lock);
 	jit_mutex_create(&context->builder_lock);
+	jit_monitor_create(&context->on_demand_monitor);
 	context->functions = 0;
 	context->last_function = 0;
 	context->on_demand_driver = _jit_function_compile_on_demand;
@@ -127,16 +133,18 @@ jit_context_destroy(jit_context_t context)
 
 	jit_mutex_destroy(&context->memory_lock);
 	jit_mutex_destroy(&context->builder_lock);
+	jit_monitor_destroy(&context->on_demand_monitor);
 
 	jit_free(context);
 }
 
 /*@
  * @deftypefun void jit_context_build_start (jit_context_t @var{context})
- * This routine should be called before you start building a function
+ * This routine may be called before you start building a function
  * to be JIT'ed.  It acquires a lock on the context to prevent other
- * threads from accessing the build process, since only one thread
- * can be performing build operations at any one time.
+ * threads that also call this routine from building at the same time.
+ * The JIT does not need this lock for its own data structures, so it is
+ * only useful when the front end has to serialize its own build state.
  * @end deftypefun
 @*/
 void
@@ -168,13 +176,14 @@ jit_context_build_end(jit_context_t context)
  *
  * @enumerate
  * @item
- * The context is locked by calling @code{jit_context_build_start}.
+ * The function is marked as being compiled by the calling thread.
+ * If some other thread is already compiling it, then @code{libjit}
+ * waits until that thread has finished.
  *
  * @item
- * If the function has already been compiled, @code{libjit} unlocks
- * the context and returns immediately.  This can happen because of race
- * conditions between threads: some other thread may have beaten us
- * to the on-demand compiler.
+ * If the function has already been compiled, @code{libjit} returns
+ * immediately.  This can happen because of race conditions between
+ * threads: some other thread may have beaten us to the on-demand compiler.
  *
  * @item
  * The user's on-demand compiler is called.  It is responsible for building
@@ -187,8 +196,9 @@ jit_context_build_end(jit_context_t context)
  * will call @code{jit_function_compile} to compile the function.
  *
  * @item
- * The context is unlocked by calling @code{jit_context_build_end} and
- * @code{libjit} jumps to the newly-compiled entry point.  If an error
+ * The function is no longer marked as being compiled, and any threads
+ * waiting for it are woken up.  @code{libjit} then jumps to the
+ * newly-compiled entry point.  If an error
  * occurs, a built-in exception of type @code{JIT_RESULT_COMPILE_ERROR}
  * or @code{JIT_RESULT_OUT_OF_MEMORY} will be thrown.
  *
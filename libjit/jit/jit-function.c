@@ -36,11 +36,11 @@
  * Once the build process is complete, the user calls
  * @code{jit_function_compile} to convert it into its executable form.
  *
- * It is recommended that you call @code{jit_context_build_start} before
- * calling @code{jit_function_create}, and then call
- * @code{jit_context_build_end} after you have called
- * @code{jit_function_compile}.  This will protect the JIT's internal
- * data structures within a multi-threaded environment.
+ * Different threads may build and compile different functions of the
+ * same context at the same time.  A single function must only be built
+ * by one thread at a time.  Use @code{jit_context_build_start} and
+ * @code{jit_context_build_end} if the front end needs to serialize its
+ * own state while building.
  * @end deftypefun
 @*/
 jit_function_t
@@ -84,12 +84,28 @@ jit_function_create(jit_context_t context, jit_type_t signature)
 # endif
 #endif /* !defined(JIT_BACKEND_INTERP) && (defined(jit_redirector_size) || defined(jit_indirector_size)) */
 
+	/* Add the function to the context list */
+	func->next = 0;
+	func->prev = context->last_function;
+	if(context->last_function)
+	{
+		context->last_function->next = func;
+	}
+	else
+	{
+		context->functions = func;
+	}
+	context->last_function = func;
+
+	/* Functions built by different threads often share a signature,
+	   so its reference count is only updated under the lock */
+	func->signature = jit_type_copy(signature);
+
 	/* Release the memory context */
 	_jit_memory_unlock(context);
 
 	/* Initialize the function block */
 	func->context = context;
-	func->signature = jit_type_copy(signature);
 	func->optimization_level = JIT_OPTLEVEL_NORMAL;
 
 #if !defined(JIT_BACKEND_INTERP) && defined(jit_redirector_size)
@@ -106,19 +122,6 @@ jit_function_create(jit_context_t context, jit_type_t signature)
 	_jit_flush_exec(func->indirector, jit_indirector_size);
 #endif
 
-	/* Add the function to the context list */
-	func->next = 0;
-	func->prev = context->last_function;
-	if(context->last_function)
-	{
-		context->last_function->next = func;
-	}
-	else
-	{
-		context->functions = func;
-	}
-	context->last_function = func;
-
 	/* Return the function to the caller */
 	return func;
 }
@@ -228,6 +231,7 @@ void
 _jit_function_destroy(jit_function_t func)
 {
 	jit_context_t context;
+	_jit_branch_counts_t counts;
 
 	if(!func)
 	{
@@ -235,6 +239,22 @@ _jit_function_destroy(jit_function_t func)
 	}
 
 	context = func->context;
+
+	_jit_function_free_builder(func);
+	_jit_varint_free_data(func->bytecode_offset);
+	jit_meta_destroy(&func->meta);
+
+	while((counts = func->branch_counts) != 0)
+	{
+		func->branch_counts = counts->next;
+		jit_free(counts);
+	}
+
+	_jit_memory_lock(context);
+
+	jit_type_free(func->signature);
+
+	/* Remove the function from the context list */
 	if(func->next)
 	{
 		func->next->prev = func->prev;
@@ -252,13 +272,6 @@ _jit_function_destroy(jit_function_t func)
 		context->functions = func->next;
 	}
 
-	_jit_function_free_builder(func);
-	_jit_varint_free_data(func->bytecode_offset);
-	jit_meta_destroy(&func->meta);
-	jit_type_free(func->signature);
-
-	_jit_memory_lock(context);
-
 #if !defined(JIT_BACKEND_INTERP) && (defined(jit_redirector_size) || defined(jit_indirector_size))
 # if defined(jit_redirector_size)
 	_jit_memory_free_trampoline(context, func->redirector);
@@ -714,6 +727,94 @@ jit_function_from_pc(jit_context_t context, void *pc, void **handler)
 	return func;
 }
 
+/*@
+ * @deftypefun {unsigned int} jit_function_get_bytecode_offset (jit_function_t @var{func}, void *@var{pc})
+ * Get the bytecode offset that is recorded for the program counter
+ * location @var{pc} within @var{func}.  This will be @code{JIT_NO_OFFSET}
+ * if @var{pc} is not within @var{func}, or if there is no bytecode
+ * offset associated with it.
+ *
+ * This is equivalent to calling @code{jit_stack_trace_get_offset} on
+ * a stack trace entry, and is intended for front ends that record raw
+ * program counters when an exception is thrown and only map them back
+ * to bytecode offsets when the trace is actually inspected.
+ * @end deftypefun
+@*/
+unsigned int
+jit_function_get_bytecode_offset(jit_function_t func, void *pc)
+{
+	void *func_info;
+
+	if(!func || !pc)
+	{
+		return JIT_NO_OFFSET;
+	}
+	func_info = _jit_memory_find_function_info(func->context, pc);
+	if(!func_info || _jit_memory_get_function(func->context, func_info) != func)
+	{
+		return JIT_NO_OFFSET;
+	}
+	return _jit_function_get_bytecode(func, func_info, pc, 0);
+}
+
+/*@
+ * @deftypefun {unsigned long} jit_function_get_code_size (jit_function_t @var{func})
+ * Get the number of bytes of code that were generated for @var{func}.
+ * When the interpreter is in use, this is the size of the function's
+ * interpreted bytecode.  Returns zero if the function has not been
+ * compiled yet.
+ * @end deftypefun
+@*/
+unsigned long
+jit_function_get_code_size(jit_function_t func)
+{
+	void *func_info;
+	unsigned char *start;
+	unsigned char *end;
+
+	if(!func || !func->is_compiled)
+	{
+		return 0;
+	}
+
+	/* Look up the cache region that holds the entry point */
+	func_info = _jit_memory_find_function_info(func->context, func->entry_point);
+	if(!func_info)
+	{
+		return 0;
+	}
+	start = _jit_memory_get_function_start(func->context, func_info);
+	end = _jit_memory_get_function_end(func->context, func_info);
+	return (unsigned long)(end - start);
+}
+
+/*@
+ * @deftypefun {void *} jit_function_get_code_start (jit_function_t @var{func})
+ * Get the start of the code that was generated for @var{func}, or NULL
+ * if the function has not been compiled yet.  Unlike the closure, this
+ * address is fixed for the lifetime of the compiled code on every
+ * backend, so front ends can record program counters as offsets from it
+ * and pass @code{start + offset} to @code{jit_function_get_bytecode_offset}
+ * later.
+ * @end deftypefun
+@*/
+void *
+jit_function_get_code_start(jit_function_t func)
+{
+	void *func_info;
+
+	if(!func || !func->is_compiled)
+	{
+		return 0;
+	}
+	func_info = _jit_memory_find_function_info(func->context, func->entry_point);
+	if(!func_info)
+	{
+		return 0;
+	}
+	return _jit_memory_get_function_start(func->context, func_info);
+}
+
 /*@
  * @deftypefun {void *} jit_function_to_vtable_pointer (jit_function_t @var{func})
  * Return a pointer that is suitable for referring to this function
@@ -1018,6 +1119,126 @@ jit_function_get_max_optimization_level(void)
 	return JIT_OPTLEVEL_NORMAL;
 }
 
+jit_nuint *
+_jit_function_get_branch_counters(jit_function_t func, unsigned int branch, int create)
+{
+	_jit_branch_counts_t *link;
+	unsigned int chunk;
+
+	/* Walk the chunk list, allocating missing chunks if necessary */
+	link = &func->branch_counts;
+	for(chunk = branch / _JIT_BRANCH_COUNTS_CHUNK; ; --chunk)
+	{
+		if(!*link)
+		{
+			if(!create)
+			{
+				return 0;
+			}
+			*link = jit_cnew(struct _jit_branch_counts);
+			if(!*link)
+			{
+				return 0;
+			}
+		}
+		if(chunk == 0)
+		{
+			break;
+		}
+		link = &(*link)->next;
+	}
+
+	if(branch >= func->num_branch_counts)
+	{
+		if(!create)
+		{
+			return 0;
+		}
+		func->num_branch_counts = branch + 1;
+	}
+	return (*link)->counts[branch % _JIT_BRANCH_COUNTS_CHUNK];
+}
+
+/*@
+ * @deftypefun void jit_function_collect_branch_counts (jit_function_t @var{func}, int @var{flag})
+ * Enable or disable the collection of branch counts for @var{func}.
+ * While enabled, every conditional branch that is built with
+ * @code{jit_insn_branch_if} or @code{jit_insn_branch_if_not} is
+ * numbered in the order in which it is built, and the generated
+ * code counts how many times it is taken and not taken.  This makes
+ * the code slower, so it is normally only enabled for a first
+ * compilation of the function.
+ *
+ * When the function is built again with collection disabled, the
+ * counts are used as the branch weights of the branches with the
+ * same numbers, which guide the placement of blocks by the optimizer.
+ * This requires the front end to build the same instruction sequence
+ * as before.  The counts are kept until the function is destroyed,
+ * and they are not updated atomically, so they are only approximate
+ * if the function runs on several threads at once.
+ * @end deftypefun
+@*/
+void
+jit_function_collect_branch_counts(jit_function_t func, int flag)
+{
+	if(func)
+	{
+		func->collect_branch_counts = (flag != 0);
+	}
+}
+
+/*@
+ * @deftypefun {unsigned int} jit_function_get_num_branch_counts (jit_function_t @var{func})
+ * Get the number of conditional branches in @var{func} that have
+ * counts collected by @code{jit_function_collect_branch_counts}.
+ * @end deftypefun
+@*/
+unsigned int
+jit_function_get_num_branch_counts(jit_function_t func)
+{
+	if(func)
+	{
+		return func->num_branch_counts;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+/*@
+ * @deftypefun int jit_function_get_branch_counts (jit_function_t @var{func}, unsigned int @var{branch}, jit_ulong *@var{taken}, jit_ulong *@var{not_taken})
+ * Get the number of times that the conditional branch numbered
+ * @var{branch} in @var{func} was taken and not taken.  Returns zero
+ * if there are no counts for the branch.
+ * @end deftypefun
+@*/
+int
+jit_function_get_branch_counts(jit_function_t func, unsigned int branch,
+			       jit_ulong *taken, jit_ulong *not_taken)
+{
+	jit_nuint *counters;
+
+	if(!func)
+	{
+		return 0;
+	}
+	counters = _jit_function_get_branch_counters(func, branch, 0);
+	if(!counters)
+	{
+		return 0;
+	}
+	if(taken)
+	{
+		*taken = counters[0];
+	}
+	if(not_taken)
+	{
+		*not_taken = counters[1];
+	}
+	return 1;
+}
+
 /*@
  * @deftypefun {jit_label_t} jit_function_reserve_label (jit_function_t @var{func})
  * Allocate a new label for later use within the function @var{func}.  Most
@@ -3589,19 +3589,11 @@ int jit_insn_branch(jit_function_t func, jit_label_t *label)
 	return jit_insn_new_block(func);
 }
 
-/*@
- * @deftypefun int jit_insn_branch_if (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{label})
- * Terminate the current block by branching to a specific label if
- * the specified value is non-zero.  Returns zero if out of memory.
- *
- * If @var{value} refers to a conditional expression that was created
- * by @code{jit_insn_eq}, @code{jit_insn_ne}, etc, then the conditional
- * expression will be replaced by an appropriate conditional branch
- * instruction.
- * @end deftypefun
-@*/
-int jit_insn_branch_if
-		(jit_function_t func, jit_value_t value, jit_label_t *label)
+/*
+ * Output a conditional branch that is taken if the value is non-zero.
+ */
+static int
+branch_if(jit_function_t func, jit_value_t value, jit_label_t *label)
 {
 	jit_insn_t insn;
 	jit_insn_t prev;
@@ -3801,19 +3793,11 @@ add_block:
 	return jit_insn_new_block(func);
 }
 
-/*@
- * @deftypefun int jit_insn_branch_if_not (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{label})
- * Terminate the current block by branching to a specific label if
- * the specified value is zero.  Returns zero if out of memory.
- *
- * If @var{value} refers to a conditional expression that was created
- * by @code{jit_insn_eq}, @code{jit_insn_ne}, etc, then the conditional
- * expression will be followed by an appropriate conditional branch
- * instruction, instead of a value load.
- * @end deftypefun
-@*/
-int jit_insn_branch_if_not
-		(jit_function_t func, jit_value_t value, jit_label_t *label)
+/*
+ * Output a conditional branch that is taken if the value is zero.
+ */
+static int
+branch_if_not(jit_function_t func, jit_value_t value, jit_label_t *label)
 {
 	jit_insn_t insn;
 	jit_insn_t prev;
@@ -4014,6 +3998,226 @@ add_block:
 	return jit_insn_new_block(func);
 }
 
+/*
+ * Set the weights of the conditional branch that ended the block
+ * before the current one.  The weights are scaled down to fit,
+ * keeping non-zero weights non-zero.
+ */
+static void
+set_branch_weights(jit_function_t func, jit_ulong taken, jit_ulong not_taken)
+{
+	jit_block_t block;
+
+	while(taken > (jit_ulong)0xFFFFFFFF || not_taken > (jit_ulong)0xFFFFFFFF)
+	{
+		taken = (taken >> 1) | (taken & 1);
+		not_taken = (not_taken >> 1) | (not_taken & 1);
+	}
+
+	block = func->builder->current_block->prev;
+	block->taken_weight = (jit_uint)taken;
+	block->not_taken_weight = (jit_uint)not_taken;
+}
+
+/*
+ * Output code that increments a branch counter.
+ */
+static int
+count_branch(jit_function_t func, jit_nuint *counter)
+{
+	jit_value_t addr;
+	jit_value_t value;
+
+	addr = jit_value_create_nint_constant
+		(func, jit_type_void_ptr, (jit_nint)counter);
+	if(!addr)
+	{
+		return 0;
+	}
+	value = jit_insn_load_relative(func, addr, 0, jit_type_nuint);
+	if(!value)
+	{
+		return 0;
+	}
+	value = jit_insn_add
+		(func, value, jit_value_create_nint_constant(func, jit_type_nuint, 1));
+	if(!value)
+	{
+		return 0;
+	}
+	return jit_insn_store_relative(func, addr, 0, value);
+}
+
+/*
+ * Output a numbered conditional branch.  If branch counts are being
+ * collected for the function, then the branch is followed by code that
+ * counts how often it is taken and not taken.  Otherwise the branch
+ * is output plainly and gets the weights from the counts that were
+ * collected previously, if any.
+ */
+static int
+profile_branch(jit_function_t func, jit_value_t value,
+	       jit_label_t *label, int invert)
+{
+	jit_label_t not_taken_label = jit_label_undefined;
+	jit_nuint *counters;
+	unsigned int branch;
+
+	branch = (func->builder->num_branches)++;
+	if(!func->collect_branch_counts)
+	{
+		if(!(invert ? branch_if_not(func, value, label)
+			    : branch_if(func, value, label)))
+		{
+			return 0;
+		}
+		counters = _jit_function_get_branch_counters(func, branch, 0);
+		if(counters)
+		{
+			set_branch_weights(func, counters[0], counters[1]);
+		}
+		return 1;
+	}
+
+	counters = _jit_function_get_branch_counters(func, branch, 1);
+	if(!counters)
+	{
+		return 0;
+	}
+
+	/* Skip the "taken" counter if the branch is not taken */
+	if(!(invert ? branch_if(func, value, &not_taken_label)
+		    : branch_if_not(func, value, &not_taken_label)))
+	{
+		return 0;
+	}
+	if(!count_branch(func, &counters[0]))
+	{
+		return 0;
+	}
+	if(*label == jit_label_undefined)
+	{
+		*label = (func->builder->next_label)++;
+	}
+	if(!jit_insn_branch(func, label))
+	{
+		return 0;
+	}
+	if(!jit_insn_label(func, &not_taken_label))
+	{
+		return 0;
+	}
+	return count_branch(func, &counters[1]);
+}
+
+/*@
+ * @deftypefun int jit_insn_branch_if (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{label})
+ * Terminate the current block by branching to a specific label if
+ * the specified value is non-zero.  Returns zero if out of memory.
+ *
+ * If @var{value} refers to a conditional expression that was created
+ * by @code{jit_insn_eq}, @code{jit_insn_ne}, etc, then the conditional
+ * expression will be replaced by an appropriate conditional branch
+ * instruction.
+ *
+ * Unless @var{value} is constant, the branch is numbered for
+ * profiling.  @xref{jit_function_collect_branch_counts}.
+ * @end deftypefun
+@*/
+int jit_insn_branch_if
+		(jit_function_t func, jit_value_t value, jit_label_t *label)
+{
+	if(!value || !label)
+	{
+		return 0;
+	}
+	if(!_jit_function_ensure_builder(func))
+	{
+		return 0;
+	}
+	if(jit_value_is_constant(value))
+	{
+		return branch_if(func, value, label);
+	}
+	return profile_branch(func, value, label, 0);
+}
+
+/*@
+ * @deftypefun int jit_insn_branch_if_not (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{label})
+ * Terminate the current block by branching to a specific label if
+ * the specified value is zero.  Returns zero if out of memory.
+ *
+ * If @var{value} refers to a conditional expression that was created
+ * by @code{jit_insn_eq}, @code{jit_insn_ne}, etc, then the conditional
+ * expression will be followed by an appropriate conditional branch
+ * instruction, instead of a value load.
+ *
+ * Unless @var{value} is constant, the branch is numbered for
+ * profiling.  @xref{jit_function_collect_branch_counts}.
+ * @end deftypefun
+@*/
+int jit_insn_branch_if_not
+		(jit_function_t func, jit_value_t value, jit_label_t *label)
+{
+	if(!value || !label)
+	{
+		return 0;
+	}
+	if(!_jit_function_ensure_builder(func))
+	{
+		return 0;
+	}
+	if(jit_value_is_constant(value))
+	{
+		return branch_if_not(func, value, label);
+	}
+	return profile_branch(func, value, label, 1);
+}
+
+/*@
+ * @deftypefun int jit_insn_branch_if_weighted (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{label}, unsigned int @var{taken}, unsigned int @var{not_taken})
+ * @deftypefunx int jit_insn_branch_if_not_weighted (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{label}, unsigned int @var{taken}, unsigned int @var{not_taken})
+ * Output a conditional branch like @code{jit_insn_branch_if} or
+ * @code{jit_insn_branch_if_not}, with a hint about how often it is
+ * taken.  The optimizer lays out the more heavily weighted path so
+ * that it falls through.  A weight of zero for one path marks it as
+ * cold, so that its blocks are moved out of line: for example, pass
+ * weights 0 and 1 for a branch to an error handler.
+ *
+ * The weights replace any branch counts that were collected before.
+ * They are ignored while branch counts are being collected.
+ * @end deftypefun
+@*/
+int jit_insn_branch_if_weighted
+		(jit_function_t func, jit_value_t value, jit_label_t *label,
+		 unsigned int taken, unsigned int not_taken)
+{
+	if(!jit_insn_branch_if(func, value, label))
+	{
+		return 0;
+	}
+	if(!jit_value_is_constant(value) && !func->collect_branch_counts)
+	{
+		set_branch_weights(func, taken, not_taken);
+	}
+	return 1;
+}
+
+int jit_insn_branch_if_not_weighted
+		(jit_function_t func, jit_value_t value, jit_label_t *label,
+		 unsigned int taken, unsigned int not_taken)
+{
+	if(!jit_insn_branch_if_not(func, value, label))
+	{
+		return 0;
+	}
+	if(!jit_value_is_constant(value) && !func->collect_branch_counts)
+	{
+		set_branch_weights(func, taken, not_taken);
+	}
+	return 1;
+}
+
 /*@
  * @deftypefun int jit_insn_jump_table (jit_function_t @var{func}, jit_value_t @var{value}, jit_label_t *@var{labels}, unsigned int @var{num_labels})
  * Branch to a label from the @var{labels} table. The @var{value} is the
@@ -7257,8 +7461,9 @@ static int initialize_setjmp_block(jit_function_t func)
 	}
 #endif	/* !HAVE_SIGSETJMP */
 
-	/* Branch to the end of the init code if "setjmp" returned zero */
-	if(!jit_insn_branch_if_not(func, value, &code_label))
+	/* Branch to the end of the init code if "setjmp" returned zero,
+	   which is what happens unless an exception was thrown */
+	if(!jit_insn_branch_if_not_weighted(func, value, &code_label, 1, 0))
 	{
 		return 0;
 	}
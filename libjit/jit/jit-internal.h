@@ -252,6 +252,12 @@ struct _jit_block
 	unsigned		visited : 1;
 	unsigned		ends_in_dead : 1;
 	unsigned		address_of : 1;
+	unsigned		cold : 1;
+
+	/* Relative weights of the taken and not taken paths of the
+	   conditional branch that ends the block, both zero if unknown */
+	jit_uint		taken_weight;
+	jit_uint		not_taken_weight;
 
 	/* Metadata */
 	jit_meta_t		meta;
@@ -262,6 +268,20 @@ struct _jit_block
 	void			*fixup_absolute_list;
 };
 
+/*
+ * Chunk of branch counters collected by instrumented code.  Each
+ * conditional branch has a pair of counters: the number of times
+ * the branch was taken and the number of times it was not taken.
+ * The chunks never move, because the code refers to them directly.
+ */
+#define	_JIT_BRANCH_COUNTS_CHUNK	64
+typedef struct _jit_branch_counts *_jit_branch_counts_t;
+struct _jit_branch_counts
+{
+	_jit_branch_counts_t	next;
+	jit_nuint		counts[_JIT_BRANCH_COUNTS_CHUNK][2];
+};
+
 /*
  * Internal structure of a value.
  */
@@ -419,6 +439,9 @@ struct _jit_builder
 	/* Generate position-independent code */
 	unsigned		position_independent : 1;
 
+	/* Number of conditional branches that were numbered for profiling */
+	unsigned int		num_branches;
+
 	/* Memory pools that contain values, instructions, and metadata blocks */
 	jit_memory_pool		value_pool;
 	jit_memory_pool		edge_pool;
@@ -485,11 +508,19 @@ struct _jit_function
 	unsigned		no_throw : 1;
 	unsigned		no_return : 1;
 	unsigned		has_try : 1;
+	unsigned		collect_branch_counts : 1;
 	unsigned		optimization_level : 8;
 
+	/* Branch counters collected by instrumented code */
+	_jit_branch_counts_t	branch_counts;
+	unsigned int		num_branch_counts;
+
 	/* Flag set once the function is compiled */
 	int volatile		is_compiled;
 
+	/* Flag set while a thread compiles the function on demand */
+	int			is_compiling;
+
 	/* The entry point for the function's compiled code */
 	void * volatile		entry_point;
 
@@ -516,6 +547,15 @@ struct _jit_function
  */
 int _jit_function_ensure_builder(jit_function_t func);
 
+/*
+ * Get the counters for a numbered conditional branch, allocating
+ * them if "create" is non-zero.  Returns NULL if out of memory or
+ * the counters do not exist.
+ */
+jit_nuint *_jit_function_get_branch_counters(jit_function_t func,
+					     unsigned int branch,
+					     int create);
+
 /*
  * Free the builder associated with a function.
  */
@@ -567,6 +607,9 @@ struct _jit_context
 	/* Lock that controls access to the building process */
 	jit_mutex_t		builder_lock;
 
+	/* Monitor that coordinates threads compiling functions on demand */
+	jit_monitor_t		on_demand_monitor;
+
 	/* List of functions that are currently registered with the context */
 	jit_function_t		functions;
 	jit_function_t		last_function;
@@ -656,6 +699,7 @@ struct jit_thread_control
 	jit_exception_func	exception_handler;
 	jit_backtrace_t		backtrace_head;
 	struct jit_jmp_buf	*setjmp_head;
+	jit_thread_resource_t	resources;
 };
 
 /*
@@ -679,6 +723,12 @@ void _jit_block_build_cfg(jit_function_t func);
  */
 void _jit_block_clean_cfg(jit_function_t func);
 
+/*
+ * Move cold blocks out of line and lay out the hot paths so that they
+ * fall through, according to the branch weights of the blocks.
+ */
+void _jit_block_layout(jit_function_t func);
+
 /*
  * Compute block postorder for control flow graph depth first traversal.
  */
@@ -47,19 +47,26 @@ straight vanilla ANSI C.
 #if defined(JIT_BACKEND_INTERP)
 
 /*
- * Determine what kind of interpreter dispatch to use.
+ * Label table for the direct threaded interpreter.
  */
-#ifdef HAVE_COMPUTED_GOTO
-	#if defined(PIC) && defined(HAVE_PIC_COMPUTED_GOTO)
-		#define	JIT_INTERP_TOKEN_PIC	1
-	#elif defined(PIC)
-		#define	JIT_INTERP_SWITCH		1
-	#else
-		#define	JIT_INTERP_TOKEN		1
-	#endif
-#else /* !HAVE_COMPUTED_GOTO */
-	#define	JIT_INTERP_SWITCH			1
-#endif /* !HAVE_COMPUTED_GOTO */
+#if defined(JIT_INTERP_DIRECT)
+
+void **_jit_interp_label_table;
+
+int _jit_interp_opcode_for_label(void *label)
+{
+	int opcode;
+	for(opcode = 0; opcode < JIT_INTERP_OP_END_MARKER; ++opcode)
+	{
+		if(jit_interp_label_for_opcode(opcode) == label)
+		{
+			return opcode;
+		}
+	}
+	return JIT_OP_NOP;
+}
+
+#endif /* JIT_INTERP_DIRECT */
 
 /*
  * Modify the program counter and stack pointer.
@@ -191,6 +198,10 @@ straight vanilla ANSI C.
 			((type *)(((jit_item *)args) + VM_NINT_ARG))
 #define	VM_LOC(type)		\
 			((type *)(((jit_item *)frame) + VM_NINT_ARG))
+#define	VM_LOC2(type)		\
+			((type *)(((jit_item *)frame) + VM_NINT_ARG2))
+#define	VM_LOC3(type)		\
+			((type *)(((jit_item *)frame) + VM_NINT_ARG3))
 
 /*
  * Handle the return value from a function that reports a builtin exception.
@@ -321,6 +332,25 @@ void _jit_run_function(jit_function_interp_t func, jit_item *args,
 	/* Define the label table for computed goto dispatch */
 	#include "jit-interp-labels.h"
 
+#if defined(JIT_INTERP_DIRECT)
+	/* Export the label table to the code generator if requested */
+	if(!func)
+	{
+#if defined(JIT_INTERP_TOKEN_PIC)
+		static void *label_table[JIT_INTERP_OP_END_MARKER];
+		for(temparg = 0; temparg < JIT_INTERP_OP_END_MARKER; ++temparg)
+		{
+			label_table[temparg] =
+				&&JIT_OP_NOP_label + main_label_table[temparg];
+		}
+		_jit_interp_label_table = label_table;
+#else
+		_jit_interp_label_table = main_label_table;
+#endif
+		return;
+	}
+#endif
+
 	/* Set up the stack frame for this function */
 	current_frame_size = func->frame_size;
 	frame_base = (jit_item *)alloca(current_frame_size);
@@ -4991,6 +5021,310 @@ restart_tail:
 		}
 		VMBREAK;
 
+		/******************************************************************
+		 * Superinstructions.
+		 ******************************************************************/
+
+		VMCASE(JIT_INTERP_OP_IADD_LLL):
+		{
+			/* Add two 32-bit integer locals into a local */
+			*VM_LOC(jit_int) = *VM_LOC2(jit_int) + *VM_LOC3(jit_int);
+			VM_MODIFY_PC(4);
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_IADD_LLC):
+		{
+			/* Add a 32-bit integer local and a constant into a local */
+			*VM_LOC(jit_int) = *VM_LOC2(jit_int) + (jit_int)VM_NINT_ARG3;
+			VM_MODIFY_PC(4);
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_ISUB_LLL):
+		{
+			/* Subtract two 32-bit integer locals into a local */
+			*VM_LOC(jit_int) = *VM_LOC2(jit_int) - *VM_LOC3(jit_int);
+			VM_MODIFY_PC(4);
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_ISUB_LLC):
+		{
+			/* Subtract a constant from a 32-bit integer local into a local */
+			*VM_LOC(jit_int) = *VM_LOC2(jit_int) - (jit_int)VM_NINT_ARG3;
+			VM_MODIFY_PC(4);
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_COPY_INT_LL):
+		{
+			/* Copy a 32-bit integer local into another local */
+			*VM_LOC(jit_int) = *VM_LOC2(jit_int);
+			VM_MODIFY_PC(3);
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_COPY_INT_LC):
+		{
+			/* Copy a 32-bit integer constant into a local */
+			*VM_LOC(jit_int) = (jit_int)VM_NINT_ARG2;
+			VM_MODIFY_PC(3);
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IFALSE_L):
+		{
+			/* Branch if a 32-bit integer local is false */
+			if(*VM_LOC2(jit_int) == 0)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(3);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ITRUE_L):
+		{
+			/* Branch if a 32-bit integer local is true */
+			if(*VM_LOC2(jit_int) != 0)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(3);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IEQ_LL):
+		{
+			/* Branch if signed 32-bit integer locals are equal */
+			if(*VM_LOC2(jit_int) == *VM_LOC3(jit_int))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IEQ_LC):
+		{
+			/* Branch if signed 32-bit local is equal to a constant */
+			if(*VM_LOC2(jit_int) == (jit_int)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_INE_LL):
+		{
+			/* Branch if signed 32-bit integer locals are not equal */
+			if(*VM_LOC2(jit_int) != *VM_LOC3(jit_int))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_INE_LC):
+		{
+			/* Branch if signed 32-bit local is not equal to a constant */
+			if(*VM_LOC2(jit_int) != (jit_int)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ILT_LL):
+		{
+			/* Branch if signed 32-bit integer locals are less than */
+			if(*VM_LOC2(jit_int) < *VM_LOC3(jit_int))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ILT_LC):
+		{
+			/* Branch if signed 32-bit local is less than a constant */
+			if(*VM_LOC2(jit_int) < (jit_int)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ILT_UN_LL):
+		{
+			/* Branch if unsigned 32-bit integer locals are less than */
+			if(*VM_LOC2(jit_uint) < *VM_LOC3(jit_uint))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ILT_UN_LC):
+		{
+			/* Branch if unsigned 32-bit local is less than a constant */
+			if(*VM_LOC2(jit_uint) < (jit_uint)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ILE_LL):
+		{
+			/* Branch if signed 32-bit integer locals are less than or equal */
+			if(*VM_LOC2(jit_int) <= *VM_LOC3(jit_int))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_ILE_LC):
+		{
+			/* Branch if signed 32-bit local is less than or equal to a constant */
+			if(*VM_LOC2(jit_int) <= (jit_int)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IGT_LL):
+		{
+			/* Branch if signed 32-bit integer locals are greater than */
+			if(*VM_LOC2(jit_int) > *VM_LOC3(jit_int))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IGT_LC):
+		{
+			/* Branch if signed 32-bit local is greater than a constant */
+			if(*VM_LOC2(jit_int) > (jit_int)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IGE_LL):
+		{
+			/* Branch if signed 32-bit integer locals are greater than or equal */
+			if(*VM_LOC2(jit_int) >= *VM_LOC3(jit_int))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IGE_LC):
+		{
+			/* Branch if signed 32-bit local is greater than or equal to a constant */
+			if(*VM_LOC2(jit_int) >= (jit_int)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IGE_UN_LL):
+		{
+			/* Branch if unsigned 32-bit integer locals are greater than or equal */
+			if(*VM_LOC2(jit_uint) >= *VM_LOC3(jit_uint))
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
+		VMCASE(JIT_INTERP_OP_BR_IGE_UN_LC):
+		{
+			/* Branch if unsigned 32-bit local is greater than or equal to a constant */
+			if(*VM_LOC2(jit_uint) >= (jit_uint)VM_NINT_ARG3)
+			{
+				pc = VM_BR_TARGET;
+			}
+			else
+			{
+				VM_MODIFY_PC(4);
+			}
+		}
+		VMBREAK;
+
 		/******************************************************************
 		 * Debugging support.
 		 ******************************************************************/
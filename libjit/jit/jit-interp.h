@@ -90,6 +90,53 @@ struct jit_function_interp
 #define	jit_function_interp_entry_pc(info)	\
 			((void **)(((unsigned char *)(info)) + jit_function_interp_size))
 
+/*
+ * Determine what kind of interpreter dispatch to use.  When computed
+ * goto's are available, the code is direct threaded: the opcodes in the
+ * instruction stream are replaced by the addresses of their handlers.
+ */
+#ifdef HAVE_COMPUTED_GOTO
+	#if defined(PIC) && defined(HAVE_PIC_COMPUTED_GOTO)
+		#define	JIT_INTERP_TOKEN_PIC	1
+	#elif defined(PIC)
+		#define	JIT_INTERP_SWITCH		1
+	#else
+		#define	JIT_INTERP_TOKEN		1
+	#endif
+	#if !defined(JIT_INTERP_SWITCH) && !defined(JIT_INTERP_NO_DIRECT)
+		#define	JIT_INTERP_DIRECT		1
+	#endif
+#else /* !HAVE_COMPUTED_GOTO */
+	#define	JIT_INTERP_SWITCH			1
+#endif /* !HAVE_COMPUTED_GOTO */
+
+/*
+ * Label table that is exported by "_jit_run_function" for the direct
+ * threaded interpreter, and the macro that the code generator uses to
+ * get the handler address for an opcode.
+ */
+#if defined(JIT_INTERP_DIRECT)
+
+extern void **_jit_interp_label_table;
+
+#define	jit_interp_label_for_opcode(opcode)	\
+			(_jit_interp_label_table[(opcode)])
+
+/*
+ * Get the opcode that corresponds to a label address in direct
+ * threaded code.  This is only used to disassemble the code.
+ */
+int _jit_interp_opcode_for_label(void *label);
+
+#endif /* JIT_INTERP_DIRECT */
+
+/*
+ * Run an interpreted function.  If "func" is NULL, then export the
+ * label table of the direct threaded interpreter instead.
+ */
+void _jit_run_function(jit_function_interp_t func, jit_item *args,
+					   jit_item *return_area);
+
 #ifdef	__cplusplus
 };
 #endif
@@ -74,6 +74,24 @@ struct jit_cache_page
 	long			factor;		/* Page size factor */
 };
 
+/*
+ * Structure of a code arena.  Every thread that writes to the cache
+ * gets an arena of its own, so that several functions may be written
+ * at the same time.  When the thread exits, its arena is orphaned and
+ * handed to the next thread that needs one.
+ */
+typedef struct jit_cache_arena *jit_cache_arena_t;
+struct jit_cache_arena
+{
+	struct jit_thread_resource resource;	/* Thread that owns the arena */
+	unsigned char		*free_start;	/* Current start of the free region */
+	unsigned char		*free_end;	/* Current end of the free region */
+	unsigned char		*prev_start;	/* Previous start of the free region */
+	unsigned char		*prev_end;	/* Previous end of the free region */
+	jit_cache_node_t	node;		/* Information for the current function */
+	jit_cache_arena_t	next;		/* Next arena in the cache */
+};
+
 /*
  * Structure of the method cache.
  */
@@ -86,11 +104,7 @@ struct jit_cache
 	unsigned long		pageSize;	/* Default size of a page for allocation */
 	unsigned int		maxPageFactor;	/* Maximum page size factor */
 	long			pagesLeft;	/* Number of pages left to allocate */
-	unsigned char		*free_start;	/* Current start of the free region */
-	unsigned char		*free_end;	/* Current end of the free region */
-	unsigned char		*prev_start;	/* Previous start of the free region */
-	unsigned char		*prev_end;	/* Previous end of the free region */
-	jit_cache_node_t	node;		/* Information for the current function */
+	jit_cache_arena_t	arenas;		/* Per-thread code arenas */
 	struct jit_cache_node	head;		/* Head of the lookup tree */
 	struct jit_cache_node	nil;		/* Nil pointer for the lookup tree */
 };
@@ -119,13 +133,13 @@ struct jit_cache
 	((node)->left = (jit_cache_node_t)(((jit_nuint)(node)->left) & ~((jit_nuint)1)))
 
 void _jit_cache_destroy(jit_cache_t cache);
-void * _jit_cache_alloc_data(jit_cache_t cache, unsigned long size, unsigned long align);
 
 /*
- * Allocate a cache page and add it to the cache.
+ * Allocate a cache page, add it to the cache and make it the
+ * working region of an arena.
  */
 static void
-AllocCachePage(jit_cache_t cache, int factor)
+AllocCachePage(jit_cache_t cache, jit_cache_arena_t arena, int factor)
 {
 	long num;
 	unsigned char *ptr;
@@ -182,8 +196,8 @@ AllocCachePage(jit_cache_t cache, int factor)
 		{
 			_jit_free_exec(ptr, cache->pageSize * factor);
 		failAlloc:
-			cache->free_start = 0;
-			cache->free_end = 0;
+			arena->free_start = 0;
+			arena->free_end = 0;
 			return;
 		}
 
@@ -201,8 +215,74 @@ AllocCachePage(jit_cache_t cache, int factor)
 	}
 
 	/* Set up the working region within the new page */
-	cache->free_start = ptr;
-	cache->free_end = ptr + (int) cache->pageSize * factor;
+	arena->free_start = ptr;
+	arena->free_end = ptr + (int) cache->pageSize * factor;
+}
+
+/*
+ * Get the arena of the calling thread, creating it if necessary.
+ * The caller must hold the memory context lock.  The global lock is
+ * also taken because exiting threads orphan their arenas under it.
+ */
+static jit_cache_arena_t
+GetArena(jit_cache_t cache)
+{
+	jit_thread_control_t self;
+	jit_cache_arena_t arena;
+	jit_cache_arena_t orphan;
+
+	self = _jit_thread_get_control();
+	if(!self)
+	{
+		return 0;
+	}
+	orphan = 0;
+	jit_mutex_lock(&_jit_global_lock);
+	for(arena = cache->arenas; arena != 0; arena = arena->next)
+	{
+		if(arena->resource.owner == self)
+		{
+			jit_mutex_unlock(&_jit_global_lock);
+			return arena;
+		}
+		if(!orphan && !(arena->resource.owner))
+		{
+			orphan = arena;
+		}
+	}
+
+	/* This is the first time the thread uses the cache.  Take over
+	   the arena of a thread that has exited, if there is one */
+	if(orphan)
+	{
+		/* Discard any function that was left unfinished */
+		if(orphan->node)
+		{
+			orphan->free_start = orphan->prev_start;
+			orphan->free_end = orphan->prev_end;
+			orphan->node = 0;
+		}
+		_jit_thread_claim_resource(&(orphan->resource));
+		jit_mutex_unlock(&_jit_global_lock);
+		return orphan;
+	}
+
+	/* Create a new arena */
+	arena = jit_cnew(struct jit_cache_arena);
+	if(!arena)
+	{
+		jit_mutex_unlock(&_jit_global_lock);
+		return 0;
+	}
+	_jit_thread_claim_resource(&(arena->resource));
+	jit_mutex_unlock(&_jit_global_lock);
+	arena->next = cache->arenas;
+	cache->arenas = arena;
+
+	/* Give the arena a page of its own.  If this fails then the
+	   arena is left empty, which is reported as a full cache */
+	AllocCachePage(cache, arena, 0);
+	return arena;
 }
 
 /*
@@ -366,6 +446,7 @@ jit_cache_t
 _jit_cache_create(jit_context_t context)
 {
 	jit_cache_t cache;
+	jit_cache_arena_t arena;
 	long limit, cache_page_size;
 	int max_page_factor;
 	unsigned long exec_page_size;
@@ -410,8 +491,7 @@ _jit_cache_create(jit_context_t context)
 	cache->maxNumPages = 0;
 	cache->pageSize = cache_page_size;
 	cache->maxPageFactor = max_page_factor;
-	cache->free_start = 0;
-	cache->free_end = 0;
+	cache->arenas = 0;
 	if(limit > 0)
 	{
 		cache->pagesLeft = limit / cache_page_size;
@@ -424,7 +504,6 @@ _jit_cache_create(jit_context_t context)
 	{
 		cache->pagesLeft = -1;
 	}
-	cache->node = 0;
 	cache->nil.left = &(cache->nil);
 	cache->nil.right = &(cache->nil);
 	cache->nil.func = 0;
@@ -432,9 +511,9 @@ _jit_cache_create(jit_context_t context)
 	cache->head.right = &(cache->nil);
 	cache->head.func = 0;
 
-	/* Allocate the initial cache page */
-	AllocCachePage(cache, 0);
-	if(!cache->free_start)
+	/* Allocate the initial cache page for the creating thread */
+	arena = GetArena(cache);
+	if(!arena || !arena->free_start)
 	{
 		_jit_cache_destroy(cache);
 		return 0;
@@ -448,6 +527,17 @@ void
 _jit_cache_destroy(jit_cache_t cache)
 {
 	unsigned long page;
+	jit_cache_arena_t arena;
+
+	/* Free all of the arenas, detaching them from their threads */
+	jit_mutex_lock(&_jit_global_lock);
+	while((arena = cache->arenas) != 0)
+	{
+		cache->arenas = arena->next;
+		_jit_thread_release_resource(&(arena->resource));
+		jit_free(arena);
+	}
+	jit_mutex_unlock(&_jit_global_lock);
 
 	/* Free all of the cache pages */
 	for(page = 0; page < cache->numPages; ++page)
@@ -467,39 +557,54 @@ _jit_cache_destroy(jit_cache_t cache)
 void
 _jit_cache_extend(jit_cache_t cache, int count)
 {
+	jit_cache_arena_t arena;
+	unsigned long page;
+	struct jit_cache_page *p;
+
 	/* Compute the page size factor */
 	int factor = 1 << count;
 
 	/* Bail out if there is a started function */
-	if(cache->node)
+	arena = GetArena(cache);
+	if(!arena || arena->node)
 	{
 		return;
 	}
 
 	/* If we had a newly allocated page then it has to be freed
-	   to let allocate another new page of appropriate size. */
-	struct jit_cache_page *p = &cache->pages[cache->numPages - 1];
-	if((cache->free_start == ((unsigned char *)p->page))
-	   && (cache->free_end == (cache->free_start + cache->pageSize * p->factor)))
+	   to let allocate another new page of appropriate size.  Other
+	   arenas may have allocated pages since, so look the page up */
+	for(page = cache->numPages; page > 0 && arena->free_start; --page)
 	{
-		_jit_free_exec(p->page, cache->pageSize * p->factor);
-
-		--(cache->numPages);
-		if(cache->pagesLeft >= 0)
+		p = &cache->pages[page - 1];
+		if(arena->free_start != ((unsigned char *)p->page))
 		{
-			cache->pagesLeft += p->factor;
+			continue;
 		}
-		cache->free_start = 0;
-		cache->free_end = 0;
-
-		if(factor <= p->factor)
+		if(arena->free_end == (arena->free_start + cache->pageSize * p->factor))
 		{
-			factor = p->factor << 1;
+			_jit_free_exec(p->page, cache->pageSize * p->factor);
+
+			if(cache->pagesLeft >= 0)
+			{
+				cache->pagesLeft += p->factor;
+			}
+			arena->free_start = 0;
+			arena->free_end = 0;
+
+			if(factor <= p->factor)
+			{
+				factor = p->factor << 1;
+			}
+
+			--(cache->numPages);
+			*p = cache->pages[cache->numPages];
 		}
+		break;
 	}
 
 	/* Allocate a new page now */
-	AllocCachePage(cache, factor);
+	AllocCachePage(cache, arena, factor);
 }
 
 jit_function_t
@@ -514,39 +619,67 @@ _jit_cache_free_function(jit_cache_t cache, jit_function_t func)
 	jit_free(func);
 }
 
+/*
+ * Allocate data from the top of an arena's free region.
+ */
+static void *
+alloc_data(jit_cache_arena_t arena, unsigned long size, unsigned long align)
+{
+	unsigned char *ptr;
+
+	/* Get memory from the top of the free region, so that it does not
+	   overlap with the function code possibly being written at the bottom
+	   of the free region */
+	ptr = arena->free_end - size;
+	ptr = (unsigned char *) (((jit_nuint) ptr) & ~(align - 1));
+	if(ptr < arena->free_start)
+	{
+		/* When we aligned the block, it caused an overflow */
+		return 0;
+	}
+
+	/* Allocate the block and return it */
+	arena->free_end = ptr;
+	return ptr;
+}
+
 int
 _jit_cache_start_function(jit_cache_t cache, jit_function_t func)
 {
+	jit_cache_arena_t arena;
+
 	/* Bail out if there is a started function already */
-	if(cache->node)
+	arena = GetArena(cache);
+	if(!arena || arena->node)
 	{
 		return JIT_MEMORY_ERROR;
 	}
 
 	/* Bail out if the cache is already full */
-	if(!cache->free_start)
+	if(!arena->free_start)
 	{
 		return JIT_MEMORY_TOO_BIG;
 	}
 
 	/* Save the cache position */
-	cache->prev_start = cache->free_start;
-	cache->prev_end = cache->free_end;
+	arena->prev_start = arena->free_start;
+	arena->prev_end = arena->free_end;
 
 	/* Allocate a new cache node */
-	cache->node = _jit_cache_alloc_data(
-		cache, sizeof(struct jit_cache_node), sizeof(void *));
-	if(!cache->node)
+	arena->node = alloc_data(
+		arena, sizeof(struct jit_cache_node), sizeof(void *));
+	if(!arena->node)
 	{
-		return JIT_MEMORY_TOO_BIG;
+		/* The arena is almost exhausted, a new page may help */
+		return JIT_MEMORY_RESTART;
 	}
-	cache->node->func = func;
+	arena->node->func = func;
 
 	/* Initialize the function information */
-	cache->node->start = cache->free_start;
-	cache->node->end = 0;
-	cache->node->left = 0;
-	cache->node->right = 0;
+	arena->node->start = arena->free_start;
+	arena->node->end = 0;
+	arena->node->left = 0;
+	arena->node->right = 0;
 
 	return JIT_MEMORY_OK;
 }
@@ -554,8 +687,11 @@ _jit_cache_start_function(jit_cache_t cache, jit_function_t func)
 int
 _jit_cache_end_function(jit_cache_t cache, int result)
 {
+	jit_cache_arena_t arena;
+
 	/* Bail out if there is no started function */
-	if(!cache->node)
+	arena = GetArena(cache);
+	if(!arena || !arena->node)
 	{
 		return JIT_MEMORY_ERROR;
 	}
@@ -564,17 +700,18 @@ _jit_cache_end_function(jit_cache_t cache, int result)
 	if(result != JIT_MEMORY_OK)
 	{
 		/* Restore the saved cache position */
-		cache->free_start = cache->prev_start;
-		cache->free_end = cache->prev_end;
-		cache->node = 0;
+		arena->free_start = arena->prev_start;
+		arena->free_end = arena->prev_end;
+		arena->node = 0;
 
 		return JIT_MEMORY_RESTART;
 	}
 
-	/* Update the method region block and then add it to the lookup tree */
-	cache->node->end = cache->free_start;
-	AddToLookupTree(cache, cache->node);
-	cache->node = 0;
+	/* Update the method region block and then publish it in the
+	   lookup tree that is shared by all of the arenas */
+	arena->node->end = arena->free_start;
+	AddToLookupTree(cache, arena->node);
+	arena->node = 0;
 
 	/* The method is ready to go */
 	return JIT_MEMORY_OK;
@@ -583,90 +720,93 @@ _jit_cache_end_function(jit_cache_t cache, int result)
 void *
 _jit_cache_get_code_break(jit_cache_t cache)
 {
+	jit_cache_arena_t arena;
+
 	/* Bail out if there is no started function */
-	if(!cache->node)
+	arena = GetArena(cache);
+	if(!arena || !arena->node)
 	{
 		return 0;
 	}
 
 	/* Return the address of the available code area */
-	return cache->free_start;
+	return arena->free_start;
 }
 
 void
 _jit_cache_set_code_break(jit_cache_t cache, void *ptr)
 {
+	jit_cache_arena_t arena;
+
 	/* Bail out if there is no started function */
-	if(!cache->node)
+	arena = GetArena(cache);
+	if(!arena || !arena->node)
 	{
 		return;
 	}
 	/* Sanity checks */
-	if((unsigned char *) ptr < cache->free_start)
+	if((unsigned char *) ptr < arena->free_start)
 	{
 		return;
 	}
-	if((unsigned char *) ptr > cache->free_end)
+	if((unsigned char *) ptr > arena->free_end)
 	{
 		return;
 	}
 
 	/* Update the address of the available code area */
-	cache->free_start = ptr;
+	arena->free_start = ptr;
 }
 
 void *
 _jit_cache_get_code_limit(jit_cache_t cache)
 {
+	jit_cache_arena_t arena;
+
 	/* Bail out if there is no started function */
-	if(!cache->node)
+	arena = GetArena(cache);
+	if(!arena || !arena->node)
 	{
 		return 0;
 	}
 
 	/* Return the end address of the available code area */
-	return cache->free_end;
+	return arena->free_end;
 }
 
 void *
 _jit_cache_alloc_data(jit_cache_t cache, unsigned long size, unsigned long align)
 {
-	unsigned char *ptr;
+	jit_cache_arena_t arena;
 
-	/* Get memory from the top of the free region, so that it does not
-	   overlap with the function code possibly being written at the bottom
-	   of the free region */
-	ptr = cache->free_end - size;
-	ptr = (unsigned char *) (((jit_nuint) ptr) & ~(align - 1));
-	if(ptr < cache->free_start)
+	arena = GetArena(cache);
+	if(!arena)
 	{
-		/* When we aligned the block, it caused an overflow */
 		return 0;
 	}
-
-	/* Allocate the block and return it */
-	cache->free_end = ptr;
-	return ptr;
+	return alloc_data(arena, size, align);
 }
 
 static void *
 alloc_code(jit_cache_t cache, unsigned int size, unsigned int align)
 {
+	jit_cache_arena_t arena;
 	unsigned char *ptr;
 
 	/* Bail out if there is a started function */
-	if(cache->node)
+	arena = GetArena(cache);
+	if(!arena || arena->node)
 	{
 		return 0;
 	}
 	/* Bail out if there is no cache available */
-	if(!cache->free_start)
+	if(!arena->free_start)
 	{
 		return 0;
 	}
 
 	/* Allocate aligned memory. */
-	ptr = cache->free_start;
+	ptr = arena->free_start;
 	if(align > 1)
 	{
 		jit_nuint p = ((jit_nuint) ptr + align - 1) & ~(align - 1);
@@ -674,19 +814,19 @@ alloc_code(jit_cache_t cache, unsigned int size, unsigned int align)
 	}
 
 	/* Do we need to allocate a new cache page? */
-	if((ptr + size) > cache->free_end)
+	if((ptr + size) > arena->free_end)
 	{
 		/* Allocate a new page */
-		AllocCachePage(cache, 0);
+		AllocCachePage(cache, arena, 0);
 
 		/* Bail out if the cache is full */
-		if(!cache->free_start)
+		if(!arena->free_start)
 		{
 			return 0;
 		}
 
 		/* Allocate memory from the new page */
-		ptr = cache->free_start;
+		ptr = arena->free_start;
 		if(align > 1)
 		{
 			jit_nuint p = ((jit_nuint) ptr + align - 1) & ~(align - 1);
@@ -695,7 +835,7 @@ alloc_code(jit_cache_t cache, unsigned int size, unsigned int align)
 	}
 
 	/* Allocate the block and return it */
-	cache->free_start = ptr + size;
+	arena->free_start = ptr + size;
 	return (void *) ptr;
 }
 
@@ -1002,10 +1142,19 @@ as auxiliary data, attached to the jit_cache_method block.
 Threading issues
 ----------------
 
-Writing a method to the cache, querying a method by address, or querying
-offset information for a method, are not thread-safe.  The caller should
-arrange for a cache lock to be acquired prior to performing these
-operations.
+Each thread writes methods into an arena of its own.  An arena is a
+free region carved out of a cache page that belongs to that thread
+alone, so the code of a method being translated by one thread never
+shares a page region with another thread's method.  Page allocation,
+the arena list and the lookup tree are shared by all of the threads.
+
+The cache functions themselves are not thread-safe.  The caller should
+arrange for a cache lock to be acquired around each call.  However,
+the lock does not need to be held while the code is being written
+between _jit_cache_start_method and _jit_cache_end_method, because
+nothing else writes to the thread's arena in the meantime.  The method
+becomes visible to lookups when _jit_cache_end_method adds it to the
+lookup tree.
 
 Executing methods from the cache is thread-safe, as the method code is
 fixed in place once it has been written.
@@ -1024,14 +1173,13 @@ to a starting address for execution:
 
 	Look in "jit_function_t" to see if we already have a starting address.
 		If so, then bail out.
-	Acquire the cache lock.
-	Check again to see if we already have a starting address, just
-		in case another thread got here first.  If so, then release
-		the cache lock and bail out.
+	Mark the method as being translated by this thread.  If another
+		thread got here first, then wait for it to finish and bail out.
+	Acquire the cache lock, start the method and release the lock.
 	Translate the method.
+	Acquire the cache lock, end the method and release the lock.
 	Update the "jit_function_t" structure to contain the starting address.
 	Force a CPU cache line flush.
-	Release the cache lock.
 
 Why aren't methods flushed when the cache fills up?
 ---------------------------------------------------
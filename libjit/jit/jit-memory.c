@@ -55,12 +55,19 @@ _jit_memory_destroy(jit_context_t context)
 void *
 _jit_memory_find_function_info(jit_context_t context, void *pc)
 {
+	void *func_info;
+
 	if(!context->memory_context)
 	{
 		return 0;
 	}
-	/* TODO: read lock? */
-	return context->memory_manager->find_function_info(context->memory_context, pc);
+
+	/* The lookup tree is rebalanced when other threads finish compiling
+	   functions, so it must not be walked without the memory lock */
+	_jit_memory_lock(context);
+	func_info = context->memory_manager->find_function_info(context->memory_context, pc);
+	_jit_memory_unlock(context);
+	return func_info;
 }
 
 jit_function_t
@@ -195,10 +195,16 @@ generation is complete.
 	} while (0)
 
 /*
- * Write an interpreter opcode to the cache.
+ * Write an interpreter opcode to the cache.  Direct threaded code
+ * contains the address of the opcode's handler instead of its number.
  */
+#if defined(JIT_INTERP_DIRECT)
+#define	jit_cache_opcode(gen,opcode)	\
+			jit_cache_native((gen), jit_interp_label_for_opcode((opcode)))
+#else
 #define	jit_cache_opcode(gen,opcode)	\
 			jit_cache_native((gen), (jit_nint)(opcode))
+#endif
 
 /*
  * Write "n" bytes to the cache, rounded up to a multiple of "void *".
@@ -233,7 +239,11 @@ generation is complete.
 @*/
 void _jit_init_backend(void)
 {
-	/* Nothing to do here for the interpreter */
+#if defined(JIT_INTERP_DIRECT)
+	/* Fetch the label table that is needed to generate direct
+	   threaded code from the interpreter */
+	_jit_run_function(0, 0, 0);
+#endif
 }
 
 /*@
@@ -1032,6 +1042,227 @@ store_value(jit_gencode_t gen, jit_value_t value)
 	jit_cache_native(gen, offset);
 }
 
+/*
+ * Get the frame offset of a value if it is a 32-bit integer local
+ * variable, or -1 if it is not.
+ */
+static jit_nint
+int_local_offset(jit_value_t value)
+{
+	int kind;
+
+	if(!value || value->is_constant)
+	{
+		return -1;
+	}
+	kind = jit_type_normalize(value->type)->kind;
+	if(kind != JIT_TYPE_INT && kind != JIT_TYPE_UINT)
+	{
+		return -1;
+	}
+	_jit_gen_fix_value(value);
+	if(value->frame_offset < 0)
+	{
+		return -1;
+	}
+	return value->frame_offset;
+}
+
+/*
+ * Determine if a value is a 32-bit integer constant.
+ */
+static int
+is_int_constant(jit_value_t value)
+{
+	int kind;
+
+	if(!value || !value->is_constant)
+	{
+		return 0;
+	}
+	kind = jit_type_normalize(value->type)->kind;
+	return (kind == JIT_TYPE_INT || kind == JIT_TYPE_UINT);
+}
+
+/*
+ * Output the target of the branch instruction that starts at "pc".
+ */
+static void
+output_branch_target(jit_gencode_t gen, jit_block_t block, void **pc)
+{
+	if(block->address)
+	{
+		/* We already know the address of the block */
+		jit_cache_native(gen, ((void **)(block->address)) - pc);
+	}
+	else
+	{
+		/* Record this position on the block's fixup list */
+		jit_cache_native(gen, block->fixup_list);
+		block->fixup_list = (void *)pc;
+	}
+}
+
+/*
+ * Output a superinstruction for "insn" if it has one of the forms that
+ * are frequent enough to have their own opcodes: integer additions and
+ * subtractions, copies and comparison branches whose operands are locals
+ * or constants.  Returns zero if "insn" should be output normally.
+ */
+static int
+output_superinsn(jit_gencode_t gen, jit_function_t func, jit_insn_t insn)
+{
+	jit_block_t block;
+	jit_nint dest;
+	jit_nint value1;
+	jit_nint value2;
+	int opcode;
+	void **pc;
+
+	switch(insn->opcode)
+	{
+	case JIT_OP_IADD:
+	case JIT_OP_ISUB:
+		dest = int_local_offset(insn->dest);
+		value1 = int_local_offset(insn->value1);
+		if(dest < 0 || value1 < 0)
+		{
+			return 0;
+		}
+		if(is_int_constant(insn->value2))
+		{
+			opcode = (insn->opcode == JIT_OP_IADD
+				  ? JIT_INTERP_OP_IADD_LLC : JIT_INTERP_OP_ISUB_LLC);
+			value2 = (jit_nint)(insn->value2->address);
+		}
+		else
+		{
+			opcode = (insn->opcode == JIT_OP_IADD
+				  ? JIT_INTERP_OP_IADD_LLL : JIT_INTERP_OP_ISUB_LLL);
+			value2 = int_local_offset(insn->value2);
+			if(value2 < 0)
+			{
+				return 0;
+			}
+		}
+		jit_cache_opcode(gen, opcode);
+		jit_cache_native(gen, dest);
+		jit_cache_native(gen, value1);
+		jit_cache_native(gen, value2);
+		return 1;
+
+	case JIT_OP_COPY_INT:
+		dest = int_local_offset(insn->dest);
+		if(dest < 0)
+		{
+			return 0;
+		}
+		if(is_int_constant(insn->value1))
+		{
+			opcode = JIT_INTERP_OP_COPY_INT_LC;
+			value1 = (jit_nint)(insn->value1->address);
+		}
+		else
+		{
+			opcode = JIT_INTERP_OP_COPY_INT_LL;
+			value1 = int_local_offset(insn->value1);
+			if(value1 < 0)
+			{
+				return 0;
+			}
+		}
+		jit_cache_opcode(gen, opcode);
+		jit_cache_native(gen, dest);
+		jit_cache_native(gen, value1);
+		return 1;
+
+	case JIT_OP_BR_IFALSE:
+	case JIT_OP_BR_ITRUE:
+		value1 = int_local_offset(insn->value1);
+		block = jit_block_from_label(func, (jit_label_t)(insn->dest));
+		if(value1 < 0 || !block)
+		{
+			return 0;
+		}
+		if(insn->opcode == JIT_OP_BR_IFALSE)
+		{
+			opcode = JIT_INTERP_OP_BR_IFALSE_L;
+		}
+		else
+		{
+			opcode = JIT_INTERP_OP_BR_ITRUE_L;
+		}
+		pc = (void **)(gen->ptr);
+		jit_cache_opcode(gen, opcode);
+		output_branch_target(gen, block, pc);
+		jit_cache_native(gen, value1);
+		return 1;
+
+	case JIT_OP_BR_IEQ:
+		opcode = JIT_INTERP_OP_BR_IEQ_LL;
+		break;
+
+	case JIT_OP_BR_INE:
+		opcode = JIT_INTERP_OP_BR_INE_LL;
+		break;
+
+	case JIT_OP_BR_ILT:
+		opcode = JIT_INTERP_OP_BR_ILT_LL;
+		break;
+
+	case JIT_OP_BR_ILT_UN:
+		opcode = JIT_INTERP_OP_BR_ILT_UN_LL;
+		break;
+
+	case JIT_OP_BR_ILE:
+		opcode = JIT_INTERP_OP_BR_ILE_LL;
+		break;
+
+	case JIT_OP_BR_IGT:
+		opcode = JIT_INTERP_OP_BR_IGT_LL;
+		break;
+
+	case JIT_OP_BR_IGE:
+		opcode = JIT_INTERP_OP_BR_IGE_LL;
+		break;
+
+	case JIT_OP_BR_IGE_UN:
+		opcode = JIT_INTERP_OP_BR_IGE_UN_LL;
+		break;
+
+	default:
+		return 0;
+	}
+
+	/* Output a comparison branch.  The constant form of each opcode
+	   immediately follows the form that compares two locals */
+	value1 = int_local_offset(insn->value1);
+	block = jit_block_from_label(func, (jit_label_t)(insn->dest));
+	if(value1 < 0 || !block)
+	{
+		return 0;
+	}
+	if(is_int_constant(insn->value2))
+	{
+		++opcode;
+		value2 = (jit_nint)(insn->value2->address);
+	}
+	else
+	{
+		value2 = int_local_offset(insn->value2);
+		if(value2 < 0)
+		{
+			return 0;
+		}
+	}
+	pc = (void **)(gen->ptr);
+	jit_cache_opcode(gen, opcode);
+	output_branch_target(gen, block, pc);
+	jit_cache_native(gen, value1);
+	jit_cache_native(gen, value2);
+	return 1;
+}
+
 /*@
  * @deftypefun void _jit_gen_insn (jit_gencode_t @var{gen}, jit_function_t @var{func}, jit_block_t @var{block}, jit_insn_t @var{insn})
  * Generate native code for the specified @var{insn}.  This function should
@@ -1048,6 +1279,12 @@ void _jit_gen_insn(jit_gencode_t gen, jit_function_t func,
 	jit_nint offset;
 	jit_nint size;
 
+	/* Use a superinstruction if there is one for this instruction */
+	if(output_superinsn(gen, func, insn))
+	{
+		return;
+	}
+
 	switch(insn->opcode)
 	{
 	case JIT_OP_BR_IEQ:
@@ -1124,17 +1361,7 @@ void _jit_gen_insn(jit_gencode_t gen, jit_function_t func,
 		{
 			break;
 		}
-		if(block->address)
-		{
-			/* We already know the address of the block */
-			jit_cache_native(gen, ((void **)(block->address)) - pc);
-		}
-		else
-		{
-			/* Record this position on the block's fixup list */
-			jit_cache_native(gen, block->fixup_list);
-			block->fixup_list = (void *)pc;
-		}
+		output_branch_target(gen, block, pc);
 		break;
 
 	case JIT_OP_CALL_FILTER:
@@ -1189,17 +1416,7 @@ void _jit_gen_insn(jit_gencode_t gen, jit_function_t func,
 		}
 		pc = (void **)(gen->ptr);
 		jit_cache_opcode(gen, insn->opcode);
-		if(block->address)
-		{
-			/* We already know the address of the block */
-			jit_cache_native(gen, ((void **)(block->address)) - pc);
-		}
-		else
-		{
-			/* Record this position on the block's fixup list */
-			jit_cache_native(gen, block->fixup_list);
-			block->fixup_list = (void *)pc;
-		}
+		output_branch_target(gen, block, pc);
 		store_value(gen, insn->dest);
 		break;
 
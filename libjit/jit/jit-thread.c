@@ -48,6 +48,26 @@ jit_mutex_t _jit_global_lock;
  */
 static pthread_key_t control_key;
 
+/*
+ * Free the control object when its thread exits.  Resources that the
+ * thread still holds are orphaned so that other threads can reuse them.
+ */
+static void free_control(void *obj)
+{
+	jit_thread_control_t control = (jit_thread_control_t)obj;
+	jit_thread_resource_t resource;
+
+	jit_mutex_lock(&_jit_global_lock);
+	while((resource = control->resources) != 0)
+	{
+		control->resources = resource->next;
+		resource->owner = 0;
+		resource->next = 0;
+	}
+	jit_mutex_unlock(&_jit_global_lock);
+	jit_free(control);
+}
+
 /*
  * Initialize the pthread support routines.  Only called once.
  */
@@ -58,7 +78,7 @@ static void init_pthread(void)
 	/* Allocate a thread-specific variable for the JIT's thread
 	   control object, and arrange for it to be freed when the
 	   thread exits or is otherwise terminated */
-	pthread_key_create(&control_key, jit_free);
+	pthread_key_create(&control_key, free_control);
 }
 
 #elif defined(JIT_THREADS_WIN32)
@@ -149,6 +169,51 @@ jit_thread_control_t _jit_thread_get_control(void)
 	return control;
 }
 
+void _jit_thread_claim_resource(jit_thread_resource_t resource)
+{
+	jit_thread_control_t control = _jit_thread_get_control();
+	resource->owner = control;
+	if(control)
+	{
+		resource->next = control->resources;
+		control->resources = resource;
+	}
+}
+
+void _jit_thread_release_resource(jit_thread_resource_t resource)
+{
+	jit_thread_resource_t *prev;
+	if(resource->owner)
+	{
+		prev = &(resource->owner->resources);
+		while(*prev != 0 && *prev != resource)
+		{
+			prev = &((*prev)->next);
+		}
+		if(*prev)
+		{
+			*prev = resource->next;
+		}
+		resource->owner = 0;
+		resource->next = 0;
+	}
+}
+
+#if !(defined(__GNUC__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)) && \
+	!defined(JIT_THREADS_WIN32)
+
+unsigned int _jit_atomic_add(unsigned int *ptr, int delta)
+{
+	unsigned int value;
+	_jit_thread_init();
+	jit_mutex_lock(&_jit_global_lock);
+	value = (*ptr += delta);
+	jit_mutex_unlock(&_jit_global_lock);
+	return value;
+}
+
+#endif
+
 jit_thread_id_t _jit_thread_current_id(void)
 {
 #if defined(JIT_THREADS_PTHREAD)
@@ -111,6 +111,45 @@ typedef int jit_mutex_t;
  */
 extern jit_mutex_t _jit_global_lock;
 
+/*
+ * Atomically add to a reference count and return the new value.
+ */
+#if defined(__GNUC__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)
+#define	jit_atomic_add(ptr,delta)	(__sync_add_and_fetch((ptr), (delta)))
+#elif defined(JIT_THREADS_WIN32)
+#define	jit_atomic_add(ptr,delta)	\
+		((unsigned int)InterlockedExchangeAdd((LONG volatile *)(ptr), \
+											  (delta)) + (delta))
+#else
+unsigned int _jit_atomic_add(unsigned int *ptr, int delta);
+#define	jit_atomic_add(ptr,delta)	(_jit_atomic_add((ptr), (delta)))
+#endif
+
+/*
+ * A resource that is held by a thread, such as a code cache arena.
+ * When the thread exits, its resources are orphaned by clearing their
+ * owner, so that other threads may claim them.  The fields are protected
+ * by the global lock.
+ */
+typedef struct jit_thread_resource *jit_thread_resource_t;
+struct jit_thread_resource
+{
+	jit_thread_control_t	owner;		/* Thread that holds the resource */
+	jit_thread_resource_t	next;		/* Next resource of the same thread */
+};
+
+/*
+ * Make the current thread the owner of a resource.  The caller must
+ * hold the global lock.
+ */
+void _jit_thread_claim_resource(jit_thread_resource_t resource);
+
+/*
+ * Remove a resource from its owner, if any.  The caller must hold
+ * the global lock.
+ */
+void _jit_thread_release_resource(jit_thread_resource_t resource);
+
 /*
  * Define the primitive monitor operations.
  */
@@ -433,7 +433,7 @@ jit_type_t jit_type_copy(jit_type_t type)
 	{
 		return type;
 	}
-	++(type->ref_count);
+	jit_atomic_add(&(type->ref_count), 1);
 	return type;
 }
 
@@ -451,7 +451,7 @@ void jit_type_free(jit_type_t type)
 	{
 		return;
 	}
-	if(--(type->ref_count) != 0)
+	if(jit_atomic_add(&(type->ref_count), -1) != 0)
 	{
 		return;
 	}
@@ -161,11 +161,18 @@ echo '};'
 echo ''
 
 # Output the helper macros (PIC).
+echo '#if defined(JIT_INTERP_DIRECT)'
+echo '#define VMSWITCH(pc)        { goto *((pc)[0]);'
+echo '#define VMSWITCHEND         }'
+echo '#define VMCASE(val)         val##_label'
+echo '#define VMBREAK             goto *((pc)[0])'
+echo '#else'
 echo '#define VMSWITCH(pc)        { goto *(&&JIT_OP_NOP_label + main_label_table[VMFETCH((pc))]);'
 echo '#define VMSWITCHEND         }'
 echo '#define VMCASE(val)         val##_label'
 echo '#define VMBREAK             \
             goto *(&&JIT_OP_NOP_label + main_label_table[VMFETCH((pc))])'
+echo '#endif'
 echo ''
 
 # Now to handle the non-PIC case of using computed goto's.
@@ -279,11 +286,18 @@ echo '};'
 echo ''
 
 # Output the helper macros (non-PIC).
+echo '#if defined(JIT_INTERP_DIRECT)'
+echo '#define VMSWITCH(pc)        { goto *((pc)[0]);'
+echo '#define VMSWITCHEND         }'
+echo '#define VMCASE(val)         val##_label'
+echo '#define VMBREAK             goto *((pc)[0])'
+echo '#else'
 echo '#define VMSWITCH(pc)        { goto *main_label_table[VMFETCH((pc))];'
 echo '#define VMSWITCHEND         }'
 echo '#define VMCASE(val)         val##_label'
 echo '#define VMBREAK             \
             goto *main_label_table[VMFETCH((pc))]'
+echo '#endif'
 echo ''
 
 # Output the non-goto case of the helper macros.
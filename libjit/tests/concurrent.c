@@ -0,0 +1,208 @@
+/*
+ * concurrent.c - Compile and run functions from several threads at once.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * The libjit library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * The libjit library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the libjit library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+
+Several threads share one context.  Each of them builds and compiles
+functions of its own, runs them, looks them up again by their entry
+point and also calls a set of shared functions that are compiled on
+demand by whichever thread reaches them first.  The threads are started
+in several waves, so that the code arenas of exited threads are reused.
+
+The program exits with a non-zero status if any result is wrong, and
+with status 77 (skipped) if libjit was built without thread support.
+
+*/
+
+#include "config.h"
+#include <jit/jit.h>
+#include <stdio.h>
+#if defined(HAVE_PTHREAD_H) && defined(HAVE_LIBPTHREAD)
+#include <pthread.h>
+#define	HAVE_THREADS	1
+#endif
+
+#ifdef HAVE_THREADS
+
+#define	NUM_WAVES		4
+#define	NUM_THREADS		8
+#define	NUM_FUNCS		100
+#define	NUM_SHARED		32
+
+static jit_context_t context;
+static jit_type_t signature;
+static jit_function_t helper;
+static jit_function_t shared[NUM_SHARED];
+static pthread_mutex_t error_lock = PTHREAD_MUTEX_INITIALIZER;
+static int errors;
+
+static void error(const char *msg, jit_int x, jit_int y, jit_int result)
+{
+	pthread_mutex_lock(&error_lock);
+	printf("%s: x = %d, y = %d, result = %d\n",
+		   msg, (int)x, (int)y, (int)result);
+	++errors;
+	pthread_mutex_unlock(&error_lock);
+}
+
+/*
+ * The helper returns "x * y".
+ */
+static int build_helper(jit_function_t func)
+{
+	jit_value_t x = jit_value_get_param(func, 0);
+	jit_value_t y = jit_value_get_param(func, 1);
+	jit_insn_return(func, jit_insn_mul(func, x, y));
+	return JIT_RESULT_OK;
+}
+
+/*
+ * The test functions return "helper(x, y) + x - 1", going through
+ * a floating-point conversion and a call to exercise more of the
+ * code generator and the shared signature.
+ */
+static int build_func(jit_function_t func)
+{
+	jit_value_t args[2];
+	jit_value_t temp;
+	args[0] = jit_value_get_param(func, 0);
+	args[1] = jit_value_get_param(func, 1);
+	temp = jit_insn_call(func, "helper", helper, 0, args, 2, 0);
+	temp = jit_insn_convert(func, temp, jit_type_float64, 0);
+	temp = jit_insn_add(func, temp, jit_insn_convert
+		(func, args[0], jit_type_float64, 0));
+	temp = jit_insn_sub(func, temp, jit_value_create_float64_constant
+		(func, jit_type_float64, 1.0));
+	jit_insn_return(func, jit_insn_convert(func, temp, jit_type_int, 0));
+	return JIT_RESULT_OK;
+}
+
+static jit_int expected(jit_int x, jit_int y)
+{
+	return x * y + x - 1;
+}
+
+static void *worker(void *arg)
+{
+	jit_int id = (jit_int)(jit_nint)arg;
+	jit_function_t func;
+	jit_int x, y, result;
+	void *args[2];
+	int index;
+
+	args[0] = &x;
+	args[1] = &y;
+	for(index = 0; index < NUM_FUNCS; ++index)
+	{
+		x = index;
+		y = id;
+
+		/* Build and run a function of our own */
+		func = jit_function_create(context, signature);
+		if(!func)
+		{
+			error("jit_function_create failed", x, y, 0);
+			continue;
+		}
+		build_func(func);
+		if(jit_function_compile(func) != JIT_RESULT_OK)
+		{
+			error("jit_function_compile failed", x, y, 0);
+			continue;
+		}
+		result = 0;
+		jit_function_apply(func, args, &result);
+		if(result != expected(x, y))
+		{
+			error("wrong result", x, y, result);
+		}
+
+		/* Look the function up while other threads add to the cache.
+		   The interpreter's closures are not entry points in the cache */
+		if(!jit_uses_interpreter() &&
+		   jit_function_from_closure
+				(context, jit_function_to_closure(func)) != func)
+		{
+			error("jit_function_from_closure failed", x, y, 0);
+		}
+
+		/* Run a shared function, compiling it if necessary */
+		result = 0;
+		jit_function_apply(shared[(index + id) % NUM_SHARED], args, &result);
+		if(result != expected(x, y))
+		{
+			error("wrong shared result", x, y, result);
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	pthread_t threads[NUM_THREADS];
+	jit_type_t params[2];
+	int wave, index;
+
+	jit_init();
+	context = jit_context_create();
+	params[0] = jit_type_int;
+	params[1] = jit_type_int;
+	signature = jit_type_create_signature
+		(jit_abi_cdecl, jit_type_int, params, 2, 1);
+
+	helper = jit_function_create(context, signature);
+	build_helper(helper);
+	jit_function_compile(helper);
+	for(index = 0; index < NUM_SHARED; ++index)
+	{
+		shared[index] = jit_function_create(context, signature);
+		jit_function_set_on_demand_compiler(shared[index], build_func);
+	}
+
+	for(wave = 0; wave < NUM_WAVES; ++wave)
+	{
+		for(index = 0; index < NUM_THREADS; ++index)
+		{
+			if(pthread_create(&threads[index], 0, worker,
+							  (void *)(jit_nint)(wave * NUM_THREADS + index)))
+			{
+				printf("pthread_create failed\n");
+				return 1;
+			}
+		}
+		for(index = 0; index < NUM_THREADS; ++index)
+		{
+			pthread_join(threads[index], 0);
+		}
+	}
+
+	jit_type_free(signature);
+	jit_context_destroy(context);
+	return (errors != 0);
+}
+
+#else /* !HAVE_THREADS */
+
+int main(int argc, char *argv[])
+{
+	return 77;
+}
+
+#endif /* !HAVE_THREADS */
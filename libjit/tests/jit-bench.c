@@ -0,0 +1,681 @@
+/*
+ * jit-bench.c - Code generation benchmarks for libjit.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * The libjit library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * The libjit library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the libjit library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+
+This program builds a fixed corpus of functions through the public
+libjit API and reports, for each of them, the number of IR instructions,
+the time taken to build and to compile them, the size of the generated
+code and the time taken to run it.  Every result is also checked against
+a C reference implementation, so the program doubles as a regression test.
+Times are the best of "compile-repeat" builds and of three runs, which
+keeps them stable enough to compare between builds.
+
+The report is written to stdout in JSON, so that the reports of two
+builds can be compared with "diff".  The backend in use is the one that
+libjit was configured with: configure with "--enable-interpreter" to
+benchmark the interpreter.
+
+Usage: jit-bench [-c compile-repeat] [-n iterations]
+
+*/
+
+#include <jit/jit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/*
+ * Maximum number of functions that a kernel may build.
+ */
+#define	BENCH_MAX_FUNCS		4
+
+/*
+ * Functions that were built for a kernel.  The first one is the
+ * kernel's entry point, the others are helpers that it calls.
+ */
+typedef struct
+{
+	jit_function_t	funcs[BENCH_MAX_FUNCS];
+	int				num_funcs;
+
+} bench_build_t;
+
+/*
+ * Description of a kernel.  All kernels take a single "uint" argument
+ * and return a "uint" result.
+ */
+typedef struct
+{
+	const char	*name;
+	int			(*build)(jit_context_t context, bench_build_t *build);
+	jit_uint	(*reference)(jit_uint arg);
+	jit_uint	arg_divisor;
+	jit_uint	arg_fixed;
+
+} bench_kernel_t;
+
+/*
+ * Get the current time in microseconds.
+ */
+static double
+bench_now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (double)(tv.tv_sec) * 1000000.0 + (double)(tv.tv_usec);
+}
+
+/*
+ * Create a function with the signature "uint (uint)" and register it.
+ */
+static jit_function_t
+bench_create(jit_context_t context, bench_build_t *build)
+{
+	jit_type_t params[1];
+	jit_type_t signature;
+	jit_function_t func;
+
+	params[0] = jit_type_uint;
+	signature = jit_type_create_signature
+		(jit_abi_cdecl, jit_type_uint, params, 1, 1);
+	func = jit_function_create(context, signature);
+	jit_type_free(signature);
+	if(func)
+	{
+		build->funcs[(build->num_funcs)++] = func;
+	}
+	return func;
+}
+
+/*
+ * Helpers for building the loop kernels.
+ */
+#define	UINT(func, value)	\
+	jit_value_create_nint_constant((func), jit_type_uint, (value))
+
+static jit_value_t
+bench_uint_local(jit_function_t func, jit_nint value)
+{
+	jit_value_t local = jit_value_create(func, jit_type_uint);
+	jit_insn_store(func, local, UINT(func, value));
+	return local;
+}
+
+static void
+bench_increment(jit_function_t func, jit_value_t local)
+{
+	jit_insn_store(func, local, jit_insn_add(func, local, UINT(func, 1)));
+}
+
+/*
+ * Integer arithmetic in a simple counted loop.
+ */
+static int
+build_arith(jit_context_t context, bench_build_t *build)
+{
+	jit_function_t func = bench_create(context, build);
+	jit_value_t n, i, s, t;
+	jit_label_t top = jit_label_undefined;
+	jit_label_t done = jit_label_undefined;
+
+	if(!func)
+	{
+		return 0;
+	}
+	n = jit_value_get_param(func, 0);
+	i = bench_uint_local(func, 0);
+	s = bench_uint_local(func, 0);
+
+	jit_insn_label(func, &top);
+	jit_insn_branch_if_not(func, jit_insn_lt(func, i, n), &done);
+	t = jit_insn_xor(func, jit_insn_mul(func, i, UINT(func, 7)),
+					 jit_insn_shr(func, i, UINT(func, 2)));
+	t = jit_insn_sub(func, t, jit_insn_div(func, i, UINT(func, 3)));
+	t = jit_insn_add(func, t, jit_insn_rem(func, i, UINT(func, 5)));
+	jit_insn_store(func, s, jit_insn_add(func, s, t));
+	bench_increment(func, i);
+	jit_insn_branch(func, &top);
+
+	jit_insn_label(func, &done);
+	jit_insn_return(func, s);
+	return 1;
+}
+
+static jit_uint
+reference_arith(jit_uint n)
+{
+	jit_uint i, s = 0;
+	for(i = 0; i < n; ++i)
+	{
+		s += ((i * 7) ^ (i >> 2)) - (i / 3) + (i % 5);
+	}
+	return s;
+}
+
+/*
+ * Floating-point arithmetic and conversions in a loop.  The sum is
+ * scaled down and returned as an integer.
+ */
+static int
+build_float(jit_context_t context, bench_build_t *build)
+{
+	jit_function_t func = bench_create(context, build);
+	jit_value_t n, i, s, x;
+	jit_label_t top = jit_label_undefined;
+	jit_label_t done = jit_label_undefined;
+
+	if(!func)
+	{
+		return 0;
+	}
+	n = jit_value_get_param(func, 0);
+	i = bench_uint_local(func, 0);
+	s = jit_value_create(func, jit_type_float64);
+	jit_insn_store(func, s,
+		jit_value_create_float64_constant(func, jit_type_float64, 0.0));
+
+	jit_insn_label(func, &top);
+	jit_insn_branch_if_not(func, jit_insn_lt(func, i, n), &done);
+	x = jit_insn_convert(func, i, jit_type_float64, 0);
+	x = jit_insn_mul(func, x,
+		jit_value_create_float64_constant(func, jit_type_float64, 0.5));
+	x = jit_insn_div(func, jit_insn_mul(func, x, x),
+		jit_insn_add(func, x,
+			jit_value_create_float64_constant(func, jit_type_float64, 1.0)));
+	jit_insn_store(func, s, jit_insn_add(func, s, x));
+	bench_increment(func, i);
+	jit_insn_branch(func, &top);
+
+	jit_insn_label(func, &done);
+	s = jit_insn_div(func, s,
+		jit_value_create_float64_constant(func, jit_type_float64, 4096.0));
+	jit_insn_return(func, jit_insn_convert(func, s, jit_type_uint, 0));
+	return 1;
+}
+
+static jit_uint
+reference_float(jit_uint n)
+{
+	jit_uint i;
+	jit_float64 s = 0.0;
+	jit_float64 x;
+	for(i = 0; i < n; ++i)
+	{
+		x = ((jit_float64)i) * 0.5;
+		s += (x * x) / (x + 1.0);
+	}
+	return (jit_uint)(s / 4096.0);
+}
+
+/*
+ * Nested loops with a short inner trip count.
+ */
+static int
+build_nested(jit_context_t context, bench_build_t *build)
+{
+	jit_function_t func = bench_create(context, build);
+	jit_value_t n, i, j, s, t;
+	jit_label_t outer = jit_label_undefined;
+	jit_label_t inner = jit_label_undefined;
+	jit_label_t inner_done = jit_label_undefined;
+	jit_label_t done = jit_label_undefined;
+
+	if(!func)
+	{
+		return 0;
+	}
+	n = jit_value_get_param(func, 0);
+	i = bench_uint_local(func, 0);
+	j = jit_value_create(func, jit_type_uint);
+	s = bench_uint_local(func, 0);
+
+	jit_insn_label(func, &outer);
+	jit_insn_branch_if_not(func, jit_insn_lt(func, i, n), &done);
+	jit_insn_store(func, j, UINT(func, 0));
+	jit_insn_label(func, &inner);
+	jit_insn_branch_if_not(func, jit_insn_lt(func, j, UINT(func, 16)),
+						   &inner_done);
+	t = jit_insn_add(func, jit_insn_and(func, i, j), UINT(func, 1));
+	jit_insn_store(func, s, jit_insn_add(func, s, t));
+	bench_increment(func, j);
+	jit_insn_branch(func, &inner);
+	jit_insn_label(func, &inner_done);
+	bench_increment(func, i);
+	jit_insn_branch(func, &outer);
+
+	jit_insn_label(func, &done);
+	jit_insn_return(func, s);
+	return 1;
+}
+
+static jit_uint
+reference_nested(jit_uint n)
+{
+	jit_uint i, j, s = 0;
+	for(i = 0; i < n; ++i)
+	{
+		for(j = 0; j < 16; ++j)
+		{
+			s += (i & j) + 1;
+		}
+	}
+	return s;
+}
+
+/*
+ * Recursive calls.
+ */
+static int
+build_calls(jit_context_t context, bench_build_t *build)
+{
+	jit_function_t func = bench_create(context, build);
+	jit_value_t n, a, b, args[1];
+	jit_label_t recurse = jit_label_undefined;
+
+	if(!func)
+	{
+		return 0;
+	}
+	n = jit_value_get_param(func, 0);
+
+	jit_insn_branch_if(func, jit_insn_ge(func, n, UINT(func, 2)), &recurse);
+	jit_insn_return(func, n);
+
+	jit_insn_label(func, &recurse);
+	args[0] = jit_insn_sub(func, n, UINT(func, 1));
+	a = jit_insn_call(func, "fib", func, 0, args, 1, 0);
+	args[0] = jit_insn_sub(func, n, UINT(func, 2));
+	b = jit_insn_call(func, "fib", func, 0, args, 1, 0);
+	jit_insn_return(func, jit_insn_add(func, a, b));
+	return 1;
+}
+
+static jit_uint
+reference_calls(jit_uint n)
+{
+	if(n < 2)
+	{
+		return n;
+	}
+	return reference_calls(n - 1) + reference_calls(n - 2);
+}
+
+/*
+ * Exceptions thrown by a callee and caught by the caller.
+ */
+static int
+build_except(jit_context_t context, bench_build_t *build)
+{
+	jit_function_t func = bench_create(context, build);
+	jit_function_t thrower = bench_create(context, build);
+	jit_value_t n, i, s, t, args[1];
+	jit_label_t top = jit_label_undefined;
+	jit_label_t done = jit_label_undefined;
+	jit_label_t no_throw = jit_label_undefined;
+
+	if(!func || !thrower)
+	{
+		return 0;
+	}
+
+	/* The thrower returns its argument, except for every 16th call */
+	t = jit_value_get_param(thrower, 0);
+	jit_insn_branch_if(thrower,
+		jit_insn_and(thrower, t, UINT(thrower, 15)), &no_throw);
+	jit_insn_throw(thrower, jit_value_create_nint_constant
+		(thrower, jit_type_void_ptr, 1));
+	jit_insn_label(thrower, &no_throw);
+	jit_insn_return(thrower, t);
+
+	/* The caller sums the results and counts the exceptions */
+	jit_insn_uses_catcher(func);
+	n = jit_value_get_param(func, 0);
+	i = bench_uint_local(func, 0);
+	s = bench_uint_local(func, 0);
+
+	jit_insn_label(func, &top);
+	jit_insn_branch_if_not(func, jit_insn_lt(func, i, n), &done);
+	args[0] = i;
+	t = jit_insn_call(func, "thrower", thrower, 0, args, 1, 0);
+	jit_insn_store(func, s, jit_insn_add(func, s, t));
+	bench_increment(func, i);
+	jit_insn_branch(func, &top);
+
+	jit_insn_label(func, &done);
+	jit_insn_return(func, s);
+
+	jit_insn_start_catcher(func);
+	jit_insn_store(func, s, jit_insn_add(func, s, UINT(func, 1000)));
+	bench_increment(func, i);
+	jit_insn_branch(func, &top);
+	return 1;
+}
+
+static jit_uint
+reference_except(jit_uint n)
+{
+	jit_uint i, s = 0;
+	for(i = 0; i < n; ++i)
+	{
+		s += ((i & 15) == 0) ? 1000 : i;
+	}
+	return s;
+}
+
+/*
+ * Dense switch lowered to a jump table.
+ */
+#define	BENCH_SWITCH_CASES	8
+
+static int
+build_switch(jit_context_t context, bench_build_t *build)
+{
+	jit_function_t func = bench_create(context, build);
+	jit_value_t n, i, s;
+	jit_label_t top = jit_label_undefined;
+	jit_label_t next = jit_label_undefined;
+	jit_label_t done = jit_label_undefined;
+	jit_label_t cases[BENCH_SWITCH_CASES];
+	int label;
+
+	if(!func)
+	{
+		return 0;
+	}
+	n = jit_value_get_param(func, 0);
+	i = bench_uint_local(func, 0);
+	s = bench_uint_local(func, 0);
+	for(label = 0; label < BENCH_SWITCH_CASES; ++label)
+	{
+		cases[label] = jit_label_undefined;
+	}
+
+	jit_insn_label(func, &top);
+	jit_insn_branch_if_not(func, jit_insn_lt(func, i, n), &done);
+	jit_insn_jump_table(func, jit_insn_rem(func, i,
+						UINT(func, BENCH_SWITCH_CASES)),
+						cases, BENCH_SWITCH_CASES);
+	for(label = 0; label < BENCH_SWITCH_CASES; ++label)
+	{
+		jit_insn_label(func, &cases[label]);
+		jit_insn_store(func, s, jit_insn_add(func,
+			jit_insn_mul(func, s, UINT(func, label + 1)), i));
+		jit_insn_branch(func, &next);
+	}
+	jit_insn_label(func, &next);
+	bench_increment(func, i);
+	jit_insn_branch(func, &top);
+
+	jit_insn_label(func, &done);
+	jit_insn_return(func, s);
+	return 1;
+}
+
+static jit_uint
+reference_switch(jit_uint n)
+{
+	jit_uint i, s = 0;
+	for(i = 0; i < n; ++i)
+	{
+		s = s * ((i % BENCH_SWITCH_CASES) + 1) + i;
+	}
+	return s;
+}
+
+/*
+ * The corpus.  Loop kernels run "iterations / arg_divisor" times,
+ * the others use a fixed argument.
+ */
+static bench_kernel_t const kernels[] = {
+	{"arith",	build_arith,	reference_arith,	1,		0},
+	{"float",	build_float,	reference_float,	1,		0},
+	{"nested",	build_nested,	reference_nested,	16,		0},
+	{"calls",	build_calls,	reference_calls,	0,		24},
+	{"except",	build_except,	reference_except,	100,	0},
+	{"switch",	build_switch,	reference_switch,	1,		0},
+};
+#define	BENCH_NUM_KERNELS	(sizeof(kernels) / sizeof(bench_kernel_t))
+
+/*
+ * Count the IR instructions in a function that has not been compiled yet.
+ */
+static unsigned long
+bench_count_insns(jit_function_t func)
+{
+	unsigned long count = 0;
+	jit_block_t block = 0;
+	jit_insn_iter_t iter;
+
+	while((block = jit_block_next(func, block)) != 0)
+	{
+		jit_insn_iter_init(&iter, block);
+		while(jit_insn_iter_next(&iter) != 0)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+/*
+ * Results for a single kernel.
+ */
+typedef struct
+{
+	int				num_funcs;
+	unsigned long	insns;
+	unsigned long	code_size;
+	double			build_us;
+	double			compile_us;
+	double			exec_us;
+	int				ok;
+
+} bench_result_t;
+
+/*
+ * Build and compile a kernel in a fresh context, keeping the best
+ * times over all repetitions.  On the last repetition the kernel
+ * is also run and its result checked.
+ */
+static int
+bench_run_kernel(const bench_kernel_t *kernel, int repeat,
+				 jit_uint iterations, bench_result_t *result)
+{
+	jit_context_t context;
+	bench_build_t build;
+	jit_uint arg;
+	jit_uint value;
+	void *args[1];
+	double start, elapsed;
+	int rep, posn, run;
+
+	memset(result, 0, sizeof(bench_result_t));
+	arg = kernel->arg_fixed;
+	if(kernel->arg_divisor)
+	{
+		arg = iterations / kernel->arg_divisor;
+	}
+
+	for(rep = 0; rep < repeat; ++rep)
+	{
+		context = jit_context_create();
+		if(!context)
+		{
+			return 0;
+		}
+		build.num_funcs = 0;
+
+		/* Build the IR */
+		jit_context_build_start(context);
+		start = bench_now();
+		if(!(*(kernel->build))(context, &build))
+		{
+			jit_context_build_end(context);
+			jit_context_destroy(context);
+			return 0;
+		}
+		elapsed = bench_now() - start;
+		if(rep == 0 || elapsed < result->build_us)
+		{
+			result->build_us = elapsed;
+		}
+		if(rep == 0)
+		{
+			result->num_funcs = build.num_funcs;
+			for(posn = 0; posn < build.num_funcs; ++posn)
+			{
+				result->insns += bench_count_insns(build.funcs[posn]);
+			}
+		}
+
+		/* Compile it */
+		start = bench_now();
+		for(posn = 0; posn < build.num_funcs; ++posn)
+		{
+			if(!jit_function_compile(build.funcs[posn]))
+			{
+				jit_context_build_end(context);
+				jit_context_destroy(context);
+				return 0;
+			}
+		}
+		elapsed = bench_now() - start;
+		if(rep == 0 || elapsed < result->compile_us)
+		{
+			result->compile_us = elapsed;
+		}
+		jit_context_build_end(context);
+
+		if(rep == repeat - 1)
+		{
+			for(posn = 0; posn < build.num_funcs; ++posn)
+			{
+				result->code_size +=
+					jit_function_get_code_size(build.funcs[posn]);
+			}
+
+			/* Run the kernel a few times and keep the best time */
+			args[0] = &arg;
+			result->exec_us = -1.0;
+			for(run = 0; run < 3; ++run)
+			{
+				start = bench_now();
+				jit_function_apply(build.funcs[0], args, &value);
+				elapsed = bench_now() - start;
+				if(result->exec_us < 0.0 || elapsed < result->exec_us)
+				{
+					result->exec_us = elapsed;
+				}
+			}
+
+			/* Check the result against the C implementation */
+			result->ok = (value == (*(kernel->reference))(arg));
+		}
+
+		jit_context_destroy(context);
+	}
+
+	return 1;
+}
+
+static void
+usage(const char *progname)
+{
+	fprintf(stderr, "Usage: %s [-c compile-repeat] [-n iterations]\n",
+			progname);
+	exit(1);
+}
+
+int
+main(int argc, char **argv)
+{
+	const char *progname = argv[0];
+	int repeat = 20;
+	jit_uint iterations = 1000000;
+	bench_result_t result;
+	unsigned int kernel;
+	int failed = 0;
+
+	/* Parse the command-line options */
+	while(argc > 1 && argv[1][0] == '-')
+	{
+		if(argc < 3)
+		{
+			usage(progname);
+		}
+		if(!strcmp(argv[1], "-c"))
+		{
+			repeat = atoi(argv[2]);
+		}
+		else if(!strcmp(argv[1], "-n"))
+		{
+			iterations = (jit_uint)strtoul(argv[2], 0, 0);
+		}
+		else
+		{
+			usage(progname);
+		}
+		argc -= 2;
+		argv += 2;
+	}
+	if(argc > 1 || repeat < 1)
+	{
+		usage(progname);
+	}
+
+	jit_init();
+
+	printf("{\n");
+	printf("  \"backend\": \"%s\",\n",
+		   jit_uses_interpreter() ? "interpreter" : "native");
+	printf("  \"compile_repeat\": %d,\n", repeat);
+	printf("  \"iterations\": %lu,\n", (unsigned long)iterations);
+	printf("  \"kernels\": [\n");
+	for(kernel = 0; kernel < BENCH_NUM_KERNELS; ++kernel)
+	{
+		if(!bench_run_kernel(&kernels[kernel], repeat, iterations, &result))
+		{
+			fprintf(stderr, "%s: could not compile kernel `%s'\n",
+					progname, kernels[kernel].name);
+			failed = 1;
+		}
+		else if(!result.ok)
+		{
+			fprintf(stderr, "%s: kernel `%s' returned a wrong result\n",
+					progname, kernels[kernel].name);
+			failed = 1;
+		}
+		printf("    {\"name\": \"%s\", \"functions\": %d, \"insns\": %lu, "
+			   "\"build_us\": %.2f, \"compile_us\": %.2f, "
+			   "\"compile_ns_per_insn\": %.1f, \"code_size\": %lu, "
+			   "\"exec_us\": %.1f, \"ok\": %s}%s\n",
+			   kernels[kernel].name, result.num_funcs, result.insns,
+			   result.build_us, result.compile_us,
+			   result.insns ? (result.compile_us * 1000.0) / result.insns : 0.0,
+			   result.code_size, result.exec_us,
+			   result.ok ? "true" : "false",
+			   (kernel + 1 < BENCH_NUM_KERNELS) ? "," : "");
+	}
+	printf("  ]\n");
+	printf("}\n");
+	return failed;
+}
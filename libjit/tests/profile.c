@@ -0,0 +1,302 @@
+/*
+ * profile.c - Test branch weights, branch profiling and block layout.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * The libjit library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * The libjit library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the libjit library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+
+The first part builds a function with weighted branches for every
+combination of weights, branch sense and optimization level, and checks
+that each path still computes the right result after the blocks have
+been laid out, including a cold path that throws an exception.
+
+The second part collects branch counts for a loop, checks the counters,
+and then rebuilds the loop without instrumentation so that the counts
+are used as weights.
+
+The program exits with a non-zero status if any check fails.
+
+*/
+
+#include <jit/jit.h>
+#include <stdio.h>
+
+static int errors;
+
+static void error(const char *msg, int arg1, int arg2)
+{
+	printf("%s (%d, %d)\n", msg, arg1, arg2);
+	++errors;
+}
+
+/*
+ * Branch weights to try, as taken and not taken pairs.
+ */
+static const unsigned int weights[][2] = {
+	{0, 1}, {1, 0}, {1, 1}, {100, 1}, {1, 100}
+};
+#define	NUM_WEIGHTS		(sizeof(weights) / sizeof(weights[0]))
+
+/*
+ * Value that is thrown by the cold path of "classify".
+ */
+static int thrown;
+
+/*
+ * Build "classify(x)", which returns "x + 100" if "x >= 10",
+ * throws if "x == 13" and returns "x * 2" otherwise.  The first
+ * branch has the given weights and the throw is marked as cold.
+ */
+static void build_classify(jit_function_t func, unsigned int taken,
+						   unsigned int not_taken, int invert)
+{
+	jit_label_t big = jit_label_undefined;
+	jit_label_t cold = jit_label_undefined;
+	jit_value_t x = jit_value_get_param(func, 0);
+	jit_value_t ten = jit_value_create_nint_constant(func, jit_type_int, 10);
+
+	if(invert)
+	{
+		jit_insn_branch_if_not_weighted
+			(func, jit_insn_lt(func, x, ten), &big, taken, not_taken);
+	}
+	else
+	{
+		jit_insn_branch_if_weighted
+			(func, jit_insn_ge(func, x, ten), &big, taken, not_taken);
+	}
+	jit_insn_return(func, jit_insn_mul
+		(func, x, jit_value_create_nint_constant(func, jit_type_int, 2)));
+
+	jit_insn_label(func, &big);
+	jit_insn_branch_if_weighted
+		(func, jit_insn_eq(func, x, jit_value_create_nint_constant
+			(func, jit_type_int, 13)), &cold, 0, 1);
+	jit_insn_return(func, jit_insn_add
+		(func, x, jit_value_create_nint_constant(func, jit_type_int, 100)));
+
+	jit_insn_label(func, &cold);
+	jit_insn_throw(func, jit_value_create_nint_constant
+		(func, jit_type_void_ptr, (jit_nint)&thrown));
+}
+
+static void test_weights(jit_context_t context, jit_type_t signature)
+{
+	jit_function_t func;
+	unsigned int weight;
+	unsigned int level;
+	int invert;
+	jit_int x, result;
+	void *args[1];
+
+	args[0] = &x;
+	for(level = 0; level <= jit_function_get_max_optimization_level(); ++level)
+	{
+		for(weight = 0; weight < NUM_WEIGHTS; ++weight)
+		{
+			for(invert = 0; invert < 2; ++invert)
+			{
+				func = jit_function_create(context, signature);
+				jit_function_set_optimization_level(func, level);
+				build_classify(func, weights[weight][0],
+							   weights[weight][1], invert);
+				if(!jit_function_compile(func))
+				{
+					error("classify did not compile", weight, invert);
+					continue;
+				}
+				for(x = -5; x < 20; ++x)
+				{
+					result = 0;
+					if(!jit_function_apply(func, args, &result))
+					{
+						if(x != 13 || jit_exception_get_last() != &thrown)
+						{
+							error("classify threw", weight, x);
+						}
+						jit_exception_clear_last();
+					}
+					else if(x == 13)
+					{
+						error("classify did not throw", weight, invert);
+					}
+					else if(result != (x >= 10 ? x + 100 : x * 2))
+					{
+						error("wrong classify result", weight, x);
+					}
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Build "loop(n)", which adds 10 for every multiple of 4 below "n"
+ * and 1 for every other number.  Branch 0 leaves the loop and branch 1
+ * skips to the "other" case.
+ */
+static void build_loop(jit_function_t func)
+{
+	jit_label_t top = jit_label_undefined;
+	jit_label_t other = jit_label_undefined;
+	jit_label_t next = jit_label_undefined;
+	jit_label_t done = jit_label_undefined;
+	jit_value_t n = jit_value_get_param(func, 0);
+	jit_value_t sum = jit_value_create(func, jit_type_int);
+	jit_value_t i = jit_value_create(func, jit_type_int);
+	jit_value_t temp;
+
+	jit_insn_store(func, sum, jit_value_create_nint_constant
+		(func, jit_type_int, 0));
+	jit_insn_store(func, i, jit_value_create_nint_constant
+		(func, jit_type_int, 0));
+
+	jit_insn_label(func, &top);
+	jit_insn_branch_if(func, jit_insn_ge(func, i, n), &done);
+	temp = jit_insn_and(func, i, jit_value_create_nint_constant
+		(func, jit_type_int, 3));
+	jit_insn_branch_if_not(func, jit_insn_eq(func, temp,
+		jit_value_create_nint_constant(func, jit_type_int, 0)), &other);
+	jit_insn_store(func, sum, jit_insn_add(func, sum,
+		jit_value_create_nint_constant(func, jit_type_int, 10)));
+	jit_insn_branch(func, &next);
+
+	jit_insn_label(func, &other);
+	jit_insn_store(func, sum, jit_insn_add(func, sum,
+		jit_value_create_nint_constant(func, jit_type_int, 1)));
+
+	jit_insn_label(func, &next);
+	jit_insn_store(func, i, jit_insn_add(func, i,
+		jit_value_create_nint_constant(func, jit_type_int, 1)));
+	jit_insn_branch(func, &top);
+
+	jit_insn_label(func, &done);
+	jit_insn_return(func, sum);
+}
+
+static jit_int expected_loop(jit_int n)
+{
+	jit_int sum = 0;
+	jit_int i;
+	for(i = 0; i < n; ++i)
+	{
+		sum += ((i & 3) == 0 ? 10 : 1);
+	}
+	return sum;
+}
+
+static void check_loop(jit_function_t func, jit_int n)
+{
+	jit_int result = 0;
+	void *args[1];
+
+	args[0] = &n;
+	if(!jit_function_apply(func, args, &result) || result != expected_loop(n))
+	{
+		error("wrong loop result", n, result);
+	}
+}
+
+static void check_counts(jit_function_t func, unsigned int branch,
+						 jit_ulong taken, jit_ulong not_taken)
+{
+	jit_ulong actual_taken = 0;
+	jit_ulong actual_not_taken = 0;
+
+	if(!jit_function_get_branch_counts
+			(func, branch, &actual_taken, &actual_not_taken))
+	{
+		error("missing branch counts", branch, 0);
+	}
+	else if(actual_taken != taken || actual_not_taken != not_taken)
+	{
+		error("wrong taken count", branch, (int)actual_taken);
+		error("wrong not taken count", branch, (int)actual_not_taken);
+	}
+}
+
+static void test_profile(jit_context_t context, jit_type_t signature)
+{
+	jit_function_t func;
+	jit_ulong taken, not_taken;
+
+	/* Instrument the loop and run it for 100 and 20 iterations */
+	func = jit_function_create(context, signature);
+	jit_function_collect_branch_counts(func, 1);
+	build_loop(func);
+	if(!jit_function_compile(func))
+	{
+		error("instrumented loop did not compile", 0, 0);
+		return;
+	}
+	if(jit_function_get_num_branch_counts(func) != 2)
+	{
+		error("wrong number of branches",
+			  jit_function_get_num_branch_counts(func), 2);
+	}
+	check_loop(func, 100);
+	check_loop(func, 20);
+
+	/* The exit branch is taken once per call, and the "other" branch
+	   is taken for the 75 + 15 numbers that are not multiples of 4 */
+	check_counts(func, 0, 2, 120);
+	check_counts(func, 1, 90, 30);
+	if(jit_function_get_branch_counts(func, 2, &taken, &not_taken))
+	{
+		error("counts for a branch that does not exist", 2, 0);
+	}
+
+	/* Rebuild the loop using the counts as weights */
+	jit_function_collect_branch_counts(func, 0);
+	jit_function_set_recompilable(func);
+	build_loop(func);
+	if(!jit_function_compile(func))
+	{
+		error("profiled loop did not compile", 0, 0);
+		return;
+	}
+	check_loop(func, 0);
+	check_loop(func, 1);
+	check_loop(func, 100);
+
+	/* The rebuilt code is not instrumented */
+	check_counts(func, 0, 2, 120);
+	check_counts(func, 1, 90, 30);
+}
+
+int main(int argc, char *argv[])
+{
+	jit_context_t context;
+	jit_type_t params[1];
+	jit_type_t signature;
+
+	jit_init();
+	context = jit_context_create();
+	params[0] = jit_type_int;
+	signature = jit_type_create_signature
+		(jit_abi_cdecl, jit_type_int, params, 1, 1);
+
+	jit_context_build_start(context);
+	test_weights(context, signature);
+	test_profile(context, signature);
+	jit_context_build_end(context);
+
+	jit_type_free(signature);
+	jit_context_destroy(context);
+	return (errors != 0);
+}
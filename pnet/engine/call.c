@@ -71,8 +71,9 @@ extern	"C" {
 			do { \
 				if((stacktop + (nwords)) > stacklimit) \
 				{ \
-					_ILExecThreadSetException(thread, _ILSystemException \
-						(thread, "System.StackOverflowException")); \
+					_ILExecThreadSetException(thread, \
+						_ILSystemWellKnownException \
+							(thread, IL_WKC_STACK_OVERFLOW_EXCEPTION)); \
 					return 1; \
 				} \
 			} while (0)
@@ -1185,8 +1186,8 @@ int _ILCallMethod(ILExecThread *thread, ILMethod *method,
 	{
 	    if((frame = _ILAllocCallFrame(thread)) == 0)
 		{
-			_ILExecThreadSetException(thread, _ILSystemException
-				(thread, "System.StackOverflowException"));
+			_ILExecThreadSetException(thread, _ILSystemWellKnownException
+				(thread, IL_WKC_STACK_OVERFLOW_EXCEPTION));
 			return 1;
 	    }
 	}
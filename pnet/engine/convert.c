@@ -584,24 +584,24 @@ unsigned char *_ILConvertMethod(ILExecThread *thread, ILMethod *method)
 			case IL_CONVERT_VERIFY_FAILED:
 			{
 				_ILExecThreadSetException
-					(thread, _ILSystemException(thread, 
-						"System.Security.VerificationException"));
+					(thread, _ILSystemWellKnownException
+						(thread, IL_WKC_VERIFICATION_EXCEPTION));
 			}
 			break;
 
 			case IL_CONVERT_ENTRY_POINT:
 			{
 				_ILExecThreadSetException
-					(thread, _ILSystemException(thread, 
-						"System.EntryPointNotFoundException"));
+					(thread, _ILSystemWellKnownException
+						(thread, IL_WKC_ENTRY_POINT_NOT_FOUND_EXCEPTION));
 			}
 			break;
 
 			case IL_CONVERT_NOT_IMPLEMENTED:
 			{
 				_ILExecThreadSetException
-					(thread, _ILSystemException(thread, 
-						"System.NotImplementedException"));
+					(thread, _ILSystemWellKnownException
+						(thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION));
 			}
 			break;
 
@@ -614,14 +614,15 @@ unsigned char *_ILConvertMethod(ILExecThread *thread, ILMethod *method)
 			case IL_CONVERT_TYPE_INIT:
 			{
 				_ILExecThreadSetException
-					(thread, _ILSystemException(thread, 
-						"System.TypeInitializationException"));
+					(thread, _ILSystemWellKnownException
+						(thread, IL_WKC_TYPE_INITIALIZATION_EXCEPTION));
 			}
 			break;
 
 			case IL_CONVERT_DLL_NOT_FOUND:
 			{
-				obj = _ILSystemException(thread, "System.DllNotFoundException");
+				obj = _ILSystemWellKnownException
+					(thread, IL_WKC_DLL_NOT_FOUND_EXCEPTION);
 
 				if (errorInfo)
 				{
@@ -1083,6 +1083,14 @@ static int unwind(ILExecThread *thread,
 			context.frame = frame;
 			context.stackTop = frame;
 			exceptUnwind = FindUnwindBlock(unwind, &context);
+			if(exceptUnwind == unwind)
+			{
+				/*
+				 * The pc is not within a protected region, so there
+				 * is nothing to do in this frame.
+				 */
+				exceptUnwind = 0;
+			}
 			while(exceptUnwind)
 			{
 				if(exceptUnwind->flags ==  _IL_CVM_UNWIND_TYPE_TRY)
@@ -609,6 +609,21 @@ extern	"C" {
 #define COP_PREFIX_PROFILE_START		0x92
 #define COP_PREFIX_PROFILE_END			0x93
 
+/*
+ * Native calls through a direct call stub.
+ */
+#define COP_PREFIX_CALL_NATIVE_STUB		0x94
+#define COP_PREFIX_CALL_NATIVE_VOID_STUB	0x95
+
+/*
+ * Inlined string functions from the C library.
+ */
+#define COP_PREFIX_STRLEN				0x96
+#define COP_PREFIX_STRCMP				0x97
+#define COP_PREFIX_STRCHR				0x98
+#define COP_PREFIX_MEMCMP				0x99
+#define COP_PREFIX_MEMCHR				0x9A
+
 
 /*
  * Definition of a CVM stack word which can hold
@@ -678,10 +693,17 @@ typedef union
 typedef struct _tagILCVMUnwindTry ILCVMUnwindTry;
 typedef struct _tagILCVMUnwindHandler ILCVMUnwindHandler;
 typedef struct _tagILCVMUnwind ILCVMUnwind;
+typedef struct _tagILCVMUnwindRange ILCVMUnwindRange;
 
 struct _tagILCVMUnwindTry
 {
 	ILInt32				firstHandler;
+	/*
+	 * The pc range table for the method.  This is only set in the
+	 * outermost unwind information block (the one for the method).
+	 */
+	ILInt32				numRanges;
+	const ILCVMUnwindRange *ranges;
 };
 
 struct _tagILCVMUnwindHandler
@@ -734,6 +756,27 @@ struct _tagILCVMUnwind
 	} un;
 };
 
+/*
+ * Entry in the pc range table of a method.  The entries are sorted
+ * by pc and partition the method's code, so the innermost unwind
+ * block for a pc can be found with a binary search.  Each range ends
+ * where the next one starts, and the last one ends at the end of
+ * the method.
+ */
+struct _tagILCVMUnwindRange
+{
+	unsigned char	   *start;
+	/*
+	 * Index of the innermost unwind information block for the range.
+	 */
+	ILInt32				block;
+	/*
+	 * The sum of the stackChange values of the block and all of its
+	 * surrounding blocks.
+	 */
+	ILInt32				stackChange;
+};
+
 /*
  * Context definition for the cvm interpreter (aka ucontext)
  */
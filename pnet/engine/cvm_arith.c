@@ -1675,7 +1675,8 @@ VMCASE(COP_FFIXUP):
 VMCASE(COP_DFIXUP):
 {
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.NotImplementedException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION);
 	goto throwException;
 }
 /* Not reached */
@@ -2162,7 +2163,8 @@ VMCASE(COP_PREFIX_FWRITE_ELEM):
 VMCASE(COP_PREFIX_DWRITE_ELEM):
 {
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.NotImplementedException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION);
 	goto throwException;
 }
 /* Not reached */
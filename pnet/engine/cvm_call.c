@@ -2275,4 +2275,80 @@ VMCASE(COP_PREFIX_PROFILE_END):
 }
 VMBREAK(COP_PREFIX_PROFILE_END);
 
+/**
+ * <opcode name="call_native_stub" group="Call management instructions">
+ *   <operation>Call a native function that has a return value
+ *              through a direct call stub</operation>
+ *
+ *   <format>prefix<fsep/>call_native_stub<fsep/>function<fsep/>stub</format>
+ *   <dformat>{call_native_stub}<fsep/>function<fsep/>stub</dformat>
+ *
+ *   <form name="call_native_stub" code="COP_PREFIX_CALL_NATIVE_STUB"/>
+ *
+ *   <before>..., address</before>
+ *   <after>...</after>
+ *
+ *   <description>The <i>call_native_stub</i> instruction is identical
+ *   to <i>call_native</i>, except that the call is made through
+ *   <i>stub</i> rather than a "cif" descriptor.</description>
+ *
+ *   <notes>The CVM translation process uses this instruction in place
+ *   of <i>call_native</i> when the native signature consists only of
+ *   integer and pointer values, and the platform supports calling
+ *   such signatures directly.  This avoids the overhead of decoding
+ *   the signature on every call.</notes>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_CALL_NATIVE_STUB):
+{
+	BEGIN_NATIVE_CALL();
+
+	/* Call a native method through a direct call stub */
+	COPY_STATE_TO_THREAD();
+#if defined(HAVE_LIBFFI)
+	_ILCallNativeStub(CVMP_ARG_PTR2(void *), CVMP_ARG_PTR(void *),
+					  stacktop[-1].ptrValue, nativeArgs);
+#endif
+	RESTORE_STATE_FROM_THREAD();
+	pc = thread->pc;
+	MODIFY_PC_AND_STACK(CVMP_LEN_PTR2, -1);
+
+	END_NATIVE_CALL();
+}
+VMBREAK(COP_PREFIX_CALL_NATIVE_STUB);
+
+/**
+ * <opcode name="call_native_void_stub" group="Call management instructions">
+ *   <operation>Call a native function with no return value
+ *              through a direct call stub</operation>
+ *
+ *   <format>prefix<fsep/>call_native_void_stub<fsep/>function<fsep/>stub</format>
+ *   <dformat>{call_native_void_stub}<fsep/>function<fsep/>stub</dformat>
+ *
+ *   <form name="call_native_void_stub"
+ *         code="COP_PREFIX_CALL_NATIVE_VOID_STUB"/>
+ *
+ *   <description>The <i>call_native_void_stub</i> instruction is identical
+ *   to <i>call_native_stub</i>, except that the native function is assumed
+ *   not to have a return value.</description>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_CALL_NATIVE_VOID_STUB):
+{
+	BEGIN_NATIVE_CALL();
+
+	/* Call a native method with no return value through a stub */
+	COPY_STATE_TO_THREAD();
+#if defined(HAVE_LIBFFI)
+	_ILCallNativeStub(CVMP_ARG_PTR2(void *), CVMP_ARG_PTR(void *),
+					  0, nativeArgs);
+#endif
+	RESTORE_STATE_FROM_THREAD();
+	pc = thread->pc;
+	MODIFY_PC_AND_STACK(CVMP_LEN_PTR2, 0);
+
+	END_NATIVE_CALL();
+}
+VMBREAK(COP_PREFIX_CALL_NATIVE_VOID_STUB);
+
 #endif /* IL_CVM_PREFIX */
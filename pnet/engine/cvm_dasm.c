@@ -668,16 +668,24 @@ static CVMOpcode const prefixOpcodes[0xA0] = {
 	{"profile_start",	CVM_OPER_NONE},
 	{"profile_end",		CVM_OPER_NONE},
 
+	/*
+	 * Native calls through a direct call stub.
+	 */
+	{"call_native_stub", CVM_OPER_CALL_NATIVE},
+	{"call_native_void_stub", CVM_OPER_CALL_NATIVE},
+
+	/*
+	 * Inlined string functions from the C library.
+	 */
+	{"strlen",			CVM_OPER_NONE},
+	{"strcmp",			CVM_OPER_NONE},
+	{"strchr",			CVM_OPER_NONE},
+	{"memcmp",			CVM_OPER_NONE},
+	{"memchr",			CVM_OPER_NONE},
+
 	/*
 	 * Reserved opcodes.
 	 */
-	{"preserved_94",	CVM_OPER_NONE},
-	{"preserved_95",	CVM_OPER_NONE},
-	{"preserved_96",	CVM_OPER_NONE},
-	{"preserved_97",	CVM_OPER_NONE},
-	{"preserved_98",	CVM_OPER_NONE},
-	{"preserved_99",	CVM_OPER_NONE},
-	{"preserved_9A",	CVM_OPER_NONE},
 	{"preserved_9B",	CVM_OPER_NONE},
 	{"preserved_9C",	CVM_OPER_NONE},
 	{"preserved_9D",	CVM_OPER_NONE},
@@ -1149,6 +1157,29 @@ int _ILDumpCVMInsn(FILE *stream, ILMethod *currMethod, unsigned char *pc)
 				}
 				break;
 
+				case CVM_OPER_CALL_NATIVE:
+				{
+					fprintf(stream, "0x%08lX (",
+							(unsigned long)(CVMReadPointer(pc + 2)));
+					methodEntry = _ILFindInternalByAddr
+							(CVMReadPointer(pc + 2), &str);
+					if(methodEntry)
+					{
+						fprintf(stream, "%s.%s \"%s\"", str,
+								methodEntry->methodName,
+								(methodEntry->signature ?
+									methodEntry->signature :
+									methodEntry[-1].signature));
+					}
+					else
+					{
+						putc('?', stream);
+					}
+					putc(')', stream);
+					size = 2 + sizeof(void *) * 2;
+				}
+				break;
+
 				default:
 				{
 					size = 2;
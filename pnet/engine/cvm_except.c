@@ -23,44 +23,51 @@
 /*
  * Find the most nested unwind information block where the pc.
  * Returns NULL if no such exception block could be found.
+ *
+ * The coder stores a table of pc ranges sorted by start address in
+ * the outermost block, so this is a binary search rather than a walk
+ * over the tree of nested blocks.
  */
 static const ILCVMUnwind *FindUnwindBlock(const ILCVMUnwind *unwind,
 										  ILCVMContext *context)
 {
 	const unsigned char *pc;
-	ILInt32 index ;
-	CVMWord *stacktop;
-	const ILCVMUnwind *prevEB;
+	const ILCVMUnwindRange *ranges;
+	ILInt32 left;
+	ILInt32 right;
+	ILInt32 middle;
 
 	pc = context->pc;
-	stacktop = context->frame;
-	prevEB = 0;
-	index = 0;
-	while(index >= 0)
+	context->stackTop = context->frame;
+	if(pc < unwind[0].start || pc >= unwind[0].end)
 	{
-		const ILCVMUnwind *block;
+		return 0;
+	}
 
-		block = &(unwind[index]);
-		if(pc < block->start)
-		{
-			break;
-		}
-		else if(pc >= block->end)
+	/*
+	 * Find the last range that starts at or before the pc.
+	 */
+	ranges = unwind[0].un.tryBlock.ranges;
+	left = 0;
+	right = unwind[0].un.tryBlock.numRanges - 1;
+	while(left < right)
+	{
+		middle = left + (right - left + 1) / 2;
+		if(ranges[middle].start <= pc)
 		{
-			index = block->nextNested;
+			left = middle;
 		}
 		else
 		{
-			prevEB = block;
-			stacktop += block->stackChange;
-			index = block->nested;
+			right = middle - 1;
 		}
 	}
+
 	/*
 	 * Update the stacktop in the context structure.
 	 */
-	context->stackTop = stacktop;
-	return prevEB;
+	context->stackTop += ranges[left].stackChange;
+	return &(unwind[ranges[left].block]);
 }
 
 #elif defined(IL_CVM_LOCALS)
@@ -212,7 +219,8 @@ throwThreadAbortException:
 	 */
 throwNullReferenceException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.NullReferenceException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_NULL_REFERENCE_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -220,7 +228,8 @@ throwNullReferenceException:
 	 */
 throwArithmeticException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.ArithmeticException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_ARITHMETIC_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -228,7 +237,8 @@ throwArithmeticException:
 	 */
 throwOverflowException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.OverflowException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_OVERFLOW_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -236,7 +246,8 @@ throwOverflowException:
 	 */
 throwDivideByZeroException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.DivideByZeroException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_DIVIDE_BY_ZERO_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -244,7 +255,8 @@ throwDivideByZeroException:
 	 */
 throwStackOverflowException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.StackOverflowException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_STACK_OVERFLOW_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -252,7 +264,8 @@ throwStackOverflowException:
 	 */
 throwMissingMethodException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.MissingMethodException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_MISSING_METHOD_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -260,7 +273,8 @@ throwMissingMethodException:
 	 */
 throwInvalidCastException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.InvalidCastException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_INVALID_CAST_EXCEPTION);
 	goto throwException;
 
 	/*
@@ -268,7 +282,8 @@ throwInvalidCastException:
 	 */
 throwIndexOutOfRangeException:
 	COPY_STATE_TO_THREAD();
-	tempptr = _ILSystemException(thread, "System.IndexOutOfRangeException");
+	tempptr = _ILSystemWellKnownException
+		(thread, IL_WKC_INDEX_OUT_OF_RANGE_EXCEPTION);
 	goto throwException;
 }
 VMBREAK(COP_PREFIX_THROW);
@@ -60,6 +60,7 @@ extern	"C" {
 #define	CVMP_LEN_WORD					6
 #define	CVMP_LEN_WORD2					10
 #define	CVMP_LEN_PTR					(2 + sizeof(void *))
+#define	CVMP_LEN_PTR2					(2 + 2 * sizeof(void *))
 #define	CVMP_LEN_WORD_PTR				(6 + sizeof(void *))
 #define	CVMP_LEN_WORD2_PTR				(10 + sizeof(void *))
 #define	CVMP_LEN_WORD2_PTR2				(10 + 2 * sizeof(void *))
@@ -112,6 +113,8 @@ extern	"C" {
 #define	CVMP_ARG_WORD					(IL_READ_UINT32(pc + 2))
 #define	CVMP_ARG_WORD2					(IL_READ_UINT32(pc + 6))
 #define	CVMP_ARG_PTR(type)				((type)(ReadPointer(pc + 2)))
+#define	CVMP_ARG_PTR2(type)				\
+			((type)(ReadPointer(pc + 2 + sizeof(void *))))
 #define	CVMP_ARG_WORD_PTR(type)			((type)(ReadPointer(pc + 6)))
 #define	CVMP_ARG_WORD2_PTR(type)		((type)(ReadPointer(pc + 10)))
 #define	CVMP_ARG_WORD2_PTR2(type)		((type)(ReadPointer(pc + 10 + sizeof(void *))))
@@ -154,6 +157,7 @@ extern	"C" {
 #define	CVMP_LEN_WORD					_CVM_LEN_FROM_WORDS(2)
 #define	CVMP_LEN_WORD2					_CVM_LEN_FROM_WORDS(3)
 #define	CVMP_LEN_PTR					_CVM_LEN_FROM_WORDS(2)
+#define	CVMP_LEN_PTR2					_CVM_LEN_FROM_WORDS(3)
 #define	CVMP_LEN_WORD_PTR				_CVM_LEN_FROM_WORDS(3)
 #define	CVMP_LEN_WORD2_PTR				_CVM_LEN_FROM_WORDS(4)
 #define	CVMP_LEN_WORD2_PTR2				_CVM_LEN_FROM_WORDS(5)
@@ -207,6 +211,7 @@ extern	"C" {
 #define	CVMP_ARG_WORD			CVM_ARG_WORD
 #define	CVMP_ARG_WORD2			CVM_ARG_WORD2
 #define	CVMP_ARG_PTR(type)		CVM_ARG_PTR(type)
+#define	CVMP_ARG_PTR2(type)		CVM_ARG_PTR2(type)
 #define	CVMP_ARG_WORD_PTR(type)			((type)(_CVM_ARG(2)))
 #define	CVMP_ARG_WORD2_PTR(type)		((type)(_CVM_ARG(3)))
 #define	CVMP_ARG_WORD2_PTR2(type)		((type)(_CVM_ARG(4)))
@@ -638,6 +638,233 @@ VMCASE(COP_PREFIX_SARRAY_CLEAR_AI4I4):
 }
 VMBREAK(COP_PREFIX_SARRAY_CLEAR_AI4I4);
 
+/**
+ * <opcode name="strlen" group="Inline methods">
+ *   <operation>Compute the length of a C string</operation>
+ *
+ *   <format>prefix<fsep/>strlen</format>
+ *   <dformat>{strlen}</dformat>
+ *
+ *   <form name="strlen" code="COP_PREFIX_STRLEN"/>
+ *
+ *   <before>..., str</before>
+ *   <after>..., result</after>
+ *
+ *   <description>The <i>str</i> is popped from the stack as the
+ *   type <code>ptr</code>.  The number of bytes before the first
+ *   zero byte at <i>str</i> is pushed onto the stack as the type
+ *   <code>uint32</code>.</description>
+ *
+ *   <notes>This instruction is used to inline calls to the
+ *   <code>strlen</code> function in the C library.</notes>
+ *
+ *   <exceptions>
+ *     <exception name="System.NullReferenceException">Raised if
+ *     <i>str</i> is <code>null</code>.</exception>
+ *   </exceptions>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_STRLEN):
+{
+	/* Compute the length of a C string */
+	BEGIN_NULL_CHECK(stacktop[-1].ptrValue)
+	{
+		stacktop[-1].uintValue =
+			(ILUInt32)strlen((const char *)(stacktop[-1].ptrValue));
+		MODIFY_PC_AND_STACK(CVMP_LEN_NONE, 0);
+	}
+	END_NULL_CHECK();
+}
+VMBREAK(COP_PREFIX_STRLEN);
+
+/**
+ * <opcode name="strcmp" group="Inline methods">
+ *   <operation>Compare two C strings</operation>
+ *
+ *   <format>prefix<fsep/>strcmp</format>
+ *   <dformat>{strcmp}</dformat>
+ *
+ *   <form name="strcmp" code="COP_PREFIX_STRCMP"/>
+ *
+ *   <before>..., str1, str2</before>
+ *   <after>..., result</after>
+ *
+ *   <description>The <i>str1</i> and <i>str2</i> are popped from
+ *   the stack as the type <code>ptr</code>.  The strings are compared
+ *   as unsigned bytes, and the <code>int32</code> <i>result</i> is
+ *   pushed onto the stack.  The <i>result</i> is less than, equal to,
+ *   or greater than zero if <i>str1</i> is less than, equal to, or
+ *   greater than <i>str2</i>.</description>
+ *
+ *   <notes>This instruction is used to inline calls to the
+ *   <code>strcmp</code> function in the C library.</notes>
+ *
+ *   <exceptions>
+ *     <exception name="System.NullReferenceException">Raised if
+ *     <i>str1</i> or <i>str2</i> is <code>null</code>.</exception>
+ *   </exceptions>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_STRCMP):
+{
+	/* Compare two C strings */
+	BEGIN_NULL_CHECK(stacktop[-2].ptrValue && stacktop[-1].ptrValue)
+	{
+		stacktop[-2].intValue =
+			(ILInt32)strcmp((const char *)(stacktop[-2].ptrValue),
+							(const char *)(stacktop[-1].ptrValue));
+		MODIFY_PC_AND_STACK(CVMP_LEN_NONE, -1);
+	}
+	END_NULL_CHECK();
+}
+VMBREAK(COP_PREFIX_STRCMP);
+
+/**
+ * <opcode name="strchr" group="Inline methods">
+ *   <operation>Find a character in a C string</operation>
+ *
+ *   <format>prefix<fsep/>strchr</format>
+ *   <dformat>{strchr}</dformat>
+ *
+ *   <form name="strchr" code="COP_PREFIX_STRCHR"/>
+ *
+ *   <before>..., str, ch</before>
+ *   <after>..., result</after>
+ *
+ *   <description>The <i>str</i> and <i>ch</i> are popped from the
+ *   stack as the types <code>ptr</code> and <code>int32</code>
+ *   respectively.  The <code>ptr</code> <i>result</i> is pushed onto
+ *   the stack, pointing at the first occurrence of <i>ch</i> in
+ *   <i>str</i>, or <code>null</code> if there is none.  The zero
+ *   byte at the end of <i>str</i> is included in the search.</description>
+ *
+ *   <notes>This instruction is used to inline calls to the
+ *   <code>strchr</code> function in the C library.</notes>
+ *
+ *   <exceptions>
+ *     <exception name="System.NullReferenceException">Raised if
+ *     <i>str</i> is <code>null</code>.</exception>
+ *   </exceptions>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_STRCHR):
+{
+	/* Find a character in a C string */
+	BEGIN_NULL_CHECK(stacktop[-2].ptrValue)
+	{
+		stacktop[-2].ptrValue =
+			(void *)strchr((const char *)(stacktop[-2].ptrValue),
+						   (int)(stacktop[-1].intValue));
+		MODIFY_PC_AND_STACK(CVMP_LEN_NONE, -1);
+	}
+	END_NULL_CHECK();
+}
+VMBREAK(COP_PREFIX_STRCHR);
+
+/**
+ * <opcode name="memcmp" group="Inline methods">
+ *   <operation>Compare two blocks of memory</operation>
+ *
+ *   <format>prefix<fsep/>memcmp</format>
+ *   <dformat>{memcmp}</dformat>
+ *
+ *   <form name="memcmp" code="COP_PREFIX_MEMCMP"/>
+ *
+ *   <before>..., ptr1, ptr2, length</before>
+ *   <after>..., result</after>
+ *
+ *   <description>The <i>ptr1</i>, <i>ptr2</i> and <i>length</i> are
+ *   popped from the stack as the types <code>ptr</code>, <code>ptr</code>
+ *   and <code>uint32</code> respectively.  The first <i>length</i> bytes
+ *   at <i>ptr1</i> and <i>ptr2</i> are compared as unsigned bytes, and
+ *   the <code>int32</code> <i>result</i> is pushed onto the stack.
+ *   </description>
+ *
+ *   <notes>This instruction is used to inline calls to the
+ *   <code>memcmp</code> function in the C library.  The pointers are
+ *   not used if <i>length</i> is zero.</notes>
+ *
+ *   <exceptions>
+ *     <exception name="System.NullReferenceException">Raised if
+ *     <i>ptr1</i> or <i>ptr2</i> is <code>null</code>.</exception>
+ *   </exceptions>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_MEMCMP):
+{
+	/* Compare two blocks of memory */
+	tempNum = stacktop[-1].uintValue;
+	if(tempNum == 0)
+	{
+		stacktop[-3].intValue = 0;
+		MODIFY_PC_AND_STACK(CVMP_LEN_NONE, -2);
+	}
+	else
+	{
+		BEGIN_NULL_CHECK(stacktop[-3].ptrValue && stacktop[-2].ptrValue)
+		{
+			stacktop[-3].intValue =
+				(ILInt32)IL_MEMCMP(stacktop[-3].ptrValue,
+								   stacktop[-2].ptrValue, tempNum);
+			MODIFY_PC_AND_STACK(CVMP_LEN_NONE, -2);
+		}
+		END_NULL_CHECK();
+	}
+}
+VMBREAK(COP_PREFIX_MEMCMP);
+
+/**
+ * <opcode name="memchr" group="Inline methods">
+ *   <operation>Find a byte in a block of memory</operation>
+ *
+ *   <format>prefix<fsep/>memchr</format>
+ *   <dformat>{memchr}</dformat>
+ *
+ *   <form name="memchr" code="COP_PREFIX_MEMCHR"/>
+ *
+ *   <before>..., ptr, ch, length</before>
+ *   <after>..., result</after>
+ *
+ *   <description>The <i>ptr</i>, <i>ch</i> and <i>length</i> are
+ *   popped from the stack as the types <code>ptr</code>, <code>int32</code>
+ *   and <code>uint32</code> respectively.  The <code>ptr</code>
+ *   <i>result</i> is pushed onto the stack, pointing at the first
+ *   occurrence of <i>ch</i> in the first <i>length</i> bytes at
+ *   <i>ptr</i>, or <code>null</code> if there is none.</description>
+ *
+ *   <notes>This instruction is used to inline calls to the
+ *   <code>memchr</code> function in the C library.  The pointer is
+ *   not used if <i>length</i> is zero.</notes>
+ *
+ *   <exceptions>
+ *     <exception name="System.NullReferenceException">Raised if
+ *     <i>ptr</i> is <code>null</code>.</exception>
+ *   </exceptions>
+ * </opcode>
+ */
+VMCASE(COP_PREFIX_MEMCHR):
+{
+	/* Find a byte in a block of memory */
+	tempNum = stacktop[-1].uintValue;
+	if(tempNum == 0)
+	{
+		stacktop[-3].ptrValue = 0;
+		MODIFY_PC_AND_STACK(CVMP_LEN_NONE, -2);
+	}
+	else
+	{
+		BEGIN_NULL_CHECK(stacktop[-3].ptrValue)
+		{
+			stacktop[-3].ptrValue =
+				ILMemChr(stacktop[-3].ptrValue,
+						 (int)(stacktop[-2].intValue), tempNum);
+			MODIFY_PC_AND_STACK(CVMP_LEN_NONE, -2);
+		}
+		END_NULL_CHECK();
+	}
+}
+VMBREAK(COP_PREFIX_MEMCHR);
+
 /**
  * <opcode name="abs_i4" group="Inline methods">
  *   <operation>Compute the absolute value of an int</operation>
@@ -1279,7 +1506,7 @@ VMCASE(COP_PREFIX_TANH):
 {
 	COPY_STATE_TO_THREAD();
 	stacktop[0].ptrValue =
-		_ILSystemException(thread, "System.NotImplementedException");
+		_ILSystemWellKnownException(thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION);
 	stacktop += 1;
 	goto throwException;
 }
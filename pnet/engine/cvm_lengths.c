@@ -619,13 +619,23 @@ unsigned char const _ILCVMLengths[512] = {
 	/* profile_start */		CVMP_LEN_NONE,
 	/* profile_end */		CVMP_LEN_NONE,
 
-	/* preserved_94 */		CVMP_LEN_NONE,
-	/* preserved_95 */		CVMP_LEN_NONE,
-	/* preserved_96 */		CVMP_LEN_NONE,
-	/* preserved_97 */		CVMP_LEN_NONE,
-	/* preserved_98 */		CVMP_LEN_NONE,
-	/* preserved_99 */		CVMP_LEN_NONE,
-	/* preserved_9a */		CVMP_LEN_NONE,
+	/*
+	 * Native calls through a direct call stub.
+	 */
+
+	/* call_native_stub */	CVMP_LEN_PTR2,
+	/* call_native_void_stub */ CVMP_LEN_PTR2,
+
+	/*
+	 * Inlined string functions from the C library.
+	 */
+
+	/* strlen */			CVMP_LEN_NONE,
+	/* strcmp */			CVMP_LEN_NONE,
+	/* strchr */			CVMP_LEN_NONE,
+	/* memcmp */			CVMP_LEN_NONE,
+	/* memchr */			CVMP_LEN_NONE,
+
 	/* preserved_9b */		CVMP_LEN_NONE,
 	/* preserved_9c */		CVMP_LEN_NONE,
 	/* preserved_9d */		CVMP_LEN_NONE,
@@ -924,7 +924,7 @@ case COP_DFIXUP:
 {
 	COPY_STATE_TO_THREAD();
 	stacktop[0].ptrValue =
-		_ILSystemException(thread, "System.NotImplementedException");
+		_ILSystemWellKnownException(thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION);
 	stacktop += 1;
 	goto throwException;
 }
@@ -468,6 +468,31 @@ static int CVMCoder_CallInlineable(ILCoder *coder, int inlineType,
 		CASE_INLINEMETHOD(SQRT);
 		CASE_INLINEMETHOD(TAN);
 		CASE_INLINEMETHOD(TANH);
+
+		/*
+		 * Cases for C library string inlines.
+		 */
+		CASE_INLINEMETHOD(STRLEN);
+		CASE_INLINEMETHOD_1(STRCMP);
+		CASE_INLINEMETHOD_1(STRCHR);
+
+		case IL_INLINEMETHOD_MEMCMP:
+		{
+			/* Compare two blocks of memory */
+			CVMP_OUT_NONE(COP_PREFIX_MEMCMP);
+			CVM_ADJUST(-2);
+			return 1;
+		}
+		/* Not reached */
+
+		case IL_INLINEMETHOD_MEMCHR:
+		{
+			/* Find a byte in a block of memory */
+			CVMP_OUT_NONE(COP_PREFIX_MEMCHR);
+			CVM_ADJUST(-2);
+			return 1;
+		}
+		/* Not reached */
 	}
 
 	/* If we get here, then we don't know how to inline the method */
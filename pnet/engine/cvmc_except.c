@@ -117,6 +117,99 @@ static void CVMCoder_RetFromFilter(ILCoder *coder)
 	CVMP_OUT_NONE(COP_PREFIX_RET_FROM_FILTER);
 }
 
+/*
+ * Walk the tree of unwind information blocks to find the innermost
+ * block containing a pc.  Returns the index of the block or -1 if
+ * the pc is not within the method.  The sum of the stack changes
+ * of the blocks on the way is returned in "stackChange".
+ */
+static ILInt32 FindInnermostBlock(const ILCVMUnwind *cvmUnwind,
+								  const unsigned char *pc,
+								  ILInt32 *stackChange)
+{
+	const ILCVMUnwind *block;
+	ILInt32 index = 0;
+	ILInt32 found = -1;
+
+	*stackChange = 0;
+	while(index >= 0)
+	{
+		block = &(cvmUnwind[index]);
+		if(pc < block->start)
+		{
+			break;
+		}
+		else if(pc >= block->end)
+		{
+			index = block->nextNested;
+		}
+		else
+		{
+			found = index;
+			*stackChange += block->stackChange;
+			index = block->nested;
+		}
+	}
+	return found;
+}
+
+/*
+ * Build the sorted pc range table for a method from its unwind
+ * information.  "ranges" must have room for 2 * numBlocks + 1 entries.
+ */
+static void BuildUnwindRanges(ILCVMUnwind *cvmUnwind, ILInt32 numBlocks,
+							  ILCVMUnwindRange *ranges)
+{
+	ILInt32 numRanges;
+	ILInt32 index;
+	ILInt32 posn;
+	unsigned char *pc;
+
+	/* Collect the block boundaries within the method */
+	numRanges = 0;
+	ranges[numRanges++].start = cvmUnwind[0].start;
+	for(index = 1; index <= numBlocks; ++index)
+	{
+		ranges[numRanges++].start = cvmUnwind[index].start;
+		if(cvmUnwind[index].end < cvmUnwind[0].end)
+		{
+			ranges[numRanges++].start = cvmUnwind[index].end;
+		}
+	}
+
+	/* Sort the boundaries.  There are usually only a handful of them,
+	   so a simple insertion sort is good enough */
+	for(index = 1; index < numRanges; ++index)
+	{
+		pc = ranges[index].start;
+		posn = index;
+		while(posn > 0 && ranges[posn - 1].start > pc)
+		{
+			ranges[posn].start = ranges[posn - 1].start;
+			--posn;
+		}
+		ranges[posn].start = pc;
+	}
+
+	/* Assign the innermost block to each range, merging adjacent
+	   ranges that end up in the same block */
+	posn = 0;
+	for(index = 0; index < numRanges; ++index)
+	{
+		pc = ranges[index].start;
+		ranges[posn].start = pc;
+		ranges[posn].block = FindInnermostBlock
+			(cvmUnwind, pc, &(ranges[posn].stackChange));
+		if(posn == 0 || ranges[posn].block != ranges[posn - 1].block)
+		{
+			++posn;
+		}
+	}
+
+	cvmUnwind[0].un.tryBlock.numRanges = posn;
+	cvmUnwind[0].un.tryBlock.ranges = ranges;
+}
+
 static void CVMCoder_OutputExceptionTable(ILCoder *_coder,
 										  ILCoderExceptions *exceptions)
 {
@@ -134,8 +227,10 @@ static void CVMCoder_OutputExceptionTable(ILCoder *_coder,
 		return;
 	}
 
+	/* The range table is stored directly after the unwind information */
 	cvmUnwind = (ILCVMUnwind *)ILCacheAlloc(&(coder->codePosn),
-											(exceptions->numBlocks + 1) * sizeof(ILCVMUnwind));
+											(exceptions->numBlocks + 1) * sizeof(ILCVMUnwind) +
+											(2 * exceptions->numBlocks + 1) * sizeof(ILCVMUnwindRange));
 	if(!cvmUnwind)
 	{
 		return;
@@ -309,6 +404,12 @@ static void CVMCoder_OutputExceptionTable(ILCoder *_coder,
 	 * Set the nested information for the function block.
 	 */
 	cvmUnwind[0].nested = exceptions->firstBlock->userData;
+
+	/*
+	 * Build the pc range table used to locate the innermost block.
+	 */
+	BuildUnwindRanges(cvmUnwind, exceptions->numBlocks,
+					  (ILCVMUnwindRange *)&(cvmUnwind[exceptions->numBlocks + 1]));
 }
 
 /*
@@ -240,6 +240,13 @@ extern	"C" {
 				_CVM_PTR((value1)); \
 				_CVM_PTR((value2)); \
 			} while (0)
+#define	_CVMP_OUT_PTR2(opcode,value1,value2)	\
+			do { \
+				_CVM_BYTE(COP_PREFIX); \
+				_CVM_BYTE((opcode)); \
+				_CVM_PTR((value1)); \
+				_CVM_PTR((value2)); \
+			} while (0)
 
 /*
  * Output an instruction that has a word argument and a pointer argument.
@@ -743,6 +750,12 @@ extern	"C" {
 				_CVM_PTR((value1)); \
 				_CVM_PTR((value2)); \
 			} while (0)
+#define	_CVMP_OUT_PTR2(opcode,value1,value2)	\
+			do { \
+				_CVMP_OPCODE((opcode)); \
+				_CVM_PTR((value1)); \
+				_CVM_PTR((value2)); \
+			} while (0)
 
 /*
  * Output an instruction that has a word argument and a pointer argument.
@@ -1030,6 +1043,8 @@ extern	"C" {
 #define	CVMP_OUT_PTR(opcode,value)	_CVMP_OUT_PTR((opcode), (value))
 #define	CVM_OUT_PTR2(opcode,value1,value2)	\
 			_CVM_OUT_PTR2((opcode), (value1), (value2))
+#define	CVMP_OUT_PTR2(opcode,value1,value2)	\
+			_CVMP_OUT_PTR2((opcode), (value1), (value2))
 #define	CVMP_OUT_WORD_PTR(opcode,value1,value2)	\
 			_CVMP_OUT_WORD_PTR((opcode), (value1), (value2))
 #define	CVMP_OUT_WORD2_PTR(opcode,value1,value2,value3)	\
@@ -1143,6 +1158,11 @@ static void cvm_out_ptr2(ILCoder *coder, int opcode, void *value1, void *value2)
 {
 	_CVM_OUT_PTR2(opcode, value1, value2);
 }
+static void cvmp_out_ptr2(ILCoder *coder, int opcode,
+						  void *value1, void *value2)
+{
+	_CVMP_OUT_PTR2(opcode, value1, value2);
+}
 static void cvmp_out_word2_ptr(ILCoder *coder, int opcode,
 							   ILInt32 value1, ILInt32 value2, void *value3)
 {
@@ -1215,6 +1235,10 @@ static void cvmp_out_word2_ptr2(ILCoder *coder, int opcode,
 	do { \
 		cvm_out_ptr2(((ILCoder *)coder), (opcode), (value1), (value2)); \
 	} while (0)
+#define	CVMP_OUT_PTR2(opcode,value1,value2)	\
+	do { \
+		cvmp_out_ptr2(((ILCoder *)coder), (opcode), (value1), (value2)); \
+	} while (0)
 #define	CVMP_OUT_WORD_PTR(opcode,value1,value2)	\
 			_CVMP_OUT_WORD_PTR((opcode), (value1), (value2))
 #define	CVMP_OUT_WORD2_PTR(opcode,value1,value2,value3)	\
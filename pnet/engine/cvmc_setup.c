@@ -938,6 +938,35 @@ static void CVMEntryPushNativeArgs(CVMEntryContext *ctx, ILCVMCoder *coder,
 	}
 }
 
+/*
+ * Output a native call through a direct call stub, if the
+ * signature described by "cif" can be called that way.
+ * Returns zero if an ordinary "call_native" is required.
+ */
+static int CVMOutNativeStubCall(ILCVMCoder *coder, void *fn,
+								void *cif, int hasReturn)
+{
+#if defined(HAVE_LIBFFI)
+	void *stub = _ILMakeNativeCallStub(cif);
+	if(!stub)
+	{
+		return 0;
+	}
+	if(hasReturn)
+	{
+		CVMP_OUT_PTR2(COP_PREFIX_CALL_NATIVE_STUB, fn, stub);
+		CVM_ADJUST(-1);
+	}
+	else
+	{
+		CVMP_OUT_PTR2(COP_PREFIX_CALL_NATIVE_VOID_STUB, fn, stub);
+	}
+	return 1;
+#else
+	return 0;
+#endif
+}
+
 /*
  * Call a native method.
  */
@@ -996,7 +1025,7 @@ static void CVMEntryCallNative(CVMEntryContext *ctx, ILCVMCoder *coder,
 			CVM_ADJUST(-1);
 		}
 	}
-	else
+	else if(!CVMOutNativeStubCall(coder, fn, cif, hasReturn))
 	{
 		if(hasReturn)
 		{
@@ -1647,7 +1676,7 @@ static void CVMCoder_CallFfi(ILCoder *coder, void *fn, void *cif,
 			CVM_ADJUST(-1);
 		}
 	}
-	else
+	else if(!CVMOutNativeStubCall((ILCVMCoder *)coder, fn, cif, hasReturn))
 	{
 		if(hasReturn)
 		{
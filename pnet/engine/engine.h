@@ -244,6 +244,36 @@ typedef struct
 #include "jitc.h"
 #endif
 
+/*
+ * Well-known classes that are resolved once, when the image that
+ * defines them is loaded, instead of by name every time they are used.
+ */
+#define	IL_WKC_ARITHMETIC_EXCEPTION			0
+#define	IL_WKC_DIVIDE_BY_ZERO_EXCEPTION		1
+#define	IL_WKC_DLL_NOT_FOUND_EXCEPTION		2
+#define	IL_WKC_ENTRY_POINT_NOT_FOUND_EXCEPTION	3
+#define	IL_WKC_EXECUTION_ENGINE_EXCEPTION	4
+#define	IL_WKC_INDEX_OUT_OF_RANGE_EXCEPTION	5
+#define	IL_WKC_INVALID_CAST_EXCEPTION		6
+#define	IL_WKC_MISSING_METHOD_EXCEPTION		7
+#define	IL_WKC_NOT_IMPLEMENTED_EXCEPTION	8
+#define	IL_WKC_NULL_REFERENCE_EXCEPTION		9
+#define	IL_WKC_OUT_OF_MEMORY_EXCEPTION		10
+#define	IL_WKC_OVERFLOW_EXCEPTION			11
+#define	IL_WKC_STACK_OVERFLOW_EXCEPTION		12
+#define	IL_WKC_TYPE_INITIALIZATION_EXCEPTION	13
+#define	IL_WKC_VERIFICATION_EXCEPTION		14
+#define	IL_WKC_ATTRIBUTE					15
+#define	IL_WKC_THREAD						16
+#define	IL_WKC_NUM_CLASSES					17
+
+/*
+ * Well-known methods, which are resolved on first use.
+ */
+#define	IL_WKM_OBJECT_RESOURCE				0
+#define	IL_WKM_THREAD_CTOR					1
+#define	IL_WKM_NUM_METHODS					2
+
 /*
  * Execution control context for a process.
  */
@@ -283,6 +313,14 @@ struct _tagILExecProcess
 	ILClass        *clrTypeClass;
 	ILClass		 *threadAbortClass;
 
+	/* Well-known classes and methods (see "IL_WKC_*" and "IL_WKM_*") */
+	ILClass		   *wellKnownClasses[IL_WKC_NUM_CLASSES];
+	ILMethod	   *wellKnownMethods[IL_WKM_NUM_METHODS];
+
+	/* Cached metadata used when recording exception stack traces */
+	ILField		   *stackTraceField;
+	ILClass		   *packedFrameArrayClass;
+
 	/* The object to throw when the system runs out of memory */
 	ILObject	   *outOfMemoryObject;
 
@@ -295,6 +333,12 @@ struct _tagILExecProcess
 	/* Hash table that contains all intern'ed strings within the system */
 	void		   *internHash;
 
+	/* Hash table that contains the "ffi_cif" structures for native calls */
+	void		   *cifHash;
+
+	/* Hash table that contains the marshalling plans for native closures */
+	void		   *closureThunkHash;
+
 	/* name of this appDomain / ILExecProcess */
 	char		   *friendlyName;
 
@@ -841,6 +885,20 @@ void *_ILMakeCifForMethod(ILExecProcess *process, ILMethod *method,
 void *_ILMakeCifForConstructor(ILExecProcess *process, ILMethod *method,
 								int isInternal);
 
+/*
+ * Get a direct call stub for the native signature described by a
+ * "ffi_cif" structure.  Returns NULL if the signature cannot be
+ * called through a stub on this platform.  Stubs are shared by
+ * all signatures with the same shape, and are never free'd.
+ */
+void *_ILMakeNativeCallStub(void *cif);
+
+/*
+ * Call a native function through a direct call stub.  The arguments
+ * are laid out in the same way as for "ffi_call".
+ */
+void _ILCallNativeStub(void *stub, void *fn, void *rvalue, void **avalue);
+
 /*
  * Make a native closure for a particular delegate.  "method"
  * is the method within the delegate object.
@@ -912,6 +970,36 @@ ILClass *_ILLookupClass(ILExecProcess *process,
 						const char *className,
 						int classNameLen);
 
+/*
+ * Resolve the well-known classes that are defined by an image
+ * that has just been loaded into a process.
+ */
+void _ILResolveWellKnownClasses(ILExecProcess *process, ILImage *image);
+
+/*
+ * Get a well-known class without laying it out.  This may be called
+ * with the metadata lock held.  Returns NULL if the class does not
+ * exist in the system library.
+ */
+ILClass *_ILLookupWellKnownClass(ILExecProcess *process, int index);
+
+/*
+ * Get a well-known class, laid out and ready for use.  Returns NULL
+ * if the class does not exist in the system library.
+ */
+ILClass *_ILWellKnownClass(ILExecThread *thread, int index);
+
+/*
+ * Get the fully-qualified name of a well-known class.
+ */
+const char *_ILWellKnownClassName(int index);
+
+/*
+ * Get a well-known method.  Returns NULL if the method does
+ * not exist in the system library.
+ */
+ILMethod *_ILWellKnownMethod(ILExecThread *thread, int index);
+
 /*
  * Look up an interface method.  Returns NULL if not found.
  */
@@ -1017,6 +1105,13 @@ int _ILSystemObjectSetField(ILExecThread *thread, ILObject* obj,
  */
 void _ILSetExceptionStackTrace(ILExecThread *thread, ILObject *object);
 
+/*
+ * Get the "stackTrace" field within "System.Exception" and the
+ * "PackedStackFrame[]" class.  Both are cached on the process.
+ */
+ILField *_ILExceptionStackTraceField(ILExecThread *thread);
+ILClass *_ILPackedStackFrameArrayClass(ILExecThread *thread);
+
 /*
  * Create a system exception object of a particular class.
  * We do this very carefully, to avoid re-entering the engine.
@@ -1025,6 +1120,11 @@ void _ILSetExceptionStackTrace(ILExecThread *thread, ILObject *object);
  */
 void *_ILSystemException(ILExecThread *thread, const char *className);
 
+/*
+ * Create a system exception object of a well-known class.
+ */
+void *_ILSystemWellKnownException(ILExecThread *thread, int index);
+
 /*
  * Initialize the CVM native code unrolling library.  Returns
  * zero if insufficient memory available.
@@ -46,8 +46,8 @@ static int InitializeClass(ILExecThread *thread, ILClass *classInfo)
 	{
 		/* Throw a "TypeInitializationException" */
 		METADATA_UNLOCK(_ILExecThreadProcess(thread));
-		_ILExecThreadSetException(thread, _ILSystemException
-			(thread, "System.TypeInitializationException"));
+		_ILExecThreadSetException(thread, _ILSystemWellKnownException
+			(thread, IL_WKC_TYPE_INITIALIZATION_EXCEPTION));
 		return 0;
 	}
 
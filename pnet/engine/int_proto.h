@@ -358,6 +358,7 @@ extern ILBool _IL_Debugger_InternalLaunch(ILExecThread * _thread);
 extern void _IL_Debugger_Log(ILExecThread * _thread, ILInt32 level, ILString * category, ILString * message);
 
 extern System_Array * _IL_StackFrame_GetExceptionStackTrace(ILExecThread * _thread);
+extern void _IL_StackFrame_ResolveExceptionStackTrace(ILExecThread * _thread, System_Array * trace);
 extern void _IL_StackFrame_InternalGetMethod(ILExecThread * _thread, void * _result, ILInt32 skipFrames);
 extern ILInt32 _IL_StackFrame_InternalGetILOffset(ILExecThread * _thread, ILInt32 skipFrames);
 extern ILInt32 _IL_StackFrame_InternalGetNativeOffset(ILExecThread * _thread, ILInt32 skipFrames);
@@ -375,6 +376,15 @@ extern ILInt32 _IL_DefaultEncoding_InternalGetMaxByteCount(ILExecThread * _threa
 extern ILInt32 _IL_DefaultEncoding_InternalGetMaxCharCount(ILExecThread * _thread, ILInt32 byteCount);
 extern ILString * _IL_DefaultEncoding_InternalGetString(ILExecThread * _thread, System_Array * bytes, ILInt32 index, ILInt32 count);
 
+extern ILInt32 _IL_UTF8Encoding_InternalDecode(ILExecThread * _thread, System_Array * bytes, ILInt32 byteIndex, ILInt32 byteCount, System_Array * chars, ILInt32 * charIndex);
+extern ILInt32 _IL_UTF8Encoding_InternalEncode_aciiaBRi(ILExecThread * _thread, System_Array * chars, ILInt32 charIndex, ILInt32 charCount, System_Array * bytes, ILInt32 * byteIndex);
+extern ILInt32 _IL_UTF8Encoding_InternalEncode_StringiiaBRi(ILExecThread * _thread, ILString * s, ILInt32 charIndex, ILInt32 charCount, System_Array * bytes, ILInt32 * byteIndex);
+
+extern void _IL_ASCIIEncoding_InternalGetBytes_aciiaBi(ILExecThread * _thread, System_Array * chars, ILInt32 charIndex, ILInt32 charCount, System_Array * bytes, ILInt32 byteIndex);
+extern void _IL_ASCIIEncoding_InternalGetBytes_StringiiaBi(ILExecThread * _thread, ILString * s, ILInt32 charIndex, ILInt32 charCount, System_Array * bytes, ILInt32 byteIndex);
+extern void _IL_ASCIIEncoding_InternalGetChars(ILExecThread * _thread, System_Array * bytes, ILInt32 byteIndex, ILInt32 byteCount, System_Array * chars, ILInt32 charIndex);
+extern ILString * _IL_ASCIIEncoding_InternalGetString(ILExecThread * _thread, System_Array * bytes, ILInt32 index, ILInt32 count);
+
 extern ILObject * _IL_StringBuilder_Append_c(ILExecThread * _thread, ILObject * _this, ILUInt16 value);
 extern ILObject * _IL_StringBuilder_Append_Stringii(ILExecThread * _thread, ILObject * _this, ILString * value, ILInt32 startIndex, ILInt32 length);
 extern ILObject * _IL_StringBuilder_Append_ci(ILExecThread * _thread, ILObject * _this, ILUInt16 value, ILInt32 repeatCount);
@@ -602,8 +612,11 @@ extern void _IL_CryptoMethods_HashFree(ILExecThread * _thread, ILNativeInt state
 extern void _IL_CryptoMethods_HashReset(ILExecThread * _thread, ILNativeInt state);
 extern void _IL_CryptoMethods_HashUpdate(ILExecThread * _thread, ILNativeInt state, System_Array * buffer, ILInt32 offset, ILInt32 count);
 extern void _IL_CryptoMethods_HashFinal(ILExecThread * _thread, ILNativeInt state, System_Array * hash);
+extern void _IL_CryptoMethods_HashBatch(ILExecThread * _thread, ILInt32 algorithm, System_Array * buffer, System_Array * offsets, System_Array * lengths, System_Array * hashes);
 extern void _IL_CryptoMethods_Decrypt(ILExecThread * _thread, ILNativeInt state, System_Array * inBuffer, ILInt32 inOffset, System_Array * outBuffer, ILInt32 outOffset);
 extern void _IL_CryptoMethods_Encrypt(ILExecThread * _thread, ILNativeInt state, System_Array * inBuffer, ILInt32 inOffset, System_Array * outBuffer, ILInt32 outOffset);
+extern void _IL_CryptoMethods_DecryptBlocks(ILExecThread * _thread, ILNativeInt state, ILInt32 mode, System_Array * iv, System_Array * inBuffer, ILInt32 inOffset, System_Array * outBuffer, ILInt32 outOffset, ILInt32 count);
+extern void _IL_CryptoMethods_EncryptBlocks(ILExecThread * _thread, ILNativeInt state, ILInt32 mode, System_Array * iv, System_Array * inBuffer, ILInt32 inOffset, System_Array * outBuffer, ILInt32 outOffset, ILInt32 count);
 extern ILNativeInt _IL_CryptoMethods_EncryptCreate(ILExecThread * _thread, ILInt32 algorithm, System_Array * key);
 extern ILNativeInt _IL_CryptoMethods_DecryptCreate(ILExecThread * _thread, ILInt32 algorithm, System_Array * key);
 extern void _IL_CryptoMethods_SymmetricFree(ILExecThread * _thread, ILNativeInt state);
@@ -748,3 +761,6 @@ extern void _IL_Profiling_StopProfiling(ILExecThread * _thread);
 extern ILBool _IL_Profiling_IsProfilingEnabled(ILExecThread * _thread);
 extern ILBool _IL_Profiling_IsProfilingSupported(ILExecThread * _thread);
 
+extern ILInt32 _IL_XmlParserInput_ScanChars(ILExecThread * _thread, System_Array * buffer, ILInt32 start, ILInt32 end, System_Array * stops);
+extern ILInt32 _IL_XmlParserInput_ScanName(ILExecThread * _thread, System_Array * buffer, ILInt32 start, ILInt32 end);
+
@@ -1678,6 +1678,7 @@ static void marshal_pppipp(void (*fn)(), void *rvalue, void **avalue)
 
 IL_METHOD_BEGIN(StackFrame_Methods)
 	IL_METHOD("GetExceptionStackTrace", "()[vSystem.Diagnostics.PackedStackFrame;", _IL_StackFrame_GetExceptionStackTrace, marshal_pp)
+	IL_METHOD("ResolveExceptionStackTrace", "([vSystem.Diagnostics.PackedStackFrame;)V", _IL_StackFrame_ResolveExceptionStackTrace, marshal_vpp)
 	IL_METHOD("InternalGetMethod", "(i)vSystem.RuntimeMethodHandle;", _IL_StackFrame_InternalGetMethod, marshal_vppi)
 	IL_METHOD("InternalGetILOffset", "(i)i", _IL_StackFrame_InternalGetILOffset, marshal_ipi)
 	IL_METHOD("InternalGetNativeOffset", "(i)i", _IL_StackFrame_InternalGetNativeOffset, marshal_ipi)
@@ -1724,6 +1725,45 @@ IL_METHOD_END
 
 #if !defined(HAVE_LIBFFI)
 
+static void marshal_ippiipp(void (*fn)(), void *rvalue, void **avalue)
+{
+	*((ILNativeInt *)rvalue) = (*(ILInt32 (*)(void *, void *, ILInt32, ILInt32, void *, void *))fn)(*((void * *)(avalue[0])), *((void * *)(avalue[1])), *((ILInt32 *)(avalue[2])), *((ILInt32 *)(avalue[3])), *((void * *)(avalue[4])), *((void * *)(avalue[5])));
+}
+
+#endif
+
+#ifndef _IL_UTF8Encoding_suppressed
+
+IL_METHOD_BEGIN(UTF8Encoding_Methods)
+	IL_METHOD("InternalDecode", "([Bii[c&i)i", _IL_UTF8Encoding_InternalDecode, marshal_ippiipp)
+	IL_METHOD("InternalEncode", "([cii[B&i)i", _IL_UTF8Encoding_InternalEncode_aciiaBRi, marshal_ippiipp)
+	IL_METHOD("InternalEncode", "(oSystem.String;ii[B&i)i", _IL_UTF8Encoding_InternalEncode_StringiiaBRi, marshal_ippiipp)
+IL_METHOD_END
+
+#endif
+
+#if !defined(HAVE_LIBFFI)
+
+static void marshal_vppiipi(void (*fn)(), void *rvalue, void **avalue)
+{
+	(*(void (*)(void *, void *, ILInt32, ILInt32, void *, ILInt32))fn)(*((void * *)(avalue[0])), *((void * *)(avalue[1])), *((ILInt32 *)(avalue[2])), *((ILInt32 *)(avalue[3])), *((void * *)(avalue[4])), *((ILInt32 *)(avalue[5])));
+}
+
+#endif
+
+#ifndef _IL_ASCIIEncoding_suppressed
+
+IL_METHOD_BEGIN(ASCIIEncoding_Methods)
+	IL_METHOD("InternalGetBytes", "([cii[Bi)V", _IL_ASCIIEncoding_InternalGetBytes_aciiaBi, marshal_vppiipi)
+	IL_METHOD("InternalGetBytes", "(oSystem.String;ii[Bi)V", _IL_ASCIIEncoding_InternalGetBytes_StringiiaBi, marshal_vppiipi)
+	IL_METHOD("InternalGetChars", "([Bii[ci)V", _IL_ASCIIEncoding_InternalGetChars, marshal_vppiipi)
+	IL_METHOD("InternalGetString", "([Bii)oSystem.String;", _IL_ASCIIEncoding_InternalGetString, marshal_pppii)
+IL_METHOD_END
+
+#endif
+
+#if !defined(HAVE_LIBFFI)
+
 static void marshal_pppS(void (*fn)(), void *rvalue, void **avalue)
 {
 	*((void * *)rvalue) = (*(void * (*)(void *, void *, ILUInt16))fn)(*((void * *)(avalue[0])), *((void * *)(avalue[1])), *((ILUInt16 *)(avalue[2])));
@@ -2665,6 +2705,24 @@ static void marshal_vpjpipi(void (*fn)(), void *rvalue, void **avalue)
 
 #if !defined(HAVE_LIBFFI)
 
+static void marshal_vpjippipii(void (*fn)(), void *rvalue, void **avalue)
+{
+	(*(void (*)(void *, ILNativeUInt, ILInt32, void *, void *, ILInt32, void *, ILInt32, ILInt32))fn)(*((void * *)(avalue[0])), *((ILNativeUInt *)(avalue[1])), *((ILInt32 *)(avalue[2])), *((void * *)(avalue[3])), *((void * *)(avalue[4])), *((ILInt32 *)(avalue[5])), *((void * *)(avalue[6])), *((ILInt32 *)(avalue[7])), *((ILInt32 *)(avalue[8])));
+}
+
+#endif
+
+#if !defined(HAVE_LIBFFI)
+
+static void marshal_vpipppp(void (*fn)(), void *rvalue, void **avalue)
+{
+	(*(void (*)(void *, ILInt32, void *, void *, void *, void *))fn)(*((void * *)(avalue[0])), *((ILInt32 *)(avalue[1])), *((void * *)(avalue[2])), *((void * *)(avalue[3])), *((void * *)(avalue[4])), *((void * *)(avalue[5])));
+}
+
+#endif
+
+#if !defined(HAVE_LIBFFI)
+
 static void marshal_jpip(void (*fn)(), void *rvalue, void **avalue)
 {
 	*((ILNativeUInt *)rvalue) = (*(ILNativeUInt (*)(void *, ILInt32, void *))fn)(*((void * *)(avalue[0])), *((ILInt32 *)(avalue[1])), *((void * *)(avalue[2])));
@@ -2699,8 +2757,11 @@ IL_METHOD_BEGIN(CryptoMethods_Methods)
 	IL_METHOD("HashReset", "(j)V", _IL_CryptoMethods_HashReset, marshal_vpj)
 	IL_METHOD("HashUpdate", "(j[Bii)V", _IL_CryptoMethods_HashUpdate, marshal_vpjpii)
 	IL_METHOD("HashFinal", "(j[B)V", _IL_CryptoMethods_HashFinal, marshal_vpjp)
+	IL_METHOD("HashBatch", "(i[B[i[i[B)V", _IL_CryptoMethods_HashBatch, marshal_vpipppp)
 	IL_METHOD("Decrypt", "(j[Bi[Bi)V", _IL_CryptoMethods_Decrypt, marshal_vpjpipi)
 	IL_METHOD("Encrypt", "(j[Bi[Bi)V", _IL_CryptoMethods_Encrypt, marshal_vpjpipi)
+	IL_METHOD("DecryptBlocks", "(ji[B[Bi[Bii)V", _IL_CryptoMethods_DecryptBlocks, marshal_vpjippipii)
+	IL_METHOD("EncryptBlocks", "(ji[B[Bi[Bii)V", _IL_CryptoMethods_EncryptBlocks, marshal_vpjippipii)
 	IL_METHOD("EncryptCreate", "(i[B)j", _IL_CryptoMethods_EncryptCreate, marshal_jpip)
 	IL_METHOD("DecryptCreate", "(i[B)j", _IL_CryptoMethods_DecryptCreate, marshal_jpip)
 	IL_METHOD("SymmetricFree", "(j)V", _IL_CryptoMethods_SymmetricFree, marshal_vpj)
@@ -3142,6 +3203,24 @@ IL_METHOD_END
 
 #endif
 
+#if !defined(HAVE_LIBFFI)
+
+static void marshal_ippiip(void (*fn)(), void *rvalue, void **avalue)
+{
+	*((ILNativeInt *)rvalue) = (*(ILInt32 (*)(void *, void *, ILInt32, ILInt32, void *))fn)(*((void * *)(avalue[0])), *((void * *)(avalue[1])), *((ILInt32 *)(avalue[2])), *((ILInt32 *)(avalue[3])), *((void * *)(avalue[4])));
+}
+
+#endif
+
+#ifndef _IL_XmlParserInput_suppressed
+
+IL_METHOD_BEGIN(XmlParserInput_Methods)
+	IL_METHOD("ScanChars", "([cii[c)i", _IL_XmlParserInput_ScanChars, marshal_ippiip)
+	IL_METHOD("ScanName", "([cii)i", _IL_XmlParserInput_ScanName, marshal_ippii)
+IL_METHOD_END
+
+#endif
+
 typedef struct
 {
 	const char *name;
@@ -3150,6 +3229,9 @@ typedef struct
 
 } InternalClassInfo;
 static InternalClassInfo const internalClassTable[] = {
+#ifndef _IL_ASCIIEncoding_suppressed
+	{"ASCIIEncoding", "System.Text", ASCIIEncoding_Methods},
+#endif
 #ifndef _IL_Activator_suppressed
 	{"Activator", "System", Activator_Methods},
 #endif
@@ -3378,11 +3460,17 @@ static InternalClassInfo const internalClassTable[] = {
 #ifndef _IL_TypedReference_suppressed
 	{"TypedReference", "System", TypedReference_Methods},
 #endif
+#ifndef _IL_UTF8Encoding_suppressed
+	{"UTF8Encoding", "System.Text", UTF8Encoding_Methods},
+#endif
 #ifndef _IL_WaitEvent_suppressed
 	{"WaitEvent", "System.Threading", WaitEvent_Methods},
 #endif
 #ifndef _IL_WaitHandle_suppressed
 	{"WaitHandle", "System.Threading", WaitHandle_Methods},
 #endif
+#ifndef _IL_XmlParserInput_suppressed
+	{"XmlParserInput", "System.Xml.Private", XmlParserInput_Methods},
+#endif
 };
 #define numInternalClasses (sizeof(internalClassTable) / sizeof(InternalClassInfo))
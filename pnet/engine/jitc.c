@@ -77,6 +77,20 @@ extern	"C" {
  */
 /* #define _IL_JIT_ENABLE_INLINE 1 */
 
+/*
+ * Omit the bounds and null checks for array accesses in counted loops
+ * over arrays.  This is on by default; comment out the following define
+ * to disable it.
+ */
+#define _IL_JIT_OPTIMIZE_ARRAY_LOOPS 1
+
+/*
+ * The array loop optimization relies on the tracking of locals.
+ */
+#ifndef _IL_JIT_OPTIMIZE_LOCALS
+#undef _IL_JIT_OPTIMIZE_ARRAY_LOOPS
+#endif
+
 #ifdef _IL_JIT_DUMP_FUNCTION
 #ifndef _IL_JIT_ENABLE_DEBUG
 #define _IL_JIT_ENABLE_DEBUG 1
@@ -337,6 +351,31 @@ static ILJitType _ILJitSignature_ILSArrayCopy_AI4AI4I4 = 0;
  */
 static ILJitType _ILJitSignature_ILSArrayClear_AI4I4 = 0;
 
+/*
+ * size_t strlen(const char *str)
+ */
+static ILJitType _ILJitSignature_strlen = 0;
+
+/*
+ * int strcmp(const char *str1, const char *str2)
+ */
+static ILJitType _ILJitSignature_strcmp = 0;
+
+/*
+ * char *strchr(const char *str, int ch)
+ */
+static ILJitType _ILJitSignature_strchr = 0;
+
+/*
+ * int memcmp(const void *ptr1, const void *ptr2, size_t len)
+ */
+static ILJitType _ILJitSignature_memcmp = 0;
+
+/*
+ * void *memchr(const void *ptr, int ch, size_t len)
+ */
+static ILJitType _ILJitSignature_memchr = 0;
+
 #if !defined(IL_CONFIG_REDUCE_CODE) && !defined(IL_WITHOUT_TOOLS)
 #ifdef ENHANCED_PROFILER
 /*
@@ -376,6 +415,7 @@ static void *JITCoder_HandleLockedMethod(ILCoder *coder, ILMethod *method);
 #include "jitc_locals.c"
 #include "jitc_stack.c"
 #include "jitc_labels.c"
+#include "jitc_loops.c"
 #include "jitc_inline.c"
 #include "jitc_except.c"
 #include "jitc_alloc.c"
@@ -434,6 +474,7 @@ struct _tagILJITCoder
 #include "jitc_locals.c"
 #include "jitc_stack.c"
 #include "jitc_labels.c"
+#include "jitc_loops.c"
 #include "jitc_profile.c"
 #include "jitc_except.c"
 #undef	IL_JITC_CODER_INSTANCE
@@ -1980,55 +2021,64 @@ void *_ILJitExceptionHandler(int exception_type)
     {
 		case(JIT_RESULT_OVERFLOW):
 		{
-			object = _ILSystemException(thread, "System.OverflowException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_OVERFLOW_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_ARITHMETIC):
 		{
-			object = _ILSystemException(thread, "System.ArithmeticException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_ARITHMETIC_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_DIVISION_BY_ZERO):
 		{
-			object = _ILSystemException(thread, "System.DivideByZeroException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_DIVIDE_BY_ZERO_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_COMPILE_ERROR):
 		{
-			object = _ILSystemException(thread, "System.ExecutionEngineException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_EXECUTION_ENGINE_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_OUT_OF_MEMORY):
 		{
-			object = _ILSystemException(thread, "System.OutOfMemoryException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_OUT_OF_MEMORY_EXCEPTION);
 		}    
 		break;
 
 		case(JIT_RESULT_NULL_REFERENCE):
 		{
-			object = _ILSystemException(thread, "System.NullReferenceException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_NULL_REFERENCE_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_NULL_FUNCTION):
 		{
-			object = _ILSystemException(thread, "System.MissingMethodException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_MISSING_METHOD_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_CALLED_NESTED):
 		{
-			object = _ILSystemException(thread, "System.MissingMethodException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_MISSING_METHOD_EXCEPTION);
 		}
 		break;
 
 		case(JIT_RESULT_OUT_OF_BOUNDS):
 		{
-			object = _ILSystemException(thread, "System.IndexOutOfRangeException");
+			object = _ILSystemWellKnownException
+				(thread, IL_WKC_INDEX_OUT_OF_RANGE_EXCEPTION);
 		}
 		break;
 
@@ -2563,6 +2613,52 @@ int ILJitInit()
 		return 0;
 	}
 
+	args[0] = _IL_JIT_TYPE_VPTR;
+	returnType = _IL_JIT_TYPE_NUINT;
+	if(!(_ILJitSignature_strlen =
+		jit_type_create_signature(IL_JIT_CALLCONV_CDECL, returnType, args, 1, 1)))
+	{
+		return 0;
+	}
+
+	args[0] = _IL_JIT_TYPE_VPTR;
+	args[1] = _IL_JIT_TYPE_VPTR;
+	returnType = _IL_JIT_TYPE_INT32;
+	if(!(_ILJitSignature_strcmp =
+		jit_type_create_signature(IL_JIT_CALLCONV_CDECL, returnType, args, 2, 1)))
+	{
+		return 0;
+	}
+
+	args[0] = _IL_JIT_TYPE_VPTR;
+	args[1] = _IL_JIT_TYPE_INT32;
+	returnType = _IL_JIT_TYPE_VPTR;
+	if(!(_ILJitSignature_strchr =
+		jit_type_create_signature(IL_JIT_CALLCONV_CDECL, returnType, args, 2, 1)))
+	{
+		return 0;
+	}
+
+	args[0] = _IL_JIT_TYPE_VPTR;
+	args[1] = _IL_JIT_TYPE_VPTR;
+	args[2] = _IL_JIT_TYPE_NUINT;
+	returnType = _IL_JIT_TYPE_INT32;
+	if(!(_ILJitSignature_memcmp =
+		jit_type_create_signature(IL_JIT_CALLCONV_CDECL, returnType, args, 3, 1)))
+	{
+		return 0;
+	}
+
+	args[0] = _IL_JIT_TYPE_VPTR;
+	args[1] = _IL_JIT_TYPE_INT32;
+	args[2] = _IL_JIT_TYPE_NUINT;
+	returnType = _IL_JIT_TYPE_VPTR;
+	if(!(_ILJitSignature_memchr =
+		jit_type_create_signature(IL_JIT_CALLCONV_CDECL, returnType, args, 3, 1)))
+	{
+		return 0;
+	}
+
 #if !defined(IL_CONFIG_REDUCE_CODE) && !defined(IL_WITHOUT_TOOLS)
 #ifdef ENHANCED_PROFILER
 	args[0] = _IL_JIT_TYPE_VPTR;
@@ -2646,6 +2742,7 @@ static ILCoder *JITCoder_Create(ILExecProcess *process, ILUInt32 size,
 #include "jitc_locals.c"
 #include "jitc_stack.c"
 #include "jitc_labels.c"
+#include "jitc_loops.c"
 #include "jitc_profile.c"
 #include "jitc_except.c"
 #undef IL_JITC_CODER_INIT
@@ -2876,6 +2973,7 @@ static void JITCoder_Destroy(ILCoder *_coder)
 #include "jitc_locals.c"
 #include "jitc_stack.c"
 #include "jitc_labels.c"
+#include "jitc_loops.c"
 #include "jitc_profile.c"
 #undef IL_JITC_CODER_DESTROY
 
@@ -3102,7 +3200,8 @@ static void _ILJitEndNativeCall(ILJitFunction func, ILJitValue thread)
 	jit_insn_store_relative(func, thread,
 							offsetof(ILExecThread, runningManagedCode),
 							one);
-	jit_insn_branch_if_not(func, temp, &label);
+	/* Safe point requests are rare, so keep their handling out of line */
+	jit_insn_branch_if_not_weighted(func, temp, &label, 1, 0);
 	jit_insn_call_native(func,
 						 "ILRuntimeHandleManagedSafePointFlags",
 						 ILRuntimeHandleManagedSafePointFlags,
@@ -4995,6 +5094,7 @@ void ILJitBacktrace(void *frame, void *pc, int numFrames)
 #include "jitc_locals.c"
 #include "jitc_stack.c"
 #include "jitc_labels.c"
+#include "jitc_loops.c"
 #include "jitc_inline.c"
 #include "jitc_alloc.c"
 #include "jitc_array.c"
@@ -242,6 +242,13 @@ ILInt32 _ILJitDiagNumFrames(ILExecThread *thread);
  */
 System_Array *_ILJitGetExceptionStackTrace(ILExecThread *thread);
 
+/*
+ * Fill in the IL offsets of a stack trace that was recorded by
+ * _ILJitGetExceptionStackTrace.
+ */
+void _ILJitResolveExceptionStackTrace(ILExecThread *thread,
+									  System_Array *trace);
+
 /*
  * Create the class/struct representation of a clr type for libjit.
  * and store the type in classPrivate.
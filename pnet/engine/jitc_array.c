@@ -680,6 +680,18 @@ static void LoadArrayElem(ILJITCoder *coder, ILJitType type)
 
 	_ILJitStackPop(coder, index);
 	_ILJitStackPop(coder, array);
+	if(_ILJitArrayLoopsIndexIsSafe(coder, &array, &index))
+	{
+		/* The index is the counter of a loop over this array. */
+		arrayBase = _ILJitSArrayGetBase(coder->jitFunction,
+										_ILJitStackItemValue(array));
+		value = jit_insn_load_elem(coder->jitFunction,
+								   arrayBase,
+								   _ILJitStackItemValue(index),
+								   type);
+		_ILJitStackPushValue(coder, value);
+		return;
+	}
 	_ILJitStackItemCheckNull(coder, array);
 	length = _ILJitSArrayGetLength(coder->jitFunction,
 								   _ILJitStackItemValue(array));
@@ -711,10 +723,13 @@ static void StoreArrayElem(ILJITCoder *coder, ILJitType type)
 	_ILJitStackPop(coder, index);
 	_ILJitStackPop(coder, array);
 	valueType = jit_value_get_type(_ILJitStackItemValue(value));
-	_ILJitStackItemCheckNull(coder, array);
-	length = _ILJitSArrayGetLength(coder->jitFunction,
-								   _ILJitStackItemValue(array));
-	ValidateArrayIndex(coder, length, _ILJitStackItemValue(index));
+	if(!_ILJitArrayLoopsIndexIsSafe(coder, &array, &index))
+	{
+		_ILJitStackItemCheckNull(coder, array);
+		length = _ILJitSArrayGetLength(coder->jitFunction,
+									   _ILJitStackItemValue(array));
+		ValidateArrayIndex(coder, length, _ILJitStackItemValue(index));
+	}
 	arrayBase = _ILJitSArrayGetBase(coder->jitFunction,
 									_ILJitStackItemValue(array));
 
@@ -797,10 +812,13 @@ static void JITCoder_ArrayAccess(ILCoder *coder, int opcode,
 			_ILJitStackPop(jitCoder, index);
 			_ILJitStackPop(jitCoder, array);
 
-			_ILJitStackItemCheckNull(jitCoder, array);
-			len = _ILJitSArrayGetLength(jitCoder->jitFunction,
-										_ILJitStackItemValue(array));
-			ValidateArrayIndex(jitCoder, len, _ILJitStackItemValue(index));
+			if(!_ILJitArrayLoopsIndexIsSafe(jitCoder, &array, &index))
+			{
+				_ILJitStackItemCheckNull(jitCoder, array);
+				len = _ILJitSArrayGetLength(jitCoder->jitFunction,
+											_ILJitStackItemValue(array));
+				ValidateArrayIndex(jitCoder, len, _ILJitStackItemValue(index));
+			}
 			arrayBase = _ILJitSArrayGetBase(jitCoder->jitFunction,
 											_ILJitStackItemValue(array));
 
@@ -33,6 +33,7 @@ static void JITCoder_Label(ILCoder *coder, ILUInt32 offset)
 	if(label)
 	{
 		_ILJitValuesResetNullChecked(jitCoder);
+		_ILJitArrayLoopsLabel(jitCoder, offset);
 		if(label->labelType == _IL_JIT_LABEL_STARTCATCH)
 		{
 		#if !defined(IL_CONFIG_REDUCE_CODE) && !defined(IL_WITHOUT_TOOLS)
@@ -1769,6 +1769,168 @@ static int JITCoder_CallInlineable(ILCoder *coder, int inlineType,
 			return 1;
 		}
 		/* Not reached */
+
+		/*
+		 * Cases for C library string inlines.
+		 */
+		case IL_INLINEMETHOD_STRLEN:
+		{
+			/* Compute the length of a C string */
+			_ILJitStackItemNew(stackItem);
+			ILJitValue returnValue;
+			ILJitValue args[1];
+
+			_ILJitStackPop(jitCoder, stackItem);
+			_ILJitStackItemCheckNull(jitCoder, stackItem);
+			args[0] = _ILJitStackItemValue(stackItem);
+			returnValue = jit_insn_call_native(jitCoder->jitFunction,
+											   "strlen",
+											   (void *)strlen,
+											   _ILJitSignature_strlen,
+											   args, 1, JIT_CALL_NOTHROW);
+			returnValue = jit_insn_convert(jitCoder->jitFunction,
+										   returnValue,
+										   _IL_JIT_TYPE_UINT32, 0);
+			_ILJitStackPushValue(jitCoder, returnValue);
+			return 1;
+		}
+		/* Not reached */
+
+		case IL_INLINEMETHOD_STRCMP:
+		{
+			/* Compare two C strings */
+			_ILJitStackItemNew(stackItem1);
+			_ILJitStackItemNew(stackItem2);
+			ILJitValue returnValue;
+			ILJitValue args[2];
+
+			_ILJitStackPop(jitCoder, stackItem2);
+			_ILJitStackPop(jitCoder, stackItem1);
+			_ILJitStackItemCheckNull(jitCoder, stackItem1);
+			_ILJitStackItemCheckNull(jitCoder, stackItem2);
+			args[0] = _ILJitStackItemValue(stackItem1);
+			args[1] = _ILJitStackItemValue(stackItem2);
+			returnValue = jit_insn_call_native(jitCoder->jitFunction,
+											   "strcmp",
+											   (void *)strcmp,
+											   _ILJitSignature_strcmp,
+											   args, 2, JIT_CALL_NOTHROW);
+			_ILJitStackPushValue(jitCoder, returnValue);
+			return 1;
+		}
+		/* Not reached */
+
+		case IL_INLINEMETHOD_STRCHR:
+		{
+			/* Find a character in a C string */
+			_ILJitStackItemNew(stackItem1);
+			_ILJitStackItemNew(stackItem2);
+			ILJitValue returnValue;
+			ILJitValue args[2];
+
+			_ILJitStackPop(jitCoder, stackItem2);
+			_ILJitStackPop(jitCoder, stackItem1);
+			_ILJitStackItemCheckNull(jitCoder, stackItem1);
+			args[0] = _ILJitStackItemValue(stackItem1);
+			args[1] = _ILJitStackItemValue(stackItem2);
+			returnValue = jit_insn_call_native(jitCoder->jitFunction,
+											   "strchr",
+											   (void *)strchr,
+											   _ILJitSignature_strchr,
+											   args, 2, JIT_CALL_NOTHROW);
+			_ILJitStackPushValue(jitCoder, returnValue);
+			return 1;
+		}
+		/* Not reached */
+
+		case IL_INLINEMETHOD_MEMCMP:
+		{
+			/* Compare two blocks of memory.  The pointers are not used
+			   and the result is zero if the length is zero */
+			_ILJitStackItemNew(stackItem1);
+			_ILJitStackItemNew(stackItem2);
+			_ILJitStackItemNew(stackItem3);
+			ILJitValue returnValue = jit_value_create(jitCoder->jitFunction,
+													  _IL_JIT_TYPE_INT32);
+			ILJitValue temp;
+			ILJitValue args[3];
+			jit_label_t label = jit_label_undefined;
+
+			_ILJitStackPop(jitCoder, stackItem3);
+			_ILJitStackPop(jitCoder, stackItem2);
+			_ILJitStackPop(jitCoder, stackItem1);
+			args[0] = _ILJitStackItemValue(stackItem1);
+			args[1] = _ILJitStackItemValue(stackItem2);
+
+			/* Zero-extend the uint32 length to the size of a size_t */
+			args[2] = jit_insn_convert(jitCoder->jitFunction,
+									   _ILJitStackItemValue(stackItem3),
+									   _IL_JIT_TYPE_UINT32, 0);
+			args[2] = jit_insn_convert(jitCoder->jitFunction, args[2],
+									   _IL_JIT_TYPE_NUINT, 0);
+
+			jit_insn_store(jitCoder->jitFunction, returnValue,
+						   jit_value_create_nint_constant(jitCoder->jitFunction,
+														  _IL_JIT_TYPE_INT32,
+														  0));
+			jit_insn_branch_if_not(jitCoder->jitFunction, args[2], &label);
+			jit_insn_check_null(jitCoder->jitFunction, args[0]);
+			jit_insn_check_null(jitCoder->jitFunction, args[1]);
+			temp = jit_insn_call_native(jitCoder->jitFunction,
+										"memcmp",
+										(void *)memcmp,
+										_ILJitSignature_memcmp,
+										args, 3, JIT_CALL_NOTHROW);
+			jit_insn_store(jitCoder->jitFunction, returnValue, temp);
+			jit_insn_label(jitCoder->jitFunction, &label);
+			_ILJitStackPushValue(jitCoder, returnValue);
+			return 1;
+		}
+		/* Not reached */
+
+		case IL_INLINEMETHOD_MEMCHR:
+		{
+			/* Find a byte in a block of memory.  The pointer is not used
+			   and the result is null if the length is zero */
+			_ILJitStackItemNew(stackItem1);
+			_ILJitStackItemNew(stackItem2);
+			_ILJitStackItemNew(stackItem3);
+			ILJitValue returnValue = jit_value_create(jitCoder->jitFunction,
+													  _IL_JIT_TYPE_VPTR);
+			ILJitValue temp;
+			ILJitValue args[3];
+			jit_label_t label = jit_label_undefined;
+
+			_ILJitStackPop(jitCoder, stackItem3);
+			_ILJitStackPop(jitCoder, stackItem2);
+			_ILJitStackPop(jitCoder, stackItem1);
+			args[0] = _ILJitStackItemValue(stackItem1);
+			args[1] = _ILJitStackItemValue(stackItem2);
+
+			/* Zero-extend the uint32 length to the size of a size_t */
+			args[2] = jit_insn_convert(jitCoder->jitFunction,
+									   _ILJitStackItemValue(stackItem3),
+									   _IL_JIT_TYPE_UINT32, 0);
+			args[2] = jit_insn_convert(jitCoder->jitFunction, args[2],
+									   _IL_JIT_TYPE_NUINT, 0);
+
+			jit_insn_store(jitCoder->jitFunction, returnValue,
+						   jit_value_create_nint_constant(jitCoder->jitFunction,
+														  _IL_JIT_TYPE_VPTR,
+														  0));
+			jit_insn_branch_if_not(jitCoder->jitFunction, args[2], &label);
+			jit_insn_check_null(jitCoder->jitFunction, args[0]);
+			temp = jit_insn_call_native(jitCoder->jitFunction,
+										"memchr",
+										(void *)memchr,
+										_ILJitSignature_memchr,
+										args, 3, JIT_CALL_NOTHROW);
+			jit_insn_store(jitCoder->jitFunction, returnValue, temp);
+			jit_insn_label(jitCoder->jitFunction, &label);
+			_ILJitStackPushValue(jitCoder, returnValue);
+			return 1;
+		}
+		/* Not reached */
 	}
 	/* If we get here, then we don't know how to inline the method */
 	return 0;
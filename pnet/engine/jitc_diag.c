@@ -114,22 +114,25 @@ ILInt32 _ILJitDiagNumFrames(ILExecThread *thread)
 
 /*
  * Get the current PackedStackFrame.
+ *
+ * Only the method and the native offset from the start of the jitted
+ * code are recorded for each frame.  The IL offsets are filled in by
+ * "_ILJitResolveExceptionStackTrace" when the trace is inspected.
  */
 System_Array *_ILJitGetExceptionStackTrace(ILExecThread *thread)
 {
 	ILInt32 num = 0;
 	ILJITCoder *jitCoder = (ILJITCoder *)(_ILExecThreadProcess(thread)->coder);
-	jit_stack_trace_t stackTrace = jit_exception_get_stack_trace();
+	jit_stack_trace_t stackTrace;
 
 	if(!jitCoder)
 	{
 		return 0;
 	}
 
+	stackTrace = jit_exception_get_stack_trace();
 	if(stackTrace)
 	{
-		/* Get the number of frames on the stack, and also determine
-		   where the exception constructors stop and real code starts */
 		ILUInt32 size = jit_stack_trace_get_size(stackTrace);
 		ILJitFunction jitFunction;
 		ILMethod *method;
@@ -137,52 +140,38 @@ System_Array *_ILJitGetExceptionStackTrace(ILExecThread *thread)
 		PackedStackFrame *data;
 		ILClass *classInfo;
 		ILUInt32 current;
-
-		for(current = 0; current < size; ++current)
-		{
-			jitFunction = jit_stack_trace_get_function(jitCoder->context,
-													   stackTrace, current);
-			if(jitFunction)
-			{
-				if(jit_function_get_meta(jitFunction, IL_JIT_META_METHOD) != 0)
-				{
-					++num;
-				}
-
-			}
-		}
+		ILInt32 max;
 
 		/* Put an upper limit on the number of frames so that we
-		   don't arbitrarily blow up the exception handling system */
-		if(num > 256)
-		{
-			num = 256;
-		}
+		   don't arbitrarily blow up the exception handling system.
+		   Not every frame is a managed method, so the array may end
+		   up shorter than this */
+		max = (size > 256 ? 256 : (ILInt32)size);
 
 		/* Allocate an array for the packed stack data.  We cannot
 		   use "ILExecThreadNew" because it will re-enter the engine.
 		   If we are throwing "StackOverflowException", then we will
 		   get an infinite recursive loop */
-		classInfo = ILExecThreadLookupClass
-				(thread, "[vSystem.Diagnostics.PackedStackFrame;");
+		classInfo = _ILPackedStackFrameArrayClass(thread);
 		if(!classInfo)
 		{
+			jit_stack_trace_free(stackTrace);
 			ILExecThreadThrowOutOfMemory(thread);
 			return 0;
 		}
 		array = _ILEngineAlloc(thread, classInfo,
 							   sizeof(System_Array) +
-							   		num * sizeof(PackedStackFrame));
+							   		max * sizeof(PackedStackFrame));
 		if(!array)
 		{
+			jit_stack_trace_free(stackTrace);
 			return 0;
 		}
-		ArrayLength(array) = num;
 
 		/* Fill the array with the packed stack data */
 		data = (PackedStackFrame *)ArrayToBuffer(array);
 		current = 0;
-		while(current < size && num > 0)
+		while(current < size && num < max)
 		{
 			jitFunction = jit_stack_trace_get_function(jitCoder->context,
 													   stackTrace, current);
@@ -192,19 +181,18 @@ System_Array *_ILJitGetExceptionStackTrace(ILExecThread *thread)
 													IL_JIT_META_METHOD)) != 0)
 				{
 					data->method = method;
-					data->offset = jit_stack_trace_get_offset(jitCoder->context,
-															  stackTrace,
-															  current);
-					/* Get the native pc  */
-					/* TODO: make nativeOffset a void *. */
-					data->nativeOffset = (ILInt32)jit_stack_trace_get_pc(stackTrace,
-																		 current);
+					data->offset = IL_PACKED_FRAME_UNRESOLVED;
+					data->nativeOffset = (ILInt32)
+						((unsigned char *)jit_stack_trace_get_pc(stackTrace,
+																 current) -
+						 (unsigned char *)jit_function_get_code_start(jitFunction));
 					++data;
-					--num;
+					++num;
 				}
 			}
 			++current;
 		}
+		ArrayLength(array) = num;
 		jit_stack_trace_free(stackTrace);
 
 		/* Done */
@@ -213,3 +201,44 @@ System_Array *_ILJitGetExceptionStackTrace(ILExecThread *thread)
 	return 0;
 }
 
+/*
+ * Fill in the IL offsets of a stack trace that was recorded by
+ * "_ILJitGetExceptionStackTrace".
+ */
+void _ILJitResolveExceptionStackTrace(ILExecThread *thread,
+									  System_Array *trace)
+{
+	ILInt32 num;
+	PackedStackFrame *data;
+	ILJitFunction jitFunction;
+	unsigned char *pc;
+	unsigned int offset;
+
+	if(!trace)
+	{
+		return;
+	}
+	num = ArrayLength(trace);
+	data = (PackedStackFrame *)ArrayToBuffer(trace);
+	while(num > 0)
+	{
+		if(data->offset == IL_PACKED_FRAME_UNRESOLVED)
+		{
+			offset = JIT_NO_OFFSET;
+			jitFunction = ILJitFunctionFromILMethod(data->method);
+			if(jitFunction)
+			{
+				pc = (unsigned char *)jit_function_get_code_start(jitFunction);
+				if(pc)
+				{
+					offset = jit_function_get_bytecode_offset
+						(jitFunction, pc + data->nativeOffset);
+				}
+			}
+			data->offset = (offset == JIT_NO_OFFSET ? -1 : (ILInt32)offset);
+		}
+		++data;
+		--num;
+	}
+}
+
@@ -82,9 +82,7 @@ static void _ILJitFindAndSetStackTrace(ILJITCoder *jitCoder, ILJitValue exceptio
 	ILField *field;
 
 	/* Find the "stackTrace" field within the "Exception" class */
-	field = ILExecThreadLookupField
-			(_thread, "System.Exception", "stackTrace",
-			 "[vSystem.Diagnostics.PackedStackFrame;");
+	field = _ILExceptionStackTraceField(_thread);
 	if(field)
 	{
 		/* Get the stack trace and pop the frame */
@@ -106,16 +104,15 @@ static void _ILJitFindAndSetStackTrace(ILJITCoder *jitCoder, ILJitValue exceptio
 static void _ILJitThrowSystem(ILJitFunction jitFunction,
 							  ILUInt32 exception)
 {
-	static const char * const exceptionClasses[] = {
-		"Ok",
-		"System.OutOfMemoryException",
-		"System.InvalidCastException",
-		"System.IndexOutOfRangeException",
-		"System.MissingMethodException",
-		"System.DllNotFoundException",
-		"System.EntryPointNotFoundException"
+	static const int exceptionClasses[] = {
+		-1,
+		IL_WKC_OUT_OF_MEMORY_EXCEPTION,
+		IL_WKC_INVALID_CAST_EXCEPTION,
+		IL_WKC_INDEX_OUT_OF_RANGE_EXCEPTION,
+		IL_WKC_MISSING_METHOD_EXCEPTION,
+		IL_WKC_DLL_NOT_FOUND_EXCEPTION,
+		IL_WKC_ENTRY_POINT_NOT_FOUND_EXCEPTION
 	};
-	#define	numExceptions	(sizeof(exceptionClasses) / sizeof(const char *))
 	ILExecThread *_thread = ILExecThreadCurrent();
 
 	if(exception == _IL_JIT_OUT_OF_MEMORY)
@@ -129,20 +126,18 @@ static void _ILJitThrowSystem(ILJitFunction jitFunction,
 	}
 	if(exception > 0)
 	{
-		ILClass *classInfo = _ILLookupClass(_ILExecThreadProcess(_thread),
-											exceptionClasses[exception],
-											strlen(exceptionClasses[exception]));
+		ILClass *classInfo = _ILLookupWellKnownClass
+			(_ILExecThreadProcess(_thread), exceptionClasses[exception]);
 		ILJitValue info;
 		if(!classInfo)
 		{
 		#ifndef REDUCED_STDIO
 			/* Huh?  The required class doesn't exist.  This shouldn't happen */
 			fprintf(stderr, "Fatal error: %s is missing from the system library\n",
-					exceptionClasses[exception]);
+					_ILWellKnownClassName(exceptionClasses[exception]));
 			return;
 		#endif
 		}
-		classInfo = ILClassResolve(classInfo);
 		if(!(classInfo->userData) || 
 			(((ILClassPrivate *)(classInfo->userData))->inLayout))
 		{
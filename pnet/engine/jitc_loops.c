@@ -0,0 +1,811 @@
+/*
+ * jitc_loops.c - Jit coder handling of counted loops over arrays.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifdef IL_JITC_DECLARATIONS
+
+#ifdef _IL_JIT_OPTIMIZE_ARRAY_LOOPS
+
+/*
+ * Description of a counted loop over a simple array found in the IL code
+ * of the method being compiled.  This is the form emitted by the compilers
+ * for "for(i = 0; i < a.Length; ++i)" and for "foreach" over an array:
+ *
+ *			ldc.i4	n				(n >= 0)
+ *			stloc	i
+ *			br		COND
+ *	BODY:	...						(no stores to i or a)
+ *	INCR:	ldloc	i
+ *			ldc.i4.1
+ *			add
+ *			stloc	i
+ *	COND:	ldloc	i
+ *			ldloc	a				(or ldarg a)
+ *			ldlen
+ *			conv.i4
+ *			blt		BODY
+ *
+ * The body can only be entered through the "blt" so while the body is
+ * coded 0 <= i < a.Length holds and a is not null.
+ */
+typedef struct _tagILJitArrayLoop ILJitArrayLoop;
+struct _tagILJitArrayLoop
+{
+	ILUInt32	bodyStart;		/* IL offset of the first body instruction */
+	ILUInt32	incrStart;		/* IL offset of the index increment */
+	ILUInt32	indexNum;		/* Number of the local holding the index */
+	ILUInt32	arrayNum;		/* Number of the local or arg holding the array */
+	int			arrayIsArg;		/* The array is held in an argument */
+	int			isActive;		/* The loop body is currently coded */
+};
+
+/*
+ * IL instruction decoded while looking for array loops.
+ * Local and argument accesses, constant loads and branches are
+ * normalized to the long form of the opcode.
+ */
+typedef struct _tagILJitLoopInsn ILJitLoopInsn;
+struct _tagILJitLoopInsn
+{
+	ILUInt32	offset;			/* IL offset of the instruction */
+	int			opcode;			/* Normalized opcode */
+	ILInt32		arg;			/* Local/arg number, constant or jump target */
+};
+
+/*
+ * Branch found while looking for array loops.
+ */
+typedef struct _tagILJitLoopBranch ILJitLoopBranch;
+struct _tagILJitLoopBranch
+{
+	ILUInt32	src;			/* IL offset of the branch instruction */
+	ILUInt32	dest;			/* IL offset of the branch target */
+};
+
+/*
+ * Find the counted loops over arrays in the IL code of the method.
+ * Returns 0 on failure.
+ */
+static int _ILJitArrayLoopsFind(ILJITCoder *coder, ILMethodCode *code,
+								ILCoderExceptions *coderExceptions);
+
+/*
+ * Update the state of the array loops at a label.
+ */
+static void _ILJitArrayLoopsLabel(ILJITCoder *coder, ILUInt32 offset);
+
+/*
+ * Update the state of the array loops on a store to a local.
+ */
+static void _ILJitArrayLoopsStoreLocal(ILJITCoder *coder, ILUInt32 localNum);
+
+/*
+ * Update the state of the array loops on a store to an argument.
+ */
+static void _ILJitArrayLoopsStoreArg(ILJITCoder *coder, ILUInt32 argNum);
+
+/*
+ * Check if the index is known to be within the bounds of the array.
+ * Returns 1 if the bounds and null checks can be omitted.
+ */
+static int _ILJitArrayLoopsIndexIsSafe(ILJITCoder *coder,
+									   ILJitStackItem *array,
+									   ILJitStackItem *index);
+
+#else	/* !_IL_JIT_OPTIMIZE_ARRAY_LOOPS */
+
+#define _ILJitArrayLoopsFind(coder, code, coderExceptions)	1
+#define _ILJitArrayLoopsLabel(coder, offset)
+#define _ILJitArrayLoopsStoreLocal(coder, localNum)
+#define _ILJitArrayLoopsStoreArg(coder, argNum)
+#define _ILJitArrayLoopsIndexIsSafe(coder, array, index)	0
+
+#endif	/* !_IL_JIT_OPTIMIZE_ARRAY_LOOPS */
+
+#endif	/* IL_JITC_DECLARATIONS */
+
+#ifdef	IL_JITC_CODER_INSTANCE
+#ifdef _IL_JIT_OPTIMIZE_ARRAY_LOOPS
+
+	/* The counted array loops in the current method. */
+	ILJitArrayLoop *arrayLoops;
+	int				numArrayLoops;
+	int				maxArrayLoops;
+
+#endif	/* _IL_JIT_OPTIMIZE_ARRAY_LOOPS */
+#endif	/* IL_JITC_CODER_INSTANCE */
+
+#ifdef	IL_JITC_CODER_INIT
+#ifdef _IL_JIT_OPTIMIZE_ARRAY_LOOPS
+
+	/* Init the array loop stuff. */
+	coder->arrayLoops = 0;
+	coder->numArrayLoops = 0;
+	coder->maxArrayLoops = 0;
+
+#endif	/* _IL_JIT_OPTIMIZE_ARRAY_LOOPS */
+#endif	/* IL_JITC_CODER_INIT */
+
+#ifdef	IL_JITC_CODER_DESTROY
+#ifdef _IL_JIT_OPTIMIZE_ARRAY_LOOPS
+
+	if(coder->arrayLoops)
+	{
+		ILFree(coder->arrayLoops);
+		coder->arrayLoops = 0;
+	}
+
+#endif	/* _IL_JIT_OPTIMIZE_ARRAY_LOOPS */
+#endif	/* IL_JITC_CODER_DESTROY */
+
+#ifdef IL_JITC_FUNCTIONS
+#ifdef _IL_JIT_OPTIMIZE_ARRAY_LOOPS
+
+/*
+ * Decode the IL code of a method.
+ * The buffers must be large enough to hold code->codeLen entries.
+ * Returns the number of instructions decoded.
+ */
+static ILUInt32 _ILJitLoopsDecode(ILMethodCode *code, ILJitLoopInsn *insns,
+								  ILJitLoopBranch *branches,
+								  ILUInt32 *numBranches)
+{
+	unsigned char *start = (unsigned char *)(code->code);
+	unsigned char *pc = start;
+	ILUInt32 len = code->codeLen;
+	ILUInt32 numInsns = 0;
+	ILUInt32 insnSize;
+	ILUInt32 offset;
+	ILUInt32 numCases;
+	int opcode;
+	int argType;
+
+	*numBranches = 0;
+	while(len > 0)
+	{
+		offset = (ILUInt32)(pc - start);
+		opcode = pc[0];
+		if(opcode != IL_OP_PREFIX)
+		{
+			insnSize = (ILUInt32)(ILMainOpcodeSmallTable[opcode].size);
+			argType = ILMainOpcodeSmallTable[opcode].args;
+		}
+		else
+		{
+			opcode = pc[1];
+			insnSize = (ILUInt32)(ILPrefixOpcodeSmallTable[opcode].size);
+			argType = ILPrefixOpcodeSmallTable[opcode].args;
+			opcode += IL_OP_PREFIX;
+		}
+		insns[numInsns].offset = offset;
+		insns[numInsns].opcode = opcode;
+		insns[numInsns].arg = 0;
+
+		switch(argType)
+		{
+			case IL_OPCODE_ARGS_SHORT_JUMP:
+			{
+				insns[numInsns].arg = (ILInt32)(offset + insnSize) +
+									  (ILInt32)(ILInt8)(pc[1]);
+			}
+			break;
+
+			case IL_OPCODE_ARGS_LONG_JUMP:
+			{
+				insns[numInsns].arg = (ILInt32)(offset + insnSize) +
+									  IL_READ_INT32(pc + 1);
+			}
+			break;
+
+			case IL_OPCODE_ARGS_SHORT_VAR:
+			case IL_OPCODE_ARGS_SHORT_ARG:
+			{
+				insns[numInsns].arg = (ILInt32)(pc[1]);
+			}
+			break;
+
+			case IL_OPCODE_ARGS_LONG_VAR:
+			case IL_OPCODE_ARGS_LONG_ARG:
+			{
+				insns[numInsns].arg = (ILInt32)IL_READ_UINT16(pc + 2);
+			}
+			break;
+
+			case IL_OPCODE_ARGS_INT8:
+			{
+				insns[numInsns].arg = (ILInt32)(ILInt8)(pc[1]);
+			}
+			break;
+
+			case IL_OPCODE_ARGS_INT32:
+			{
+				insns[numInsns].arg = IL_READ_INT32(pc + 1);
+			}
+			break;
+
+			case IL_OPCODE_ARGS_SWITCH:
+			{
+				numCases = IL_READ_UINT32(pc + 1);
+				insnSize = 5 + numCases * 4;
+				while(numCases > 0)
+				{
+					--numCases;
+					branches[*numBranches].src = offset;
+					branches[*numBranches].dest =
+						offset + insnSize +
+						(ILUInt32)IL_READ_INT32(pc + 5 + numCases * 4);
+					++(*numBranches);
+				}
+			}
+			break;
+
+			case IL_OPCODE_ARGS_ANN_DATA:
+			{
+				if(opcode == IL_OP_ANN_DATA_S)
+				{
+					insnSize = (((ILUInt32)(pc[1])) & 0xFF) + 2;
+				}
+				else
+				{
+					insnSize = (IL_READ_UINT32(pc + 2) + 6);
+				}
+			}
+			break;
+
+			case IL_OPCODE_ARGS_ANN_PHI:
+			{
+				insnSize = ((ILUInt32)IL_READ_UINT16(pc + 1)) * 2 + 3;
+			}
+			break;
+		}
+
+		/* Normalize the opcodes we are interested in */
+		switch(opcode)
+		{
+			case IL_OP_LDLOC_0:
+			case IL_OP_LDLOC_1:
+			case IL_OP_LDLOC_2:
+			case IL_OP_LDLOC_3:
+			{
+				insns[numInsns].arg = opcode - IL_OP_LDLOC_0;
+				insns[numInsns].opcode = IL_OP_LDLOC_S;
+			}
+			break;
+
+			case IL_OP_STLOC_0:
+			case IL_OP_STLOC_1:
+			case IL_OP_STLOC_2:
+			case IL_OP_STLOC_3:
+			{
+				insns[numInsns].arg = opcode - IL_OP_STLOC_0;
+				insns[numInsns].opcode = IL_OP_STLOC_S;
+			}
+			break;
+
+			case IL_OP_LDARG_0:
+			case IL_OP_LDARG_1:
+			case IL_OP_LDARG_2:
+			case IL_OP_LDARG_3:
+			{
+				insns[numInsns].arg = opcode - IL_OP_LDARG_0;
+				insns[numInsns].opcode = IL_OP_LDARG_S;
+			}
+			break;
+
+			case IL_OP_PREFIX + IL_PREFIX_OP_LDLOC:
+			{
+				insns[numInsns].opcode = IL_OP_LDLOC_S;
+			}
+			break;
+
+			case IL_OP_PREFIX + IL_PREFIX_OP_STLOC:
+			{
+				insns[numInsns].opcode = IL_OP_STLOC_S;
+			}
+			break;
+
+			case IL_OP_PREFIX + IL_PREFIX_OP_LDLOCA:
+			{
+				insns[numInsns].opcode = IL_OP_LDLOCA_S;
+			}
+			break;
+
+			case IL_OP_PREFIX + IL_PREFIX_OP_LDARG:
+			{
+				insns[numInsns].opcode = IL_OP_LDARG_S;
+			}
+			break;
+
+			case IL_OP_PREFIX + IL_PREFIX_OP_STARG:
+			{
+				insns[numInsns].opcode = IL_OP_STARG_S;
+			}
+			break;
+
+			case IL_OP_PREFIX + IL_PREFIX_OP_LDARGA:
+			{
+				insns[numInsns].opcode = IL_OP_LDARGA_S;
+			}
+			break;
+
+			case IL_OP_LDC_I4_M1:
+			case IL_OP_LDC_I4_0:
+			case IL_OP_LDC_I4_1:
+			case IL_OP_LDC_I4_2:
+			case IL_OP_LDC_I4_3:
+			case IL_OP_LDC_I4_4:
+			case IL_OP_LDC_I4_5:
+			case IL_OP_LDC_I4_6:
+			case IL_OP_LDC_I4_7:
+			case IL_OP_LDC_I4_8:
+			{
+				insns[numInsns].arg = opcode - IL_OP_LDC_I4_0;
+				insns[numInsns].opcode = IL_OP_LDC_I4;
+			}
+			break;
+
+			case IL_OP_LDC_I4_S:
+			{
+				insns[numInsns].opcode = IL_OP_LDC_I4;
+			}
+			break;
+
+			case IL_OP_BR_S:
+			{
+				insns[numInsns].opcode = IL_OP_BR;
+			}
+			break;
+
+			case IL_OP_BLT_S:
+			{
+				insns[numInsns].opcode = IL_OP_BLT;
+			}
+			break;
+		}
+
+		if(argType == IL_OPCODE_ARGS_SHORT_JUMP ||
+		   argType == IL_OPCODE_ARGS_LONG_JUMP)
+		{
+			branches[*numBranches].src = offset;
+			branches[*numBranches].dest = (ILUInt32)(insns[numInsns].arg);
+			++(*numBranches);
+		}
+
+		++numInsns;
+		pc += insnSize;
+		len -= insnSize;
+	}
+	return numInsns;
+}
+
+/*
+ * Find the index of the instruction at an IL offset.
+ * Returns -1 if there is no instruction starting at the offset.
+ */
+static ILInt32 _ILJitLoopsFindInsn(ILJitLoopInsn *insns, ILUInt32 numInsns,
+								   ILUInt32 offset)
+{
+	ILUInt32 left = 0;
+	ILUInt32 right = numInsns;
+	ILUInt32 middle;
+
+	while(left < right)
+	{
+		middle = left + (right - left) / 2;
+		if(insns[middle].offset == offset)
+		{
+			return (ILInt32)middle;
+		}
+		else if(insns[middle].offset < offset)
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			right = middle;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Check if the instruction at position "n" is an access of the given kind
+ * to the local or argument "num".
+ */
+#define _ILJitLoopsIsInsn(insns, n, op, num) \
+	(((insns)[(n)].opcode == (op)) && ((insns)[(n)].arg == (ILInt32)(num)))
+
+/*
+ * Check if the blt instruction at position "n" closes a counted array loop.
+ * Returns 1 and fills in the loop if it does.
+ */
+static int _ILJitLoopsMatch(ILJITCoder *coder, ILMethodCode *code,
+							ILCoderExceptions *coderExceptions,
+							ILJitLoopInsn *insns, ILUInt32 numInsns,
+							ILJitLoopBranch *branches, ILUInt32 numBranches,
+							ILUInt32 n, ILJitArrayLoop *loop)
+{
+	ILUInt32 indexNum;
+	ILUInt32 arrayNum;
+	int arrayIsArg;
+	ILUInt32 initStart;
+	ILUInt32 condStart;
+	ILUInt32 loopEnd;
+	ILInt32 body;
+	ILInt32 current;
+	ILUInt32 block;
+
+	if(n < 8 || insns[n].opcode != IL_OP_BLT ||
+	   (ILUInt32)(insns[n].arg) >= insns[n].offset)
+	{
+		return 0;
+	}
+
+	/* The loop condition: "ldloc i; ldloc|ldarg a; ldlen; conv.i4; blt" */
+	if(insns[n - 1].opcode != IL_OP_CONV_I4 ||
+	   insns[n - 2].opcode != IL_OP_LDLEN ||
+	   insns[n - 4].opcode != IL_OP_LDLOC_S)
+	{
+		return 0;
+	}
+	indexNum = (ILUInt32)(insns[n - 4].arg);
+	arrayNum = (ILUInt32)(insns[n - 3].arg);
+	if(insns[n - 3].opcode == IL_OP_LDLOC_S)
+	{
+		arrayIsArg = 0;
+		if(arrayNum >= coder->jitLocals.numSlots || arrayNum == indexNum)
+		{
+			return 0;
+		}
+	}
+	else if(insns[n - 3].opcode == IL_OP_LDARG_S)
+	{
+		arrayIsArg = 1;
+		if(arrayNum >= coder->jitParams.numSlots)
+		{
+			return 0;
+		}
+	}
+	else
+	{
+		return 0;
+	}
+	if(indexNum >= coder->jitLocals.numSlots)
+	{
+		return 0;
+	}
+
+	/* The increment: "ldloc i; ldc.i4.1; add; stloc i" */
+	if(!_ILJitLoopsIsInsn(insns, n - 8, IL_OP_LDLOC_S, indexNum) ||
+	   !_ILJitLoopsIsInsn(insns, n - 7, IL_OP_LDC_I4, 1) ||
+	   insns[n - 6].opcode != IL_OP_ADD ||
+	   !_ILJitLoopsIsInsn(insns, n - 5, IL_OP_STLOC_S, indexNum))
+	{
+		return 0;
+	}
+
+	/* The initialization: "ldc.i4 n; stloc i; br COND" just before the body */
+	condStart = insns[n - 4].offset;
+	body = _ILJitLoopsFindInsn(insns, numInsns, (ILUInt32)(insns[n].arg));
+	if(body < 3 || body > (ILInt32)(n - 8))
+	{
+		return 0;
+	}
+	if(!_ILJitLoopsIsInsn(insns, body - 1, IL_OP_BR, condStart) ||
+	   !_ILJitLoopsIsInsn(insns, body - 2, IL_OP_STLOC_S, indexNum) ||
+	   insns[body - 3].opcode != IL_OP_LDC_I4 ||
+	   insns[body - 3].arg < 0)
+	{
+		return 0;
+	}
+	initStart = insns[body - 3].offset;
+	loopEnd = insns[n].offset;
+
+	/* Neither the index nor the array may be stored to in the body */
+	for(current = body; current < (ILInt32)(n - 8); ++current)
+	{
+		if(_ILJitLoopsIsInsn(insns, current, IL_OP_STLOC_S, indexNum))
+		{
+			return 0;
+		}
+		if(arrayIsArg)
+		{
+			if(_ILJitLoopsIsInsn(insns, current, IL_OP_STARG_S, arrayNum))
+			{
+				return 0;
+			}
+		}
+		else if(_ILJitLoopsIsInsn(insns, current, IL_OP_STLOC_S, arrayNum))
+		{
+			return 0;
+		}
+	}
+
+	/* Neither the index nor the array may have their address taken */
+	for(current = 0; current < (ILInt32)numInsns; ++current)
+	{
+		if(_ILJitLoopsIsInsn(insns, current, IL_OP_LDLOCA_S, indexNum))
+		{
+			return 0;
+		}
+		if(arrayIsArg)
+		{
+			if(_ILJitLoopsIsInsn(insns, current, IL_OP_LDARGA_S, arrayNum))
+			{
+				return 0;
+			}
+		}
+		else if(_ILJitLoopsIsInsn(insns, current, IL_OP_LDLOCA_S, arrayNum))
+		{
+			return 0;
+		}
+	}
+
+	/* The only way into the loop from outside is the "br COND" */
+	for(block = 0; block < numBranches; ++block)
+	{
+		if(branches[block].dest > initStart && branches[block].dest <= loopEnd)
+		{
+			if(branches[block].src >= insns[body].offset &&
+			   branches[block].src <= loopEnd)
+			{
+				continue;
+			}
+			if(branches[block].src == insns[body - 1].offset &&
+			   branches[block].dest == condStart)
+			{
+				continue;
+			}
+			return 0;
+		}
+	}
+
+	/* Exception blocks must be nested completely in the body */
+	for(block = 0; block < coderExceptions->numBlocks; ++block)
+	{
+		ILCoderExceptionBlock *exception = &(coderExceptions->blocks[block]);
+
+		if((exception->startOffset > initStart &&
+			exception->startOffset <= loopEnd) ||
+		   (exception->endOffset > initStart &&
+			exception->endOffset <= loopEnd))
+		{
+			if(exception->startOffset < insns[body].offset ||
+			   exception->endOffset > insns[n - 8].offset)
+			{
+				return 0;
+			}
+		}
+	}
+
+	loop->bodyStart = insns[body].offset;
+	loop->incrStart = insns[n - 8].offset;
+	loop->indexNum = indexNum;
+	loop->arrayNum = arrayNum;
+	loop->arrayIsArg = arrayIsArg;
+	loop->isActive = 0;
+	return 1;
+}
+
+/*
+ * Find the counted loops over arrays in the IL code of the method.
+ */
+static int _ILJitArrayLoopsFind(ILJITCoder *coder, ILMethodCode *code,
+								ILCoderExceptions *coderExceptions)
+{
+	ILJitLoopInsn *insns;
+	ILJitLoopBranch *branches;
+	ILUInt32 numInsns;
+	ILUInt32 numBranches;
+	ILUInt32 current;
+	ILJitArrayLoop loop;
+
+	coder->numArrayLoops = 0;
+	if(code->codeLen < 16)
+	{
+		/* The method is too small to contain an array loop. */
+		return 1;
+	}
+
+	insns = (ILJitLoopInsn *)ILMalloc(code->codeLen * sizeof(ILJitLoopInsn));
+	if(!insns)
+	{
+		return 0;
+	}
+	branches = (ILJitLoopBranch *)ILMalloc(code->codeLen *
+										   sizeof(ILJitLoopBranch));
+	if(!branches)
+	{
+		ILFree(insns);
+		return 0;
+	}
+
+	numInsns = _ILJitLoopsDecode(code, insns, branches, &numBranches);
+	for(current = 0; current < numInsns; ++current)
+	{
+		if(!_ILJitLoopsMatch(coder, code, coderExceptions,
+							 insns, numInsns, branches, numBranches,
+							 current, &loop))
+		{
+			continue;
+		}
+		if(coder->numArrayLoops >= coder->maxArrayLoops)
+		{
+			ILJitArrayLoop *newLoops = (ILJitArrayLoop *)
+				ILRealloc(coder->arrayLoops,
+						  (coder->maxArrayLoops + 4) * sizeof(ILJitArrayLoop));
+			if(!newLoops)
+			{
+				ILFree(branches);
+				ILFree(insns);
+				return 0;
+			}
+			coder->arrayLoops = newLoops;
+			coder->maxArrayLoops += 4;
+		}
+		coder->arrayLoops[coder->numArrayLoops++] = loop;
+
+	#if !defined(IL_CONFIG_REDUCE_CODE) && !defined(IL_WITHOUT_TOOLS)
+		if(coder->flags & IL_CODER_FLAG_STATS)
+		{
+			ILMutexLock(globalTraceMutex);
+			fprintf(stdout,
+				"ArrayLoop: body %i, increment %i\n",
+				loop.bodyStart, loop.incrStart);
+			ILMutexUnlock(globalTraceMutex);
+		}
+	#endif
+	}
+
+	ILFree(branches);
+	ILFree(insns);
+	return 1;
+}
+
+/*
+ * Get the slot of the array of an array loop.
+ */
+#define _ILJitArrayLoopArraySlot(coder, loop) \
+	((loop)->arrayIsArg ? \
+		&_ILJitLocalSlotFromSlots((coder)->jitParams, (loop)->arrayNum) : \
+		&_ILJitLocalSlotFromSlots((coder)->jitLocals, (loop)->arrayNum))
+
+/*
+ * Get the slot of the index of an array loop.
+ */
+#define _ILJitArrayLoopIndexSlot(coder, loop) \
+	(&_ILJitLocalSlotFromSlots((coder)->jitLocals, (loop)->indexNum))
+
+/*
+ * Update the state of the array loops at a label.
+ */
+static void _ILJitArrayLoopsLabel(ILJITCoder *coder, ILUInt32 offset)
+{
+	int current;
+
+#ifdef	_IL_JIT_ENABLE_INLINE
+	if(coder->currentInlineContext)
+	{
+		return;
+	}
+#endif	/* _IL_JIT_ENABLE_INLINE */
+
+	for(current = 0; current < coder->numArrayLoops; ++current)
+	{
+		ILJitArrayLoop *loop = &(coder->arrayLoops[current]);
+
+		loop->isActive = (offset >= loop->bodyStart &&
+						  offset < loop->incrStart);
+		if(loop->isActive)
+		{
+			/* The ldlen in the loop condition checked the array for null. */
+			_ILJitLocalSlotSetFlags(*_ILJitArrayLoopArraySlot(coder, loop),
+									_IL_JIT_VALUE_NULLCHECKED);
+		}
+	}
+}
+
+/*
+ * Update the state of the array loops on a store to a local.
+ */
+static void _ILJitArrayLoopsStoreLocal(ILJITCoder *coder, ILUInt32 localNum)
+{
+	int current;
+
+#ifdef	_IL_JIT_ENABLE_INLINE
+	if(coder->currentInlineContext)
+	{
+		return;
+	}
+#endif	/* _IL_JIT_ENABLE_INLINE */
+
+	for(current = 0; current < coder->numArrayLoops; ++current)
+	{
+		ILJitArrayLoop *loop = &(coder->arrayLoops[current]);
+
+		if(loop->indexNum == localNum ||
+		   (!(loop->arrayIsArg) && loop->arrayNum == localNum))
+		{
+			loop->isActive = 0;
+		}
+	}
+}
+
+/*
+ * Update the state of the array loops on a store to an argument.
+ */
+static void _ILJitArrayLoopsStoreArg(ILJITCoder *coder, ILUInt32 argNum)
+{
+	int current;
+
+#ifdef	_IL_JIT_ENABLE_INLINE
+	if(coder->currentInlineContext)
+	{
+		return;
+	}
+#endif	/* _IL_JIT_ENABLE_INLINE */
+
+	for(current = 0; current < coder->numArrayLoops; ++current)
+	{
+		ILJitArrayLoop *loop = &(coder->arrayLoops[current]);
+
+		if(loop->arrayIsArg && loop->arrayNum == argNum)
+		{
+			loop->isActive = 0;
+		}
+	}
+}
+
+/*
+ * Check if the index is known to be within the bounds of the array.
+ */
+static int _ILJitArrayLoopsIndexIsSafe(ILJITCoder *coder,
+									   ILJitStackItem *array,
+									   ILJitStackItem *index)
+{
+	int current;
+
+#ifdef	_IL_JIT_ENABLE_INLINE
+	if(coder->currentInlineContext)
+	{
+		return 0;
+	}
+#endif	/* _IL_JIT_ENABLE_INLINE */
+
+	if(!(array->flags & _IL_JIT_VALUE_COPYOF) ||
+	   !(index->flags & _IL_JIT_VALUE_COPYOF))
+	{
+		return 0;
+	}
+	for(current = 0; current < coder->numArrayLoops; ++current)
+	{
+		ILJitArrayLoop *loop = &(coder->arrayLoops[current]);
+
+		if(loop->isActive &&
+		   index->refValue == _ILJitArrayLoopIndexSlot(coder, loop) &&
+		   array->refValue == _ILJitArrayLoopArraySlot(coder, loop))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+#endif	/* _IL_JIT_OPTIMIZE_ARRAY_LOOPS */
+#endif	/* IL_JITC_FUNCTIONS */
@@ -92,6 +92,12 @@ static int JITCoder_Setup(ILCoder *_coder, unsigned char **start,
 	{
 		return 0;
 	}
+
+	/* Find the counted loops over arrays. */
+	if(!_ILJitArrayLoopsFind(coder, code, coderExceptions))
+	{
+		return 0;
+	}
 #ifdef _IL_JIT_OPTIMIZE_INIT_LOCALS
 	coder->localsInitialized = 0;
 #endif
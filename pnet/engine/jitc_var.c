@@ -81,6 +81,7 @@ static void JITCoder_StoreArg(ILCoder *coder, ILUInt32 argNum,
 	}
 #endif
 
+	_ILJitArrayLoopsStoreArg(jitCoder, argNum);
 	_ILJitStackPopToArg(jitCoder, argNum);
 }
 
@@ -103,6 +104,7 @@ static void JITCoder_StoreLocal(ILCoder *coder, ILUInt32 localNum,
 	}
 #endif
 
+	_ILJitArrayLoopsStoreLocal(jitCoder, localNum);
 	_ILJitStackPopToLocal(jitCoder, localNum);
 }
 
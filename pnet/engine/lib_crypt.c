@@ -57,6 +57,18 @@ extern	"C" {
 #define	IL_ALG_RSA_SIGN			11
 #define	IL_ALG_RIPEMD160		12
 
+/*
+ * Cipher modes for the bulk symmetric functions.
+ */
+#define	IL_MODE_ECB				0
+#define	IL_MODE_CBC				1
+#define	IL_MODE_CTR				2
+
+/*
+ * Largest block size of any of the symmetric algorithms.
+ */
+#define	IL_MAX_BLOCK_SIZE		16
+
 /*
  * Hash context header.
  */
@@ -78,11 +90,17 @@ typedef struct
 typedef void (*SymResetFunc)(void *ctx);
 typedef void (*SymCryptFunc)(void *ctx, unsigned char *input,
 							 unsigned char *output);
+typedef void (*SymBulkFunc)(void *ctx, int mode, unsigned char *iv,
+							unsigned char *input, unsigned char *output,
+							unsigned long numBlocks);
 typedef struct
 {
 	SymResetFunc	reset;
 	SymCryptFunc	encrypt;
 	SymCryptFunc	decrypt;
+	SymBulkFunc		encryptBlocks;
+	SymBulkFunc		decryptBlocks;
+	int				blockSize;
 
 } SymContext;
 
@@ -319,7 +337,8 @@ ILNativeInt _IL_CryptoMethods_HashNew(ILExecThread *_thread, ILInt32 algorithm)
 		/* Not reached */
 	}
 	_ILExecThreadSetException(_thread,
-			_ILSystemException(_thread, "System.NotImplementedException"));
+			_ILSystemWellKnownException
+				(_thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION));
 	return 0;
 }
 
@@ -365,6 +384,157 @@ void _IL_CryptoMethods_HashFinal(ILExecThread *_thread, ILNativeInt state,
 	}
 }
 
+/*
+ * Get the size of the hash values that are output by an algorithm.
+ */
+static ILInt32 HashSize(ILInt32 algorithm)
+{
+	switch(algorithm)
+	{
+		case IL_ALG_MD5:		return IL_MD5_HASH_SIZE;
+		case IL_ALG_SHA1:		return IL_SHA_HASH_SIZE;
+		case IL_ALG_SHA256:		return IL_SHA256_HASH_SIZE;
+		case IL_ALG_SHA384:		return IL_SHA384_HASH_SIZE;
+		case IL_ALG_SHA512:		return IL_SHA512_HASH_SIZE;
+		case IL_ALG_RIPEMD160:	return IL_RIPEMD160_HASH_SIZE;
+	}
+	return 0;
+}
+
+/*
+ * public static void HashBatch(int algorithm, byte[] buffer,
+ *                              int[] offsets, int[] lengths,
+ *                              byte[] hashes);
+ */
+void _IL_CryptoMethods_HashBatch(ILExecThread *_thread, ILInt32 algorithm,
+								 System_Array *buffer, System_Array *offsets,
+								 System_Array *lengths, System_Array *hashes)
+{
+	unsigned char *data;
+	ILInt32 *offs;
+	ILInt32 *lens;
+	unsigned char *output;
+	ILInt32 length;
+	ILInt32 count;
+	ILInt32 size;
+	ILNativeInt state;
+	ILInt32 posn;
+
+	/* Validate the parameters */
+	if(!buffer)
+	{
+		ILExecThreadThrowArgNull(_thread, "buffer");
+		return;
+	}
+	if(!offsets)
+	{
+		ILExecThreadThrowArgNull(_thread, "offsets");
+		return;
+	}
+	if(!lengths)
+	{
+		ILExecThreadThrowArgNull(_thread, "lengths");
+		return;
+	}
+	if(!hashes)
+	{
+		ILExecThreadThrowArgNull(_thread, "hashes");
+		return;
+	}
+	data = (unsigned char *)(ArrayToBuffer(buffer));
+	offs = (ILInt32 *)(ArrayToBuffer(offsets));
+	lens = (ILInt32 *)(ArrayToBuffer(lengths));
+	output = (unsigned char *)(ArrayToBuffer(hashes));
+	length = ArrayLength(buffer);
+	count = ArrayLength(offsets);
+	if(ArrayLength(lengths) != count)
+	{
+		ILExecThreadThrowArgRange(_thread, "lengths", "Arg_InvalidArrayRange");
+		return;
+	}
+	for(posn = 0; posn < count; ++posn)
+	{
+		if(offs[posn] < 0 || offs[posn] > length)
+		{
+			ILExecThreadThrowArgRange(_thread, "offsets", "ArgRange_Array");
+			return;
+		}
+		if(lens[posn] < 0 || lens[posn] > (length - offs[posn]))
+		{
+			ILExecThreadThrowArgRange
+				(_thread, "lengths", "Arg_InvalidArrayRange");
+			return;
+		}
+	}
+	size = HashSize(algorithm);
+	if(!size)
+	{
+		_ILExecThreadSetException(_thread,
+				_ILSystemWellKnownException
+					(_thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION));
+		return;
+	}
+	if((ArrayLength(hashes) / size) < count)
+	{
+		ILExecThreadThrowArgRange(_thread, "hashes", "Arg_InvalidArrayRange");
+		return;
+	}
+	if(count <= 0)
+	{
+		return;
+	}
+
+	if(algorithm == IL_ALG_SHA256)
+	{
+		/* SHA-256 can hash several messages side by side */
+		const unsigned char **messages;
+		unsigned long *messageLens;
+		messages = (const unsigned char **)
+			ILMalloc(count * sizeof(const unsigned char *));
+		messageLens = (unsigned long *)
+			ILMalloc(count * sizeof(unsigned long));
+		if(!messages || !messageLens)
+		{
+			if(messages)
+			{
+				ILFree(messages);
+			}
+			if(messageLens)
+			{
+				ILFree(messageLens);
+			}
+			ILExecThreadThrowOutOfMemory(_thread);
+			return;
+		}
+		for(posn = 0; posn < count; ++posn)
+		{
+			messages[posn] = data + offs[posn];
+			messageLens[posn] = (unsigned long)(lens[posn]);
+		}
+		ILSHA256Batch(messages, messageLens, output, (unsigned long)count);
+		ILFree(messages);
+		ILFree(messageLens);
+		return;
+	}
+
+	/* Hash the messages one at a time, reusing a single context */
+	state = _IL_CryptoMethods_HashNew(_thread, algorithm);
+	if(!state)
+	{
+		return;
+	}
+	for(posn = 0; posn < count; ++posn)
+	{
+		(*(((HashContext *)state)->reset))(&(((MD5HashContext *)state)->md5));
+		(*(((HashContext *)state)->update))
+			(&(((MD5HashContext *)state)->md5),
+			 data + offs[posn], (unsigned long)(lens[posn]));
+		(*(((HashContext *)state)->final))
+			(&(((MD5HashContext *)state)->md5), output + posn * size);
+	}
+	_IL_CryptoMethods_HashFree(_thread, state);
+}
+
 /*
  * void HashFree(IntPtr state);
  */
@@ -541,6 +711,120 @@ void _IL_CryptoMethods_GenerateRandom(ILExecThread *thread,
 	ILMutexUnlock(thread->process->randomLock);
 }
 
+/*
+ * Process a run of blocks in a particular cipher mode, using
+ * the single block function of a symmetric algorithm.
+ */
+static void SymCryptBlocks(SymContext *context, SymCryptFunc func,
+						   int decrypt, int mode, unsigned char *iv,
+						   unsigned char *input, unsigned char *output,
+						   unsigned long numBlocks)
+{
+	void *ctx = &(((RC2Context *)context)->rc2);
+	int size = context->blockSize;
+	unsigned char temp[IL_MAX_BLOCK_SIZE];
+	int posn;
+	while(numBlocks > 0)
+	{
+		switch(mode)
+		{
+			case IL_MODE_CBC:
+			{
+				if(decrypt)
+				{
+					ILMemCpy(temp, input, size);
+					(*func)(ctx, input, output);
+					for(posn = 0; posn < size; ++posn)
+					{
+						output[posn] ^= iv[posn];
+					}
+					ILMemCpy(iv, temp, size);
+				}
+				else
+				{
+					for(posn = 0; posn < size; ++posn)
+					{
+						iv[posn] ^= input[posn];
+					}
+					(*func)(ctx, iv, iv);
+					ILMemCpy(output, iv, size);
+				}
+			}
+			break;
+
+			case IL_MODE_CTR:
+			{
+				/* The counter is always run forwards through the cipher */
+				(*(context->encrypt))(ctx, iv, temp);
+				for(posn = size - 1; posn >= 0; --posn)
+				{
+					if(++(iv[posn]) != 0)
+					{
+						break;
+					}
+				}
+				for(posn = 0; posn < size; ++posn)
+				{
+					output[posn] = (unsigned char)(input[posn] ^ temp[posn]);
+				}
+			}
+			break;
+
+			default:
+			{
+				(*func)(ctx, input, output);
+			}
+			break;
+		}
+		input += size;
+		output += size;
+		--numBlocks;
+	}
+	ILMemZero(temp, sizeof(temp));
+}
+
+/*
+ * Bulk functions for AES/Rijndael.
+ */
+static void AESEncryptBlocks(void *ctx, int mode, unsigned char *iv,
+							 unsigned char *input, unsigned char *output,
+							 unsigned long numBlocks)
+{
+	switch(mode)
+	{
+		case IL_MODE_CBC:
+			ILAESEncryptCBC((ILAESContext *)ctx, iv, input, output, numBlocks);
+			break;
+
+		case IL_MODE_CTR:
+			ILAESCryptCTR((ILAESContext *)ctx, iv, input, output, numBlocks);
+			break;
+
+		default:
+			ILAESEncryptECB((ILAESContext *)ctx, input, output, numBlocks);
+			break;
+	}
+}
+static void AESDecryptBlocks(void *ctx, int mode, unsigned char *iv,
+							 unsigned char *input, unsigned char *output,
+							 unsigned long numBlocks)
+{
+	switch(mode)
+	{
+		case IL_MODE_CBC:
+			ILAESDecryptCBC((ILAESContext *)ctx, iv, input, output, numBlocks);
+			break;
+
+		case IL_MODE_CTR:
+			ILAESCryptCTR((ILAESContext *)ctx, iv, input, output, numBlocks);
+			break;
+
+		default:
+			ILAESDecryptECB((ILAESContext *)ctx, input, output, numBlocks);
+			break;
+	}
+}
+
 /*
  * public static IntPtr EncryptCreate(int algorithm, byte[] key);
  */
@@ -563,6 +847,9 @@ ILNativeInt _IL_CryptoMethods_EncryptCreate(ILExecThread *_thread,
 			context->reset = (SymResetFunc)ILDESFinalize;
 			context->encrypt = (SymCryptFunc)ILDESProcess;
 			context->decrypt = (SymCryptFunc)ILDESProcess;
+			context->encryptBlocks = 0;
+			context->decryptBlocks = 0;
+			context->blockSize = 8;
 			ILDESInit(&(((DESContext *)context)->des),
 					  ArrayToBuffer(key), 0);
 			return (ILNativeInt)context;
@@ -581,6 +868,9 @@ ILNativeInt _IL_CryptoMethods_EncryptCreate(ILExecThread *_thread,
 			context->reset = (SymResetFunc)ILDES3Finalize;
 			context->encrypt = (SymCryptFunc)ILDES3Process;
 			context->decrypt = (SymCryptFunc)ILDES3Process;
+			context->encryptBlocks = 0;
+			context->decryptBlocks = 0;
+			context->blockSize = 8;
 			ILDES3Init(&(((DES3Context *)context)->des3),
 					   ArrayToBuffer(key), (int)(ArrayLength(key) * 8), 0);
 			return (ILNativeInt)context;
@@ -599,6 +889,9 @@ ILNativeInt _IL_CryptoMethods_EncryptCreate(ILExecThread *_thread,
 			context->reset = (SymResetFunc)ILRC2Finalize;
 			context->encrypt = (SymCryptFunc)ILRC2Encrypt;
 			context->decrypt = (SymCryptFunc)ILRC2Decrypt;
+			context->encryptBlocks = 0;
+			context->decryptBlocks = 0;
+			context->blockSize = 8;
 			ILRC2Init(&(((RC2Context *)context)->rc2),
 					  ArrayToBuffer(key), (int)(ArrayLength(key) * 8));
 			return (ILNativeInt)context;
@@ -617,6 +910,9 @@ ILNativeInt _IL_CryptoMethods_EncryptCreate(ILExecThread *_thread,
 			context->reset = (SymResetFunc)ILAESFinalize;
 			context->encrypt = (SymCryptFunc)ILAESEncrypt;
 			context->decrypt = (SymCryptFunc)ILAESDecrypt;
+			context->encryptBlocks = AESEncryptBlocks;
+			context->decryptBlocks = AESDecryptBlocks;
+			context->blockSize = 16;
 			ILAESInit(&(((AESContext *)context)->aes),
 					  ArrayToBuffer(key), (int)(ArrayLength(key) * 8));
 			return (ILNativeInt)context;
@@ -624,7 +920,8 @@ ILNativeInt _IL_CryptoMethods_EncryptCreate(ILExecThread *_thread,
 		/* Not reached */
 	}
 	_ILExecThreadSetException(_thread,
-			_ILSystemException(_thread, "System.NotImplementedException"));
+			_ILSystemWellKnownException
+				(_thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION));
 	return 0;
 }
 
@@ -653,6 +950,9 @@ ILNativeInt _IL_CryptoMethods_DecryptCreate(ILExecThread *_thread,
 			context->reset = (SymResetFunc)ILDESFinalize;
 			context->encrypt = (SymCryptFunc)ILDESProcess;
 			context->decrypt = (SymCryptFunc)ILDESProcess;
+			context->encryptBlocks = 0;
+			context->decryptBlocks = 0;
+			context->blockSize = 8;
 			ILDESInit(&(((DESContext *)context)->des),
 					  ArrayToBuffer(key), 1);
 			return (ILNativeInt)context;
@@ -671,6 +971,9 @@ ILNativeInt _IL_CryptoMethods_DecryptCreate(ILExecThread *_thread,
 			context->reset = (SymResetFunc)ILDES3Finalize;
 			context->encrypt = (SymCryptFunc)ILDES3Process;
 			context->decrypt = (SymCryptFunc)ILDES3Process;
+			context->encryptBlocks = 0;
+			context->decryptBlocks = 0;
+			context->blockSize = 8;
 			ILDES3Init(&(((DES3Context *)context)->des3),
 					   ArrayToBuffer(key), (int)(ArrayLength(key) * 8), 1);
 			return (ILNativeInt)context;
@@ -719,6 +1022,80 @@ void _IL_CryptoMethods_Decrypt(ILExecThread *_thread,
 	}
 }
 
+/*
+ * public static void EncryptBlocks(IntPtr state, int mode, byte[] iv,
+ *									byte[] inBuffer, int inOffset,
+ *									byte[] outBuffer, int outOffset,
+ *									int count);
+ */
+void _IL_CryptoMethods_EncryptBlocks(ILExecThread *_thread,
+									 ILNativeInt state, ILInt32 mode,
+									 System_Array *iv, System_Array *inBuffer,
+									 ILInt32 inOffset, System_Array *outBuffer,
+									 ILInt32 outOffset, ILInt32 count)
+{
+	SymContext *context = (SymContext *)state;
+	unsigned char *input;
+	unsigned char *output;
+	unsigned char *ivBuffer;
+	unsigned long numBlocks;
+	if(context && count > 0)
+	{
+		input = ((unsigned char *)(ArrayToBuffer(inBuffer))) + inOffset;
+		output = ((unsigned char *)(ArrayToBuffer(outBuffer))) + outOffset;
+		ivBuffer = (iv ? (unsigned char *)(ArrayToBuffer(iv)) : 0);
+		numBlocks = (unsigned long)(count / context->blockSize);
+		if(context->encryptBlocks)
+		{
+			(*(context->encryptBlocks))
+				(&(((RC2Context *)state)->rc2), (int)mode,
+				 ivBuffer, input, output, numBlocks);
+		}
+		else
+		{
+			SymCryptBlocks(context, context->encrypt, 0, (int)mode,
+						   ivBuffer, input, output, numBlocks);
+		}
+	}
+}
+
+/*
+ * public static void DecryptBlocks(IntPtr state, int mode, byte[] iv,
+ *									byte[] inBuffer, int inOffset,
+ *									byte[] outBuffer, int outOffset,
+ *									int count);
+ */
+void _IL_CryptoMethods_DecryptBlocks(ILExecThread *_thread,
+									 ILNativeInt state, ILInt32 mode,
+									 System_Array *iv, System_Array *inBuffer,
+									 ILInt32 inOffset, System_Array *outBuffer,
+									 ILInt32 outOffset, ILInt32 count)
+{
+	SymContext *context = (SymContext *)state;
+	unsigned char *input;
+	unsigned char *output;
+	unsigned char *ivBuffer;
+	unsigned long numBlocks;
+	if(context && count > 0)
+	{
+		input = ((unsigned char *)(ArrayToBuffer(inBuffer))) + inOffset;
+		output = ((unsigned char *)(ArrayToBuffer(outBuffer))) + outOffset;
+		ivBuffer = (iv ? (unsigned char *)(ArrayToBuffer(iv)) : 0);
+		numBlocks = (unsigned long)(count / context->blockSize);
+		if(context->decryptBlocks)
+		{
+			(*(context->decryptBlocks))
+				(&(((RC2Context *)state)->rc2), (int)mode,
+				 ivBuffer, input, output, numBlocks);
+		}
+		else
+		{
+			SymCryptBlocks(context, context->decrypt, 1, (int)mode,
+						   ivBuffer, input, output, numBlocks);
+		}
+	}
+}
+
 /*
  * public static void SymmetricFree(IntPtr state);
  */
@@ -395,6 +395,14 @@ typedef struct
 
 } PackedStackFrame;
 
+/*
+ * Value of "PackedStackFrame.offset" for a frame whose IL offset has
+ * not been computed yet.  Exception stack traces only record native
+ * offsets when they are captured: the IL offsets are filled in by
+ * "StackFrame.ResolveExceptionStackTrace" when they are needed.
+ */
+#define	IL_PACKED_FRAME_UNRESOLVED	(-2)
+
 /*
  * Structure of the ECMA part of the "System.Exception" class.
  */
@@ -453,8 +453,7 @@ System_Array *_IL_StackFrame_GetExceptionStackTrace(ILExecThread *thread)
 	   use "ILExecThreadNew" because it will re-enter the engine.
 	   If we are throwing "StackOverflowException", then we will
 	   get an infinite recursive loop */
-	classInfo = ILExecThreadLookupClass
-			(thread, "[vSystem.Diagnostics.PackedStackFrame;");
+	classInfo = _ILPackedStackFrameArrayClass(thread);
 	if(!classInfo)
 	{
 		ILExecThreadThrowOutOfMemory(thread);
@@ -484,15 +483,11 @@ System_Array *_IL_StackFrame_GetExceptionStackTrace(ILExecThread *thread)
 				start -= ILCoderCtorOffset(thread->process->coder);
 			}
 
-			/* Get the native offset from the method start */
+			/* Get the native offset from the method start.  The IL
+			   offset is expensive to compute, so we leave it until
+			   someone actually asks for the stack trace */
 			data->nativeOffset = (ILInt32)(frame->pc - start);
-
-			/* Get the IL offset from the coder.  We use the native
-			   offset minus 1 because we want the IL offset for the
-			   instruction just before the return address, not after */
-			data->offset = (ILInt32)ILCoderGetILOffset
-				(thread->process->coder, (void *)start,
-				 (ILUInt32)(data->nativeOffset - 1), 0);
+			data->offset = IL_PACKED_FRAME_UNRESOLVED;
 		}
 		else
 		{
@@ -516,6 +511,50 @@ System_Array *_IL_StackFrame_GetExceptionStackTrace(ILExecThread *thread)
 #endif
 }
 
+/*
+ * internal static void ResolveExceptionStackTrace(PackedStackFrame[] trace);
+ */
+void _IL_StackFrame_ResolveExceptionStackTrace(ILExecThread *thread,
+											   System_Array *trace)
+{
+#ifdef IL_USE_CVM
+	ILInt32 num;
+	PackedStackFrame *data;
+	unsigned char *start;
+
+	if(!trace)
+	{
+		return;
+	}
+	num = ArrayLength(trace);
+	data = (PackedStackFrame *)ArrayToBuffer(trace);
+	while(num > 0)
+	{
+		if(data->offset == IL_PACKED_FRAME_UNRESOLVED)
+		{
+			/* Find the start of the frame method */
+			start = (unsigned char *)ILMethodGetUserData(data->method);
+			if(ILMethodIsConstructor(data->method))
+			{
+				start -= ILCoderCtorOffset(thread->process->coder);
+			}
+
+			/* Get the IL offset from the coder.  We use the native
+			   offset minus 1 because we want the IL offset for the
+			   instruction just before the return address, not after */
+			data->offset = (ILInt32)ILCoderGetILOffset
+				(thread->process->coder, (void *)start,
+				 (ILUInt32)(data->nativeOffset - 1), 0);
+		}
+		++data;
+		--num;
+	}
+#endif
+#ifdef IL_USE_JIT
+	_ILJitResolveExceptionStackTrace(thread, trace);
+#endif
+}
+
 #else /* !IL_CONFIG_DEBUG_LINES */
 
 int ILExecProcessDebugHook(ILExecProcess *process,
@@ -1,5 +1,6 @@
 /*
- * lib_encoding.c - Internalcall methods for "System.Text.DefaultEncoding".
+ * lib_encoding.c - Internalcall methods for "System.Text.DefaultEncoding",
+ *                  "System.Text.UTF8Encoding", and "System.Text.ASCIIEncoding".
  *
  * Copyright (C) 2002  Southern Storm Software, Pty Ltd.
  *
@@ -163,6 +164,151 @@ ILInt32 _IL_DefaultEncoding_InternalCodePage(ILExecThread *_thread)
 	return (ILInt32)ILGetCodePage();
 }
 
+/*
+ * private static int InternalDecode(byte[] bytes, int byteIndex,
+ *									 int byteCount, char[] chars,
+ *									 ref int charIndex);
+ */
+ILInt32 _IL_UTF8Encoding_InternalDecode
+				(ILExecThread *_thread, System_Array *bytes,
+				 ILInt32 byteIndex, ILInt32 byteCount,
+				 System_Array *chars, ILInt32 *charIndex)
+{
+	unsigned long used;
+	unsigned long result;
+	if(chars)
+	{
+		result = ILUTF8ToUTF16
+			(((ILUInt8 *)ArrayToBuffer(bytes)) + byteIndex,
+			 (unsigned long)byteCount,
+			 ((ILUInt16 *)ArrayToBuffer(chars)) + *charIndex,
+			 (unsigned long)(ArrayLength(chars) - *charIndex), &used);
+	}
+	else
+	{
+		result = ILUTF8ToUTF16
+			(((ILUInt8 *)ArrayToBuffer(bytes)) + byteIndex,
+			 (unsigned long)byteCount, 0, 0, &used);
+	}
+	*charIndex += (ILInt32)used;
+	return (ILInt32)result;
+}
+
+/*
+ * Encode UTF-16 characters as UTF-8 for "UTF8Encoding.InternalEncode".
+ */
+static ILInt32 UTF8Encode(const ILUInt16 *chars, ILInt32 charCount,
+						  System_Array *bytes, ILInt32 *byteIndex)
+{
+	unsigned long used;
+	unsigned long result;
+	if(bytes)
+	{
+		result = ILUTF16ToUTF8
+			(chars, (unsigned long)charCount,
+			 ((ILUInt8 *)ArrayToBuffer(bytes)) + *byteIndex,
+			 (unsigned long)(ArrayLength(bytes) - *byteIndex), &used);
+	}
+	else
+	{
+		result = ILUTF16ToUTF8
+			(chars, (unsigned long)charCount, 0, 0, &used);
+	}
+	*byteIndex += (ILInt32)used;
+	return (ILInt32)result;
+}
+
+/*
+ * private static int InternalEncode(char[] chars, int charIndex,
+ *									 int charCount, byte[] bytes,
+ *									 ref int byteIndex);
+ */
+ILInt32 _IL_UTF8Encoding_InternalEncode_aciiaBRi
+				(ILExecThread *_thread, System_Array *chars,
+				 ILInt32 charIndex, ILInt32 charCount,
+				 System_Array *bytes, ILInt32 *byteIndex)
+{
+	return UTF8Encode(((ILUInt16 *)ArrayToBuffer(chars)) + charIndex,
+					  charCount, bytes, byteIndex);
+}
+
+/*
+ * private static int InternalEncode(String s, int charIndex,
+ *									 int charCount, byte[] bytes,
+ *									 ref int byteIndex);
+ */
+ILInt32 _IL_UTF8Encoding_InternalEncode_StringiiaBRi
+				(ILExecThread *_thread, ILString *s,
+				 ILInt32 charIndex, ILInt32 charCount,
+				 System_Array *bytes, ILInt32 *byteIndex)
+{
+	return UTF8Encode(StringToBuffer(s) + charIndex,
+					  charCount, bytes, byteIndex);
+}
+
+/*
+ * private static void InternalGetBytes(char[] chars, int charIndex,
+ *										int charCount, byte[] bytes,
+ *										int byteIndex);
+ */
+void _IL_ASCIIEncoding_InternalGetBytes_aciiaBi
+				(ILExecThread *_thread, System_Array *chars,
+				 ILInt32 charIndex, ILInt32 charCount,
+				 System_Array *bytes, ILInt32 byteIndex)
+{
+	ILUTF16ToASCII(((ILUInt16 *)ArrayToBuffer(chars)) + charIndex,
+				   ((ILUInt8 *)ArrayToBuffer(bytes)) + byteIndex,
+				   (unsigned long)charCount, (unsigned char)'?');
+}
+
+/*
+ * private static void InternalGetBytes(String s, int charIndex,
+ *										int charCount, byte[] bytes,
+ *										int byteIndex);
+ */
+void _IL_ASCIIEncoding_InternalGetBytes_StringiiaBi
+				(ILExecThread *_thread, ILString *s,
+				 ILInt32 charIndex, ILInt32 charCount,
+				 System_Array *bytes, ILInt32 byteIndex)
+{
+	ILUTF16ToASCII(StringToBuffer(s) + charIndex,
+				   ((ILUInt8 *)ArrayToBuffer(bytes)) + byteIndex,
+				   (unsigned long)charCount, (unsigned char)'?');
+}
+
+/*
+ * private static void InternalGetChars(byte[] bytes, int byteIndex,
+ *										int byteCount, char[] chars,
+ *										int charIndex);
+ */
+void _IL_ASCIIEncoding_InternalGetChars
+				(ILExecThread *_thread, System_Array *bytes,
+				 ILInt32 byteIndex, ILInt32 byteCount,
+				 System_Array *chars, ILInt32 charIndex)
+{
+	ILASCIIToUTF16(((ILUInt8 *)ArrayToBuffer(bytes)) + byteIndex,
+				   ((ILUInt16 *)ArrayToBuffer(chars)) + charIndex,
+				   (unsigned long)byteCount, (unsigned short)'?');
+}
+
+/*
+ * private static String InternalGetString(byte[] bytes, int index,
+ *										   int count);
+ */
+ILString *_IL_ASCIIEncoding_InternalGetString
+				(ILExecThread *_thread, System_Array *bytes,
+				 ILInt32 index, ILInt32 count)
+{
+	System_String *str = _IL_String_NewString(_thread, count);
+	if(!str)
+	{
+		return 0;
+	}
+	ILASCIIToUTF16(((ILUInt8 *)ArrayToBuffer(bytes)) + index,
+				   StringToBuffer(str), (unsigned long)count, 0);
+	return (ILString *)str;
+}
+
 /*
  * private static int InternalCultureID();
  */
@@ -121,8 +121,8 @@ ILObject *_ILGetClrType(ILExecThread *thread, ILClass *classInfo)
 
 	if(!classInfo)
 	{
-		_ILExecThreadSetException(thread, _ILSystemException
-			(thread, "System.TypeInitializationException"));
+		_ILExecThreadSetException(thread, _ILSystemWellKnownException
+			(thread, IL_WKC_TYPE_INITIALIZATION_EXCEPTION));
 		return 0;
 	}
 
@@ -137,8 +137,8 @@ ILObject *_ILGetClrType(ILExecThread *thread, ILClass *classInfo)
 		if(!_ILLayoutClass(_ILExecThreadProcess(thread), classInfo))
 		{
 			IL_METADATA_UNLOCK(_ILExecThreadProcess(thread));
-			_ILExecThreadSetException(thread, _ILSystemException
-				(thread, "System.TypeInitializationException"));
+			_ILExecThreadSetException(thread, _ILSystemWellKnownException
+				(thread, IL_WKC_TYPE_INITIALIZATION_EXCEPTION));
 			return 0;
 		}
 		IL_METADATA_UNLOCK(_ILExecThreadProcess(thread));
@@ -151,8 +151,8 @@ ILObject *_ILGetClrType(ILExecThread *thread, ILClass *classInfo)
 			/* Create a new "ClrType" instance */
 			if(!(thread->process->clrTypeClass))
 			{
-				_ILExecThreadSetException(thread, _ILSystemException
-					(thread, "System.TypeInitializationException"));
+				_ILExecThreadSetException(thread, _ILSystemWellKnownException
+					(thread, IL_WKC_TYPE_INITIALIZATION_EXCEPTION));
 				return 0;
 			}
 			obj = _ILEngineAllocObject(thread, thread->process->clrTypeClass);
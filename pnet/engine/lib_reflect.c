@@ -431,7 +431,7 @@ System_Array *_IL_ClrHelpers_GetCustomAttributes
 	ILObject **buffer;
 	ILClass *classInfo;
 	ILAttribute *attr;
-	ILClass *attributeClass=ILExecThreadLookupClass(thread,"System.Attribute");
+	ILClass *attributeClass=_ILWellKnownClass(thread, IL_WKC_ATTRIBUTE);
 
 	/* Check that we have reflection access to the item */
 	if(item && _ILClrCheckItemAccess(thread, item))
@@ -894,20 +894,13 @@ ILInt32 _IL_String_IndexOfAny(ILExecThread *thread,
 
 	/* Search for the value */
 	buf = StringToBuffer(_this) + startIndex;
-	while(count > 0)
+	anyPosn = (ILInt32)ILUTF16FindAny(buf, (unsigned long)count,
+									  anyBuf, (unsigned long)anyLength);
+	if(anyPosn < 0)
 	{
-		for(anyPosn = 0; anyPosn < anyLength; ++anyPosn)
-		{
-			if(*buf == anyBuf[anyPosn])
-			{
-				return startIndex;
-			}
-		}
-		++buf;
-		++startIndex;
-		--count;
+		return -1;
 	}
-	return -1;
+	return startIndex + anyPosn;
 }
 
 /*
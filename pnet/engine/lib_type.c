@@ -647,7 +647,8 @@ void _ILClrNotImplemented(ILExecThread *thread)
 {
 	/* Avoid re-entering the C# class library to create the exception */
 	_ILExecThreadSetException
-		(thread, _ILSystemException(thread, "System.NotImplementedException"));
+		(thread, _ILSystemWellKnownException
+			(thread, IL_WKC_NOT_IMPLEMENTED_EXCEPTION));
 }
 
 /*
@@ -0,0 +1,104 @@
+/*
+ * lib_xml.c - Internalcall methods for "System.Xml.Private.XmlParserInput".
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "engine.h"
+#include "lib_defs.h"
+#include "il_utils.h"
+#include "il_xml.h"
+
+#ifdef	__cplusplus
+extern	"C" {
+#endif
+
+/*
+ * Validate the range "start..end" within a character buffer.
+ */
+static int ValidateRange(ILExecThread *_thread, System_Array *buffer,
+						 ILInt32 start, ILInt32 end)
+{
+	if(!buffer)
+	{
+		ILExecThreadThrowArgNull(_thread, "buffer");
+		return 0;
+	}
+	if(start < 0 || end < start || end > ArrayLength(buffer))
+	{
+		ILExecThreadThrowArgRange(_thread, "start", "ArgRange_Array");
+		return 0;
+	}
+	return 1;
+}
+
+/*
+ * private static int ScanChars(char[] buffer, int start, int end,
+ *                              char[] stops);
+ *
+ * Returns the index of the first character in "start..end" that
+ * is in "stops", or "end" if there is no such character.
+ */
+ILInt32 _IL_XmlParserInput_ScanChars(ILExecThread *_thread,
+									 System_Array *buffer,
+									 ILInt32 start, ILInt32 end,
+									 System_Array *stops)
+{
+	long posn;
+	if(!ValidateRange(_thread, buffer, start, end))
+	{
+		return end;
+	}
+	if(!stops)
+	{
+		ILExecThreadThrowArgNull(_thread, "stops");
+		return end;
+	}
+	posn = ILUTF16FindAny(((ILUInt16 *)(ArrayToBuffer(buffer))) + start,
+						  (unsigned long)(end - start),
+						  (ILUInt16 *)(ArrayToBuffer(stops)),
+						  (unsigned long)(ArrayLength(stops)));
+	if(posn < 0)
+	{
+		return end;
+	}
+	return start + (ILInt32)posn;
+}
+
+/*
+ * private static int ScanName(char[] buffer, int start, int end);
+ *
+ * Returns the index of the first character in "start..end" that
+ * is not an ASCII name character, or "end" if there is no such
+ * character.
+ */
+ILInt32 _IL_XmlParserInput_ScanName(ILExecThread *_thread,
+									System_Array *buffer,
+									ILInt32 start, ILInt32 end)
+{
+	if(!ValidateRange(_thread, buffer, start, end))
+	{
+		return end;
+	}
+	return start + (ILInt32)ILXMLNameCharRun
+		(((ILUInt16 *)(ArrayToBuffer(buffer))) + start,
+		 (unsigned long)(end - start));
+}
+
+#ifdef	__cplusplus
+};
+#endif
@@ -872,6 +872,139 @@ int _ILLookupTypeMatch(ILType *type, const char *signature)
 	return 0;
 }
 
+/*
+ * Names of the well-known classes, in "IL_WKC_*" order.
+ */
+static struct
+{
+	const char *fullName;
+	const char *name;
+	const char *namespace;
+
+} const wellKnownClasses[IL_WKC_NUM_CLASSES] = {
+	{"System.ArithmeticException", "ArithmeticException", "System"},
+	{"System.DivideByZeroException", "DivideByZeroException", "System"},
+	{"System.DllNotFoundException", "DllNotFoundException", "System"},
+	{"System.EntryPointNotFoundException",
+			"EntryPointNotFoundException", "System"},
+	{"System.ExecutionEngineException", "ExecutionEngineException", "System"},
+	{"System.IndexOutOfRangeException", "IndexOutOfRangeException", "System"},
+	{"System.InvalidCastException", "InvalidCastException", "System"},
+	{"System.MissingMethodException", "MissingMethodException", "System"},
+	{"System.NotImplementedException", "NotImplementedException", "System"},
+	{"System.NullReferenceException", "NullReferenceException", "System"},
+	{"System.OutOfMemoryException", "OutOfMemoryException", "System"},
+	{"System.OverflowException", "OverflowException", "System"},
+	{"System.StackOverflowException", "StackOverflowException", "System"},
+	{"System.TypeInitializationException",
+			"TypeInitializationException", "System"},
+	{"System.Security.VerificationException",
+			"VerificationException", "System.Security"},
+	{"System.Attribute", "Attribute", "System"},
+	{"System.Threading.Thread", "Thread", "System.Threading"},
+};
+
+/*
+ * Classes, names and signatures of the well-known methods,
+ * in "IL_WKM_*" order.
+ */
+static struct
+{
+	int			classIndex;
+	const char *className;
+	const char *name;
+	const char *signature;
+
+} const wellKnownMethods[IL_WKM_NUM_METHODS] = {
+	{-1, "System.Object", "_", "(oSystem.String;)oSystem.String;"},
+	{IL_WKC_THREAD, "System.Threading.Thread", ".ctor", "(Tj)V"},
+};
+
+void _ILResolveWellKnownClasses(ILExecProcess *process, ILImage *image)
+{
+	ILContext *context = ILImageToContext(image);
+	int index;
+
+	for(index = 0; index < IL_WKC_NUM_CLASSES; ++index)
+	{
+		if(!(process->wellKnownClasses[index]))
+		{
+			process->wellKnownClasses[index] = ILClassLookupGlobal
+				(context, wellKnownClasses[index].name,
+				 wellKnownClasses[index].namespace);
+		}
+	}
+}
+
+ILClass *_ILLookupWellKnownClass(ILExecProcess *process, int index)
+{
+	ILClass *classInfo = process->wellKnownClasses[index];
+
+	/* Fall back to a lookup by name if the class was not seen
+	   when the system library was loaded */
+	if(!classInfo)
+	{
+		classInfo = _ILLookupClass(process, wellKnownClasses[index].fullName,
+								   strlen(wellKnownClasses[index].fullName));
+		if(!classInfo)
+		{
+			return 0;
+		}
+		process->wellKnownClasses[index] = classInfo;
+	}
+	return ILClassResolve(classInfo);
+}
+
+ILClass *_ILWellKnownClass(ILExecThread *thread, int index)
+{
+	ILExecProcess *process = _ILExecThreadProcess(thread);
+	ILClass *classInfo = _ILLookupWellKnownClass(process, index);
+
+	/* Make sure that the class has been laid out */
+	if(classInfo && !_ILLayoutAlreadyDone(classInfo))
+	{
+		IL_METADATA_WRLOCK(process);
+		if(!_ILLayoutClass(process, classInfo))
+		{
+			IL_METADATA_UNLOCK(process);
+			return 0;
+		}
+		IL_METADATA_UNLOCK(process);
+	}
+	return classInfo;
+}
+
+const char *_ILWellKnownClassName(int index)
+{
+	return wellKnownClasses[index].fullName;
+}
+
+ILMethod *_ILWellKnownMethod(ILExecThread *thread, int index)
+{
+	ILExecProcess *process = _ILExecThreadProcess(thread);
+	ILMethod *method = process->wellKnownMethods[index];
+	ILClass *classInfo;
+
+	if(!method)
+	{
+		if(wellKnownMethods[index].classIndex >= 0)
+		{
+			classInfo = _ILWellKnownClass
+				(thread, wellKnownMethods[index].classIndex);
+		}
+		else
+		{
+			classInfo = ILExecThreadLookupClass
+				(thread, wellKnownMethods[index].className);
+		}
+		method = ILExecThreadLookupMethodInClass
+			(thread, classInfo, wellKnownMethods[index].name,
+			 wellKnownMethods[index].signature);
+		process->wellKnownMethods[index] = method;
+	}
+	return method;
+}
+
 #ifdef	__cplusplus
 };
 #endif
@@ -290,6 +290,259 @@ static ffi_type *TypeToFFI(ILExecProcess *process, ILType *type, int isInternal)
 	}
 }
 
+/*
+ * Methods with identical native signatures share a single "ffi_cif".
+ * The shared structures are kept in a per-process hash table keyed
+ * on the return and argument types.
+ */
+static unsigned long CifHashCompute(const void *elem)
+{
+	const ffi_cif *cif = (const ffi_cif *)elem;
+	unsigned long hash = (unsigned long)(cif->rtype) + cif->nargs;
+	unsigned arg;
+	for(arg = 0; arg < cif->nargs; ++arg)
+	{
+		hash = (hash << 5) + hash + (unsigned long)(cif->arg_types[arg]);
+	}
+	return hash;
+}
+static int CifHashMatch(const void *elem, const void *key)
+{
+	const ffi_cif *cif1 = (const ffi_cif *)elem;
+	const ffi_cif *cif2 = (const ffi_cif *)key;
+	unsigned arg;
+	if(cif1->rtype != cif2->rtype || cif1->nargs != cif2->nargs ||
+	   cif1->abi != cif2->abi)
+	{
+		return 0;
+	}
+	for(arg = 0; arg < cif1->nargs; ++arg)
+	{
+		if(cif1->arg_types[arg] != cif2->arg_types[arg])
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+static void CifHashFree(void *elem)
+{
+	ILFree(elem);
+}
+
+/*
+ * Prepare a "ffi_cif" structure that was allocated with ILMalloc,
+ * or replace it with an identical one that was prepared earlier.
+ * Returns NULL if the signature cannot be handled by "libffi".
+ */
+static ffi_cif *PrepareSharedCif(ILExecProcess *process, ffi_cif *cif,
+								 unsigned nargs, ffi_type *rtype,
+								 ffi_type **args)
+{
+	ffi_cif *shared;
+
+	/* Look for a structure with the same signature */
+	cif->abi = FFI_DEFAULT_ABI;
+	cif->nargs = nargs;
+	cif->rtype = rtype;
+	cif->arg_types = args;
+	if(!(process->cifHash))
+	{
+		process->cifHash = ILHashCreate(0, CifHashCompute, CifHashCompute,
+										CifHashMatch, CifHashFree);
+	}
+	if(process->cifHash &&
+	   (shared = ILHashFindType(process->cifHash, cif, ffi_cif)) != 0)
+	{
+		ILFree(cif);
+		return shared;
+	}
+
+	/* Prepare the new structure and remember it for next time */
+	if(ffi_prep_cif(cif, FFI_DEFAULT_ABI, nargs, rtype, args) != FFI_OK)
+	{
+		ILFree(cif);
+		return 0;
+	}
+	if(process->cifHash)
+	{
+		ILHashAdd(process->cifHash, cif);
+	}
+	return cif;
+}
+
+/*
+ * Direct call stubs for native signatures that consist only of
+ * integer and pointer values no larger than a native word.  Such
+ * calls can be made with an ordinary C call through a cast function
+ * pointer, which avoids the work that "ffi_call" does to classify
+ * and copy the arguments on every call.  Each stub handles all
+ * signatures with a particular number of arguments.
+ *
+ * This relies on every integer argument occupying a full native word,
+ * in a register or on the stack, and on the argument values being
+ * stored in full stack words.  We only enable it on the little-endian
+ * x86 platforms where that is known to hold.
+ */
+#if (defined(__i386) || defined(__i386__) || defined(__x86_64__)) && \
+	!defined(IL_WIN32_PLATFORM)
+#define	IL_NATIVE_CALL_STUBS	1
+#define	IL_NATIVE_STUB_MAX_ARGS	6
+#endif
+
+#ifdef IL_NATIVE_CALL_STUBS
+
+typedef ILNativeInt (*ILNativeStubFunc)(void (*fn)(), void **avalue);
+
+typedef struct
+{
+	ILNativeStubFunc	func;
+	unsigned short		rtype;
+
+} ILNativeCallStub;
+
+#define	STUB_ARG(n)		(*((ILNativeInt *)(avalue[(n)])))
+
+static ILNativeInt NativeStub0(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(void))fn)();
+}
+static ILNativeInt NativeStub1(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(ILNativeInt))fn)(STUB_ARG(0));
+}
+static ILNativeInt NativeStub2(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(ILNativeInt, ILNativeInt))fn)
+		(STUB_ARG(0), STUB_ARG(1));
+}
+static ILNativeInt NativeStub3(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(ILNativeInt, ILNativeInt, ILNativeInt))fn)
+		(STUB_ARG(0), STUB_ARG(1), STUB_ARG(2));
+}
+static ILNativeInt NativeStub4(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(ILNativeInt, ILNativeInt, ILNativeInt,
+							  ILNativeInt))fn)
+		(STUB_ARG(0), STUB_ARG(1), STUB_ARG(2), STUB_ARG(3));
+}
+static ILNativeInt NativeStub5(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(ILNativeInt, ILNativeInt, ILNativeInt,
+							  ILNativeInt, ILNativeInt))fn)
+		(STUB_ARG(0), STUB_ARG(1), STUB_ARG(2), STUB_ARG(3), STUB_ARG(4));
+}
+static ILNativeInt NativeStub6(void (*fn)(), void **avalue)
+{
+	return (*(ILNativeInt (*)(ILNativeInt, ILNativeInt, ILNativeInt,
+							  ILNativeInt, ILNativeInt, ILNativeInt))fn)
+		(STUB_ARG(0), STUB_ARG(1), STUB_ARG(2), STUB_ARG(3), STUB_ARG(4),
+		 STUB_ARG(5));
+}
+
+/*
+ * The stubs for each combination of argument count and return type.
+ * The return type determines how the result is extended to a word.
+ */
+#define	STUB_ROW(func)	\
+	{{func, FFI_TYPE_VOID}, {func, FFI_TYPE_UINT8}, {func, FFI_TYPE_SINT8}, \
+	 {func, FFI_TYPE_UINT16}, {func, FFI_TYPE_SINT16}, \
+	 {func, FFI_TYPE_UINT32}, {func, FFI_TYPE_SINT32}, \
+	 {func, FFI_TYPE_POINTER}}
+static ILNativeCallStub const nativeStubs[IL_NATIVE_STUB_MAX_ARGS + 1][8] = {
+	STUB_ROW(NativeStub0),
+	STUB_ROW(NativeStub1),
+	STUB_ROW(NativeStub2),
+	STUB_ROW(NativeStub3),
+	STUB_ROW(NativeStub4),
+	STUB_ROW(NativeStub5),
+	STUB_ROW(NativeStub6)
+};
+
+/*
+ * Get the column within "nativeStubs" for a type, or -1 if the
+ * type cannot be passed or returned through a direct call stub.
+ */
+static int NativeStubKind(ffi_type *type, int isReturn)
+{
+	switch(type->type)
+	{
+		case FFI_TYPE_VOID:		return (isReturn ? 0 : -1);
+		case FFI_TYPE_UINT8:	return 1;
+		case FFI_TYPE_SINT8:	return 2;
+		case FFI_TYPE_UINT16:	return 3;
+		case FFI_TYPE_SINT16:	return 4;
+		case FFI_TYPE_UINT32:	return 5;
+		case FFI_TYPE_SINT32:	return 6;
+		case FFI_TYPE_POINTER:	return 7;
+	#if defined(__x86_64__)
+		case FFI_TYPE_UINT64:
+		case FFI_TYPE_SINT64:	return 7;
+	#endif
+	}
+	return -1;
+}
+
+#endif /* IL_NATIVE_CALL_STUBS */
+
+void *_ILMakeNativeCallStub(void *_cif)
+{
+#ifdef IL_NATIVE_CALL_STUBS
+	ffi_cif *cif = (ffi_cif *)_cif;
+	unsigned arg;
+	int kind;
+
+	if(!cif || cif->abi != FFI_DEFAULT_ABI ||
+	   cif->nargs > IL_NATIVE_STUB_MAX_ARGS)
+	{
+		return 0;
+	}
+	for(arg = 0; arg < cif->nargs; ++arg)
+	{
+		if(NativeStubKind(cif->arg_types[arg], 0) < 0)
+		{
+			return 0;
+		}
+	}
+	if((kind = NativeStubKind(cif->rtype, 1)) < 0)
+	{
+		return 0;
+	}
+	return (void *)&(nativeStubs[cif->nargs][kind]);
+#else
+	return 0;
+#endif
+}
+
+void _ILCallNativeStub(void *_stub, void *fn, void *rvalue, void **avalue)
+{
+#ifdef IL_NATIVE_CALL_STUBS
+	const ILNativeCallStub *stub = (const ILNativeCallStub *)_stub;
+	ILNativeInt result = (*(stub->func))((void (*)())fn, avalue);
+
+	/* Small integer results are widened to a full word, in the
+	   same way that "ffi_call" does it */
+	switch(stub->rtype)
+	{
+		case FFI_TYPE_UINT8:
+			*((ILNativeInt *)rvalue) = (ILNativeInt)(ILUInt8)result; break;
+		case FFI_TYPE_SINT8:
+			*((ILNativeInt *)rvalue) = (ILNativeInt)(ILInt8)result; break;
+		case FFI_TYPE_UINT16:
+			*((ILNativeInt *)rvalue) = (ILNativeInt)(ILUInt16)result; break;
+		case FFI_TYPE_SINT16:
+			*((ILNativeInt *)rvalue) = (ILNativeInt)(ILInt16)result; break;
+		case FFI_TYPE_UINT32:
+			*((ILNativeInt *)rvalue) = (ILNativeInt)(ILUInt32)result; break;
+		case FFI_TYPE_SINT32:
+			*((ILNativeInt *)rvalue) = (ILNativeInt)(ILInt32)result; break;
+		case FFI_TYPE_POINTER:
+			*((ILNativeInt *)rvalue) = result; break;
+	}
+#endif
+}
+
 void *_ILMakeCifForMethod(ILExecProcess *process, ILMethod *method, int isInternal)
 {
 	ILType *signature = ILMethod_Signature(method);
@@ -367,7 +620,7 @@ void *_ILMakeCifForMethod(ILExecProcess *process, ILMethod *method, int isIntern
 	}
 
 	/* Prepare the "ffi_cif" structure for the call */
-	if(ffi_prep_cif(cif, FFI_DEFAULT_ABI, numArgs, rtype, args) != FFI_OK)
+	if((cif = PrepareSharedCif(process, cif, numArgs, rtype, args)) == 0)
 	{
 		fprintf(stderr, "Cannot marshal a type in the definition of %s::%s\n",
 				ILClass_Name(ILMethod_Owner(method)), ILMethod_Name(method));
@@ -433,7 +686,7 @@ void *_ILMakeCifForConstructor(ILExecProcess *process, ILMethod *method, int isI
 	}
 
 	/* Prepare the "ffi_cif" structure for the call */
-	if(ffi_prep_cif(cif, FFI_DEFAULT_ABI, numArgs, rtype, args) != FFI_OK)
+	if((cif = PrepareSharedCif(process, cif, numArgs, rtype, args)) == 0)
 	{
 		fprintf(stderr, "Cannot marshal a type in the definition of %s::%s\n",
 				ILClass_Name(ILMethod_Owner(method)), ILMethod_Name(method));
@@ -453,20 +706,299 @@ void *_ILMakeCifForConstructor(ILExecProcess *process, ILMethod *method, int isI
 			do { \
 				if((stacktop + (nwords)) > stacklimit) \
 				{ \
-					_ILExecThreadSetException(thread, _ILSystemException \
-						(thread, "System.StackOverflowException")); \
+					_ILExecThreadSetException(thread, \
+						_ILSystemWellKnownException \
+							(thread, IL_WKC_STACK_OVERFLOW_EXCEPTION)); \
 					return 1; \
 				} \
 			} while (0)
 
+/*
+ * Ways in which a closure parameter or return value is converted
+ * between its native representation and the CVM stack.
+ */
+#define	IL_THUNK_VOID			0
+#define	IL_THUNK_INT32			1
+#define	IL_THUNK_INT64			2
+#define	IL_THUNK_FLOAT32		3
+#define	IL_THUNK_FLOAT64		4
+#define	IL_THUNK_NFLOAT			5
+#define	IL_THUNK_TYPEDREF		6
+#define	IL_THUNK_PTR			7
+#define	IL_THUNK_VALUE			8
+#define	IL_THUNK_INDIRECT		9
+#define	IL_THUNK_ANSI_STRING	10
+#define	IL_THUNK_UTF8_STRING	11
+#define	IL_THUNK_UTF16_STRING	12
+#define	IL_THUNK_FNPTR			13
+#define	IL_THUNK_ARRAY			14
+#define	IL_THUNK_CUSTOM			15
+
+/*
+ * Conversion information for a single parameter or return value.
+ */
+typedef struct
+{
+	int			kind;
+	ILUInt32	size;
+	char	   *customName;
+	int			customNameLen;
+	char	   *customCookie;
+	int			customCookieLen;
+
+} ILClosureThunkItem;
+
+/*
+ * Marshalling plan for calls from native code through a closure.
+ * The plan depends only upon the delegate's "Invoke" method (or the
+ * method itself for method closures), so it is computed once and
+ * shared by every closure with the same signature.  This avoids
+ * inspecting the marshalling metadata on every call.
+ */
+typedef struct
+{
+	ILMethod		   *pinvokeInfo;
+	ILUInt32			numParams;
+	ILClosureThunkItem	result;
+	ILClosureThunkItem	params[1];
+
+} ILClosureThunk;
+
+/*
+ * Data that is attached to a delegate closure.
+ */
+typedef struct
+{
+	System_Delegate	   *delegate;
+	ILClosureThunk	   *thunk;
+
+} ILDelegateClosureData;
+
+/*
+ * Determine how to convert a closure parameter or return value.
+ * This must be called with the metadata lock held.
+ */
+static void ClosureThunkItem(ILExecProcess *process, ILMethod *pinvokeInfo,
+							 ILUInt32 param, ILType *type,
+							 ILClosureThunkItem *item)
+{
+	ILUInt32 marshalType;
+
+	/* Marshal values that need special handling */
+	marshalType = ILPInvokeGetMarshalType(0, pinvokeInfo, param,
+										  &(item->customName),
+										  &(item->customNameLen),
+										  &(item->customCookie),
+										  &(item->customCookieLen), type);
+	item->size = 0;
+	switch(marshalType)
+	{
+		case IL_META_MARSHAL_ANSI_STRING:
+		{
+			item->kind = IL_THUNK_ANSI_STRING;
+		}
+		return;
+
+		case IL_META_MARSHAL_UTF8_STRING:
+		{
+			item->kind = IL_THUNK_UTF8_STRING;
+		}
+		return;
+
+		case IL_META_MARSHAL_UTF16_STRING:
+		{
+			item->kind = IL_THUNK_UTF16_STRING;
+		}
+		return;
+
+		case IL_META_MARSHAL_CUSTOM:
+		{
+			item->kind = IL_THUNK_CUSTOM;
+		}
+		return;
+
+		case IL_META_MARSHAL_FNPTR:
+		{
+			/* Delegates are only converted on the way back out */
+			if(param == 0)
+			{
+				item->kind = IL_THUNK_FNPTR;
+				return;
+			}
+		}
+		break;
+
+		case IL_META_MARSHAL_ARRAY:
+		{
+			/* Arrays are only converted on the way back out */
+			if(param == 0)
+			{
+				item->kind = IL_THUNK_ARRAY;
+				return;
+			}
+		}
+		break;
+	}
+
+	/* Marshal the value directly */
+	type = ILTypeGetEnumType(type);
+	if(ILType_IsPrimitive(type))
+	{
+		switch(ILType_ToElement(type))
+		{
+			case IL_META_ELEMTYPE_BOOLEAN:
+			case IL_META_ELEMTYPE_I1:
+			case IL_META_ELEMTYPE_U1:
+			case IL_META_ELEMTYPE_I2:
+			case IL_META_ELEMTYPE_U2:
+			case IL_META_ELEMTYPE_CHAR:
+			case IL_META_ELEMTYPE_I4:
+			case IL_META_ELEMTYPE_U4:
+		#ifdef IL_NATIVE_INT32
+			case IL_META_ELEMTYPE_I:
+			case IL_META_ELEMTYPE_U:
+		#endif
+				item->kind = IL_THUNK_INT32; break;
+
+			case IL_META_ELEMTYPE_I8:
+			case IL_META_ELEMTYPE_U8:
+		#ifdef IL_NATIVE_INT64
+			case IL_META_ELEMTYPE_I:
+			case IL_META_ELEMTYPE_U:
+		#endif
+				item->kind = IL_THUNK_INT64; break;
+
+			case IL_META_ELEMTYPE_R4:
+				item->kind = IL_THUNK_FLOAT32; break;
+
+			case IL_META_ELEMTYPE_R8:
+				item->kind = IL_THUNK_FLOAT64; break;
+
+			case IL_META_ELEMTYPE_R:
+				item->kind = IL_THUNK_NFLOAT; break;
+
+			case IL_META_ELEMTYPE_TYPEDBYREF:
+				item->kind = IL_THUNK_TYPEDREF; break;
+
+			default:
+				item->kind = IL_THUNK_VOID; break;
+		}
+	}
+	else if(ILType_IsClass(type))
+	{
+		/* Object reference */
+		item->kind = IL_THUNK_PTR;
+	}
+	else if(ILType_IsValueType(type))
+	{
+		/* Value type that is passed by value */
+		item->kind = IL_THUNK_VALUE;
+		item->size = _ILSizeOfTypeLocked(process, type);
+	}
+	else if(param != 0 && type != 0 && ILType_IsComplex(type) &&
+			(ILType_Kind(type) == IL_TYPE_COMPLEX_BYREF ||
+			 ILType_Kind(type) == IL_TYPE_COMPLEX_PTR))
+	{
+		/* Value that is passed by reference */
+		item->kind = IL_THUNK_PTR;
+	}
+	else if(param != 0)
+	{
+		/* Assume that everything else is an object reference */
+		item->kind = IL_THUNK_INDIRECT;
+	}
+	else
+	{
+		/* Assume that everything else is an object reference */
+		item->kind = IL_THUNK_PTR;
+	}
+}
+
+/*
+ * Hash table functions for the shared closure marshalling plans.
+ */
+static unsigned long ClosureThunkHashCompute(const void *elem)
+{
+	return (unsigned long)(((const ILClosureThunk *)elem)->pinvokeInfo);
+}
+static unsigned long ClosureThunkHashKeyCompute(const void *key)
+{
+	return (unsigned long)key;
+}
+static int ClosureThunkHashMatch(const void *elem, const void *key)
+{
+	return (((const ILClosureThunk *)elem)->pinvokeInfo == (ILMethod *)key);
+}
+static void ClosureThunkHashFree(void *elem)
+{
+	ILFree(elem);
+}
+
+/*
+ * Get the marshalling plan for closures that use "pinvokeInfo"
+ * to describe their parameters.  This must be called with the
+ * metadata lock held.  Returns NULL if out of memory.
+ */
+static ILClosureThunk *GetClosureThunk(ILExecProcess *process,
+									   ILMethod *pinvokeInfo)
+{
+	ILType *signature = ILMethod_Signature(pinvokeInfo);
+	ILUInt32 numParams = ILTypeNumParams(signature);
+	ILClosureThunk *thunk;
+	ILUInt32 param;
+
+	/* See if we already have a plan for this signature */
+	if(!(process->closureThunkHash))
+	{
+		process->closureThunkHash =
+			ILHashCreate(0, ClosureThunkHashCompute,
+						 ClosureThunkHashKeyCompute,
+						 ClosureThunkHashMatch, ClosureThunkHashFree);
+		if(!(process->closureThunkHash))
+		{
+			return 0;
+		}
+	}
+	thunk = ILHashFindType(process->closureThunkHash, pinvokeInfo,
+						   ILClosureThunk);
+	if(thunk)
+	{
+		return thunk;
+	}
+
+	/* Build a new plan and remember it for next time */
+	thunk = (ILClosureThunk *)ILMalloc
+		(sizeof(ILClosureThunk) + sizeof(ILClosureThunkItem) * numParams);
+	if(!thunk)
+	{
+		return 0;
+	}
+	thunk->pinvokeInfo = pinvokeInfo;
+	thunk->numParams = numParams;
+	ClosureThunkItem(process, pinvokeInfo, 0,
+					 ILTypeGetReturn(signature), &(thunk->result));
+	for(param = 1; param <= numParams; ++param)
+	{
+		ClosureThunkItem(process, pinvokeInfo, param,
+						 ILTypeGetParam(signature, param),
+						 &(thunk->params[param - 1]));
+	}
+	if(!ILHashAdd(process->closureThunkHash, thunk))
+	{
+		ILFree(thunk);
+		return 0;
+	}
+	return thunk;
+}
+
 /*
  * User data for "PackDelegateParams".
  */
 typedef struct
 {
-	void     **args;
-	ILMethod  *pinvokeInfo;
-	int		   needThis;
+	void     	  **args;
+	ILClosureThunk *thunk;
+	int				needThis;
 
 } PackDelegateUserData;
 
@@ -477,19 +1009,12 @@ static int PackDelegateParams(ILExecThread *thread, ILMethod *method,
 					          int isCtor, void *_this, void *userData)
 {
 	void **args = ((PackDelegateUserData *)userData)->args;
-	ILMethod *pinvokeInfo = ((PackDelegateUserData *)userData)->pinvokeInfo;
+	ILClosureThunk *thunk = ((PackDelegateUserData *)userData)->thunk;
+	ILClosureThunkItem *item = thunk->params;
 	ILType *signature = ILMethod_Signature(method);
 	CVMWord *stacktop, *stacklimit;
-	ILUInt32 param, numParams;
-	ILType *paramType;
-	void *ptr;
-	ILUInt32 size, sizeInWords;
+	ILUInt32 param, sizeInWords;
 	ILNativeFloat tempFloat;
-	ILUInt32 marshalType;
-	char *customName;
-	int customNameLen;
-	char *customCookie;
-	int customCookieLen;
 	char *strValue;
 
 	/* Get the top and extent of the stack */
@@ -514,235 +1039,197 @@ static int PackDelegateParams(ILExecThread *thread, ILMethod *method,
 		}
 		++stacktop;
 	}
-	numParams = ILTypeNumParams(signature);
-	for(param = 1; param <= numParams; ++param)
+	for(param = 0; param < thunk->numParams; ++param, ++item)
 	{
-		/* Marshal parameters that need special handling */
-		marshalType = ILPInvokeGetMarshalType(0, pinvokeInfo, param,
-											  &customName, &customNameLen,
-											  &customCookie, &customCookieLen,
-											  ILTypeGetParam(signature, param));
-		if(marshalType != IL_META_MARSHAL_DIRECT)
+		switch(item->kind)
 		{
-			switch(marshalType)
+			case IL_THUNK_VOID:		break;
+
+			case IL_THUNK_ANSI_STRING:
 			{
-				case IL_META_MARSHAL_ANSI_STRING:
+				/* Marshal an ANSI string from the native world */
+				CHECK_SPACE(1);
+				strValue = *((char **)(*args));
+				if(strValue)
 				{
-					/* Marshal an ANSI string from the native world */
-					CHECK_SPACE(1);
-					strValue = *((char **)(*args));
-					if(strValue)
-					{
-						stacktop->ptrValue = ILStringCreate(thread, strValue);
+					stacktop->ptrValue = ILStringCreate(thread, strValue);
 
-						/* Free the native string */
-						ILFreeNativeString(strValue);
+					/* Free the native string */
+					ILFreeNativeString(strValue);
 
-						if(!(stacktop->ptrValue))
-						{
-							return 1;
-						}
-					}
-					else
+					if(!(stacktop->ptrValue))
 					{
-						stacktop->ptrValue = 0;
+						return 1;
 					}
-					++args;
-					++stacktop;
 				}
-				continue;
+				else
+				{
+					stacktop->ptrValue = 0;
+				}
+				++args;
+				++stacktop;
+			}
+			break;
 
-				case IL_META_MARSHAL_UTF8_STRING:
+			case IL_THUNK_UTF8_STRING:
+			{
+				/* Marshal a UTF-8 string from the native world */
+				CHECK_SPACE(1);
+				strValue = *((char **)(*args));
+				if(strValue)
 				{
-					/* Marshal a UTF-8 string from the native world */
-					CHECK_SPACE(1);
-					strValue = *((char **)(*args));
-					if(strValue)
-					{
-						stacktop->ptrValue =
-							ILStringCreateUTF8(thread, strValue);
+					stacktop->ptrValue =
+						ILStringCreateUTF8(thread, strValue);
 
-						/* Free the native string */
-						ILFreeNativeString(strValue);
+					/* Free the native string */
+					ILFreeNativeString(strValue);
 
-						if(!(stacktop->ptrValue))
-						{
-							return 1;
-						}
-					}
-					else
+					if(!(stacktop->ptrValue))
 					{
-						stacktop->ptrValue = 0;
+						return 1;
 					}
-					++args;
-					++stacktop;
 				}
-				continue;
-
-				case IL_META_MARSHAL_UTF16_STRING:
+				else
 				{
-					/* Marshal a UTF-16 string from the native world */
-					CHECK_SPACE(1);
-					strValue = *((char **)(*args));
-					if(strValue)
-					{
-						stacktop->ptrValue =
-							ILStringWCreate(thread, (ILUInt16 *)strValue);
-
-						/* Free the native string */
-						ILFreeNativeString(strValue);
-					
-						if(!(stacktop->ptrValue))
-						{
-							return 1;
-						}
-					}
-					else
-					{
-						stacktop->ptrValue = 0;
-					}
-					++args;
-					++stacktop;
+					stacktop->ptrValue = 0;
 				}
-				continue;
+				++args;
+				++stacktop;
+			}
+			break;
 
-				case IL_META_MARSHAL_CUSTOM:
+			case IL_THUNK_UTF16_STRING:
+			{
+				/* Marshal a UTF-16 string from the native world */
+				CHECK_SPACE(1);
+				strValue = *((char **)(*args));
+				if(strValue)
 				{
-					/* Marshal a custom value from the native world */
-					CHECK_SPACE(1);
-					stacktop->ptrValue = _ILCustomToObject
-						(thread, *((void **)(*args)),
-						 customName, customNameLen,
-						 customCookie, customCookieLen);
-					if(_ILExecThreadHasException(thread))
+					stacktop->ptrValue =
+						ILStringWCreate(thread, (ILUInt16 *)strValue);
+
+					/* Free the native string */
+					ILFreeNativeString(strValue);
+				
+					if(!(stacktop->ptrValue))
 					{
 						return 1;
 					}
-					++args;
-					++stacktop;
 				}
-				continue;
+				else
+				{
+					stacktop->ptrValue = 0;
+				}
+				++args;
+				++stacktop;
 			}
-		}
+			break;
 
-		/* Marshal the parameter directly */
-		paramType = ILTypeGetEnumType(ILTypeGetParam(signature, param));
-		if(ILType_IsPrimitive(paramType))
-		{
-			/* Process a primitive value */
-			switch(ILType_ToElement(paramType))
+			case IL_THUNK_CUSTOM:
 			{
-				case IL_META_ELEMTYPE_VOID:		break;
-
-				case IL_META_ELEMTYPE_BOOLEAN:
-				case IL_META_ELEMTYPE_I1:
-				case IL_META_ELEMTYPE_U1:
-				case IL_META_ELEMTYPE_I2:
-				case IL_META_ELEMTYPE_U2:
-				case IL_META_ELEMTYPE_CHAR:
-				case IL_META_ELEMTYPE_I4:
-				case IL_META_ELEMTYPE_U4:
-			#ifdef IL_NATIVE_INT32
-				case IL_META_ELEMTYPE_I:
-				case IL_META_ELEMTYPE_U:
-			#endif
-				{
-					CHECK_SPACE(1);
-					stacktop->intValue = *((ILInt32 *)(*args));
-					++args;
-					++stacktop;
-				}
-				break;
-
-				case IL_META_ELEMTYPE_I8:
-				case IL_META_ELEMTYPE_U8:
-			#ifdef IL_NATIVE_INT64
-				case IL_META_ELEMTYPE_I:
-				case IL_META_ELEMTYPE_U:
-			#endif
+				/* Marshal a custom value from the native world */
+				CHECK_SPACE(1);
+				stacktop->ptrValue = _ILCustomToObject
+					(thread, *((void **)(*args)),
+					 item->customName, item->customNameLen,
+					 item->customCookie, item->customCookieLen);
+				if(_ILExecThreadHasException(thread))
 				{
-					CHECK_SPACE(CVM_WORDS_PER_LONG);
-					ILMemCpy(stacktop, *args, sizeof(ILInt64));
-					++args;
-					stacktop += CVM_WORDS_PER_LONG;
+					return 1;
 				}
-				break;
+				++args;
+				++stacktop;
+			}
+			break;
 
-				case IL_META_ELEMTYPE_R4:
-				{
-					CHECK_SPACE(CVM_WORDS_PER_NATIVE_FLOAT);
-					tempFloat = (ILNativeFloat)(*((ILFloat *)(*args)));
-					ILMemCpy(stacktop, &tempFloat, sizeof(ILNativeFloat));
-					++args;
-					stacktop += CVM_WORDS_PER_NATIVE_FLOAT;
-				}
-				break;
+			case IL_THUNK_INT32:
+			{
+				CHECK_SPACE(1);
+				stacktop->intValue = *((ILInt32 *)(*args));
+				++args;
+				++stacktop;
+			}
+			break;
 
-				case IL_META_ELEMTYPE_R8:
-				{
-					CHECK_SPACE(CVM_WORDS_PER_NATIVE_FLOAT);
-					tempFloat = (ILNativeFloat)(*((ILDouble *)(*args)));
-					ILMemCpy(stacktop, &tempFloat, sizeof(ILNativeFloat));
-					++args;
-					stacktop += CVM_WORDS_PER_NATIVE_FLOAT;
-				}
-				break;
+			case IL_THUNK_INT64:
+			{
+				CHECK_SPACE(CVM_WORDS_PER_LONG);
+				ILMemCpy(stacktop, *args, sizeof(ILInt64));
+				++args;
+				stacktop += CVM_WORDS_PER_LONG;
+			}
+			break;
 
-				case IL_META_ELEMTYPE_R:
-				{
-					CHECK_SPACE(CVM_WORDS_PER_NATIVE_FLOAT);
-					ILMemCpy(stacktop, *args, sizeof(ILNativeFloat));
-					++args;
-					stacktop += CVM_WORDS_PER_NATIVE_FLOAT;
-				}
-				break;
+			case IL_THUNK_FLOAT32:
+			{
+				CHECK_SPACE(CVM_WORDS_PER_NATIVE_FLOAT);
+				tempFloat = (ILNativeFloat)(*((ILFloat *)(*args)));
+				ILMemCpy(stacktop, &tempFloat, sizeof(ILNativeFloat));
+				++args;
+				stacktop += CVM_WORDS_PER_NATIVE_FLOAT;
+			}
+			break;
 
-				case IL_META_ELEMTYPE_TYPEDBYREF:
-				{
-					CHECK_SPACE(CVM_WORDS_PER_TYPED_REF);
-					ILMemCpy(stacktop, *args, sizeof(ILTypedRef));
-					++args;
-					stacktop += CVM_WORDS_PER_TYPED_REF;
-				}
-				break;
+			case IL_THUNK_FLOAT64:
+			{
+				CHECK_SPACE(CVM_WORDS_PER_NATIVE_FLOAT);
+				tempFloat = (ILNativeFloat)(*((ILDouble *)(*args)));
+				ILMemCpy(stacktop, &tempFloat, sizeof(ILNativeFloat));
+				++args;
+				stacktop += CVM_WORDS_PER_NATIVE_FLOAT;
 			}
-		}
-		else if(ILType_IsClass(paramType))
-		{
-			/* Process an object reference */
-			CHECK_SPACE(1);
-			stacktop->ptrValue = *((void **)(*args));
-			++args;
-			++stacktop;
-		}
-		else if(ILType_IsValueType(paramType))
-		{
-			/* Process a value type which was passed by value */
-			ptr = *args;
-			++args;
-			size = ILSizeOfType(thread, paramType);
-			sizeInWords = ((size + sizeof(CVMWord) - 1) / sizeof(CVMWord));
-			CHECK_SPACE(sizeInWords);
-			ILMemCpy(stacktop, ptr, size);
-			stacktop += sizeInWords;
-		}
-		else if(paramType != 0 && ILType_IsComplex(paramType) &&
-				(ILType_Kind(paramType) == IL_TYPE_COMPLEX_BYREF || 
-				 ILType_Kind(paramType) == IL_TYPE_COMPLEX_PTR))
-		{
-			/* Process a value that is being passed by reference */
-			CHECK_SPACE(1);
-			stacktop->ptrValue = *((void **)(*args));
-			++args;
-			++stacktop;
-		}
-		else
-		{
-			/* Assume that everything else is an object reference */
-			CHECK_SPACE(1);
-			stacktop->ptrValue = *args;
-			++args;
-			++stacktop;
+			break;
+
+			case IL_THUNK_NFLOAT:
+			{
+				CHECK_SPACE(CVM_WORDS_PER_NATIVE_FLOAT);
+				ILMemCpy(stacktop, *args, sizeof(ILNativeFloat));
+				++args;
+				stacktop += CVM_WORDS_PER_NATIVE_FLOAT;
+			}
+			break;
+
+			case IL_THUNK_TYPEDREF:
+			{
+				CHECK_SPACE(CVM_WORDS_PER_TYPED_REF);
+				ILMemCpy(stacktop, *args, sizeof(ILTypedRef));
+				++args;
+				stacktop += CVM_WORDS_PER_TYPED_REF;
+			}
+			break;
+
+			case IL_THUNK_VALUE:
+			{
+				/* Process a value type which was passed by value */
+				sizeInWords = ((item->size + sizeof(CVMWord) - 1) /
+									sizeof(CVMWord));
+				CHECK_SPACE(sizeInWords);
+				ILMemCpy(stacktop, *args, item->size);
+				++args;
+				stacktop += sizeInWords;
+			}
+			break;
+
+			case IL_THUNK_INDIRECT:
+			{
+				/* Assume that everything else is an object reference */
+				CHECK_SPACE(1);
+				stacktop->ptrValue = *args;
+				++args;
+				++stacktop;
+			}
+			break;
+
+			default:
+			{
+				/* Process an object reference or a value that
+				   is being passed by reference */
+				CHECK_SPACE(1);
+				stacktop->ptrValue = *((void **)(*args));
+				++args;
+				++stacktop;
+			}
+			break;
 		}
 	}
 
@@ -757,188 +1244,148 @@ static int PackDelegateParams(ILExecThread *thread, ILMethod *method,
 static void UnpackDelegateResult(ILExecThread *thread, ILMethod *method,
 					             int isCtor, void *result, void *userData)
 {
-	ILMethod *pinvokeInfo = ((PackDelegateUserData *)userData)->pinvokeInfo;
-	ILType *signature = ILMethod_Signature(method);
-	ILType *paramType;
-	ILUInt32 size, sizeInWords;
+	ILClosureThunkItem *item = &(((PackDelegateUserData *)userData)->thunk->result);
+	ILUInt32 sizeInWords;
 	ILNativeFloat tempFloat;
-	ILUInt32 marshalType;
-	char *customName;
-	int customNameLen;
-	char *customCookie;
-	int customCookieLen;
-
-	/* Marshal return types that need special handling */
-	marshalType = ILPInvokeGetMarshalType
-			(0, pinvokeInfo, 0, &customName, &customNameLen,
-			 &customCookie, &customCookieLen, ILTypeGetReturn(signature));
-	if(marshalType != IL_META_MARSHAL_DIRECT)
-	{
-		switch(marshalType)
+
+	switch(item->kind)
+	{
+		case IL_THUNK_VOID:		break;
+
+		case IL_THUNK_ANSI_STRING:
 		{
-			case IL_META_MARSHAL_ANSI_STRING:
-			{
-				/* Marshal an ANSI string back to the native world */
-				*((char **)result) = ILStringToAnsi
-					(thread, (ILString *)(thread->stackTop[-1].ptrValue));
-				--(thread->stackTop);
-			}
-			return;
+			/* Marshal an ANSI string back to the native world */
+			*((char **)result) = ILStringToAnsi
+				(thread, (ILString *)(thread->stackTop[-1].ptrValue));
+			--(thread->stackTop);
+		}
+		break;
 
-			case IL_META_MARSHAL_UTF8_STRING:
-			{
-				/* Marshal a UTF-8 string back to the native world */
-				*((char **)result) = ILStringToUTF8
-					(thread, (ILString *)(thread->stackTop[-1].ptrValue));
-				--(thread->stackTop);
-			}
-			return;
+		case IL_THUNK_UTF8_STRING:
+		{
+			/* Marshal a UTF-8 string back to the native world */
+			*((char **)result) = ILStringToUTF8
+				(thread, (ILString *)(thread->stackTop[-1].ptrValue));
+			--(thread->stackTop);
+		}
+		break;
 
-			case IL_META_MARSHAL_UTF16_STRING:
-			{
-				/* Marshal a UTF-16 string back to the native world */
-				*((ILUInt16 **)result) = ILStringToUTF16
-					(thread, (ILString *)(thread->stackTop[-1].ptrValue));
-				--(thread->stackTop);
-			}
-			return;
+		case IL_THUNK_UTF16_STRING:
+		{
+			/* Marshal a UTF-16 string back to the native world */
+			*((ILUInt16 **)result) = ILStringToUTF16
+				(thread, (ILString *)(thread->stackTop[-1].ptrValue));
+			--(thread->stackTop);
+		}
+		break;
 
-			case IL_META_MARSHAL_FNPTR:
-			{
-				/* Convert a delegate into a function closure pointer */
-				*((void **)result) = _ILDelegateGetClosure
-					(thread, (ILObject *)(thread->stackTop[-1].ptrValue));
-				--(thread->stackTop);
-			}
-			return;
+		case IL_THUNK_FNPTR:
+		{
+			/* Convert a delegate into a function closure pointer */
+			*((void **)result) = _ILDelegateGetClosure
+				(thread, (ILObject *)(thread->stackTop[-1].ptrValue));
+			--(thread->stackTop);
+		}
+		break;
 
-			case IL_META_MARSHAL_ARRAY:
+		case IL_THUNK_ARRAY:
+		{
+			/* Convert an array into a pointer to its first member */
+			void *array = thread->stackTop[-1].ptrValue;
+			--(thread->stackTop);
+			if(array)
 			{
-				/* Convert an array into a pointer to its first member */
-				void *array = thread->stackTop[-1].ptrValue;
-				--(thread->stackTop);
-				if(array)
-				{
-					*((void **)result) = ArrayToBuffer(array);
-				}
-				else
-				{
-					*((void **)result) = 0;
-				}
+				*((void **)result) = ArrayToBuffer(array);
 			}
-			return;
-
-			case IL_META_MARSHAL_CUSTOM:
+			else
 			{
-				/* Marshal a custom value to the native world */
-				*((void **)result) = _ILObjectToCustom
-					(thread, (ILObject *)(thread->stackTop[-1].ptrValue),
-					 customName, customNameLen, customCookie, customCookieLen);
-				--(thread->stackTop);
+				*((void **)result) = 0;
 			}
-			return;
 		}
-	}
+		break;
 
-	/* Copy the return value into place */
-	paramType = ILTypeGetEnumType(ILTypeGetReturn(signature));
-	if(ILType_IsPrimitive(paramType))
-	{
-		/* Process a primitive value */
-		switch(ILType_ToElement(paramType))
+		case IL_THUNK_CUSTOM:
 		{
-			case IL_META_ELEMTYPE_VOID:		break;
+			/* Marshal a custom value to the native world */
+			*((void **)result) = _ILObjectToCustom
+				(thread, (ILObject *)(thread->stackTop[-1].ptrValue),
+				 item->customName, item->customNameLen,
+				 item->customCookie, item->customCookieLen);
+			--(thread->stackTop);
+		}
+		break;
 
-			case IL_META_ELEMTYPE_BOOLEAN:
-			case IL_META_ELEMTYPE_I1:
-			case IL_META_ELEMTYPE_U1:
-			case IL_META_ELEMTYPE_I2:
-			case IL_META_ELEMTYPE_U2:
-			case IL_META_ELEMTYPE_CHAR:
-			case IL_META_ELEMTYPE_I4:
-			case IL_META_ELEMTYPE_U4:
-		#ifdef IL_NATIVE_INT32
-			case IL_META_ELEMTYPE_I:
-			case IL_META_ELEMTYPE_U:
-		#endif
-			{
-				*((ILInt32 *)result) = thread->stackTop[-1].intValue;
-				--(thread->stackTop);
-			}
-			break;
+		case IL_THUNK_INT32:
+		{
+			*((ILInt32 *)result) = thread->stackTop[-1].intValue;
+			--(thread->stackTop);
+		}
+		break;
 
-			case IL_META_ELEMTYPE_I8:
-			case IL_META_ELEMTYPE_U8:
-		#ifdef IL_NATIVE_INT64
-			case IL_META_ELEMTYPE_I:
-			case IL_META_ELEMTYPE_U:
-		#endif
-			{
-				ILMemCpy(result,
-						 thread->stackTop - CVM_WORDS_PER_LONG,
-						 sizeof(ILInt64));
-				thread->stackTop -= CVM_WORDS_PER_LONG;
-			}
-			break;
+		case IL_THUNK_INT64:
+		{
+			ILMemCpy(result,
+					 thread->stackTop - CVM_WORDS_PER_LONG,
+					 sizeof(ILInt64));
+			thread->stackTop -= CVM_WORDS_PER_LONG;
+		}
+		break;
 
-			case IL_META_ELEMTYPE_R4:
-			{
-				ILMemCpy(&tempFloat,
-						 thread->stackTop - CVM_WORDS_PER_NATIVE_FLOAT,
-						 sizeof(ILNativeFloat));
-				*((ILFloat *)result) = (ILFloat)tempFloat;
-				thread->stackTop -= CVM_WORDS_PER_NATIVE_FLOAT;
-			}
-			break;
+		case IL_THUNK_FLOAT32:
+		{
+			ILMemCpy(&tempFloat,
+					 thread->stackTop - CVM_WORDS_PER_NATIVE_FLOAT,
+					 sizeof(ILNativeFloat));
+			*((ILFloat *)result) = (ILFloat)tempFloat;
+			thread->stackTop -= CVM_WORDS_PER_NATIVE_FLOAT;
+		}
+		break;
 
-			case IL_META_ELEMTYPE_R8:
-			{
-				ILMemCpy(&tempFloat,
-						 thread->stackTop - CVM_WORDS_PER_NATIVE_FLOAT,
-						 sizeof(ILNativeFloat));
-				*((ILDouble *)result) = (ILDouble)tempFloat;
-				thread->stackTop -= CVM_WORDS_PER_NATIVE_FLOAT;
-			}
-			break;
+		case IL_THUNK_FLOAT64:
+		{
+			ILMemCpy(&tempFloat,
+					 thread->stackTop - CVM_WORDS_PER_NATIVE_FLOAT,
+					 sizeof(ILNativeFloat));
+			*((ILDouble *)result) = (ILDouble)tempFloat;
+			thread->stackTop -= CVM_WORDS_PER_NATIVE_FLOAT;
+		}
+		break;
 
-			case IL_META_ELEMTYPE_R:
-			{
-				ILMemCpy(result,
-						 thread->stackTop - CVM_WORDS_PER_NATIVE_FLOAT,
-						 sizeof(ILNativeFloat));
-				thread->stackTop -= CVM_WORDS_PER_NATIVE_FLOAT;
-			}
-			break;
+		case IL_THUNK_NFLOAT:
+		{
+			ILMemCpy(result,
+					 thread->stackTop - CVM_WORDS_PER_NATIVE_FLOAT,
+					 sizeof(ILNativeFloat));
+			thread->stackTop -= CVM_WORDS_PER_NATIVE_FLOAT;
+		}
+		break;
 
-			case IL_META_ELEMTYPE_TYPEDBYREF:
-			{
-				ILMemCpy(result,
-						 thread->stackTop - CVM_WORDS_PER_TYPED_REF,
-						 sizeof(ILTypedRef));
-				thread->stackTop -= CVM_WORDS_PER_TYPED_REF;
-			}
-			break;
+		case IL_THUNK_TYPEDREF:
+		{
+			ILMemCpy(result,
+					 thread->stackTop - CVM_WORDS_PER_TYPED_REF,
+					 sizeof(ILTypedRef));
+			thread->stackTop -= CVM_WORDS_PER_TYPED_REF;
 		}
-	}
-	else if(ILType_IsClass(paramType))
-	{
-		/* Process an object reference */
-		*((void **)result) = thread->stackTop[-1].ptrValue;
-		--(thread->stackTop);
-	}
-	else if(ILType_IsValueType(paramType))
-	{
-		/* Process a value type */
-		size = ILSizeOfType(thread, paramType);
-		sizeInWords = ((size + sizeof(CVMWord) - 1) / sizeof(CVMWord));
-		ILMemCpy(result, thread->stackTop - sizeInWords, size);
-		thread->stackTop -= sizeInWords;
-	}
-	else
-	{
-		/* Assume that everything else is an object reference */
-		*((void **)result) = thread->stackTop[-1].ptrValue;
-		--(thread->stackTop);
+		break;
+
+		case IL_THUNK_VALUE:
+		{
+			/* Process a value type */
+			sizeInWords = ((item->size + sizeof(CVMWord) - 1) /
+								sizeof(CVMWord));
+			ILMemCpy(result, thread->stackTop - sizeInWords, item->size);
+			thread->stackTop -= sizeInWords;
+		}
+		break;
+
+		default:
+		{
+			/* Process an object reference */
+			*((void **)result) = thread->stackTop[-1].ptrValue;
+			--(thread->stackTop);
+		}
+		break;
 	}
 }
 
@@ -948,6 +1395,7 @@ typedef struct {
 	void *result;
 	void **args;
 	System_Delegate *delegate;
+	ILClosureThunk *thunk;
 } ILDelegateInvokeParams;
 
 /*
@@ -970,7 +1418,7 @@ static void _DelegateInvoke(ILDelegateInvokeParams *params)
 		prevParams.result = params->result;
 		prevParams.args = params->args;
 		prevParams.delegate = (System_Delegate *)(params->delegate->prev);
-;
+		prevParams.thunk = params->thunk;
 		_DelegateInvoke(&prevParams);
 		if(_ILExecThreadHasException(params->thread))
 		{
@@ -989,8 +1437,7 @@ static void _DelegateInvoke(ILDelegateInvokeParams *params)
 
 	/* Call the method */
 	userData.args = params->args;
-	userData.pinvokeInfo = (ILMethod *)ILTypeGetDelegateMethod
-		(ILType_FromClass(GetObjectClass(params->delegate)));
+	userData.thunk = params->thunk;
 	userData.needThis = 0;
 	if(_ILCallMethod(params->thread, method,
 				     UnpackDelegateResult, params->result,
@@ -1031,9 +1478,10 @@ static void *_DelegateInvokeFromNewThread(void *params)
  * Invoke a delegate from a closure.
  */
 static void DelegateInvoke(ffi_cif *cif, void *result,
-						   void **args, void *delegate)
+						   void **args, void *data)
 {
 	ILThread *thread = ILThreadSelf();
+	System_Delegate *delegate = ((ILDelegateClosureData *)data)->delegate;
 	ILClassPrivate *classPrivate = GetObjectClassPrivate(delegate);
 	ILExecProcess *process = classPrivate->process;
 	ILDelegateInvokeParams params;
@@ -1042,7 +1490,8 @@ static void DelegateInvoke(ffi_cif *cif, void *result,
 	params.cif = cif;
 	params.result = result;
 	params.args = args;
-	params.delegate = (System_Delegate *)delegate;
+	params.delegate = delegate;
+	params.thunk = ((ILDelegateClosureData *)data)->thunk;
 	if(!thread)
 	{
 		/* callback was invoked by a non pnet thread. */
@@ -1076,17 +1525,17 @@ static void DelegateInvoke(ffi_cif *cif, void *result,
  * Invoke a method from a closure.
  */
 static void MethodInvoke(ffi_cif *cif, void *result,
-						 void **args, void *_method)
+						 void **args, void *thunk)
 {
 	ILExecThread *thread = ILExecThreadCurrent();
-	ILMethod *method = (ILMethod *)_method;
+	ILMethod *method = ((ILClosureThunk *)thunk)->pinvokeInfo;
 	ILType *type;
 	ILUInt32 size;
 	PackDelegateUserData userData;
 
 	/* Call the method */
 	userData.args = args;
-	userData.pinvokeInfo = method;
+	userData.thunk = (ILClosureThunk *)thunk;
 	userData.needThis = 0;
 	if(_ILCallMethod(thread, method,
 				     UnpackDelegateResult, result, 0, 0,
@@ -1118,7 +1567,10 @@ void *_ILMakeClosureForDelegate(ILExecProcess *process, ILObject *delegate, ILMe
 	ffi_type *rtype;
 	ILUInt32 arg;
 	ILUInt32 param;
+	ILMethod *pinvokeInfo;
+	ILClosureThunk *thunk;
 	ffi_closure *closure;
+	ILDelegateClosureData *data;
 	void *closure_code = 0;
 
 	/* Determine the number of argument blocks that we need */
@@ -1149,13 +1601,34 @@ void *_ILMakeClosureForDelegate(ILExecProcess *process, ILObject *delegate, ILMe
 									(ILTypeGetParam(signature, param)), 0);
 	}
 
-	/* Prepare the "ffi_cif" structure for the call */
-	if(ffi_prep_cif(cif, FFI_DEFAULT_ABI, arg, rtype, args) != FFI_OK)
+	/* Delegates are marshalled according to their "Invoke" method */
+	pinvokeInfo = 0;
+	if(delegate)
+	{
+		pinvokeInfo = (ILMethod *)ILTypeGetDelegateMethod
+			(ILType_FromClass(GetObjectClass(delegate)));
+	}
+	if(!pinvokeInfo)
+	{
+		pinvokeInfo = method;
+	}
+
+	/* Prepare the "ffi_cif" structure for the call and find the
+	   marshalling plan for the closure's signature */
+	IL_METADATA_WRLOCK(process);
+	cif = PrepareSharedCif(process, cif, arg, rtype, args);
+	thunk = (cif ? GetClosureThunk(process, pinvokeInfo) : 0);
+	IL_METADATA_UNLOCK(process);
+	if(!cif)
 	{
 		fprintf(stderr, "Cannot marshal a type in the definition of %s::%s\n",
 				ILClass_Name(ILMethod_Owner(method)), ILMethod_Name(method));
 		return 0;
 	}
+	if(!thunk)
+	{
+		return 0;
+	}
 
 	/*
 	 * Allocate space for the closure.
@@ -1165,7 +1638,8 @@ void *_ILMakeClosureForDelegate(ILExecProcess *process, ILObject *delegate, ILMe
 	 * Not doing this means that delegates and the objects the delegates work
 	 * on will never get collected.
 	 */
-	closure = (ffi_closure *)ffi_closure_alloc(sizeof(ffi_closure), &closure_code);
+	closure = (ffi_closure *)ffi_closure_alloc
+		(sizeof(ffi_closure) + sizeof(ILDelegateClosureData), &closure_code);
 	if(!closure)
 	{
 		return 0;
@@ -1174,7 +1648,11 @@ void *_ILMakeClosureForDelegate(ILExecProcess *process, ILObject *delegate, ILMe
 	/* Prepare the closure using the call parameters */
 	if(delegate)
 	{
-		if(ffi_prep_closure_loc(closure, cif, DelegateInvoke, (void *)delegate, closure_code)
+		/* The delegate data lives in the writable part of the closure */
+		data = (ILDelegateClosureData *)(closure + 1);
+		data->delegate = (System_Delegate *)delegate;
+		data->thunk = thunk;
+		if(ffi_prep_closure_loc(closure, cif, DelegateInvoke, (void *)data, closure_code)
 				!= FFI_OK)
 		{
 			fprintf(stderr, "Cannot create a closure for %s::%s\n",
@@ -1184,7 +1662,7 @@ void *_ILMakeClosureForDelegate(ILExecProcess *process, ILObject *delegate, ILMe
 	}
 	else
 	{
-		if(ffi_prep_closure_loc(closure, cif, MethodInvoke, (void *)method, closure_code)
+		if(ffi_prep_closure_loc(closure, cif, MethodInvoke, (void *)thunk, closure_code)
 				!= FFI_OK)
 		{
 			fprintf(stderr, "Cannot create a closure for %s::%s\n",
@@ -315,6 +315,20 @@ static void _ILExecProcessDestroyInternal(ILExecProcess *process,
 		process->reflectionHash = 0;
 	}
 
+	if (process->cifHash)
+	{
+		/* Destroy the shared native call descriptors */
+		ILHashDestroy((ILHashTable *)(process->cifHash));
+		process->cifHash = 0;
+	}
+
+	if (process->closureThunkHash)
+	{
+		/* Destroy the marshalling plans for native closures */
+		ILHashDestroy((ILHashTable *)(process->closureThunkHash));
+		process->closureThunkHash = 0;
+	}
+
 #ifdef IL_CONFIG_PINVOKE
 	/* Destroy the loaded module list */
 	{
@@ -442,12 +456,18 @@ static ILExecProcess *_ILExecProcessCreateInternal(void)
 	process->stringClass = 0;
 	process->exceptionClass = 0;
 	process->clrTypeClass = 0;
+	ILMemZero(process->wellKnownClasses, sizeof(process->wellKnownClasses));
+	ILMemZero(process->wellKnownMethods, sizeof(process->wellKnownMethods));
 	process->outOfMemoryObject = 0;	
 	process->commandLineObject = 0;
 	process->threadAbortClass = 0;
+	process->stackTraceField = 0;
+	process->packedFrameArrayClass = 0;
 	ILGetCurrTime(&(process->startTime));
 	process->internHash = 0;
 	process->reflectionHash = 0;
+	process->cifHash = 0;
+	process->closureThunkHash = 0;
 	process->loadedModules = 0;
 	process->gcHandles = 0;
 	process->entryImage = 0;
@@ -865,6 +885,9 @@ void _ILExecProcessLoadStandard(ILExecProcess *process,
 			"ThreadAbortException", "System.Threading");
 	}
 
+	/* Look for the other well-known classes */
+	_ILResolveWellKnownClasses(process, image);
+
 	process->state = _IL_PROCESS_STATE_LOADED;
 }
 
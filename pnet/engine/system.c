@@ -30,19 +30,46 @@ extern	"C" {
 ILMutex *globalTraceMutex;
 #endif
 
+ILField *_ILExceptionStackTraceField(ILExecThread *thread)
+{
+	ILExecProcess *process = thread->process;
+	ILField *field = process->stackTraceField;
+	if(!field)
+	{
+		field = ILExecThreadLookupField
+				(thread, "System.Exception", "stackTrace",
+				 "[vSystem.Diagnostics.PackedStackFrame;");
+		process->stackTraceField = field;
+	}
+	return field;
+}
+
+ILClass *_ILPackedStackFrameArrayClass(ILExecThread *thread)
+{
+	ILExecProcess *process = thread->process;
+	ILClass *classInfo = process->packedFrameArrayClass;
+	if(!classInfo)
+	{
+		classInfo = ILExecThreadLookupClass
+				(thread, "[vSystem.Diagnostics.PackedStackFrame;");
+		process->packedFrameArrayClass = classInfo;
+	}
+	return classInfo;
+}
+
 #if defined(IL_CONFIG_REFLECTION) && defined(IL_CONFIG_DEBUG_LINES)
 
 /*
  * Find the "stackTrace" field within "System.Exception" and then set.
+ * Only the raw frames are recorded here: the IL offsets are resolved
+ * when the trace is inspected (see "ResolveExceptionStackTrace").
  */
 static int FindAndSetStackTrace(ILExecThread *thread, ILObject *object)
 {
 	ILField *field;
 
 	/* Find the "stackTrace" field within the "Exception" class */
-	field = ILExecThreadLookupField
-			(thread, "System.Exception", "stackTrace",
-			 "[vSystem.Diagnostics.PackedStackFrame;");
+	field = _ILExceptionStackTraceField(thread);
 	if(field)
 	{
 #ifdef IL_USE_CVM
@@ -99,7 +126,11 @@ void _ILSetExceptionStackTrace(ILExecThread *thread, ILObject *object)
 	{
 		return;
 	}
-	classInfo = ILExecThreadLookupClass(thread, "System.Exception");
+	classInfo = thread->process->exceptionClass;
+	if(!classInfo)
+	{
+		classInfo = ILExecThreadLookupClass(thread, "System.Exception");
+	}
 	if(!classInfo)
 	{
 		return;
@@ -168,6 +199,21 @@ void *_ILSystemException(ILExecThread *thread, const char *className)
 	return _ILSystemExceptionWithClass(thread, classInfo);
 }
 
+void *_ILSystemWellKnownException(ILExecThread *thread, int index)
+{
+	ILClass *classInfo = _ILWellKnownClass(thread, index);
+	if(!classInfo)
+	{
+	#ifndef REDUCED_STDIO
+		/* Huh?  The required class doesn't exist.  This shouldn't happen */
+		fprintf(stderr, "Fatal error: %s is missing from the system library\n",
+				_ILWellKnownClassName(index));
+		exit(1);
+	#endif
+	}
+	return _ILSystemExceptionWithClass(thread, classInfo);
+}
+
 int _ILSystemObjectSetField(ILExecThread *thread, ILObject* obj,
 							const char *fieldName, const char *signature,
 							ILObject *value)
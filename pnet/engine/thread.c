@@ -69,7 +69,7 @@ ILObject *ILExecThreadCurrentClrThread()
 	
 		/* Get the CLR thread class */
 
-		classInfo = ILExecThreadLookupClass(thread, "System.Threading.Thread");
+		classInfo = _ILWellKnownClass(thread, IL_WKC_THREAD);
 
 		/* Allocate a new CLR thread object */
 
@@ -80,7 +80,7 @@ ILObject *ILExecThreadCurrentClrThread()
 		
 		/* Execute the private constructor */
 
-		method = ILExecThreadLookupMethod(thread, "System.Threading.Thread", ".ctor", "(Tj)V");
+		method = _ILWellKnownMethod(thread, IL_WKM_THREAD_CTOR);
 
 		if (method == 0)
 		{
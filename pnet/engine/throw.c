@@ -73,8 +73,7 @@ void ILExecThreadThrowSystem(ILExecThread *thread, const char *typeName,
 	   look up localised error messages */
 	if(resourceName)
 	{
-		method = ILExecThreadLookupMethod(thread, "System.Object", "_",
-										  "(oSystem.String;)oSystem.String;");
+		method = _ILWellKnownMethod(thread, IL_WKM_OBJECT_RESOURCE);
 		if(method)
 		{
 			resourceString = ILStringCreate(thread, resourceName);
@@ -126,8 +125,7 @@ void ILExecThreadThrowArgRange(ILExecThread *thread, const char *paramName,
 	   look up localised error messages */
 	if(resourceName)
 	{
-		method = ILExecThreadLookupMethod(thread, "System.Object", "_",
-										  "(oSystem.String;)oSystem.String;");
+		method = _ILWellKnownMethod(thread, IL_WKM_OBJECT_RESOURCE);
 		if(method)
 		{
 			resourceString = ILStringCreate(thread, resourceName);
@@ -306,6 +304,10 @@ void ILExecThreadPrintException(ILExecThread *thread)
 	/* Print the exception stack trace */
 	if(stackTrace)
 	{
+	#ifdef IL_CONFIG_DEBUG_LINES
+		_IL_StackFrame_ResolveExceptionStackTrace
+			(thread, (System_Array *)stackTrace);
+	#endif
 		frames = (PackedStackFrame *)ArrayToBuffer(stackTrace);
 		length = ArrayLength(stackTrace);
 		for(posn = 0; posn < length; ++posn)
@@ -1331,6 +1331,97 @@ static InlineMethodInfo const InlineMethods[] = {
 };
 #define	NumInlineMethods	(sizeof(InlineMethods) / sizeof(InlineMethodInfo))
 
+/*
+ * Table of inline functions in the C library.  The parameter and return
+ * types are 'p' for a pointer and 'i' for a 32-bit integer, because the
+ * qualifiers on C pointer types appear as modifiers in the signature.
+ */
+static InlineMethodInfo const InlineCFunctions[] = {
+	{"<Module>", 0, "strlen", "(p)i", IL_INLINEMETHOD_STRLEN},
+	{"<Module>", 0, "strcmp", "(pp)i", IL_INLINEMETHOD_STRCMP},
+	{"<Module>", 0, "strchr", "(pi)p", IL_INLINEMETHOD_STRCHR},
+	{"<Module>", 0, "memcmp", "(ppi)i", IL_INLINEMETHOD_MEMCMP},
+	{"<Module>", 0, "memchr", "(pii)p", IL_INLINEMETHOD_MEMCHR}
+};
+#define	NumInlineCFunctions	(sizeof(InlineCFunctions) / sizeof(InlineMethodInfo))
+
+/*
+ * Match a C parameter or return type against a type code
+ * from the "InlineCFunctions" table.
+ */
+static int MatchCType(ILType *type, char code)
+{
+	type = ILTypeStripPrefixes(type);
+	if(code == 'p')
+	{
+		return (type != 0 && ILType_IsComplex(type) &&
+				ILType_Kind(type) == IL_TYPE_COMPLEX_PTR);
+	}
+	else
+	{
+		return (type == ILType_Int32 || type == ILType_UInt32);
+	}
+}
+
+/*
+ * Match a C function signature against an "InlineCFunctions" signature.
+ */
+static int MatchCSignature(ILType *signature, const char *name)
+{
+	ILUInt32 param, numParams;
+
+	if(ILType_HasThis(signature) ||
+	   (ILType_CallConv(signature) & IL_META_CALLCONV_MASK) ==
+	   		IL_META_CALLCONV_VARARG)
+	{
+		return 0;
+	}
+	++name;
+	numParams = ILTypeNumParams(signature);
+	for(param = 1; param <= numParams; ++param)
+	{
+		if(*name == ')' || !MatchCType(ILTypeGetParam(signature, param), *name))
+		{
+			return 0;
+		}
+		++name;
+	}
+	if(*name != ')')
+	{
+		return 0;
+	}
+	return MatchCType(ILTypeGetReturn(signature), name[1]);
+}
+
+/*
+ * Determine if the arguments to an inlined C library function are
+ * on the stack as the native pointers and integers that it expects.
+ */
+static int CFunctionArgsMatch(ILMethod *method, ILEngineStackItem *args)
+{
+	ILType *signature = ILMethod_Signature(method);
+	ILUInt32 param, numParams;
+
+	numParams = ILTypeNumParams(signature);
+	for(param = 1; param <= numParams; ++param)
+	{
+		if(MatchCType(ILTypeGetParam(signature, param), 'p'))
+		{
+			if(args[param - 1].engineType != ILEngineType_I &&
+			   args[param - 1].engineType != ILEngineType_M &&
+			   args[param - 1].engineType != ILEngineType_T)
+			{
+				return 0;
+			}
+		}
+		else if(args[param - 1].engineType != ILEngineType_I4)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
 /*
  * Determine if a method is inlineable, and return its inline type.
  * Returns -1 if the method is not inlineable.
@@ -1345,6 +1436,7 @@ static int GetInlineMethodType(ILMethod *method)
 	ILImage *image;
 	ILImage *systemImage;
 	ILType *signature;
+	const char *assemblyName;
 
 	/* Extract the information that we require to find the inline */
 	owner = ILMethod_Owner(method);
@@ -1373,6 +1465,25 @@ static int GetInlineMethodType(ILMethod *method)
 		}
 	}
 
+	/* Check for string functions in the C library */
+	if(!namespace && !strcmp(name, "<Module>"))
+	{
+		image = ILClassToImage(owner);
+		assemblyName = ILImageGetAssemblyName(image);
+		if(assemblyName && !strcmp(assemblyName, "libc"))
+		{
+			for(posn = 0; posn < NumInlineCFunctions; ++posn)
+			{
+				if(!strcmp(methodName, InlineCFunctions[posn].methodName) &&
+				   MatchCSignature(signature, InlineCFunctions[posn].signature))
+				{
+					return InlineCFunctions[posn].inlineType;
+				}
+			}
+		}
+		return -1;
+	}
+
 	/* Check for 2D array types */
 	if(Is2DArrayClass(owner))
 	{
@@ -1744,6 +1855,22 @@ callNonvirtualFromVirtual:
 							}
 						}
 						break;
+
+						case IL_INLINEMETHOD_STRLEN:
+						case IL_INLINEMETHOD_STRCMP:
+						case IL_INLINEMETHOD_STRCHR:
+						case IL_INLINEMETHOD_MEMCMP:
+						case IL_INLINEMETHOD_MEMCHR:
+						{
+							/* The native versions need real pointers and
+							   32-bit integers on the stack */
+							if(!CFunctionArgsMatch(methodInfo,
+											&(stack[stackSize - numParams])))
+							{
+								inlineType = -1;
+							}
+						}
+						break;
 					}
 
 				 	if (inlineType == IL_INLINEMETHOD_OFFSETTOSTRINGDATA)
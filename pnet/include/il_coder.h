@@ -242,6 +242,11 @@ typedef struct
 #define IL_INLINEMETHOD_ARRAY_COPY_AI4AI4I4	50
 #define IL_INLINEMETHOD_ARRAY_CLEAR_AI4I4	51
 #define IL_INLINEMETHOD_OFFSETTOSTRINGDATA	52
+#define	IL_INLINEMETHOD_STRLEN				53
+#define	IL_INLINEMETHOD_STRCMP				54
+#define	IL_INLINEMETHOD_STRCHR				55
+#define	IL_INLINEMETHOD_MEMCMP				56
+#define	IL_INLINEMETHOD_MEMCHR				57
 
 /*
  * Return values for "ILCoderFinish".
@@ -124,6 +124,14 @@ void ILSHA256Data(ILSHA256Context *sha, const void *buffer, unsigned long len);
 void ILSHA256Finalize(ILSHA256Context *sha,
 					  unsigned char hash[IL_SHA256_HASH_SIZE]);
 
+/*
+ * Hash a batch of independent messages with SHA-256, writing the
+ * hash of message "n" to "hashes + n * IL_SHA256_HASH_SIZE".
+ */
+void ILSHA256Batch(const unsigned char * const *data,
+				   const unsigned long *lengths,
+				   unsigned char *hashes, unsigned long count);
+
 /*
  * The size of SHA-512 hash values.
  */
@@ -287,8 +295,11 @@ int ILDESIsSemiWeakKey(unsigned char *key);
  */
 typedef struct
 {
-	int			numRounds;
-	ILInt32		keySchedule[15 * 4];
+	int				numRounds;
+	ILInt32			keySchedule[15 * 4];
+	int				useAESNI;
+	unsigned char	aesniEncrypt[15 * 16];
+	unsigned char	aesniDecrypt[15 * 16];
 
 } ILAESContext;
 
@@ -311,6 +322,35 @@ void ILAESEncrypt(ILAESContext *aes, unsigned char *input,
 void ILAESDecrypt(ILAESContext *aes, unsigned char *input,
 				  unsigned char *output);
 
+/*
+ * Encrypt or decrypt a run of 128-bit blocks in ECB mode.  The input
+ * and output buffers can be the same, but must not otherwise overlap.
+ */
+void ILAESEncryptECB(ILAESContext *aes, unsigned char *input,
+					 unsigned char *output, unsigned long numBlocks);
+void ILAESDecryptECB(ILAESContext *aes, unsigned char *input,
+					 unsigned char *output, unsigned long numBlocks);
+
+/*
+ * Encrypt or decrypt a run of 128-bit blocks in CBC mode.  The "iv"
+ * buffer is updated with the chaining value for the next run.
+ */
+void ILAESEncryptCBC(ILAESContext *aes, unsigned char *iv,
+					 unsigned char *input, unsigned char *output,
+					 unsigned long numBlocks);
+void ILAESDecryptCBC(ILAESContext *aes, unsigned char *iv,
+					 unsigned char *input, unsigned char *output,
+					 unsigned long numBlocks);
+
+/*
+ * Encrypt or decrypt a run of 128-bit blocks in CTR mode.  The
+ * "counter" buffer holds a 128-bit big-endian value that is
+ * incremented once for every block that is processed.
+ */
+void ILAESCryptCTR(ILAESContext *aes, unsigned char *counter,
+				   unsigned char *input, unsigned char *output,
+				   unsigned long numBlocks);
+
 /*
  * Finalize an AES encryption context, clearing all sensitive values.
  */
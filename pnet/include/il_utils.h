@@ -208,6 +208,45 @@ unsigned long ILUTF8ReadChar(const void *str, int len, int *posn);
  */
 int ILUTF8WriteChar(char *str, unsigned long ch);
 
+/*
+ * Convert a buffer of UTF-8 bytes into UTF-16 characters, stopping
+ * at the first sequence that is invalid, incomplete, longer than
+ * four bytes, or outside the Unicode range, or when "out" is full.
+ * Byte order marks are dropped.  Returns the number of bytes that
+ * were converted, and sets "*outUsed" to the number of characters.
+ * If "out" is NULL, then count the characters without storing them.
+ */
+unsigned long ILUTF8ToUTF16(const unsigned char *in, unsigned long inLen,
+							unsigned short *out, unsigned long outLen,
+							unsigned long *outUsed);
+
+/*
+ * Convert a buffer of UTF-16 characters into UTF-8 bytes, stopping
+ * at a surrogate start at the end of the buffer, or when "out" is
+ * full.  Unpaired surrogates are encoded as-is.  Returns the number
+ * of characters that were converted, and sets "*outUsed" to the
+ * number of bytes.  If "out" is NULL, then count the bytes without
+ * storing them.
+ */
+unsigned long ILUTF16ToUTF8(const unsigned short *in, unsigned long inLen,
+							unsigned char *out, unsigned long outLen,
+							unsigned long *outUsed);
+
+/*
+ * Convert ASCII bytes into UTF-16 characters.  Bytes outside the
+ * ASCII range are replaced with "replace", or are passed through
+ * as Latin-1 characters if "replace" is zero.
+ */
+void ILASCIIToUTF16(const unsigned char *in, unsigned short *out,
+					unsigned long len, unsigned short replace);
+
+/*
+ * Convert UTF-16 characters into ASCII bytes.  Characters outside
+ * the ASCII range are replaced with "replace".
+ */
+void ILUTF16ToASCII(const unsigned short *in, unsigned char *out,
+					unsigned long len, unsigned char replace);
+
 /*
  * Read a UTF-16 character from a 16-bit string position.
  * "len" and "posn" are indexes into a 16-bit array.
@@ -236,6 +275,14 @@ int ILUTF16WriteChar(unsigned short *buf, unsigned long ch);
  */
 int ILUTF16WriteCharAsBytes(void *buf, unsigned long ch);
 
+/*
+ * Find the first character in a 16-bit string that is one of the
+ * "numChars" characters in "chars".  Returns the index of the
+ * character, or -1 if none of them occur within the first "len".
+ */
+long ILUTF16FindAny(const unsigned short *str, unsigned long len,
+					const unsigned short *chars, unsigned long numChars);
+
 /*
  * Get the number of bytes that are needed to encode an array
  * of 16-bit Unicode characters in the "ANSI" encoding.
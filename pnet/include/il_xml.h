@@ -155,6 +155,14 @@ void ILXMLGetPacked(ILXMLReader *reader, void *buffer);
  */
 const char *ILXMLGetPackedParam(void *buffer, int len, const char *name);
 
+/*
+ * Get the length of the run of ASCII name characters at
+ * the start of a UTF-16 buffer.  The run stops at the first
+ * character that is not an ASCII name character, which may
+ * be a non-ASCII name character that the caller must check.
+ */
+unsigned long ILXMLNameCharRun(const unsigned short *buf, unsigned long len);
+
 #ifdef	__cplusplus
 };
 #endif
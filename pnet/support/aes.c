@@ -23,6 +23,10 @@
  * 128-bit, 192-bit, and 256-bit keys, based on the description that
  * can be found on the NIST Web site at "http://www.nist.gov/aes/".
  * This implementation is designed for correctness, not speed.
+ *
+ * The bulk ECB, CBC, and CTR functions use the AES-NI instructions
+ * instead, if the compiler can generate them and the processor says
+ * that it supports them; the portable code is used otherwise.
  */
 
 #include "il_crypt.h"
@@ -57,6 +61,21 @@ extern	"C" {
 				(buf)[3] = (unsigned char)(value); \
 			} while (0)
 
+/*
+ * Determine if we can use the AES-NI instructions.  They are enabled
+ * per function, so that the rest of the library is still compiled for
+ * the baseline processor, and are only called after checking CPUID.
+ */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+	(defined(__clang__) || \
+	 (defined(__GNUC__) && \
+	  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+	#define	IL_AES_NI	1
+	#define	IL_AES_NI_FUNC	__attribute__((__target__("aes,sse2")))
+	#include <cpuid.h>
+	#include <wmmintrin.h>
+#endif
+
 /*
  * S-box that is used in encryption operations.
  */
@@ -215,6 +234,60 @@ static IL_INLINE ILInt32 unmix(ILInt32 col)
 	return result;
 }
 
+#ifdef IL_AES_NI
+
+/*
+ * Determine if the processor supports the AES-NI instructions.
+ */
+static int HaveAESNI(void)
+{
+	static int haveAESNI = -1;
+	unsigned int eax, ebx, ecx, edx;
+	if(haveAESNI < 0)
+	{
+		if(__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		{
+			haveAESNI = ((ecx & bit_AES) != 0 && (edx & bit_SSE2) != 0);
+		}
+		else
+		{
+			haveAESNI = 0;
+		}
+	}
+	return haveAESNI;
+}
+
+/*
+ * Convert the key schedule into the form used by the AES-NI
+ * instructions.  The encryption round keys are the schedule in
+ * byte order, and the decryption round keys are the same keys in
+ * reverse order, with InvMixColumns applied to the inner rounds.
+ */
+IL_AES_NI_FUNC static void AESNIInit(ILAESContext *aes)
+{
+	int nr = aes->numRounds;
+	int posn;
+	__m128i key;
+
+	for(posn = 0; posn < (nr + 1) * 4; ++posn)
+	{
+		IL_BWRITE_INT32(aes->aesniEncrypt + posn * 4, aes->keySchedule[posn]);
+	}
+	for(posn = 0; posn <= nr; ++posn)
+	{
+		key = _mm_loadu_si128
+			((const __m128i *)(aes->aesniEncrypt + (nr - posn) * 16));
+		if(posn > 0 && posn < nr)
+		{
+			key = _mm_aesimc_si128(key);
+		}
+		_mm_storeu_si128((__m128i *)(aes->aesniDecrypt + posn * 16), key);
+	}
+	key = _mm_setzero_si128();
+}
+
+#endif /* IL_AES_NI */
+
 void ILAESInit(ILAESContext *aes, unsigned char *key, int keyBits)
 {
 	const unsigned char *s = sbox;
@@ -277,6 +350,17 @@ void ILAESInit(ILAESContext *aes, unsigned char *key, int keyBits)
 
 	/* Clear temporary values */
 	temp = 0;
+
+	/* Prepare the key schedules for the AES-NI instructions */
+#ifdef IL_AES_NI
+	aes->useAESNI = HaveAESNI();
+	if(aes->useAESNI)
+	{
+		AESNIInit(aes);
+	}
+#else
+	aes->useAESNI = 0;
+#endif
 }
 
 void ILAESEncrypt(ILAESContext *aes, unsigned char *input,
@@ -459,6 +543,374 @@ void ILAESDecrypt(ILAESContext *aes, unsigned char *input,
 	ncol0 = ncol1 = ncol2 = ncol3 = 0;
 }
 
+/*
+ * Increment a 128-bit big-endian counter block.
+ */
+static IL_INLINE void IncrementCounter(unsigned char *counter)
+{
+	int posn = 15;
+	while(posn >= 0 && ++(counter[posn]) == 0)
+	{
+		--posn;
+	}
+}
+
+#ifdef IL_AES_NI
+
+/*
+ * Load the round keys for an AES-NI operation.
+ */
+#define	AESNI_LOAD_KEYS(keys, schedule, nr)	\
+			do { \
+				int _posn; \
+				for(_posn = 0; _posn <= (nr); ++_posn) \
+				{ \
+					(keys)[_posn] = _mm_loadu_si128 \
+						((const __m128i *)((schedule) + _posn * 16)); \
+				} \
+			} while (0)
+
+/*
+ * Run one or four blocks through all of the AES-NI rounds.  Four
+ * blocks are interleaved so that the processor can overlap them.
+ */
+#define	AESNI_ROUNDS1(op, oplast, keys, nr, b0)	\
+			do { \
+				int _round; \
+				b0 = _mm_xor_si128(b0, (keys)[0]); \
+				for(_round = 1; _round < (nr); ++_round) \
+				{ \
+					b0 = op(b0, (keys)[_round]); \
+				} \
+				b0 = oplast(b0, (keys)[(nr)]); \
+			} while (0)
+#define	AESNI_ROUNDS4(op, oplast, keys, nr, b0, b1, b2, b3)	\
+			do { \
+				int _round; \
+				b0 = _mm_xor_si128(b0, (keys)[0]); \
+				b1 = _mm_xor_si128(b1, (keys)[0]); \
+				b2 = _mm_xor_si128(b2, (keys)[0]); \
+				b3 = _mm_xor_si128(b3, (keys)[0]); \
+				for(_round = 1; _round < (nr); ++_round) \
+				{ \
+					b0 = op(b0, (keys)[_round]); \
+					b1 = op(b1, (keys)[_round]); \
+					b2 = op(b2, (keys)[_round]); \
+					b3 = op(b3, (keys)[_round]); \
+				} \
+				b0 = oplast(b0, (keys)[(nr)]); \
+				b1 = oplast(b1, (keys)[(nr)]); \
+				b2 = oplast(b2, (keys)[(nr)]); \
+				b3 = oplast(b3, (keys)[(nr)]); \
+			} while (0)
+#define	AESNI_LOAD(buf, index)	\
+			_mm_loadu_si128((const __m128i *)((buf) + (index) * 16))
+#define	AESNI_STORE(buf, index, value)	\
+			_mm_storeu_si128((__m128i *)((buf) + (index) * 16), (value))
+
+/*
+ * Process a run of blocks in ECB mode using AES-NI.
+ */
+IL_AES_NI_FUNC static void AESNIEncryptECB
+			(ILAESContext *aes, unsigned char *input,
+			 unsigned char *output, unsigned long numBlocks)
+{
+	int nr = aes->numRounds;
+	__m128i keys[15];
+	__m128i b0, b1, b2, b3;
+	AESNI_LOAD_KEYS(keys, aes->aesniEncrypt, nr);
+	while(numBlocks >= 4)
+	{
+		b0 = AESNI_LOAD(input, 0);
+		b1 = AESNI_LOAD(input, 1);
+		b2 = AESNI_LOAD(input, 2);
+		b3 = AESNI_LOAD(input, 3);
+		AESNI_ROUNDS4(_mm_aesenc_si128, _mm_aesenclast_si128,
+					  keys, nr, b0, b1, b2, b3);
+		AESNI_STORE(output, 0, b0);
+		AESNI_STORE(output, 1, b1);
+		AESNI_STORE(output, 2, b2);
+		AESNI_STORE(output, 3, b3);
+		input += 64;
+		output += 64;
+		numBlocks -= 4;
+	}
+	while(numBlocks > 0)
+	{
+		b0 = AESNI_LOAD(input, 0);
+		AESNI_ROUNDS1(_mm_aesenc_si128, _mm_aesenclast_si128, keys, nr, b0);
+		AESNI_STORE(output, 0, b0);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+}
+IL_AES_NI_FUNC static void AESNIDecryptECB
+			(ILAESContext *aes, unsigned char *input,
+			 unsigned char *output, unsigned long numBlocks)
+{
+	int nr = aes->numRounds;
+	__m128i keys[15];
+	__m128i b0, b1, b2, b3;
+	AESNI_LOAD_KEYS(keys, aes->aesniDecrypt, nr);
+	while(numBlocks >= 4)
+	{
+		b0 = AESNI_LOAD(input, 0);
+		b1 = AESNI_LOAD(input, 1);
+		b2 = AESNI_LOAD(input, 2);
+		b3 = AESNI_LOAD(input, 3);
+		AESNI_ROUNDS4(_mm_aesdec_si128, _mm_aesdeclast_si128,
+					  keys, nr, b0, b1, b2, b3);
+		AESNI_STORE(output, 0, b0);
+		AESNI_STORE(output, 1, b1);
+		AESNI_STORE(output, 2, b2);
+		AESNI_STORE(output, 3, b3);
+		input += 64;
+		output += 64;
+		numBlocks -= 4;
+	}
+	while(numBlocks > 0)
+	{
+		b0 = AESNI_LOAD(input, 0);
+		AESNI_ROUNDS1(_mm_aesdec_si128, _mm_aesdeclast_si128, keys, nr, b0);
+		AESNI_STORE(output, 0, b0);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+}
+
+/*
+ * Process a run of blocks in CBC mode using AES-NI.  Encryption is
+ * inherently serial, but decryption can work on four blocks at once.
+ */
+IL_AES_NI_FUNC static void AESNIEncryptCBC
+			(ILAESContext *aes, unsigned char *iv, unsigned char *input,
+			 unsigned char *output, unsigned long numBlocks)
+{
+	int nr = aes->numRounds;
+	__m128i keys[15];
+	__m128i chain;
+	AESNI_LOAD_KEYS(keys, aes->aesniEncrypt, nr);
+	chain = AESNI_LOAD(iv, 0);
+	while(numBlocks > 0)
+	{
+		chain = _mm_xor_si128(chain, AESNI_LOAD(input, 0));
+		AESNI_ROUNDS1(_mm_aesenc_si128, _mm_aesenclast_si128,
+					  keys, nr, chain);
+		AESNI_STORE(output, 0, chain);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+	AESNI_STORE(iv, 0, chain);
+}
+IL_AES_NI_FUNC static void AESNIDecryptCBC
+			(ILAESContext *aes, unsigned char *iv, unsigned char *input,
+			 unsigned char *output, unsigned long numBlocks)
+{
+	int nr = aes->numRounds;
+	__m128i keys[15];
+	__m128i chain, c0, c1, c2, c3, b0, b1, b2, b3;
+	AESNI_LOAD_KEYS(keys, aes->aesniDecrypt, nr);
+	chain = AESNI_LOAD(iv, 0);
+	while(numBlocks >= 4)
+	{
+		/* Load all of the ciphertext first, in case "input == output" */
+		b0 = c0 = AESNI_LOAD(input, 0);
+		b1 = c1 = AESNI_LOAD(input, 1);
+		b2 = c2 = AESNI_LOAD(input, 2);
+		b3 = c3 = AESNI_LOAD(input, 3);
+		AESNI_ROUNDS4(_mm_aesdec_si128, _mm_aesdeclast_si128,
+					  keys, nr, b0, b1, b2, b3);
+		AESNI_STORE(output, 0, _mm_xor_si128(b0, chain));
+		AESNI_STORE(output, 1, _mm_xor_si128(b1, c0));
+		AESNI_STORE(output, 2, _mm_xor_si128(b2, c1));
+		AESNI_STORE(output, 3, _mm_xor_si128(b3, c2));
+		chain = c3;
+		input += 64;
+		output += 64;
+		numBlocks -= 4;
+	}
+	while(numBlocks > 0)
+	{
+		b0 = c0 = AESNI_LOAD(input, 0);
+		AESNI_ROUNDS1(_mm_aesdec_si128, _mm_aesdeclast_si128, keys, nr, b0);
+		AESNI_STORE(output, 0, _mm_xor_si128(b0, chain));
+		chain = c0;
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+	AESNI_STORE(iv, 0, chain);
+}
+
+/*
+ * Process a run of blocks in CTR mode using AES-NI.
+ */
+IL_AES_NI_FUNC static void AESNICryptCTR
+			(ILAESContext *aes, unsigned char *counter, unsigned char *input,
+			 unsigned char *output, unsigned long numBlocks)
+{
+	int nr = aes->numRounds;
+	__m128i keys[15];
+	__m128i b0, b1, b2, b3;
+	AESNI_LOAD_KEYS(keys, aes->aesniEncrypt, nr);
+	while(numBlocks >= 4)
+	{
+		b0 = AESNI_LOAD(counter, 0);
+		IncrementCounter(counter);
+		b1 = AESNI_LOAD(counter, 0);
+		IncrementCounter(counter);
+		b2 = AESNI_LOAD(counter, 0);
+		IncrementCounter(counter);
+		b3 = AESNI_LOAD(counter, 0);
+		IncrementCounter(counter);
+		AESNI_ROUNDS4(_mm_aesenc_si128, _mm_aesenclast_si128,
+					  keys, nr, b0, b1, b2, b3);
+		AESNI_STORE(output, 0, _mm_xor_si128(b0, AESNI_LOAD(input, 0)));
+		AESNI_STORE(output, 1, _mm_xor_si128(b1, AESNI_LOAD(input, 1)));
+		AESNI_STORE(output, 2, _mm_xor_si128(b2, AESNI_LOAD(input, 2)));
+		AESNI_STORE(output, 3, _mm_xor_si128(b3, AESNI_LOAD(input, 3)));
+		input += 64;
+		output += 64;
+		numBlocks -= 4;
+	}
+	while(numBlocks > 0)
+	{
+		b0 = AESNI_LOAD(counter, 0);
+		IncrementCounter(counter);
+		AESNI_ROUNDS1(_mm_aesenc_si128, _mm_aesenclast_si128, keys, nr, b0);
+		AESNI_STORE(output, 0, _mm_xor_si128(b0, AESNI_LOAD(input, 0)));
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+}
+
+#endif /* IL_AES_NI */
+
+void ILAESEncryptECB(ILAESContext *aes, unsigned char *input,
+					 unsigned char *output, unsigned long numBlocks)
+{
+#ifdef IL_AES_NI
+	if(aes->useAESNI)
+	{
+		AESNIEncryptECB(aes, input, output, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		ILAESEncrypt(aes, input, output);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+}
+
+void ILAESDecryptECB(ILAESContext *aes, unsigned char *input,
+					 unsigned char *output, unsigned long numBlocks)
+{
+#ifdef IL_AES_NI
+	if(aes->useAESNI)
+	{
+		AESNIDecryptECB(aes, input, output, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		ILAESDecrypt(aes, input, output);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+}
+
+void ILAESEncryptCBC(ILAESContext *aes, unsigned char *iv,
+					 unsigned char *input, unsigned char *output,
+					 unsigned long numBlocks)
+{
+	int posn;
+#ifdef IL_AES_NI
+	if(aes->useAESNI)
+	{
+		AESNIEncryptCBC(aes, iv, input, output, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		for(posn = 0; posn < 16; ++posn)
+		{
+			iv[posn] ^= input[posn];
+		}
+		ILAESEncrypt(aes, iv, iv);
+		ILMemCpy(output, iv, 16);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+}
+
+void ILAESDecryptCBC(ILAESContext *aes, unsigned char *iv,
+					 unsigned char *input, unsigned char *output,
+					 unsigned long numBlocks)
+{
+	unsigned char temp[16];
+	int posn;
+#ifdef IL_AES_NI
+	if(aes->useAESNI)
+	{
+		AESNIDecryptCBC(aes, iv, input, output, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		ILMemCpy(temp, input, 16);
+		ILAESDecrypt(aes, input, output);
+		for(posn = 0; posn < 16; ++posn)
+		{
+			output[posn] ^= iv[posn];
+		}
+		ILMemCpy(iv, temp, 16);
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+	ILMemZero(temp, sizeof(temp));
+}
+
+void ILAESCryptCTR(ILAESContext *aes, unsigned char *counter,
+				   unsigned char *input, unsigned char *output,
+				   unsigned long numBlocks)
+{
+	unsigned char stream[16];
+	int posn;
+#ifdef IL_AES_NI
+	if(aes->useAESNI)
+	{
+		AESNICryptCTR(aes, counter, input, output, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		ILAESEncrypt(aes, counter, stream);
+		IncrementCounter(counter);
+		for(posn = 0; posn < 16; ++posn)
+		{
+			output[posn] = (unsigned char)(input[posn] ^ stream[posn]);
+		}
+		input += 16;
+		output += 16;
+		--numBlocks;
+	}
+	ILMemZero(stream, sizeof(stream));
+}
+
 void ILAESFinalize(ILAESContext *aes)
 {
 	ILMemZero(aes, sizeof(ILAESContext));
@@ -573,12 +1025,94 @@ static void ProcessVector(AESTestVector *vector)
 	printf("\n");
 }
 
+/*
+ * Check the bulk modes against the single block functions.
+ */
+static void ProcessBulk(AESTestVector *vector)
+{
+	ILAESContext aes;
+	unsigned char plaintext[16 * 7];
+	unsigned char expected[16 * 7];
+	unsigned char actual[16 * 7];
+	unsigned char iv[16];
+	unsigned char iv2[16];
+	int block, posn;
+
+	/* Build a plaintext that is not a multiple of the interleave factor */
+	for(posn = 0; posn < (int)sizeof(plaintext); ++posn)
+	{
+		plaintext[posn] = (unsigned char)(posn * 7 + 3);
+	}
+	ILAESInit(&aes, vector->key, vector->keyBits);
+	printf("Bulk modes (%d-bit key, %s): ", vector->keyBits,
+		   (aes.useAESNI ? "AES-NI" : "portable"));
+
+	/* ECB */
+	for(block = 0; block < 7; ++block)
+	{
+		ILAESEncrypt(&aes, plaintext + block * 16, expected + block * 16);
+	}
+	ILAESEncryptECB(&aes, plaintext, actual, 7);
+	if(ILMemCmp(expected, actual, sizeof(actual)) != 0)
+	{
+		printf("*** ECB encryption failed *** ");
+	}
+	ILAESDecryptECB(&aes, actual, actual, 7);
+	if(ILMemCmp(plaintext, actual, sizeof(actual)) != 0)
+	{
+		printf("*** ECB decryption failed *** ");
+	}
+
+	/* CBC */
+	ILMemCpy(iv, vector->plaintext, 16);
+	for(block = 0; block < 7; ++block)
+	{
+		for(posn = 0; posn < 16; ++posn)
+		{
+			iv[posn] ^= plaintext[block * 16 + posn];
+		}
+		ILAESEncrypt(&aes, iv, iv);
+		ILMemCpy(expected + block * 16, iv, 16);
+	}
+	ILMemCpy(iv2, vector->plaintext, 16);
+	ILAESEncryptCBC(&aes, iv2, plaintext, actual, 7);
+	if(ILMemCmp(expected, actual, sizeof(actual)) != 0 ||
+	   ILMemCmp(iv, iv2, 16) != 0)
+	{
+		printf("*** CBC encryption failed *** ");
+	}
+	ILMemCpy(iv2, vector->plaintext, 16);
+	ILAESDecryptCBC(&aes, iv2, actual, actual, 7);
+	if(ILMemCmp(plaintext, actual, sizeof(actual)) != 0 ||
+	   ILMemCmp(iv, iv2, 16) != 0)
+	{
+		printf("*** CBC decryption failed *** ");
+	}
+
+	/* CTR, with a counter that carries across several bytes */
+	ILMemSet(iv, 0xFF, 16);
+	iv[0] = 0x01;
+	ILMemCpy(iv2, iv, 16);
+	ILAESCryptCTR(&aes, iv2, plaintext, actual, 7);
+	ILAESCryptCTR(&aes, iv, actual, actual, 7);
+	if(ILMemCmp(plaintext, actual, sizeof(actual)) != 0 ||
+	   ILMemCmp(iv, iv2, 16) != 0 || iv[0] != 0x02 || iv[15] != 0x06)
+	{
+		printf("*** CTR mode failed *** ");
+	}
+	ILAESFinalize(&aes);
+	printf("done\n");
+}
+
 int main(int argc, char *argv[])
 {
 	printf("\n");
 	ProcessVector(&vector1);
 	ProcessVector(&vector2);
 	ProcessVector(&vector3);
+	ProcessBulk(&vector1);
+	ProcessBulk(&vector2);
+	ProcessBulk(&vector3);
 	return 0;
 }
 
@@ -22,6 +22,12 @@
  * Note: this implementation is designed for clarity and ease
  * of debugging, not speed.  If you really want speed, then
  * replace this entire file with assembly code.
+ *
+ * The exceptions are the paths that RSA and DSA spend their time
+ * in: large multiplications use Karatsuba's method, and modular
+ * exponentiation with an odd modulus uses Montgomery multiplication
+ * and a sliding window, on 64-bit limbs if the compiler has a
+ * 128-bit integer type to hold their products.
  */
 
 #include "il_bignum.h"
@@ -907,13 +913,221 @@ static int DivRem(ILBigNum *numx, ILBigNum *numy,
 	return 1;
 }
 
+/*
+ * Operands of at least this many words are multiplied using
+ * Karatsuba's method.  Below this, the schoolbook method wins.
+ */
+#define	IL_KARATSUBA_THRESHOLD		32
+
+/*
+ * Multiply two word arrays using the schoolbook method.  The
+ * result must have room for "xsize + ysize" words.
+ */
+static void SchoolbookMul(ILUInt32 *result, const ILUInt32 *x, ILInt32 xsize,
+						  const ILUInt32 *y, ILInt32 ysize)
+{
+	ILInt32 xposn, yposn, posn;
+	ILUInt64 temp;
+
+	ILMemZero(result, (xsize + ysize) * sizeof(ILUInt32));
+	for(xposn = 0; xposn < xsize; ++xposn)
+	{
+		temp = 0;
+		posn = xposn;
+		for(yposn = 0; yposn < ysize; ++yposn)
+		{
+			temp += ((ILUInt64)(x[xposn])) * ((ILUInt64)(y[yposn])) +
+					((ILUInt64)(result[posn]));
+			result[posn] = (ILUInt32)temp;
+			temp >>= 32;
+			++posn;
+		}
+		result[posn] = (ILUInt32)temp;
+	}
+}
+
+/*
+ * Add "ysize" words from "y" into the "xsize" words of "x".  The
+ * caller guarantees that the sum will fit in "xsize" words.
+ */
+static void AddWords(ILUInt32 *x, ILInt32 xsize,
+					 const ILUInt32 *y, ILInt32 ysize)
+{
+	ILUInt64 temp = 0;
+	ILInt32 posn;
+	for(posn = 0; posn < ysize; ++posn)
+	{
+		temp += ((ILUInt64)(x[posn])) + ((ILUInt64)(y[posn]));
+		x[posn] = (ILUInt32)temp;
+		temp >>= 32;
+	}
+	while(temp != 0 && posn < xsize)
+	{
+		temp += (ILUInt64)(x[posn]);
+		x[posn] = (ILUInt32)temp;
+		temp >>= 32;
+		++posn;
+	}
+}
+
+/*
+ * Subtract "ysize" words in "y" from the "xsize" words of "x".  The
+ * caller guarantees that the difference will not be negative.
+ */
+static void SubWords(ILUInt32 *x, ILInt32 xsize,
+					 const ILUInt32 *y, ILInt32 ysize)
+{
+	ILUInt32 borrow = 0;
+	ILUInt32 word;
+	ILInt32 posn;
+	for(posn = 0; posn < ysize; ++posn)
+	{
+		word = x[posn];
+		x[posn] = word - y[posn] - borrow;
+		borrow = (word < y[posn] || (word == y[posn] && borrow));
+	}
+	while(borrow && posn < xsize)
+	{
+		borrow = (x[posn] == 0);
+		--(x[posn]);
+		++posn;
+	}
+}
+
+/*
+ * Get the number of scratch words needed by "KaratsubaMul".
+ */
+static ILInt32 KaratsubaScratch(ILInt32 size)
+{
+	ILInt32 scratch = 0;
+	ILInt32 high;
+	while(size >= IL_KARATSUBA_THRESHOLD)
+	{
+		high = size - size / 2;
+		scratch += 4 * (high + 1);
+		size = high + 1;
+	}
+	return scratch;
+}
+
+/*
+ * Multiply two word arrays of the same size using Karatsuba's method:
+ *
+ *		x * y = z2 * B^2h + (z1 - z2 - z0) * B^h + z0
+ *
+ * where x = x1 * B^h + x0, y = y1 * B^h + y0, z0 = x0 * y0,
+ * z2 = x1 * y1, and z1 = (x0 + x1) * (y0 + y1).  The result must
+ * have room for "2 * size" words.
+ */
+static void KaratsubaMul(ILUInt32 *result, const ILUInt32 *x,
+						 const ILUInt32 *y, ILInt32 size, ILUInt32 *scratch)
+{
+	ILInt32 low, high;
+	ILUInt32 *sumx, *sumy, *mid;
+
+	/* Use the schoolbook method for small operands */
+	if(size < IL_KARATSUBA_THRESHOLD)
+	{
+		SchoolbookMul(result, x, size, y, size);
+		return;
+	}
+
+	/* Split the operands: the high halves may be one word longer */
+	low = size / 2;
+	high = size - low;
+	sumx = scratch;
+	sumy = sumx + (high + 1);
+	mid = sumy + (high + 1);
+	scratch = mid + 2 * (high + 1);
+
+	/* Compute "z0" and "z2" directly into the result */
+	KaratsubaMul(result, x, y, low, scratch);
+	KaratsubaMul(result + 2 * low, x + low, y + low, high, scratch);
+
+	/* Compute the sums of the halves, which may carry into an extra word */
+	ILMemCpy(sumx, x + low, high * sizeof(ILUInt32));
+	sumx[high] = 0;
+	AddWords(sumx, high + 1, x, low);
+	ILMemCpy(sumy, y + low, high * sizeof(ILUInt32));
+	sumy[high] = 0;
+	AddWords(sumy, high + 1, y, low);
+
+	/* Compute "z1 - z2 - z0", which is "x0 * y1 + x1 * y0" */
+	KaratsubaMul(mid, sumx, sumy, high + 1, scratch);
+	SubWords(mid, 2 * (high + 1), result, 2 * low);
+	SubWords(mid, 2 * (high + 1), result + 2 * low, 2 * high);
+
+	/* Add the middle term into the result */
+	AddWords(result + low, low + 2 * high, mid, 2 * (high + 1));
+}
+
+/*
+ * Multiply two large word arrays using Karatsuba's method.  If the
+ * operands differ in size, then the longer one is split into pieces
+ * the size of the shorter one.  Returns zero if out of memory.
+ */
+static int LargeMul(ILUInt32 *result, const ILUInt32 *x, ILInt32 xsize,
+					const ILUInt32 *y, ILInt32 ysize)
+{
+	const ILUInt32 *tempWords;
+	ILInt32 tempSize, posn, count, total;
+	ILUInt32 *buffer;
+	ILUInt32 *piece;
+	ILUInt32 *partial;
+
+	/* Make "y" the shorter of the two operands */
+	if(xsize < ysize)
+	{
+		tempWords = x;
+		x = y;
+		y = tempWords;
+		tempSize = xsize;
+		xsize = ysize;
+		ysize = tempSize;
+	}
+
+	/* Allocate space for a piece of "x", its product, and the scratch */
+	tempSize = 3 * ysize + KaratsubaScratch(ysize);
+	buffer = (ILUInt32 *)ILMalloc(tempSize * sizeof(ILUInt32));
+	if(!buffer)
+	{
+		return 0;
+	}
+	piece = buffer;
+	partial = piece + ysize;
+
+	/* Multiply "y" by each piece of "x" and add the partial products */
+	total = xsize + ysize;
+	ILMemZero(result, total * sizeof(ILUInt32));
+	for(posn = 0; posn < xsize; posn += ysize)
+	{
+		count = xsize - posn;
+		if(count > ysize)
+		{
+			count = ysize;
+		}
+		ILMemCpy(piece, x + posn, count * sizeof(ILUInt32));
+		ILMemZero(piece + count, (ysize - count) * sizeof(ILUInt32));
+		KaratsubaMul(partial, piece, y, ysize, partial + 2 * ysize);
+		count = total - posn;
+		if(count > 2 * ysize)
+		{
+			count = 2 * ysize;
+		}
+		AddWords(result + posn, total - posn, partial, count);
+	}
+
+	/* Clear and free the temporary values */
+	ILMemZero(buffer, tempSize * sizeof(ILUInt32));
+	ILFree(buffer);
+	return 1;
+}
+
 ILBigNum *ILBigNumMul(ILBigNum *numx, ILBigNum *numy, ILBigNum *modulus)
 {
 	ILBigNum *product;
 	ILBigNum *modProduct;
 	ILInt32 size;
-	ILInt32 xposn, yposn, posn;
-	ILUInt64 temp;
 
 	/* Allocate space for the intermediate product */
 	size = numx->size + numy->size;
@@ -930,31 +1144,23 @@ ILBigNum *ILBigNumMul(ILBigNum *numx, ILBigNum *numy, ILBigNum *modulus)
 	}
 	product->size = size;
 	product->neg = (numx->neg ^ numy->neg);
-	ILMemZero(product->words, size * sizeof(ILUInt32));
 
 	/* Calculate the intermediate product */
-	for(xposn = 0; xposn < numx->size; ++xposn)
+	if(numx->size >= IL_KARATSUBA_THRESHOLD &&
+	   numy->size >= IL_KARATSUBA_THRESHOLD)
 	{
-		temp = 0;
-		posn = xposn;
-		for(yposn = 0; yposn < numy->size; ++yposn)
-		{
-			temp += ((ILUInt64)(numx->words[xposn])) *
-			        ((ILUInt64)(numy->words[yposn])) +
-					((ILUInt64)(product->words[posn]));
-			product->words[posn] = (ILUInt32)temp;
-			temp >>= 32;
-			++posn;
-		}
-		while(temp != 0)
+		if(!LargeMul(product->words, numx->words, numx->size,
+					 numy->words, numy->size))
 		{
-			/* Propagate the carry */
-			temp += product->words[posn];
-			product->words[posn] = (ILUInt32)temp;
-			temp >>= 32;
-			++posn;
+			ILFree(product);
+			return 0;
 		}
 	}
+	else
+	{
+		SchoolbookMul(product->words, numx->words, numx->size,
+					  numy->words, numy->size);
+	}
 
 	/* Normalize the intermediate product */
 	NormalizeBigNum(product);
@@ -1105,6 +1311,325 @@ cleanup:
 	return 0;
 }
 
+/*
+ * Limb types for Montgomery multiplication.  The double limb type
+ * must be able to hold the product of two limbs.
+ */
+#if defined(__SIZEOF_INT128__)
+typedef ILUInt64 MontLimb;
+__extension__ typedef unsigned __int128 MontDLimb;
+#define	IL_MONT_WORDS_PER_LIMB		2
+#else
+typedef ILUInt32 MontLimb;
+typedef ILUInt64 MontDLimb;
+#define	IL_MONT_WORDS_PER_LIMB		1
+#endif
+#define	IL_MONT_LIMB_BITS			(32 * IL_MONT_WORDS_PER_LIMB)
+
+/*
+ * Maximum window size for sliding window exponentiation.
+ */
+#define	IL_MONT_MAX_WINDOW			6
+
+/*
+ * Convert a big number into an array of limbs.
+ */
+static void BigNumToLimbs(MontLimb *limbs, ILInt32 numLimbs, ILBigNum *num)
+{
+	ILInt32 posn;
+	ILMemZero(limbs, numLimbs * sizeof(MontLimb));
+	for(posn = 0; posn < num->size; ++posn)
+	{
+		limbs[posn / IL_MONT_WORDS_PER_LIMB] |=
+			((MontLimb)(num->words[posn])) <<
+				(32 * (posn % IL_MONT_WORDS_PER_LIMB));
+	}
+}
+
+/*
+ * Convert an array of limbs into a big number.
+ */
+static ILBigNum *LimbsToBigNum(MontLimb *limbs, ILInt32 numLimbs)
+{
+	ILBigNum *num;
+	ILInt32 size, posn;
+	size = numLimbs * IL_MONT_WORDS_PER_LIMB;
+	num = (ILBigNum *)ILMalloc(sizeof(ILBigNum) +
+							   (size - 1) * sizeof(ILUInt32));
+	if(num)
+	{
+		num->size = size;
+		num->neg = 0;
+		for(posn = 0; posn < size; ++posn)
+		{
+			num->words[posn] = (ILUInt32)
+				(limbs[posn / IL_MONT_WORDS_PER_LIMB] >>
+					(32 * (posn % IL_MONT_WORDS_PER_LIMB)));
+		}
+		NormalizeBigNum(num);
+	}
+	return num;
+}
+
+/*
+ * Compute "-(m0 ^ -1) mod B" for an odd limb "m0", using Newton's
+ * method.  "m0" is its own inverse to 3 bits, and each step doubles
+ * the number of correct bits.
+ */
+static MontLimb MontInverse(MontLimb m0)
+{
+	MontLimb inv = m0;
+	int bits;
+	for(bits = 3; bits < IL_MONT_LIMB_BITS; bits *= 2)
+	{
+		inv *= (MontLimb)2 - m0 * inv;
+	}
+	return (MontLimb)0 - inv;
+}
+
+/*
+ * Compute "result = x * y / R mod m", where "R = B ^ n", using
+ * the "Coarsely Integrated Operand Scanning" method.  The "t"
+ * array must have room for "n + 2" limbs.  The result may be
+ * the same as "x" or "y".
+ */
+static void MontMul(MontLimb *result, const MontLimb *x, const MontLimb *y,
+					const MontLimb *m, MontLimb minv, ILInt32 n, MontLimb *t)
+{
+	MontDLimb temp;
+	MontLimb carry, q, word;
+	ILInt32 i, j;
+
+	ILMemZero(t, (n + 2) * sizeof(MontLimb));
+	for(i = 0; i < n; ++i)
+	{
+		/* t += x * y[i] */
+		carry = 0;
+		for(j = 0; j < n; ++j)
+		{
+			temp = ((MontDLimb)(x[j])) * ((MontDLimb)(y[i])) +
+				   ((MontDLimb)(t[j])) + ((MontDLimb)carry);
+			t[j] = (MontLimb)temp;
+			carry = (MontLimb)(temp >> IL_MONT_LIMB_BITS);
+		}
+		temp = ((MontDLimb)(t[n])) + ((MontDLimb)carry);
+		t[n] = (MontLimb)temp;
+		t[n + 1] = (MontLimb)(temp >> IL_MONT_LIMB_BITS);
+
+		/* t = (t + q * m) / B, where q is chosen to clear the low limb */
+		q = t[0] * minv;
+		temp = ((MontDLimb)q) * ((MontDLimb)(m[0])) + ((MontDLimb)(t[0]));
+		carry = (MontLimb)(temp >> IL_MONT_LIMB_BITS);
+		for(j = 1; j < n; ++j)
+		{
+			temp = ((MontDLimb)q) * ((MontDLimb)(m[j])) +
+				   ((MontDLimb)(t[j])) + ((MontDLimb)carry);
+			t[j - 1] = (MontLimb)temp;
+			carry = (MontLimb)(temp >> IL_MONT_LIMB_BITS);
+		}
+		temp = ((MontDLimb)(t[n])) + ((MontDLimb)carry);
+		t[n - 1] = (MontLimb)temp;
+		t[n] = t[n + 1] + (MontLimb)(temp >> IL_MONT_LIMB_BITS);
+	}
+
+	/* The value in "t" is less than "2 * m": subtract "m" if necessary */
+	if(!(t[n]))
+	{
+		for(j = n - 1; j >= 0 && t[j] == m[j]; --j)
+		{
+			/* Nothing to do here: just find the first difference */
+		}
+		if(j >= 0 && t[j] < m[j])
+		{
+			ILMemCpy(result, t, n * sizeof(MontLimb));
+			return;
+		}
+	}
+	carry = 0;
+	for(j = 0; j < n; ++j)
+	{
+		word = t[j];
+		result[j] = word - m[j] - carry;
+		carry = (word < m[j] || (word == m[j] && carry));
+	}
+}
+
+/*
+ * Get a bit from the absolute value of a big number.
+ */
+#define	BigNumBit(num,bit)	\
+			(((num)->words[(bit) / 32] >> ((bit) % 32)) & 1)
+
+/*
+ * Raise a big number to the power of the absolute value of an
+ * exponent, modulo an odd modulus, using Montgomery multiplication
+ * and the sliding window method.  Returns NULL if out of memory.
+ */
+static ILBigNum *MontgomeryPow(ILBigNum *numx, ILBigNum *numy,
+							   ILBigNum *modulus)
+{
+	ILInt32 n, size, numBits, bit, low, posn;
+	ILBigNum *reduced;
+	ILBigNum *rsquared;
+	ILBigNum *result;
+	MontLimb *buffer;
+	MontLimb *m, *r2, *acc, *t, *table;
+	MontLimb minv;
+	ILUInt32 top, value;
+	int window, started;
+
+	/* Determine the number of limbs and the window size */
+	n = (modulus->size + IL_MONT_WORDS_PER_LIMB - 1) / IL_MONT_WORDS_PER_LIMB;
+	numBits = (numy->size - 1) * 32;
+	for(top = numy->words[numy->size - 1]; top != 0; top >>= 1)
+	{
+		++numBits;
+	}
+	if(numBits <= 24)
+	{
+		window = 1;
+	}
+	else if(numBits <= 80)
+	{
+		window = 3;
+	}
+	else if(numBits <= 240)
+	{
+		window = 4;
+	}
+	else if(numBits <= 672)
+	{
+		window = 5;
+	}
+	else
+	{
+		window = IL_MONT_MAX_WINDOW;
+	}
+
+	/* Allocate space for the modulus, R^2, the accumulator, the
+	   multiplication temporary, and the table of odd powers */
+	size = (3 + (1 << (window - 1))) * n + n + 2;
+	buffer = (MontLimb *)ILMalloc(size * sizeof(MontLimb));
+	if(!buffer)
+	{
+		return 0;
+	}
+	m = buffer;
+	r2 = m + n;
+	acc = r2 + n;
+	t = acc + n;
+	table = t + n + 2;
+
+	/* Compute "R^2 mod m" the slow way, once */
+	posn = 2 * n * IL_MONT_WORDS_PER_LIMB;
+	rsquared = (ILBigNum *)ILMalloc(sizeof(ILBigNum) +
+									posn * sizeof(ILUInt32));
+	if(!rsquared)
+	{
+		ILFree(buffer);
+		return 0;
+	}
+	rsquared->size = posn + 1;
+	rsquared->neg = 0;
+	ILMemZero(rsquared->words, posn * sizeof(ILUInt32));
+	rsquared->words[posn] = 1;
+	reduced = ILBigNumMod(rsquared, modulus);
+	ILBigNumFree(rsquared);
+	if(!reduced)
+	{
+		ILFree(buffer);
+		return 0;
+	}
+	BigNumToLimbs(r2, n, reduced);
+	ILBigNumFree(reduced);
+
+	/* Reduce the base if it is not already in range */
+	if(ILBigNumCompareAbs(numx, modulus) >= 0)
+	{
+		reduced = ILBigNumMod(numx, modulus);
+		if(!reduced)
+		{
+			ILMemZero(buffer, size * sizeof(MontLimb));
+			ILFree(buffer);
+			return 0;
+		}
+		BigNumToLimbs(acc, n, reduced);
+		ILBigNumFree(reduced);
+	}
+	else
+	{
+		BigNumToLimbs(acc, n, numx);
+	}
+
+	/* Convert the base into Montgomery form, and build the table
+	   of its odd powers: x, x^3, x^5, ... */
+	BigNumToLimbs(m, n, modulus);
+	minv = MontInverse(m[0]);
+	MontMul(table, acc, r2, m, minv, n, t);
+	if(window > 1)
+	{
+		MontMul(acc, table, table, m, minv, n, t);
+		for(posn = 1; posn < (1 << (window - 1)); ++posn)
+		{
+			MontMul(table + posn * n, table + (posn - 1) * n, acc,
+					m, minv, n, t);
+		}
+	}
+
+	/* Scan the exponent from the top, one window at a time.  The top
+	   bit is always set, so the first window initializes "acc" */
+	started = 0;
+	bit = numBits - 1;
+	while(bit >= 0)
+	{
+		if(!BigNumBit(numy, bit))
+		{
+			MontMul(acc, acc, acc, m, minv, n, t);
+			--bit;
+			continue;
+		}
+		low = bit - window + 1;
+		if(low < 0)
+		{
+			low = 0;
+		}
+		while(!BigNumBit(numy, low))
+		{
+			++low;
+		}
+		value = 0;
+		for(posn = bit; posn >= low; --posn)
+		{
+			value = (value << 1) | BigNumBit(numy, posn);
+			if(started)
+			{
+				MontMul(acc, acc, acc, m, minv, n, t);
+			}
+		}
+		if(started)
+		{
+			MontMul(acc, acc, table + (value / 2) * n, m, minv, n, t);
+		}
+		else
+		{
+			ILMemCpy(acc, table + (value / 2) * n, n * sizeof(MontLimb));
+			started = 1;
+		}
+		bit = low - 1;
+	}
+
+	/* Convert the result out of Montgomery form by multiplying by 1 */
+	ILMemZero(r2, n * sizeof(MontLimb));
+	r2[0] = 1;
+	MontMul(acc, acc, r2, m, minv, n, t);
+	result = LimbsToBigNum(acc, n);
+
+	/* Clear and free the temporary values */
+	ILMemZero(buffer, size * sizeof(MontLimb));
+	ILFree(buffer);
+	return result;
+}
+
 ILBigNum *ILBigNumPow(ILBigNum *numx, ILBigNum *numy, ILBigNum *modulus)
 {
 	ILBigNum *power;
@@ -1113,7 +1638,22 @@ ILBigNum *ILBigNumPow(ILBigNum *numx, ILBigNum *numy, ILBigNum *modulus)
 	ILInt32 posn;
 	ILUInt32 mask;
 	int bit;
-	
+
+	/* Use Montgomery multiplication if the modulus is odd, which
+	   it always is for RSA and DSA */
+	if(modulus != 0 && modulus->size > 0 && !(modulus->neg) &&
+	   (modulus->words[0] & 1) != 0 && numy->size > 0 && !(numx->neg))
+	{
+		result = MontgomeryPow(numx, numy, modulus);
+		if(result && numy->neg)
+		{
+			temp = ILBigNumInv(result, modulus);
+			ILBigNumFree(result);
+			result = temp;
+		}
+		return result;
+	}
+
 	/* Set the initial power value to "numx" */
 	power = ILBigNumCopy(numx);
 	if(!power)
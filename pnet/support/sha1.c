@@ -57,6 +57,21 @@ extern	"C" {
 #define	KROUND3			0x8F1BBCDC
 #define	KROUND4			0xCA62C1D6
 
+/*
+ * Determine if we can use the SHA-NI instructions.  They are enabled
+ * per function, so that the rest of the library is still compiled for
+ * the baseline processor, and are only called after checking CPUID.
+ */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+	(defined(__clang__) || \
+	 (defined(__GNUC__) && \
+	  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+	#define	IL_SHA_NI	1
+	#define	IL_SHA_NI_FUNC	__attribute__((__target__("sha,sse4.1,ssse3")))
+	#include <cpuid.h>
+	#include <immintrin.h>
+#endif
+
 void ILSHAInit(ILSHAContext *sha)
 {
 	sha->inputLen = 0;
@@ -159,6 +174,159 @@ static void ProcessBlock(ILSHAContext *sha, const unsigned char *block)
 	a = b = c = d = e = temp = 0;
 }
 
+#ifdef IL_SHA_NI
+
+/*
+ * Determine if the processor supports the SHA-NI instructions.
+ */
+static int HaveSHANI(void)
+{
+	static int haveSHANI = -1;
+	unsigned int eax, ebx, ecx, edx;
+	if(haveSHANI < 0)
+	{
+		haveSHANI = 0;
+		if(__get_cpuid_max(0, 0) >= 7 &&
+		   __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+		   (ecx & bit_SSSE3) != 0 && (ecx & bit_SSE4_1) != 0)
+		{
+			__cpuid_count(7, 0, eax, ebx, ecx, edx);
+			haveSHANI = ((ebx & (1 << 29)) != 0);
+		}
+	}
+	return haveSHANI;
+}
+
+/*
+ * Perform four rounds of SHA-1 with the SHA-NI instructions.  "g" is
+ * the round group (0-19), "cur" holds the message words for the group,
+ * and "prev", "opp", and "next" hold the words for the groups before,
+ * two away from, and after it, which are scheduled as we go.  "e" is
+ * the E value for the group and "enext" receives it for the next one.
+ */
+#define	SHANI_ROUNDS(g, cur, next, opp, prev, e, enext)	\
+			do { \
+				if((g) == 0) \
+				{ \
+					e = _mm_add_epi32(e, cur); \
+				} \
+				else \
+				{ \
+					e = _mm_sha1nexte_epu32(e, cur); \
+				} \
+				enext = abcd; \
+				if((g) >= 3 && (g) <= 18) \
+				{ \
+					next = _mm_sha1msg2_epu32(next, cur); \
+				} \
+				abcd = _mm_sha1rnds4_epu32(abcd, e, (g) / 5); \
+				if((g) >= 1 && (g) <= 16) \
+				{ \
+					prev = _mm_sha1msg1_epu32(prev, cur); \
+				} \
+				if((g) >= 2 && (g) <= 17) \
+				{ \
+					opp = _mm_xor_si128(opp, cur); \
+				} \
+			} while (0)
+
+/*
+ * Process a run of blocks with the SHA-NI instructions.
+ */
+IL_SHA_NI_FUNC static void SHANIProcessBlocks(ILSHAContext *sha,
+											  const unsigned char *block,
+											  unsigned long numBlocks)
+{
+	__m128i abcd, abcdSave, e0, e0Save, e1;
+	__m128i msg0, msg1, msg2, msg3, mask;
+	ILUInt32 state[4];
+
+	/* Load the SHA state, with A in the highest word */
+	abcd = _mm_set_epi32((int)(sha->A), (int)(sha->B),
+						 (int)(sha->C), (int)(sha->D));
+	e0 = _mm_set_epi32((int)(sha->E), 0, 0, 0);
+	mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+
+	while(numBlocks > 0)
+	{
+		abcdSave = abcd;
+		e0Save = e0;
+
+		/* Load the message words, most significant word first */
+		msg0 = _mm_shuffle_epi8
+			(_mm_loadu_si128((const __m128i *)block), mask);
+		msg1 = _mm_shuffle_epi8
+			(_mm_loadu_si128((const __m128i *)(block + 16)), mask);
+		msg2 = _mm_shuffle_epi8
+			(_mm_loadu_si128((const __m128i *)(block + 32)), mask);
+		msg3 = _mm_shuffle_epi8
+			(_mm_loadu_si128((const __m128i *)(block + 48)), mask);
+
+		/* Perform the 80 rounds */
+		SHANI_ROUNDS(0,  msg0, msg1, msg2, msg3, e0, e1);
+		SHANI_ROUNDS(1,  msg1, msg2, msg3, msg0, e1, e0);
+		SHANI_ROUNDS(2,  msg2, msg3, msg0, msg1, e0, e1);
+		SHANI_ROUNDS(3,  msg3, msg0, msg1, msg2, e1, e0);
+		SHANI_ROUNDS(4,  msg0, msg1, msg2, msg3, e0, e1);
+		SHANI_ROUNDS(5,  msg1, msg2, msg3, msg0, e1, e0);
+		SHANI_ROUNDS(6,  msg2, msg3, msg0, msg1, e0, e1);
+		SHANI_ROUNDS(7,  msg3, msg0, msg1, msg2, e1, e0);
+		SHANI_ROUNDS(8,  msg0, msg1, msg2, msg3, e0, e1);
+		SHANI_ROUNDS(9,  msg1, msg2, msg3, msg0, e1, e0);
+		SHANI_ROUNDS(10, msg2, msg3, msg0, msg1, e0, e1);
+		SHANI_ROUNDS(11, msg3, msg0, msg1, msg2, e1, e0);
+		SHANI_ROUNDS(12, msg0, msg1, msg2, msg3, e0, e1);
+		SHANI_ROUNDS(13, msg1, msg2, msg3, msg0, e1, e0);
+		SHANI_ROUNDS(14, msg2, msg3, msg0, msg1, e0, e1);
+		SHANI_ROUNDS(15, msg3, msg0, msg1, msg2, e1, e0);
+		SHANI_ROUNDS(16, msg0, msg1, msg2, msg3, e0, e1);
+		SHANI_ROUNDS(17, msg1, msg2, msg3, msg0, e1, e0);
+		SHANI_ROUNDS(18, msg2, msg3, msg0, msg1, e0, e1);
+		SHANI_ROUNDS(19, msg3, msg0, msg1, msg2, e1, e0);
+
+		/* Combine the previous SHA state with the new state */
+		e0 = _mm_sha1nexte_epu32(e0, e0Save);
+		abcd = _mm_add_epi32(abcd, abcdSave);
+
+		block += 64;
+		--numBlocks;
+	}
+
+	/* Store the SHA state back into the context */
+	_mm_storeu_si128((__m128i *)state, abcd);
+	sha->A = state[3];
+	sha->B = state[2];
+	sha->C = state[1];
+	sha->D = state[0];
+	sha->E = (ILUInt32)_mm_extract_epi32(e0, 3);
+
+	/* Clear the temporary state */
+	ILMemZero(state, sizeof(state));
+}
+
+#endif /* IL_SHA_NI */
+
+/*
+ * Process a run of blocks, using the SHA-NI instructions if possible.
+ */
+static void ProcessBlocks(ILSHAContext *sha, const unsigned char *block,
+						  unsigned long numBlocks)
+{
+#ifdef IL_SHA_NI
+	if(HaveSHANI())
+	{
+		SHANIProcessBlocks(sha, block, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		ProcessBlock(sha, block);
+		block += 64;
+		--numBlocks;
+	}
+}
+
 void ILSHAData(ILSHAContext *sha, const void *buffer, unsigned long len)
 {
 	unsigned long templen;
@@ -172,9 +340,10 @@ void ILSHAData(ILSHAContext *sha, const void *buffer, unsigned long len)
 		if(!(sha->inputLen) && len >= 64)
 		{
 			/* Short cut: no point copying the data twice */
-			ProcessBlock(sha, (const unsigned char *)buffer);
-			buffer = (const void *)(((const unsigned char *)buffer) + 64);
-			len -= 64;
+			templen = (len & ~((unsigned long)63));
+			ProcessBlocks(sha, (const unsigned char *)buffer, templen / 64);
+			buffer = (const void *)(((const unsigned char *)buffer) + templen);
+			len -= templen;
 		}
 		else
 		{
@@ -186,7 +355,7 @@ void ILSHAData(ILSHAContext *sha, const void *buffer, unsigned long len)
 			ILMemCpy(sha->input + sha->inputLen, buffer, templen);
 			if((sha->inputLen += templen) >= 64)
 			{
-				ProcessBlock(sha, sha->input);
+				ProcessBlocks(sha, sha->input, 1);
 				sha->inputLen = 0;
 			}
 			buffer = (const void *)(((const unsigned char *)buffer) + templen);
@@ -222,7 +391,7 @@ void ILSHAFinalize(ILSHAContext *sha, unsigned char hash[IL_SHA_HASH_SIZE])
 			{
 				sha->input[(sha->inputLen)++] = (unsigned char)0x00;
 			}
-			ProcessBlock(sha, sha->input);
+			ProcessBlocks(sha, sha->input, 1);
 			sha->inputLen = 0;
 		}
 		else
@@ -237,7 +406,7 @@ void ILSHAFinalize(ILSHAContext *sha, unsigned char hash[IL_SHA_HASH_SIZE])
 		totalBits = (sha->totalLen << 3);
 		WriteLong(sha->input + 56, (ILUInt32)(totalBits >> 32));
 		WriteLong(sha->input + 60, (ILUInt32)totalBits);
-		ProcessBlock(sha, sha->input);
+		ProcessBlocks(sha, sha->input, 1);
 
 		/* Write the final hash value to the supplied buffer */
 		WriteLong(hash,      sha->A);
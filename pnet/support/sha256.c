@@ -53,6 +53,24 @@ extern	"C" {
 #define	RHO0(x)			(ROTATE((x), 7) ^ ROTATE((x), 18) ^ SHIFT((x), 3))
 #define	RHO1(x)			(ROTATE((x), 17) ^ ROTATE((x), 19) ^ SHIFT((x), 10))
 
+/*
+ * Determine if we can use the SHA-NI instructions, or the SSE2
+ * instructions to hash several independent messages side by side.
+ * They are enabled per function, so that the rest of the library is
+ * still compiled for the baseline processor, and are only called
+ * after checking CPUID.
+ */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+	(defined(__clang__) || \
+	 (defined(__GNUC__) && \
+	  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+	#define	IL_SHA_NI	1
+	#define	IL_SHA_NI_FUNC	__attribute__((__target__("sha,sse4.1,ssse3")))
+	#define	IL_SHA_LANES_FUNC	__attribute__((__target__("sse2")))
+	#include <cpuid.h>
+	#include <immintrin.h>
+#endif
+
 /*
  * Constants used in each of the SHA-256 rounds.
  */
@@ -153,6 +171,185 @@ static void ProcessBlock(ILSHA256Context *sha, const unsigned char *block)
 	a = b = c = d = e = f = g = h = temp = temp2 = 0;
 }
 
+#ifdef IL_SHA_NI
+
+/*
+ * Determine if the processor supports the SHA-NI instructions.
+ */
+static int HaveSHANI(void)
+{
+	static int haveSHANI = -1;
+	unsigned int eax, ebx, ecx, edx;
+	if(haveSHANI < 0)
+	{
+		haveSHANI = 0;
+		if(__get_cpuid_max(0, 0) >= 7 &&
+		   __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+		   (ecx & bit_SSSE3) != 0 && (ecx & bit_SSE4_1) != 0)
+		{
+			__cpuid_count(7, 0, eax, ebx, ecx, edx);
+			haveSHANI = ((ebx & (1 << 29)) != 0);
+		}
+	}
+	return haveSHANI;
+}
+
+/*
+ * Determine if the processor supports the SSE2 instructions.
+ */
+static int HaveSSE2(void)
+{
+	static int haveSSE2 = -1;
+	unsigned int eax, ebx, ecx, edx;
+	if(haveSSE2 < 0)
+	{
+		if(__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		{
+			haveSSE2 = ((edx & bit_SSE2) != 0);
+		}
+		else
+		{
+			haveSSE2 = 0;
+		}
+	}
+	return haveSSE2;
+}
+
+/*
+ * Load the next four message words of a block with the SHA-NI
+ * instructions, in the order that they expect.
+ */
+#define	SHANI_LOAD(n)	\
+			_mm_shuffle_epi8 \
+				(_mm_loadu_si128((const __m128i *)(block + (n) * 16)), mask)
+
+/*
+ * Perform four rounds of SHA-256 with the SHA-NI instructions,
+ * starting at round "t", with the message words in "msg".
+ */
+#define	SHANI_ROUNDS(msg, t)	\
+			do { \
+				temp = _mm_add_epi32 \
+					((msg), _mm_loadu_si128((const __m128i *)(K + (t)))); \
+				cdgh = _mm_sha256rnds2_epu32(cdgh, abef, temp); \
+				temp = _mm_shuffle_epi32(temp, 0x0E); \
+				abef = _mm_sha256rnds2_epu32(abef, cdgh, temp); \
+			} while (0)
+
+/*
+ * Compute the next four message words into "next", which holds the
+ * words from three groups before the current ones, already passed
+ * through "sha256msg1".  "cur" and "prev" hold the current words and
+ * the ones before them, which must not have been passed through it.
+ */
+#define	SHANI_SCHEDULE(next, cur, prev)	\
+			do { \
+				next = _mm_sha256msg2_epu32 \
+					(_mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4)), cur); \
+			} while (0)
+
+/*
+ * Process a run of blocks with the SHA-NI instructions.
+ */
+IL_SHA_NI_FUNC static void SHANIProcessBlocks(ILSHA256Context *sha,
+											  const unsigned char *block,
+											  unsigned long numBlocks)
+{
+	__m128i abef, cdgh, abefSave, cdghSave, temp, mask;
+	__m128i msg0, msg1, msg2, msg3;
+	ILUInt32 state[8];
+	int t;
+
+	/* Load the SHA-256 state, in the "ABEF" and "CDGH" order */
+	abef = _mm_set_epi32((int)(sha->A), (int)(sha->B),
+						 (int)(sha->E), (int)(sha->F));
+	cdgh = _mm_set_epi32((int)(sha->C), (int)(sha->D),
+						 (int)(sha->G), (int)(sha->H));
+	mask = _mm_set_epi64x(0x0C0D0E0F08090A0BLL, 0x0405060700010203LL);
+
+	while(numBlocks > 0)
+	{
+		abefSave = abef;
+		cdghSave = cdgh;
+
+		/* Rounds 0 to 15 use the message words directly */
+		msg0 = SHANI_LOAD(0);
+		SHANI_ROUNDS(msg0, 0);
+		msg1 = SHANI_LOAD(1);
+		SHANI_ROUNDS(msg1, 4);
+		msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+		msg2 = SHANI_LOAD(2);
+		SHANI_ROUNDS(msg2, 8);
+		msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+		msg3 = SHANI_LOAD(3);
+		SHANI_ROUNDS(msg3, 12);
+		SHANI_SCHEDULE(msg0, msg3, msg2);
+		msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+		/* Rounds 16 to 63 expand the message words as they go */
+		for(t = 16; t < 64; t += 16)
+		{
+			SHANI_ROUNDS(msg0, t);
+			SHANI_SCHEDULE(msg1, msg0, msg3);
+			msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+			SHANI_ROUNDS(msg1, t + 4);
+			SHANI_SCHEDULE(msg2, msg1, msg0);
+			msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+			SHANI_ROUNDS(msg2, t + 8);
+			SHANI_SCHEDULE(msg3, msg2, msg1);
+			msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+			SHANI_ROUNDS(msg3, t + 12);
+			SHANI_SCHEDULE(msg0, msg3, msg2);
+			msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+		}
+
+		/* Combine the previous SHA-256 state with the new state */
+		abef = _mm_add_epi32(abef, abefSave);
+		cdgh = _mm_add_epi32(cdgh, cdghSave);
+
+		block += 64;
+		--numBlocks;
+	}
+
+	/* Store the SHA-256 state back into the context */
+	_mm_storeu_si128((__m128i *)state, abef);
+	_mm_storeu_si128((__m128i *)(state + 4), cdgh);
+	sha->A = state[3];
+	sha->B = state[2];
+	sha->E = state[1];
+	sha->F = state[0];
+	sha->C = state[7];
+	sha->D = state[6];
+	sha->G = state[5];
+	sha->H = state[4];
+
+	/* Clear the temporary state */
+	ILMemZero(state, sizeof(state));
+}
+
+#endif /* IL_SHA_NI */
+
+/*
+ * Process a run of blocks, using the SHA-NI instructions if possible.
+ */
+static void ProcessBlocks(ILSHA256Context *sha, const unsigned char *block,
+						  unsigned long numBlocks)
+{
+#ifdef IL_SHA_NI
+	if(HaveSHANI())
+	{
+		SHANIProcessBlocks(sha, block, numBlocks);
+		return;
+	}
+#endif
+	while(numBlocks > 0)
+	{
+		ProcessBlock(sha, block);
+		block += 64;
+		--numBlocks;
+	}
+}
+
 void ILSHA256Data(ILSHA256Context *sha, const void *buffer, unsigned long len)
 {
 	unsigned long templen;
@@ -166,9 +363,10 @@ void ILSHA256Data(ILSHA256Context *sha, const void *buffer, unsigned long len)
 		if(!(sha->inputLen) && len >= 64)
 		{
 			/* Short cut: no point copying the data twice */
-			ProcessBlock(sha, (const unsigned char *)buffer);
-			buffer = (const void *)(((const unsigned char *)buffer) + 64);
-			len -= 64;
+			templen = (len & ~((unsigned long)63));
+			ProcessBlocks(sha, (const unsigned char *)buffer, templen / 64);
+			buffer = (const void *)(((const unsigned char *)buffer) + templen);
+			len -= templen;
 		}
 		else
 		{
@@ -180,7 +378,7 @@ void ILSHA256Data(ILSHA256Context *sha, const void *buffer, unsigned long len)
 			ILMemCpy(sha->input + sha->inputLen, buffer, templen);
 			if((sha->inputLen += templen) >= 64)
 			{
-				ProcessBlock(sha, sha->input);
+				ProcessBlocks(sha, sha->input, 1);
 				sha->inputLen = 0;
 			}
 			buffer = (const void *)(((const unsigned char *)buffer) + templen);
@@ -217,7 +415,7 @@ void ILSHA256Finalize(ILSHA256Context *sha,
 			{
 				sha->input[(sha->inputLen)++] = (unsigned char)0x00;
 			}
-			ProcessBlock(sha, sha->input);
+			ProcessBlocks(sha, sha->input, 1);
 			sha->inputLen = 0;
 		}
 		else
@@ -232,7 +430,7 @@ void ILSHA256Finalize(ILSHA256Context *sha,
 		totalBits = (sha->totalLen << 3);
 		WriteLong(sha->input + 56, (ILUInt32)(totalBits >> 32));
 		WriteLong(sha->input + 60, (ILUInt32)totalBits);
-		ProcessBlock(sha, sha->input);
+		ProcessBlocks(sha, sha->input, 1);
 
 		/* Write the final hash value to the supplied buffer */
 		WriteLong(hash,      sha->A);
@@ -249,6 +447,286 @@ void ILSHA256Finalize(ILSHA256Context *sha,
 	ILMemZero(sha, sizeof(ILSHA256Context));
 }
 
+/*
+ * Initial SHA-256 state, for the hashes that are computed in lanes.
+ */
+static ILUInt32 const InitState[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+	0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+#ifdef IL_SHA_NI
+
+/*
+ * Number of messages that are hashed side by side in the SSE2 lanes.
+ */
+#define	IL_SHA256_LANES		4
+
+/*
+ * Vector forms of the helper macros, which operate on the
+ * same word of each lane at once.
+ */
+#define	VROTATE(x,n)	_mm_or_si128(_mm_srli_epi32((x), (n)), \
+									 _mm_slli_epi32((x), 32 - (n)))
+#define	VCH(x,y,z)		_mm_xor_si128(_mm_and_si128((x), (y)), \
+									  _mm_andnot_si128((x), (z)))
+#define	VMAJ(x,y,z)		_mm_or_si128(_mm_and_si128((x), _mm_or_si128((y), (z))), \
+									 _mm_and_si128((y), (z)))
+#define	VSUM0(x)		_mm_xor_si128(_mm_xor_si128(VROTATE((x), 2), \
+									  VROTATE((x), 13)), VROTATE((x), 22))
+#define	VSUM1(x)		_mm_xor_si128(_mm_xor_si128(VROTATE((x), 6), \
+									  VROTATE((x), 11)), VROTATE((x), 25))
+#define	VRHO0(x)		_mm_xor_si128(_mm_xor_si128(VROTATE((x), 7), \
+									  VROTATE((x), 18)), _mm_srli_epi32((x), 3))
+#define	VRHO1(x)		_mm_xor_si128(_mm_xor_si128(VROTATE((x), 17), \
+									  VROTATE((x), 19)), _mm_srli_epi32((x), 10))
+
+/*
+ * Read a 32-bit big-endian word from a block.
+ */
+#define	READ_WORD(block,t)	\
+			((int)((((ILUInt32)((block)[(t) * 4 + 0])) << 24) | \
+			       (((ILUInt32)((block)[(t) * 4 + 1])) << 16) | \
+			       (((ILUInt32)((block)[(t) * 4 + 2])) <<  8) | \
+			        ((ILUInt32)((block)[(t) * 4 + 3]))))
+
+/*
+ * State of a message that is being hashed in one of the lanes.
+ */
+typedef struct
+{
+	const unsigned char *data;			/* Next block of the message body */
+	unsigned long		 blocks;		/* Full blocks left in the body */
+	const unsigned char *tailNext;		/* Next block of the padded tail */
+	int					 tailBlocks;	/* Blocks left in the padded tail */
+	unsigned char		*hash;			/* Final hash, or NULL if idle */
+	unsigned char		 tail[128];		/* Padded tail of the message */
+
+} SHA256Lane;
+
+/*
+ * Process one block in each of the lanes with the SSE2 instructions.
+ * Word "i" of the SHA-256 state for lane "l" is "state[i][l]".
+ */
+IL_SHA_LANES_FUNC static void LanesProcessBlock
+			(ILUInt32 state[8][IL_SHA256_LANES],
+			 const unsigned char *blocks[IL_SHA256_LANES])
+{
+	__m128i W[16];
+	__m128i a, b, c, d, e, f, g, h;
+	__m128i temp, temp2;
+	int t;
+
+	/* Load the SHA-256 state into local variables */
+	a = _mm_loadu_si128((const __m128i *)(state[0]));
+	b = _mm_loadu_si128((const __m128i *)(state[1]));
+	c = _mm_loadu_si128((const __m128i *)(state[2]));
+	d = _mm_loadu_si128((const __m128i *)(state[3]));
+	e = _mm_loadu_si128((const __m128i *)(state[4]));
+	f = _mm_loadu_si128((const __m128i *)(state[5]));
+	g = _mm_loadu_si128((const __m128i *)(state[6]));
+	h = _mm_loadu_si128((const __m128i *)(state[7]));
+
+	/* Perform 64 rounds of hash computations, expanding the
+	   message words into a rolling window of 16 as we go */
+	for(t = 0; t < 64; ++t)
+	{
+		if(t < 16)
+		{
+			W[t] = _mm_set_epi32(READ_WORD(blocks[3], t),
+								 READ_WORD(blocks[2], t),
+								 READ_WORD(blocks[1], t),
+								 READ_WORD(blocks[0], t));
+		}
+		else
+		{
+			W[t & 15] = _mm_add_epi32
+				(_mm_add_epi32(VRHO1(W[(t - 2) & 15]), W[(t - 7) & 15]),
+				 _mm_add_epi32(VRHO0(W[(t - 15) & 15]), W[t & 15]));
+		}
+		temp = _mm_add_epi32
+			(_mm_add_epi32(h, VSUM1(e)),
+			 _mm_add_epi32(_mm_add_epi32(VCH(e, f, g), W[t & 15]),
+			 			   _mm_set1_epi32((int)(K[t]))));
+		temp2 = _mm_add_epi32(VSUM0(a), VMAJ(a, b, c));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm_add_epi32(d, temp);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm_add_epi32(temp, temp2);
+	}
+
+	/* Combine the previous SHA-256 state with the new state */
+	#define	VCOMBINE(i,x)	\
+				_mm_storeu_si128((__m128i *)(state[(i)]), _mm_add_epi32 \
+					(_mm_loadu_si128((const __m128i *)(state[(i)])), (x)))
+	VCOMBINE(0, a);
+	VCOMBINE(1, b);
+	VCOMBINE(2, c);
+	VCOMBINE(3, d);
+	VCOMBINE(4, e);
+	VCOMBINE(5, f);
+	VCOMBINE(6, g);
+	VCOMBINE(7, h);
+	#undef VCOMBINE
+
+	/* Clear the temporary state */
+	ILMemZero(W, sizeof(W));
+}
+
+/*
+ * Start hashing a message in a lane.
+ */
+static void LaneStart(SHA256Lane *lane, ILUInt32 state[8][IL_SHA256_LANES],
+					  int posn, const unsigned char *data,
+					  unsigned long len, unsigned char *hash)
+{
+	unsigned long rem = (len & 63);
+	unsigned long tailLen = (rem < 56 ? 64 : 128);
+	ILUInt64 totalBits = (((ILUInt64)len) << 3);
+	int i;
+
+	/* The body of the message is hashed where it is */
+	lane->data = data;
+	lane->blocks = len / 64;
+	lane->hash = hash;
+
+	/* Pad the rest of the message to a multiple of 512 bits */
+	ILMemCpy(lane->tail, data + (len - rem), rem);
+	lane->tail[rem] = (unsigned char)0x80;
+	ILMemZero(lane->tail + rem + 1, tailLen - rem - 9);
+	WriteLong(lane->tail + tailLen - 8, (ILUInt32)(totalBits >> 32));
+	WriteLong(lane->tail + tailLen - 4, (ILUInt32)totalBits);
+	lane->tailNext = lane->tail;
+	lane->tailBlocks = (int)(tailLen / 64);
+
+	/* Reset the SHA-256 state for the lane */
+	for(i = 0; i < 8; ++i)
+	{
+		state[i][posn] = InitState[i];
+	}
+}
+
+/*
+ * Hash a batch of messages, four at a time, in the SSE2 lanes.
+ * Whenever a message is finished, the next one takes over its lane,
+ * and lanes without a message hash a dummy block until the end.
+ */
+static void LanesBatch(const unsigned char * const *data,
+					   const unsigned long *lengths,
+					   unsigned char *hashes, unsigned long count)
+{
+	static unsigned char const idleBlock[64] = {0};
+	SHA256Lane lanes[IL_SHA256_LANES];
+	ILUInt32 state[8][IL_SHA256_LANES];
+	const unsigned char *blocks[IL_SHA256_LANES];
+	unsigned long next = 0;
+	int active = 0;
+	int posn, i;
+
+	/* Load the first messages into the lanes */
+	for(posn = 0; posn < IL_SHA256_LANES; ++posn)
+	{
+		if(next < count)
+		{
+			LaneStart(&(lanes[posn]), state, posn, data[next],
+					  lengths[next], hashes + next * IL_SHA256_HASH_SIZE);
+			++next;
+			++active;
+		}
+		else
+		{
+			lanes[posn].hash = 0;
+		}
+	}
+
+	while(active > 0)
+	{
+		/* Collect the next block for each lane */
+		for(posn = 0; posn < IL_SHA256_LANES; ++posn)
+		{
+			if(!(lanes[posn].hash))
+			{
+				blocks[posn] = idleBlock;
+			}
+			else if(lanes[posn].blocks > 0)
+			{
+				blocks[posn] = lanes[posn].data;
+				lanes[posn].data += 64;
+				--(lanes[posn].blocks);
+			}
+			else
+			{
+				blocks[posn] = lanes[posn].tailNext;
+				lanes[posn].tailNext += 64;
+				--(lanes[posn].tailBlocks);
+			}
+		}
+
+		/* Hash the blocks */
+		LanesProcessBlock(state, blocks);
+
+		/* Retire the messages that are finished */
+		for(posn = 0; posn < IL_SHA256_LANES; ++posn)
+		{
+			if(!(lanes[posn].hash) || lanes[posn].blocks > 0 ||
+			   lanes[posn].tailBlocks > 0)
+			{
+				continue;
+			}
+			for(i = 0; i < 8; ++i)
+			{
+				WriteLong(lanes[posn].hash + i * 4, state[i][posn]);
+			}
+			if(next < count)
+			{
+				LaneStart(&(lanes[posn]), state, posn, data[next],
+						  lengths[next], hashes + next * IL_SHA256_HASH_SIZE);
+				++next;
+			}
+			else
+			{
+				lanes[posn].hash = 0;
+				--active;
+			}
+		}
+	}
+
+	/* Clear the temporary state */
+	ILMemZero(lanes, sizeof(lanes));
+	ILMemZero(state, sizeof(state));
+}
+
+#endif /* IL_SHA_NI */
+
+void ILSHA256Batch(const unsigned char * const *data,
+				   const unsigned long *lengths,
+				   unsigned char *hashes, unsigned long count)
+{
+	ILSHA256Context sha;
+	unsigned long posn;
+
+#ifdef IL_SHA_NI
+	/* The SHA-NI instructions are faster one message at a time,
+	   but the SSE2 lanes are faster than the portable code */
+	if(count > 1 && !HaveSHANI() && HaveSSE2())
+	{
+		LanesBatch(data, lengths, hashes, count);
+		return;
+	}
+#endif
+
+	for(posn = 0; posn < count; ++posn)
+	{
+		ILSHA256Init(&sha);
+		ILSHA256Data(&sha, data[posn], lengths[posn]);
+		ILSHA256Finalize(&sha, hashes + posn * IL_SHA256_HASH_SIZE);
+	}
+}
+
 #ifdef TEST_SHA256
 
 #include <stdio.h>
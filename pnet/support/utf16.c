@@ -21,6 +21,16 @@
 #include "il_utils.h"
 #include "il_values.h"
 
+/*
+ * Use SSE2 to compare 8 characters at a time when searching for
+ * characters, if the compiler is targeting a processor that is
+ * guaranteed to have it.
+ */
+#if defined(__SSE2__) && (defined(__i386__) || defined(__x86_64__))
+	#define	IL_UTF16_SSE2	1
+	#include <emmintrin.h>
+#endif
+
 #ifdef	__cplusplus
 extern	"C" {
 #endif
@@ -173,6 +183,66 @@ int ILUTF16WriteCharAsBytes(void *_buf, unsigned long ch)
 	}
 }
 
+/*
+ * Maximum number of characters that are compared side by side
+ * with SSE2 when searching for any of a set of characters.
+ */
+#define	IL_FIND_ANY_SSE2_MAX	8
+
+long ILUTF16FindAny(const unsigned short *str, unsigned long len,
+					const unsigned short *chars, unsigned long numChars)
+{
+	unsigned long posn = 0;
+	unsigned long index;
+#ifdef IL_UTF16_SSE2
+	__m128i sets[IL_FIND_ANY_SSE2_MAX];
+	__m128i value, found;
+	int mask;
+	if(numChars > 0 && numChars <= IL_FIND_ANY_SSE2_MAX)
+	{
+		for(index = 0; index < numChars; ++index)
+		{
+			sets[index] = _mm_set1_epi16((short)(chars[index]));
+		}
+		while((len - posn) >= 8)
+		{
+			value = _mm_loadu_si128((const __m128i *)(str + posn));
+			found = _mm_cmpeq_epi16(value, sets[0]);
+			for(index = 1; index < numChars; ++index)
+			{
+				found = _mm_or_si128
+					(found, _mm_cmpeq_epi16(value, sets[index]));
+			}
+			mask = _mm_movemask_epi8(found);
+			if(mask != 0)
+			{
+				/* Each character sets two bits in the mask */
+				index = 0;
+				while((mask & 1) == 0)
+				{
+					mask >>= 2;
+					++index;
+				}
+				return (long)(posn + index);
+			}
+			posn += 8;
+		}
+	}
+#endif
+	while(posn < len)
+	{
+		for(index = 0; index < numChars; ++index)
+		{
+			if(str[posn] == chars[index])
+			{
+				return (long)posn;
+			}
+		}
+		++posn;
+	}
+	return -1;
+}
+
 #ifdef	__cplusplus
 };
 #endif
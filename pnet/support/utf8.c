@@ -20,6 +20,15 @@
 
 #include "il_utils.h"
 
+/*
+ * Use SSE2 to convert runs of ASCII characters 16 at a time, if the
+ * compiler is targeting a processor that is guaranteed to have it.
+ */
+#if defined(__SSE2__) && (defined(__i386__) || defined(__x86_64__))
+	#define	IL_UTF8_SSE2	1
+	#include <emmintrin.h>
+#endif
+
 #ifdef	__cplusplus
 extern	"C" {
 #endif
@@ -186,6 +195,351 @@ int ILUTF8WriteChar(char *str, unsigned long ch)
 	}
 }
 
+/*
+ * Convert the run of ASCII bytes at the start of a buffer into
+ * UTF-16, stopping at the first non-ASCII byte.  If "out" is NULL,
+ * then only measure the run.  Returns the length of the run.
+ */
+static unsigned long WidenASCII(const unsigned char *in, unsigned short *out,
+								unsigned long len)
+{
+	unsigned long posn = 0;
+#ifdef IL_UTF8_SSE2
+	__m128i zero = _mm_setzero_si128();
+	__m128i value;
+	while((len - posn) >= 16)
+	{
+		value = _mm_loadu_si128((const __m128i *)(in + posn));
+		if(_mm_movemask_epi8(value) != 0)
+		{
+			break;
+		}
+		if(out)
+		{
+			_mm_storeu_si128((__m128i *)(out + posn),
+							 _mm_unpacklo_epi8(value, zero));
+			_mm_storeu_si128((__m128i *)(out + posn + 8),
+							 _mm_unpackhi_epi8(value, zero));
+		}
+		posn += 16;
+	}
+#endif
+	while(posn < len && in[posn] < 0x80)
+	{
+		if(out)
+		{
+			out[posn] = (unsigned short)(in[posn]);
+		}
+		++posn;
+	}
+	return posn;
+}
+
+/*
+ * Convert the run of ASCII characters at the start of a UTF-16
+ * buffer into bytes, stopping at the first non-ASCII character.
+ * If "out" is NULL, then only measure the run.  Returns the
+ * length of the run.
+ */
+static unsigned long NarrowASCII(const unsigned short *in, unsigned char *out,
+								 unsigned long len)
+{
+	unsigned long posn = 0;
+#ifdef IL_UTF8_SSE2
+	__m128i zero = _mm_setzero_si128();
+	__m128i mask = _mm_set1_epi16((short)0xFF80);
+	__m128i value1, value2;
+	while((len - posn) >= 16)
+	{
+		value1 = _mm_loadu_si128((const __m128i *)(in + posn));
+		value2 = _mm_loadu_si128((const __m128i *)(in + posn + 8));
+		if(_mm_movemask_epi8
+				(_mm_cmpeq_epi16
+					(_mm_and_si128(_mm_or_si128(value1, value2), mask),
+					 zero)) != 0xFFFF)
+		{
+			break;
+		}
+		if(out)
+		{
+			_mm_storeu_si128((__m128i *)(out + posn),
+							 _mm_packus_epi16(value1, value2));
+		}
+		posn += 16;
+	}
+#endif
+	while(posn < len && in[posn] < 0x80)
+	{
+		if(out)
+		{
+			out[posn] = (unsigned char)(in[posn]);
+		}
+		++posn;
+	}
+	return posn;
+}
+
+/*
+ * Determine if a byte is a UTF-8 continuation byte.
+ */
+#define	IS_CONTINUATION(ch)	(((ch) & 0xC0) == 0x80)
+
+unsigned long ILUTF8ToUTF16(const unsigned char *in, unsigned long inLen,
+							unsigned short *out, unsigned long outLen,
+							unsigned long *outUsed)
+{
+	unsigned long inPosn = 0;
+	unsigned long outPosn = 0;
+	unsigned long run;
+	unsigned long ch;
+	unsigned long len;
+	unsigned char lead;
+
+	while(inPosn < inLen)
+	{
+		lead = in[inPosn];
+		if(lead < 0x80)
+		{
+			/* Convert a run of ASCII characters */
+			run = inLen - inPosn;
+			if(out && run > (outLen - outPosn))
+			{
+				run = outLen - outPosn;
+				if(!run)
+				{
+					break;
+				}
+			}
+			run = WidenASCII(in + inPosn, (out ? out + outPosn : 0), run);
+			inPosn += run;
+			outPosn += run;
+			continue;
+		}
+		else if((lead & 0xE0) == 0xC0)
+		{
+			/* Two-byte UTF-8 character */
+			if((inLen - inPosn) < 2 || !IS_CONTINUATION(in[inPosn + 1]))
+			{
+				break;
+			}
+			ch = (((unsigned long)(lead & 0x1F)) << 6) |
+			      ((unsigned long)(in[inPosn + 1] & 0x3F));
+			len = 2;
+		}
+		else if((lead & 0xF0) == 0xE0)
+		{
+			/* Three-byte UTF-8 character */
+			if((inLen - inPosn) < 3 || !IS_CONTINUATION(in[inPosn + 1]) ||
+			   !IS_CONTINUATION(in[inPosn + 2]))
+			{
+				break;
+			}
+			ch = (((unsigned long)(lead & 0x0F)) << 12) |
+			     (((unsigned long)(in[inPosn + 1] & 0x3F)) << 6) |
+			      ((unsigned long)(in[inPosn + 2] & 0x3F));
+			len = 3;
+		}
+		else if((lead & 0xF8) == 0xF0)
+		{
+			/* Four-byte UTF-8 character */
+			if((inLen - inPosn) < 4 || !IS_CONTINUATION(in[inPosn + 1]) ||
+			   !IS_CONTINUATION(in[inPosn + 2]) ||
+			   !IS_CONTINUATION(in[inPosn + 3]))
+			{
+				break;
+			}
+			ch = (((unsigned long)(lead & 0x07)) << 18) |
+			     (((unsigned long)(in[inPosn + 1] & 0x3F)) << 12) |
+			     (((unsigned long)(in[inPosn + 2] & 0x3F)) << 6) |
+			      ((unsigned long)(in[inPosn + 3] & 0x3F));
+			if(ch >= (unsigned long)0x110000)
+			{
+				break;
+			}
+			len = 4;
+		}
+		else
+		{
+			/* Stray continuation byte, or longer sequence */
+			break;
+		}
+
+		/* Write out the character.  Byte order marks are dropped */
+		if(ch < (unsigned long)0x10000)
+		{
+			if(ch != (unsigned long)0xFEFF)
+			{
+				if(out)
+				{
+					if(outPosn >= outLen)
+					{
+						break;
+					}
+					out[outPosn] = (unsigned short)ch;
+				}
+				++outPosn;
+			}
+		}
+		else
+		{
+			if(out)
+			{
+				if((outLen - outPosn) < 2)
+				{
+					break;
+				}
+				ch -= (unsigned long)0x10000;
+				out[outPosn] = (unsigned short)((ch >> 10) + 0xD800);
+				out[outPosn + 1] = (unsigned short)((ch & 0x03FF) + 0xDC00);
+			}
+			outPosn += 2;
+		}
+		inPosn += len;
+	}
+
+	*outUsed = outPosn;
+	return inPosn;
+}
+
+unsigned long ILUTF16ToUTF8(const unsigned short *in, unsigned long inLen,
+							unsigned char *out, unsigned long outLen,
+							unsigned long *outUsed)
+{
+	unsigned long inPosn = 0;
+	unsigned long outPosn = 0;
+	unsigned long run;
+	unsigned long ch;
+	unsigned long next;
+	unsigned long len;
+	unsigned long used;
+
+	while(inPosn < inLen)
+	{
+		ch = in[inPosn];
+		if(ch < (unsigned long)0x80)
+		{
+			/* Convert a run of ASCII characters */
+			run = inLen - inPosn;
+			if(out && run > (outLen - outPosn))
+			{
+				run = outLen - outPosn;
+				if(!run)
+				{
+					break;
+				}
+			}
+			run = NarrowASCII(in + inPosn, (out ? out + outPosn : 0), run);
+			inPosn += run;
+			outPosn += run;
+			continue;
+		}
+		else if(ch < (unsigned long)0x800)
+		{
+			len = 2;
+			used = 1;
+		}
+		else if(ch >= (unsigned long)0xD800 && ch <= (unsigned long)0xDBFF)
+		{
+			/* Surrogate pair, which needs to see the next character */
+			if((inPosn + 1) >= inLen)
+			{
+				break;
+			}
+			next = in[inPosn + 1];
+			if(next >= (unsigned long)0xDC00 && next <= (unsigned long)0xDFFF)
+			{
+				ch = ((ch - 0xD800) << 10) + (next - 0xDC00) + 0x10000;
+				len = 4;
+				used = 2;
+			}
+			else
+			{
+				/* Unpaired surrogate start: write it out as-is */
+				len = 3;
+				used = 1;
+			}
+		}
+		else
+		{
+			len = 3;
+			used = 1;
+		}
+
+		/* Write out the character */
+		if(out)
+		{
+			if((outLen - outPosn) < len)
+			{
+				break;
+			}
+			switch(len)
+			{
+				case 2:
+				{
+					out[outPosn]     = (unsigned char)(0xC0 | (ch >> 6));
+					out[outPosn + 1] = (unsigned char)(0x80 | (ch & 0x3F));
+				}
+				break;
+
+				case 3:
+				{
+					out[outPosn]     = (unsigned char)(0xE0 | (ch >> 12));
+					out[outPosn + 1] =
+						(unsigned char)(0x80 | ((ch >> 6) & 0x3F));
+					out[outPosn + 2] = (unsigned char)(0x80 | (ch & 0x3F));
+				}
+				break;
+
+				default:
+				{
+					out[outPosn]     = (unsigned char)(0xF0 | (ch >> 18));
+					out[outPosn + 1] =
+						(unsigned char)(0x80 | ((ch >> 12) & 0x3F));
+					out[outPosn + 2] =
+						(unsigned char)(0x80 | ((ch >> 6) & 0x3F));
+					out[outPosn + 3] = (unsigned char)(0x80 | (ch & 0x3F));
+				}
+				break;
+			}
+		}
+		outPosn += len;
+		inPosn += used;
+	}
+
+	*outUsed = outPosn;
+	return inPosn;
+}
+
+void ILASCIIToUTF16(const unsigned char *in, unsigned short *out,
+					unsigned long len, unsigned short replace)
+{
+	unsigned long posn = 0;
+	while(posn < len)
+	{
+		posn += WidenASCII(in + posn, out + posn, len - posn);
+		while(posn < len && in[posn] >= 0x80)
+		{
+			out[posn] = (replace ? replace : (unsigned short)(in[posn]));
+			++posn;
+		}
+	}
+}
+
+void ILUTF16ToASCII(const unsigned short *in, unsigned char *out,
+					unsigned long len, unsigned char replace)
+{
+	unsigned long posn = 0;
+	while(posn < len)
+	{
+		posn += NarrowASCII(in + posn, out + posn, len - posn);
+		while(posn < len && in[posn] >= 0x80)
+		{
+			out[posn] = replace;
+			++posn;
+		}
+	}
+}
+
 #ifdef	__cplusplus
 };
 #endif
@@ -21,6 +21,15 @@
 #include "il_xml.h"
 #include "il_system.h"
 
+/*
+ * Use SSE2 to classify name characters 8 at a time, if the
+ * compiler is targeting a processor that is guaranteed to have it.
+ */
+#if defined(__SSE2__) && (defined(__i386__) || defined(__x86_64__))
+	#define	IL_XML_SSE2	1
+	#include <emmintrin.h>
+#endif
+
 /*
 
 This XML parser assumes that the input is well-formed, that DTD
@@ -860,6 +869,63 @@ const char *ILXMLGetPackedParam(void *buffer, int len, const char *name)
 	return 0;
 }
 
+/*
+ * Determine if an ASCII character is an XML name character.
+ */
+#define	IS_ASCII_NAME_CHAR(ch)	\
+			(((ch) >= 'a' && (ch) <= 'z') || ((ch) >= 'A' && (ch) <= 'Z') || \
+			 ((ch) >= '0' && (ch) <= ':') || (ch) == '.' || (ch) == '-' || \
+			 (ch) == '_')
+
+#ifdef IL_XML_SSE2
+
+/*
+ * Get a mask of the 16-bit lanes of "value" that are within "low..high".
+ */
+#define	IN_RANGE(value,low,high)	\
+			(_mm_and_si128(_mm_cmpgt_epi16((value), _mm_set1_epi16((low) - 1)), \
+						   _mm_cmplt_epi16((value), _mm_set1_epi16((high) + 1))))
+
+#endif
+
+unsigned long ILXMLNameCharRun(const unsigned short *buf, unsigned long len)
+{
+	unsigned long posn = 0;
+#ifdef IL_XML_SSE2
+	__m128i value, found;
+	int mask;
+	while((len - posn) >= 8)
+	{
+		/* Characters from 0x8000 up compare as negative,
+		   and so never fall within the ranges */
+		value = _mm_loadu_si128((const __m128i *)(buf + posn));
+		found = _mm_or_si128(IN_RANGE(value, 'a', 'z'),
+							 IN_RANGE(value, 'A', 'Z'));
+		found = _mm_or_si128(found, IN_RANGE(value, '0', ':'));
+		found = _mm_or_si128(found, IN_RANGE(value, '-', '.'));
+		found = _mm_or_si128
+			(found, _mm_cmpeq_epi16(value, _mm_set1_epi16('_')));
+		mask = _mm_movemask_epi8(found);
+		if(mask != 0xFFFF)
+		{
+			/* Each character sets two bits in the mask */
+			while((mask & 1) != 0)
+			{
+				mask >>= 2;
+				++posn;
+			}
+			return posn;
+		}
+		posn += 8;
+	}
+#endif
+	while(posn < len && IS_ASCII_NAME_CHAR(buf[posn]))
+	{
+		++posn;
+	}
+	return posn;
+}
+
 #ifdef	__cplusplus
 };
 #endif
@@ -136,6 +136,12 @@ static HashTestInfo sha1_hash_2 = {
 	{0x84, 0x98, 0x3E, 0x44, 0x1C, 0x3B, 0xD2, 0x6E, 0xBA, 0xAE,
 	 0x4A, 0xA1, 0xF9, 0x51, 0x29, 0xE5, 0xE5, 0x46, 0x70, 0xF1}
 };
+static HashTestInfo sha1_hash_3 = {
+	"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	"hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+	{0xA4, 0x9B, 0x24, 0x46, 0xA0, 0x2C, 0x64, 0x5B, 0xF4, 0x19,
+	 0xF9, 0x95, 0xB6, 0x70, 0x91, 0x25, 0x3A, 0x04, 0xA2, 0x59}
+};
 
 /*
  * Test the SHA-1 hash algorithm.
@@ -174,6 +180,14 @@ static HashTestInfo sha256_hash_2 = {
 	 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
 	 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}
 };
+static HashTestInfo sha256_hash_3 = {
+	"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	"hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+	{0xcf, 0x5b, 0x16, 0xa7, 0x78, 0xaf, 0x83, 0x80,
+	 0x03, 0x6c, 0xe5, 0x9e, 0x7b, 0x04, 0x92, 0x37,
+	 0x0b, 0x24, 0x9b, 0x11, 0xe8, 0xf0, 0x7a, 0x51,
+	 0xaf, 0xac, 0x45, 0x03, 0x7a, 0xfe, 0xe9, 0xd1}
+};
 
 /*
  * Test the SHA-256 hash algorithm.
@@ -195,6 +209,51 @@ static void test_sha256_hash(HashTestInfo *arg)
 	}
 }
 
+/*
+ * Test hashing a batch of SHA-256 messages, by comparing the
+ * results against hashing each message a byte at a time.
+ */
+static void test_sha256_batch(void *arg)
+{
+	static unsigned char buffer[2048];
+	const unsigned char *data[40];
+	unsigned long lengths[40];
+	unsigned char hashes[40 * IL_SHA256_HASH_SIZE];
+	unsigned char hash[IL_SHA256_HASH_SIZE];
+	ILSHA256Context sha256;
+	unsigned long posn, count;
+
+	/* Build the messages, of all lengths around the block boundaries */
+	for(posn = 0; posn < sizeof(buffer); ++posn)
+	{
+		buffer[posn] = (unsigned char)(posn * 7 + (posn >> 8));
+	}
+	for(posn = 0; posn < 40; ++posn)
+	{
+		data[posn] = buffer + posn * 37;
+		lengths[posn] = (posn * 13) % 200 + (posn & 1) * 55;
+	}
+
+	/* Hash the batch */
+	ILSHA256Batch(data, lengths, hashes, 40);
+
+	/* Compare against hashing the messages individually */
+	for(posn = 0; posn < 40; ++posn)
+	{
+		ILSHA256Init(&sha256);
+		for(count = 0; count < lengths[posn]; ++count)
+		{
+			ILSHA256Data(&sha256, data[posn] + count, 1);
+		}
+		ILSHA256Finalize(&sha256, hash);
+		if(ILMemCmp(hash, hashes + posn * IL_SHA256_HASH_SIZE,
+					IL_SHA256_HASH_SIZE) != 0)
+		{
+			ILUnitFailed("hash %lu of the batch is incorrect", posn);
+		}
+	}
+}
+
 /*
  * Test vectors for the SHA-384 algorithm.
  */
@@ -345,6 +404,108 @@ static void test_aes_block(BlockTestInfo *arg)
 	}
 }
 
+/*
+ * Test the bulk ECB, CBC, and CTR modes of the AES algorithm
+ * against the single block functions, optionally forcing the
+ * portable code even if the AES-NI instructions are available.
+ */
+static void aes_modes(BlockTestInfo *arg, int portable)
+{
+	ILAESContext aes;
+	unsigned char plaintext[16 * 7];
+	unsigned char expected[16 * 7];
+	unsigned char actual[16 * 7];
+	unsigned char iv[16];
+	unsigned char iv2[16];
+	int block, posn;
+
+	/* Use a run of blocks that is not a multiple of four */
+	for(posn = 0; posn < (int)sizeof(plaintext); ++posn)
+	{
+		plaintext[posn] = (unsigned char)(posn * 7 + 3);
+	}
+	ILAESInit(&aes, arg->key, arg->keyBits);
+	if(portable)
+	{
+		aes.useAESNI = 0;
+	}
+
+	/* ECB mode */
+	for(block = 0; block < 7; ++block)
+	{
+		ILAESEncrypt(&aes, plaintext + block * 16, expected + block * 16);
+	}
+	ILAESEncryptECB(&aes, plaintext, actual, 7);
+	if(ILMemCmp(actual, expected, sizeof(actual)) != 0)
+	{
+		ILUnitFailed("ECB ciphertexts don't match");
+	}
+	ILAESDecryptECB(&aes, actual, actual, 7);
+	if(ILMemCmp(actual, plaintext, sizeof(actual)) != 0)
+	{
+		ILUnitFailed("ECB plaintexts don't match");
+	}
+
+	/* CBC mode */
+	ILMemCpy(iv, arg->plaintext, 16);
+	for(block = 0; block < 7; ++block)
+	{
+		for(posn = 0; posn < 16; ++posn)
+		{
+			iv[posn] ^= plaintext[block * 16 + posn];
+		}
+		ILAESEncrypt(&aes, iv, iv);
+		ILMemCpy(expected + block * 16, iv, 16);
+	}
+	ILMemCpy(iv2, arg->plaintext, 16);
+	ILAESEncryptCBC(&aes, iv2, plaintext, actual, 7);
+	if(ILMemCmp(actual, expected, sizeof(actual)) != 0 ||
+	   ILMemCmp(iv2, iv, 16) != 0)
+	{
+		ILUnitFailed("CBC ciphertexts don't match");
+	}
+	ILMemCpy(iv2, arg->plaintext, 16);
+	ILAESDecryptCBC(&aes, iv2, actual, actual, 7);
+	if(ILMemCmp(actual, plaintext, sizeof(actual)) != 0 ||
+	   ILMemCmp(iv2, iv, 16) != 0)
+	{
+		ILUnitFailed("CBC plaintexts don't match");
+	}
+
+	/* CTR mode, with a counter that carries across several bytes */
+	ILMemSet(iv, 0xFF, 16);
+	iv[0] = 0x01;
+	ILMemCpy(iv2, iv, 16);
+	ILAESEncrypt(&aes, iv, expected);
+	for(posn = 0; posn < 16; ++posn)
+	{
+		expected[posn] ^= plaintext[posn];
+	}
+	ILAESCryptCTR(&aes, iv2, plaintext, actual, 7);
+	if(ILMemCmp(actual, expected, 16) != 0)
+	{
+		ILUnitFailed("CTR ciphertexts don't match");
+	}
+	ILAESCryptCTR(&aes, iv, actual, actual, 7);
+	if(ILMemCmp(actual, plaintext, sizeof(actual)) != 0)
+	{
+		ILUnitFailed("CTR plaintexts don't match");
+	}
+	if(ILMemCmp(iv, iv2, 16) != 0 || iv[0] != 0x02 || iv[15] != 0x06)
+	{
+		ILUnitFailed("CTR counter was not incremented correctly");
+	}
+	ILAESFinalize(&aes);
+}
+static void test_aes_modes(BlockTestInfo *arg)
+{
+	aes_modes(arg, 0);
+}
+static void test_aes_modes_portable(BlockTestInfo *arg)
+{
+	aes_modes(arg, 1);
+}
+
 /*
  * Define test vectors for the DES algorithm.
  */
@@ -978,6 +1139,75 @@ static BigNumTestInfo bignum_mul_7 = {		/* multiply double-word values */
 	ILBigNumMul,
 	"8589934595", "8589934599", 0, "73786976380737552405"
 };
+static BigNumTestInfo bignum_mul_8 = {		/* Karatsuba-sized operands */
+	ILBigNumMul,
+	"135829852904938584927735142835926677860349384693174454974851"
+	"966972781309275424184872053920832075605922985782629538473834"
+	"750387255432349299711555483428006287218857634994063903317828"
+	"641441646807307668371605262231765127984357721299565533552860"
+	"322030803807757597323201989850948840040691161230841478754371"
+	"83658467465148948790552744165375",
+	"135829852904938584927735142835926677860349384693174454974851"
+	"966972781309275424184872053920832075605922985782629538473834"
+	"750387255432349299711555483428006287218857634994063903317828"
+	"641441646807307668371605262231765127984357721299565533552860"
+	"322030803807757597323201989850948840040691161230841478754371"
+	"83658467465148948790552744165373",
+	0,
+	"184497489401772529385612327842172717039008268166646221893471"
+	"402059821287234759868672175917131173661172843563441437060059"
+	"660158104845032398976807920666283692562120150139178769612799"
+	"511748636278282415866878160176201872937423527853931074825229"
+	"289817028865471580173776186278979555862451026349435370470386"
+	"779578868176354099221238174997752816349206115770581267270787"
+	"150794323623450677776245317515417329454813403064407362042735"
+	"996851946040860914907786300197612263680432956852541430596213"
+	"559693890458444787395748034679471788934040679874752418529170"
+	"074013737830354339592533648677454966382722218862650403941282"
+	"808158064538861756272147749943825842363349560507274999860559"
+	"875"
+};
+static BigNumTestInfo bignum_mul_9 = {		/* Karatsuba with unequal sizes */
+	ILBigNumMul,
+	"135829852904938584927735142835926677860349384693174454974851"
+	"966972781309275424184872053920832075605922985782629538473834"
+	"750387255432349299711555483428006287218857634994063903317828"
+	"641441646807307668371605262231765127984357721299565533552860"
+	"322030803807757597323201989850948840040691161230841478754371"
+	"83658467465148948790552744165375",
+	"296476034789978134120813694105889196637143099477633324816082"
+	"314536891061330578960717457630202115461307371403034595170935"
+	"724489293025075877350504677578646496935046858594479715738345"
+	"467364856518143562563193206102470734007555612914096207105269"
+	"178488890947743301293297650838442152727760046517446830295902"
+	"003198032258606113584103529903220339673080606794891142197240"
+	"305184142245671365903090895689843737237511812085698333701706"
+	"561779824300625327604726460130427583460035274205809575857633"
+	"345902990376717064770455839258773171510507099132110028077728"
+	"160266796559445408422233980009645488034469133404238749146357"
+	"925975400309760081625787339024177663736163185805751165416483"
+	"569137375444258463220131699965267987276097342929294919389425"
+	"721",
+	0,
+	"402702961953621844286950607555369624422784868935557056881131"
+	"335461307658701727371551406721502307932123276358395008895125"
+	"652043531209418099658895323804953421455502359439932416245276"
+	"659698167468088937570774479761417692998541764456595941884384"
+	"880600102787969744607942278005344329659944902212055120534831"
+	"056155566296908941240558524043025165180830121485077539991635"
+	"841758649851799577347205971244822977150751022788209558423402"
+	"546547404053210184651801223670354443739167888735839198028934"
+	"819359618744367063463519196730218300143689110078685120957364"
+	"719610910869845667288914256992791621272491316433837634926866"
+	"519550015955531032947516313282735920799102765060254447174968"
+	"400765590136709866236641197412265617563031080016529569091887"
+	"894415147018866573662595713867739660709825885811184518965192"
+	"941076532812198157097602515393958890091708875729884690890264"
+	"445578879319678658246106347784503046582047233249452129562648"
+	"384128384877764588276856253003633775313690413741899575978916"
+	"916349739224975170946152432752962621809062638671291648525438"
+	"4524613578042792963614754702610375"
+};
 
 /*
  * Test vectors for "ILBigNumMod".
@@ -1054,6 +1284,50 @@ static BigNumTestInfo bignum_pow_4 = {
 	ILBigNumPow,
 	"34", "1", 0, "34"
 };
+static BigNumTestInfo bignum_pow_5 = {		/* 1024-bit odd modulus */
+	ILBigNumPow,
+	"122258078469118681672395265737144101565558661979069521883568"
+	"689399632350210386008889355775747646461513784884352607468331"
+	"417384827639501790799528424841648602488208193040136747718352"
+	"634212073390287064391976552964849293226845183016834351470107"
+	"865256020651633533255022085212623720277082553595198831597688"
+	"357903945",
+	"924559035739738317443200911878512032725471613578341556581760"
+	"174796468427648027704744203420607774400711659430636099053467"
+	"684166443867115904040711446869470266802250470581154194983642"
+	"809089159193503458923648645238666834372780098657551828572520"
+	"543498817107148422471783004846032888594819730607582821338467"
+	"43508944",
+	"169820155008523930325037811052958924775087079157454873008527"
+	"356145768495824615438283226754031201044138525735853537276261"
+	"425091023593617218694319413823118709844308483162303000045307"
+	"699279655486730566280019644348728776586905700184828609468971"
+	"841264776609024246984856134262147504539031392219596682707557"
+	"434456503",
+	"158597113941849234406087092584256329078868590912484774195314"
+	"838171313590232620827876552230662433467793238559785239849944"
+	"780945699756936455073640674803792972722719021134071374534438"
+	"702560691794101353096046611299732559777184772681839795877635"
+	"464306079536033179067906117332119794156032584587101676592269"
+	"507356667"
+};
+static BigNumTestInfo bignum_pow_6 = {		/* base larger than modulus */
+	ILBigNumPow,
+	"432491616197497538019751664125491561235727826131603554852004"
+	"337461402847552188131265056398486460659089055860709391806663"
+	"641267899960186561799308105701141271903034400734010467429530",
+	"65537",
+	"105220535724901854274411429132772765338509934236201031522909"
+	"219327119629899858874961609354543412887950808603936379063791"
+	"56687565016085846867617170449765427",
+	"284311118431243774276917429129262168981370064992374202075223"
+	"594897859503681094442708483874303383160984223094113726390683"
+	"0281097149377608889941865953645127"
+};
+static BigNumTestInfo bignum_pow_7 = {		/* even modulus */
+	ILBigNumPow,
+	"34", "23", "68", "0"
+};
 
 /*
  * Test big number operations.
@@ -1154,6 +1428,7 @@ void ILUnitRegisterTests(void)
 	ILUnitRegisterSuite("SHA-1");
 	RegisterCrypt(test_sha1_hash, sha1_hash_1);
 	RegisterCrypt(test_sha1_hash, sha1_hash_2);
+	RegisterCrypt(test_sha1_hash, sha1_hash_3);
 
 	/*
 	 * Test the properties of the SHA-256 algorithm.
@@ -1161,6 +1436,8 @@ void ILUnitRegisterTests(void)
 	ILUnitRegisterSuite("SHA-256");
 	RegisterCrypt(test_sha256_hash, sha256_hash_1);
 	RegisterCrypt(test_sha256_hash, sha256_hash_2);
+	RegisterCrypt(test_sha256_hash, sha256_hash_3);
+	ILUnitRegister("sha256_batch", (ILUnitTestFunc)test_sha256_batch, 0);
 
 	/*
 	 * Test the properties of the SHA-384 algorithm.
@@ -1183,6 +1460,18 @@ void ILUnitRegisterTests(void)
 	RegisterCrypt(test_aes_block, aes_block_1);
 	RegisterCrypt(test_aes_block, aes_block_2);
 	RegisterCrypt(test_aes_block, aes_block_3);
+	ILUnitRegister("aes_modes_1", (ILUnitTestFunc)test_aes_modes,
+				   &aes_block_1);
+	ILUnitRegister("aes_modes_2", (ILUnitTestFunc)test_aes_modes,
+				   &aes_block_2);
+	ILUnitRegister("aes_modes_3", (ILUnitTestFunc)test_aes_modes,
+				   &aes_block_3);
+	ILUnitRegister("aes_modes_portable_1",
+				   (ILUnitTestFunc)test_aes_modes_portable, &aes_block_1);
+	ILUnitRegister("aes_modes_portable_2",
+				   (ILUnitTestFunc)test_aes_modes_portable, &aes_block_2);
+	ILUnitRegister("aes_modes_portable_3",
+				   (ILUnitTestFunc)test_aes_modes_portable, &aes_block_3);
 
 	/*
 	 * Test the properties of the DES algorithm.
@@ -1249,6 +1538,8 @@ void ILUnitRegisterTests(void)
 	RegisterCrypt(test_bignum_oper, bignum_mul_5);
 	RegisterCrypt(test_bignum_oper, bignum_mul_6);
 	RegisterCrypt(test_bignum_oper, bignum_mul_7);
+	RegisterCrypt(test_bignum_oper, bignum_mul_8);
+	RegisterCrypt(test_bignum_oper, bignum_mul_9);
 
 	RegisterCrypt(test_bignum_oper, bignum_mod_1);
 	RegisterCrypt(test_bignum_oper, bignum_mod_2);
@@ -1267,6 +1558,9 @@ void ILUnitRegisterTests(void)
 	RegisterCrypt(test_bignum_oper, bignum_pow_2);
 	RegisterCrypt(test_bignum_oper, bignum_pow_3);
 	RegisterCrypt(test_bignum_oper, bignum_pow_4);
+	RegisterCrypt(test_bignum_oper, bignum_pow_5);
+	RegisterCrypt(test_bignum_oper, bignum_pow_6);
+	RegisterCrypt(test_bignum_oper, bignum_pow_7);
 }
 
 void ILUnitCleanupTests(void)
@@ -119,13 +119,18 @@
 /* Type for key of thread specific data.  */
 typedef int __libc_key_t;
 
-/* Create key for thread specific data.  */
-#define __libc_key_create(KEY,DEST) -1
+/* Create key for thread specific data.  DEST is called with the
+   value of the key when a thread created by "pthread_create" exits.  */
+extern int __libc_key_create (__libc_key_t *__key,
+			      void (*__destr) (void *));
 
 /* Set thread-specific data associated with KEY to VAL.  */
-#define __libc_setspecific(KEY,VAL) -1
+extern int __libc_setspecific (__libc_key_t __key, const void *__val);
 
 /* Get thread-specific data associated with KEY.  */
-#define __libc_getspecific(KEY) 0
+extern void *__libc_getspecific (__libc_key_t __key);
+
+/* Run the destructors for the calling thread's data.  */
+extern void __libc_destroy_keys (void);
 
 #endif	/* bits/libc-lock.h */
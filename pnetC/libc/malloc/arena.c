@@ -0,0 +1,419 @@
+/*
+ * arena.c - Size-class allocator for the C heap.
+ *
+ * This file is part of the Portable.NET C library.
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <stdint.h>
+#include <pthread-support.h>
+#include <bits/libc-lock.h>
+#include "malloc-private.h"
+
+__using__ System::Runtime::InteropServices::Marshal;
+
+/*
+
+Small requests are rounded up to one of a fixed set of size classes:
+multiples of 16 bytes up to 256, and then four classes for every
+doubling up to __MALLOC_MAX_SMALL.  Each thread keeps a free list per
+class, so that most calls to "malloc" and "free" are plain pointer
+operations that never leave the C code.
+
+When a thread's list is empty, it takes a batch of blocks from the
+shared lists, or carves new blocks out of the current chunk.  When a
+thread's list grows too long, it gives a batch back.  Only these batch
+operations take the lock, and only a new chunk calls into the engine.
+
+Memory in the chunks is never returned to the engine.  When a thread
+that was created by "pthread_create" exits, a thread-specific key's
+destructor gives all of the blocks in its lists back to the shared
+lists.  Blocks cached by other threads stay in their lists when they
+exit.
+
+*/
+
+/*
+ * Number of size classes, and the classes for the first doubling
+ * past the fixed step of 16 bytes.
+ */
+#define	NUM_CLASSES		32
+#define	STEP_CLASSES	16
+#define	STEP_LIMIT		256
+
+/*
+ * Size of the chunks that blocks are carved from.
+ */
+#define	CHUNK_SIZE		(64 * 1024)
+
+/*
+ * Number of bytes moved between a thread and the shared lists at once,
+ * and the limit on the number of blocks in a batch.
+ */
+#define	BATCH_BYTES		8192
+#define	BATCH_LIMIT		64
+
+/*
+ * A free block, linked through its usable area.
+ */
+typedef struct block
+{
+  struct block *next;
+
+} block_t;
+
+/*
+ * A list of free blocks in a single size class.
+ */
+typedef struct
+{
+  block_t *head;
+  unsigned int count;
+
+} bin_t;
+
+/*
+ * The free lists that belong to a thread.
+ */
+typedef struct
+{
+  bin_t bins[NUM_CLASSES];
+  int registered;
+
+} cache_t;
+
+static __declspec(thread) cache_t cache;
+
+/*
+ * The key whose destructor empties a thread's lists when it exits.
+ * "key_state" is 1 once the key is created, or -1 if that failed.
+ */
+static __libc_key_t key;
+static int key_state;
+
+/*
+ * The shared free lists, and the unused part of the current chunk.
+ */
+static __libc_monitor_t arena_lock = __LIBC_MONITOR_INITIALIZER;
+static bin_t shared[NUM_CLASSES];
+static char *chunk_posn;
+static char *chunk_end;
+
+/*
+ * Get the usable size of the blocks in a size class.
+ */
+static size_t
+class_size(int cls)
+{
+  int shift;
+  if(cls < STEP_CLASSES)
+    {
+      return ((size_t)(cls + 1)) << 4;
+    }
+  shift = (cls - STEP_CLASSES) / 4;
+  return ((size_t)(STEP_LIMIT + ((cls - STEP_CLASSES) % 4 + 1) *
+		   (STEP_LIMIT / 4))) << shift;
+}
+
+/*
+ * Get the size class for a request, which must be between
+ * 1 and __MALLOC_MAX_SMALL.
+ */
+static int
+size_to_class(size_t size)
+{
+  size_t limit;
+  int cls;
+  if(size <= STEP_LIMIT)
+    {
+      return (int)((size - 1) >> 4);
+    }
+
+  /* Find the doubling that contains the request, and then
+     the quarter of it */
+  cls = STEP_CLASSES;
+  limit = STEP_LIMIT;
+  while(size > (limit << 1))
+    {
+      limit <<= 1;
+      cls += 4;
+    }
+  return cls + (int)((size - limit - 1) / (limit >> 2));
+}
+
+/*
+ * Get the number of blocks to move between a thread and the shared
+ * lists at once for a size class.
+ */
+static unsigned int
+batch_count(int cls)
+{
+  unsigned int count = (unsigned int)
+    (BATCH_BYTES / (class_size(cls) + sizeof(__malloc_header_t)));
+  if(count < 1)
+    {
+      return 1;
+    }
+  else if(count > BATCH_LIMIT)
+    {
+      return BATCH_LIMIT;
+    }
+  return count;
+}
+
+/*
+ * Refill a thread's list for a size class, returning zero
+ * if out of memory.  Must be called with the lock held.
+ */
+static int
+refill(bin_t *bin, int cls)
+{
+  unsigned int want = batch_count(cls);
+  bin_t *from = &(shared[cls]);
+  size_t stride;
+  __malloc_header_t *header;
+  block_t *blk;
+
+  /* Take blocks that were given back by other threads first */
+  while(bin->count < want && from->head != 0)
+    {
+      blk = from->head;
+      from->head = blk->next;
+      --(from->count);
+      blk->next = bin->head;
+      bin->head = blk;
+      ++(bin->count);
+    }
+
+  /* Carve the rest out of the current chunk */
+  stride = class_size(cls) + sizeof(__malloc_header_t);
+  while(bin->count < want)
+    {
+      if((size_t)(chunk_end - chunk_posn) < stride)
+        {
+	  /* Abandon the tail of the chunk and get a new one */
+	  if(bin->count != 0)
+	    {
+	      break;
+	    }
+	  chunk_posn = (char *)Marshal::AllocHGlobal((long)CHUNK_SIZE);
+	  if(chunk_posn == 0)
+	    {
+	      chunk_end = 0;
+	      return 0;
+	    }
+	  chunk_end = chunk_posn + CHUNK_SIZE;
+	}
+      header = (__malloc_header_t *)chunk_posn;
+      header->size = class_size(cls);
+      chunk_posn += stride;
+      blk = (block_t *)(header + 1);
+      blk->next = bin->head;
+      bin->head = blk;
+      ++(bin->count);
+    }
+  return 1;
+}
+
+/*
+ * Give a batch of blocks from a thread's list back to the
+ * shared list for a size class.
+ */
+static void
+drain(bin_t *bin, int cls)
+{
+  unsigned int count = batch_count(cls);
+  bin_t *to = &(shared[cls]);
+  block_t *first = bin->head;
+  block_t *last = first;
+  unsigned int posn;
+
+  /* Find the end of the batch before taking the lock */
+  for(posn = 1; posn < count; ++posn)
+    {
+      last = last->next;
+    }
+  bin->head = last->next;
+  bin->count -= count;
+
+  __libc_monitor_lock(&arena_lock);
+  last->next = to->head;
+  to->head = first;
+  to->count += count;
+  __libc_monitor_unlock(&arena_lock);
+}
+
+/*
+ * Give all of the blocks in a thread's lists back to the shared
+ * lists.  This is the destructor for the thread-specific key.
+ */
+static void
+release_cache(void *arg)
+{
+  cache_t *c = (cache_t *)arg;
+  bin_t *bin;
+  block_t *last;
+  int cls;
+
+  __libc_monitor_lock(&arena_lock);
+  for(cls = 0; cls < NUM_CLASSES; ++cls)
+    {
+      bin = &(c->bins[cls]);
+      if(bin->head == 0)
+        {
+	  continue;
+	}
+      last = bin->head;
+      while(last->next != 0)
+        {
+	  last = last->next;
+	}
+      last->next = shared[cls].head;
+      shared[cls].head = bin->head;
+      shared[cls].count += bin->count;
+      bin->head = 0;
+      bin->count = 0;
+    }
+  __libc_monitor_unlock(&arena_lock);
+  c->registered = 0;
+}
+
+/*
+ * Arrange for the thread's lists to be emptied when it exits.
+ * This is called again if a block is freed after the destructor
+ * has run, so that the destructor runs once more.
+ */
+static void
+register_cache(void)
+{
+  __libc_monitor_lock(&arena_lock);
+  if(key_state == 0)
+    {
+      key_state = (__libc_key_create(&key, release_cache) == 0 ? 1 : -1);
+    }
+  __libc_monitor_unlock(&arena_lock);
+  if(key_state > 0)
+    {
+      __libc_setspecific(key, &cache);
+    }
+  cache.registered = 1;
+}
+
+void *
+__malloc_alloc(size_t size)
+{
+  __malloc_header_t *header;
+  bin_t *bin;
+  block_t *blk;
+  int cls;
+  int ok;
+
+  /* Send large requests straight to the runtime engine */
+  if(size > __MALLOC_MAX_SMALL)
+    {
+      size = (size + sizeof(__malloc_header_t) - 1) &
+	     ~(sizeof(__malloc_header_t) - 1);
+      if(size > (size_t)INT32_MAX - sizeof(__malloc_header_t))
+        {
+	  return 0;
+	}
+      header = (__malloc_header_t *)Marshal::AllocHGlobal
+	(((long)size) + (long)sizeof(__malloc_header_t));
+      if(header == 0)
+        {
+	  return 0;
+	}
+      header->size = size | __MALLOC_LARGE;
+      return (void *)(header + 1);
+    }
+
+  /* Take a block from the thread's list, refilling it if empty */
+  cls = size_to_class(size);
+  bin = &(cache.bins[cls]);
+  if(bin->head == 0)
+    {
+      if(!cache.registered)
+        {
+	  register_cache();
+	}
+      __libc_monitor_lock(&arena_lock);
+      ok = refill(bin, cls);
+      __libc_monitor_unlock(&arena_lock);
+      if(!ok)
+        {
+	  return 0;
+	}
+    }
+  blk = bin->head;
+  bin->head = blk->next;
+  --(bin->count);
+  return (void *)blk;
+}
+
+void
+__malloc_release(void *ptr)
+{
+  __malloc_header_t *header = __MALLOC_HEADER(ptr);
+  block_t *blk;
+  bin_t *bin;
+  int cls;
+
+  /* Large blocks go straight back to the runtime engine */
+  if((header->size & __MALLOC_LARGE) != 0)
+    {
+      Marshal::FreeHGlobal((long)header);
+      return;
+    }
+
+  /* Put the block on the thread's list, and give a batch back
+     if the list has grown too long */
+  if(!cache.registered)
+    {
+      register_cache();
+    }
+  cls = size_to_class(header->size);
+  bin = &(cache.bins[cls]);
+  blk = (block_t *)ptr;
+  blk->next = bin->head;
+  bin->head = blk;
+  ++(bin->count);
+  if(bin->count >= 2 * batch_count(cls))
+    {
+      drain(bin, cls);
+    }
+}
+
+void *
+__malloc_resize_large(void *ptr, size_t size)
+{
+  __malloc_header_t *header;
+  size = (size + sizeof(__malloc_header_t) - 1) &
+	 ~(sizeof(__malloc_header_t) - 1);
+  if(size > (size_t)INT32_MAX - sizeof(__malloc_header_t))
+    {
+      return 0;
+    }
+  header = (__malloc_header_t *)Marshal::ReAllocHGlobal
+    ((long)__MALLOC_HEADER(ptr),
+     ((long)size) + (long)sizeof(__malloc_header_t));
+  if(header == 0)
+    {
+      return 0;
+    }
+  header->size = size | __MALLOC_LARGE;
+  return (void *)(header + 1);
+}
@@ -22,8 +22,8 @@
 #include <malloc.h>
 #include <stdint.h>
 #include <errno.h>
-
-__using__ System::Runtime::InteropServices::Marshal;
+#include <string.h>
+#include "malloc-private.h"
 
 void *
 __calloc(size_t nmemb, size_t size)
@@ -33,20 +33,21 @@ __calloc(size_t nmemb, size_t size)
 
   /* Validate the parameters */
   full_size = ((unsigned long long)nmemb) * ((unsigned long long)size);
-  if(size == 0)
+  if(full_size == 0)
     {
-      size = 1;
+      full_size = 1;
     }
-  else if(size > (unsigned long long)(long long)INT32_MAX)
+  else if(full_size > (unsigned long long)(long long)INT32_MAX)
     {
       errno = ENOMEM;
       return 0;
     }
 
-  /* Allocate memory from the runtime engine */
-  ptr = (void *)Marshal::AllocHGlobal((long)full_size);
+  /* Allocate memory from the heap, which may have been used before */
+  ptr = __malloc_alloc((size_t)full_size);
   if(ptr != 0)
     {
+      memset(ptr, 0, (size_t)full_size);
       return ptr;
     }
   errno = ENOMEM;
@@ -20,14 +20,13 @@
  */
 
 #include <malloc.h>
-
-__using__ System::Runtime::InteropServices::Marshal;
+#include "malloc-private.h"
 
 void
 __free(void *ptr)
 {
   if(ptr != 0)
-    Marshal::FreeHGlobal((long)ptr);
+    __malloc_release(ptr);
 }
 
 weak_alias(__free, free)
@@ -0,0 +1,83 @@
+/*
+ * malloc-private.h - Internal definitions for the C heap allocator.
+ *
+ * This file is part of the Portable.NET C library.
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MALLOC_PRIVATE_H
+#define _MALLOC_PRIVATE_H
+
+#include <stddef.h>
+
+/*
+ * Every block is preceded by a header that holds its usable size.
+ * The union keeps the user's part of the block suitably aligned
+ * for any scalar type.
+ */
+typedef union
+{
+  size_t size;
+  long long align_ll;
+  double align_d;
+  void *align_p;
+
+} __malloc_header_t;
+
+#define __MALLOC_HEADER(ptr)	(((__malloc_header_t *)(ptr)) - 1)
+
+/*
+ * Blocks that are too big for a size class come straight from the
+ * runtime engine, and are marked with the low bit of their size.
+ */
+#define __MALLOC_LARGE		((size_t)1)
+
+/*
+ * Allocate a block of at least "size" bytes, which must be non-zero
+ * and no more than INT32_MAX.  Returns NULL if out of memory.
+ */
+extern void *__malloc_alloc (size_t size);
+
+/*
+ * Return a block to the heap.  "ptr" must not be NULL.
+ */
+extern void __malloc_release (void *ptr);
+
+/*
+ * Get the number of usable bytes in a block.
+ */
+#define __malloc_usable_size(ptr)	\
+  (__MALLOC_HEADER(ptr)->size & ~__MALLOC_LARGE)
+
+/*
+ * Determine if a block came straight from the runtime engine.
+ */
+#define __malloc_is_large(ptr)	\
+  ((__MALLOC_HEADER(ptr)->size & __MALLOC_LARGE) != 0)
+
+/*
+ * Resize a large block in place or by moving it, returning NULL
+ * if out of memory.  "size" must be too big for a size class.
+ */
+extern void *__malloc_resize_large (void *ptr, size_t size);
+
+/*
+ * The largest request that is served from a size class.
+ */
+#define __MALLOC_MAX_SMALL	4096
+
+#endif  /* !_MALLOC_PRIVATE_H */
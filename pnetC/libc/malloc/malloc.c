@@ -22,8 +22,7 @@
 #include <malloc.h>
 #include <stdint.h>
 #include <errno.h>
-
-__using__ System::Runtime::InteropServices::Marshal;
+#include "malloc-private.h"
 
 void *
 __malloc(size_t size)
@@ -41,8 +40,8 @@ __malloc(size_t size)
       return 0;
     }
 
-  /* Allocate memory from the runtime engine */
-  ptr = (void *)Marshal::AllocHGlobal((long)size);
+  /* Allocate memory from the heap */
+  ptr = __malloc_alloc(size);
   if(ptr != 0)
     {
       return ptr;
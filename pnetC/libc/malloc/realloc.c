@@ -22,12 +22,15 @@
 #include <malloc.h>
 #include <stdint.h>
 #include <errno.h>
-
-__using__ System::Runtime::InteropServices::Marshal;
+#include <string.h>
+#include "malloc-private.h"
 
 void *
 __realloc(void *ptr, size_t size)
 {
+  void *newptr;
+  size_t usable;
+
   /* Validate the parameters and determine the kind of realloc to perform */
   if(ptr == 0)
     {
@@ -41,12 +44,12 @@ __realloc(void *ptr, size_t size)
           errno = ENOMEM;
           return 0;
         }
-      ptr = (void *)Marshal::AllocHGlobal((long)size);
+      ptr = __malloc_alloc(size);
     }
   else if(size == 0)
     {
       /* Perform a "free" operation */
-      (void)Marshal::FreeHGlobal((long)ptr);
+      __malloc_release(ptr);
       return 0;
     }
   else if(size > (size_t)INT32_MAX)
@@ -56,7 +59,29 @@ __realloc(void *ptr, size_t size)
     }
   else
     {
-      ptr = (void *)Marshal::ReAllocHGlobal((long)ptr, (long)size);
+      /* Keep the block if it is already big enough and not too wasteful */
+      usable = __malloc_usable_size(ptr);
+      if(size <= usable && size > usable / 2)
+        {
+          return ptr;
+        }
+
+      if(size > __MALLOC_MAX_SMALL && __malloc_is_large(ptr))
+        {
+          /* Let the runtime engine resize the block in place if it can */
+          ptr = __malloc_resize_large(ptr, size);
+        }
+      else
+        {
+          /* Move the contents to a block of the new size */
+          newptr = __malloc_alloc(size);
+          if(newptr != 0)
+            {
+              memcpy(newptr, ptr, (size < usable ? size : usable));
+              __malloc_release(ptr);
+            }
+          ptr = newptr;
+        }
     }
   if(ptr != 0)
     {
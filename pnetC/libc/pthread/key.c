@@ -0,0 +1,111 @@
+/*
+ * key.c - Thread-specific data for use inside the C library.
+ *
+ * This file is part of the Portable.NET C library.
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <pthread-support.h>
+#include <bits/libc-lock.h>
+
+/*
+ * Keys come from a fixed table rather than the heap, because
+ * "malloc" uses a key to clean up after exiting threads.
+ */
+#define	MAX_KEYS		32
+
+/*
+ * Number of times to run the destructors, in case a destructor
+ * sets a value for a key whose destructor has already run.
+ */
+#define	DESTRUCTOR_ITERATIONS	4
+
+static __libc_monitor_t key_lock = __LIBC_MONITOR_INITIALIZER;
+static int num_keys;
+static void (*destructors[MAX_KEYS]) (void *);
+static __declspec(thread) void *values[MAX_KEYS];
+
+int
+__libc_key_create (__libc_key_t *key, void (*destr) (void *))
+{
+  int result = -1;
+  __libc_monitor_lock (&key_lock);
+  if (num_keys < MAX_KEYS)
+    {
+      destructors[num_keys] = destr;
+      *key = num_keys++;
+      result = 0;
+    }
+  __libc_monitor_unlock (&key_lock);
+  return result;
+}
+
+int
+__libc_setspecific (__libc_key_t key, const void *value)
+{
+  if (key < 0 || key >= MAX_KEYS)
+    {
+      return -1;
+    }
+  values[key] = (void *)value;
+  return 0;
+}
+
+void *
+__libc_getspecific (__libc_key_t key)
+{
+  if (key < 0 || key >= MAX_KEYS)
+    {
+      return 0;
+    }
+  return values[key];
+}
+
+void
+__libc_destroy_keys (void)
+{
+  int iteration, key, limit, found;
+  void (*destr) (void *);
+  void *value;
+
+  __libc_monitor_lock (&key_lock);
+  limit = num_keys;
+  __libc_monitor_unlock (&key_lock);
+
+  for (iteration = 0; iteration < DESTRUCTOR_ITERATIONS; ++iteration)
+    {
+      found = 0;
+      for (key = 0; key < limit; ++key)
+        {
+	  value = values[key];
+	  if (value != 0)
+	    {
+	      values[key] = 0;
+	      destr = destructors[key];
+	      if (destr)
+	        {
+		  (*destr) (value);
+		}
+	      found = 1;
+	    }
+	}
+      if (!found)
+        {
+	  break;
+	}
+    }
+}
@@ -21,6 +21,8 @@
 
 #include <stdlib.h>
 
+__using__ System::Runtime::InteropServices::Marshal;
+
 char *__syscall_getenv(const char *name);
 
 /* TODO: make returned pointers valid after subsequent calls to getenv */
@@ -29,7 +31,8 @@ char *__global_envval = NULL;
 char *
 getenv (const char *name)
 {
-  if (__global_envval) free (__global_envval);
+  /* The value comes from the runtime engine's heap, not "malloc" */
+  if (__global_envval) Marshal::FreeHGlobal ((long)__global_envval);
   __global_envval = __syscall_getenv (name);
   return __global_envval;
 }
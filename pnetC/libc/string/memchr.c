@@ -24,13 +24,16 @@
 void *
 memchr (const void *s, int c, size_t n)
 {
+  /* Use "unsigned char" to make the implementation 8-bit clean */
+  const unsigned char *p = (const unsigned char *)s;
+  unsigned char ch = (unsigned char)c;
   while (n > 0)
     {
-      if (*((char *)s) == c)
+      if (*p == ch)
         {
-          return (void *)s;
+          return (void *)p;
         }
-      ++s;
+      ++p;
       --n;
     }
   return NULL;
@@ -24,16 +24,20 @@
 char *
 strchr (const char * __restrict s, int c)
 {
-  int sc;
-  while ((sc = *s) != '\0')
+  /* The terminator is part of the string, so "c" may find it */
+  char ch = (char)c;
+  for (;;)
     {
-      if (sc == c)
+      if (*s == ch)
         {
           return (char *)s;
         }
+      if (*s == '\0')
+        {
+          return NULL;
+        }
       ++s;
     }
-  return NULL;
 }
 
 strong_alias(strchr, index)
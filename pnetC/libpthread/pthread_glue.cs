@@ -72,6 +72,7 @@ internal unsafe class ThreadStartup
 				finally
 				{
 					__module.__pt_destroy_keys();
+					__module.__libc_destroy_keys();
 					exited = true;
 					if(detached)
 					{
@@ -186,6 +187,7 @@ __module
 	extern public static void __libc_thread_unregister(long id);
 	extern public static Thread __libc_thread_object(long id);
 	extern public static Object __libc_thread_state(long id);
+	extern public static void __libc_destroy_keys();
 
 	// Get the location of the "errno" variable from "libc".
 	extern public static unsafe int *__errno_location();
@@ -0,0 +1,294 @@
+/*
+ * test_malloc.c - Test the C heap allocator.
+ *
+ * This file is part of the Portable.NET C library.
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * Sizes to try, which cover every small size class, the edges of
+ * the classes, and the large blocks that come from the engine.
+ */
+static size_t const sizes[] = {
+  1, 2, 7, 8, 15, 16, 17, 31, 32, 33, 100, 128, 200, 255, 256, 257,
+  300, 320, 321, 383, 384, 385, 448, 512, 513, 640, 1000, 1024, 1025,
+  1536, 2047, 2048, 2049, 3000, 3584, 4095, 4096, 4097, 5000, 8192,
+  65536, 100000
+};
+#define	NUM_SIZES	(sizeof(sizes) / sizeof(sizes[0]))
+
+#define	NUM_THREADS		8
+#define	NUM_ROUNDS		4
+
+static int errors;
+
+static void
+error (const char *msg, size_t size)
+{
+  printf ("%s (size %lu)\n", msg, (unsigned long)size);
+  ++errors;
+}
+
+/*
+ * Fill a block with a pattern that depends upon its size and seed.
+ */
+static void
+fill (unsigned char *ptr, size_t size, int seed)
+{
+  size_t posn;
+  for (posn = 0; posn < size; ++posn)
+    {
+      ptr[posn] = (unsigned char)(posn * 7 + size + seed);
+    }
+}
+
+/*
+ * Check the pattern that was written by "fill".
+ */
+static int
+check (unsigned char *ptr, size_t size, int seed)
+{
+  size_t posn;
+  for (posn = 0; posn < size; ++posn)
+    {
+      if (ptr[posn] != (unsigned char)(posn * 7 + size + seed))
+	{
+	  return 0;
+	}
+    }
+  return 1;
+}
+
+/*
+ * Allocate a block of every size at once, so that the blocks would
+ * overwrite each other if the size classes overlapped.
+ */
+static void
+test_malloc (int seed)
+{
+  unsigned char *blocks[NUM_SIZES];
+  size_t index;
+
+  for (index = 0; index < NUM_SIZES; ++index)
+    {
+      blocks[index] = (unsigned char *)malloc (sizes[index]);
+      if (!blocks[index])
+	{
+	  error ("malloc failed", sizes[index]);
+	  continue;
+	}
+      if (((unsigned long)(blocks[index]) % sizeof(double)) != 0)
+	{
+	  error ("malloc returned a misaligned block", sizes[index]);
+	}
+      fill (blocks[index], sizes[index], seed);
+    }
+  for (index = 0; index < NUM_SIZES; ++index)
+    {
+      if (blocks[index])
+	{
+	  if (!check (blocks[index], sizes[index], seed))
+	    {
+	      error ("malloc block was overwritten", sizes[index]);
+	    }
+	  free (blocks[index]);
+	}
+    }
+  free (0);
+}
+
+/*
+ * Check that "calloc" clears blocks that were used before.
+ */
+static void
+test_calloc (void)
+{
+  unsigned char *ptr;
+  size_t index, posn;
+
+  for (index = 0; index < NUM_SIZES; ++index)
+    {
+      ptr = (unsigned char *)malloc (sizes[index]);
+      if (ptr)
+	{
+	  memset (ptr, 0xFF, sizes[index]);
+	  free (ptr);
+	}
+      ptr = (unsigned char *)calloc (1, sizes[index]);
+      if (!ptr)
+	{
+	  error ("calloc failed", sizes[index]);
+	  continue;
+	}
+      for (posn = 0; posn < sizes[index]; ++posn)
+	{
+	  if (ptr[posn] != 0)
+	    {
+	      error ("calloc block was not cleared", sizes[index]);
+	      break;
+	    }
+	}
+      free (ptr);
+    }
+  ptr = (unsigned char *)calloc (4, 250);
+  if (!ptr)
+    {
+      error ("calloc failed", 1000);
+    }
+  free (ptr);
+  if (calloc ((size_t)-1, 16) != 0)
+    {
+      error ("calloc did not detect an overflow", 16);
+    }
+}
+
+/*
+ * Grow and shrink blocks between every pair of sizes, checking
+ * that the contents are kept.
+ */
+static void
+test_realloc (void)
+{
+  unsigned char *ptr;
+  unsigned char *newptr;
+  size_t from, to, keep;
+
+  for (from = 0; from < NUM_SIZES; ++from)
+    {
+      for (to = 0; to < NUM_SIZES; ++to)
+	{
+	  ptr = (unsigned char *)realloc (0, sizes[from]);
+	  if (!ptr)
+	    {
+	      error ("realloc of NULL failed", sizes[from]);
+	      continue;
+	    }
+	  fill (ptr, sizes[from], 3);
+	  newptr = (unsigned char *)realloc (ptr, sizes[to]);
+	  if (!newptr)
+	    {
+	      error ("realloc failed", sizes[to]);
+	      free (ptr);
+	      continue;
+	    }
+	  keep = (sizes[from] < sizes[to] ? sizes[from] : sizes[to]);
+	  if (!check (newptr, keep, 3 + (int)(sizes[from] - keep)))
+	    {
+	      error ("realloc lost the contents", sizes[to]);
+	    }
+	  fill (newptr, sizes[to], 5);
+	  if (!check (newptr, sizes[to], 5))
+	    {
+	      error ("realloc block is too small", sizes[to]);
+	    }
+	  free (newptr);
+	}
+    }
+}
+
+/*
+ * Blocks that are passed between threads, so that they are freed
+ * by a different thread to the one that allocated them.
+ */
+static unsigned char *passed[NUM_THREADS][NUM_SIZES];
+
+static void *
+allocate_thread (void *arg)
+{
+  int id = (int)(long)arg;
+  size_t index;
+
+  test_malloc (id);
+  for (index = 0; index < NUM_SIZES; ++index)
+    {
+      passed[id][index] = (unsigned char *)malloc (sizes[index]);
+      if (passed[id][index])
+	{
+	  fill (passed[id][index], sizes[index], id);
+	}
+    }
+  return 0;
+}
+
+static void *
+release_thread (void *arg)
+{
+  int id = (int)(long)arg;
+  int other = (id + 1) % NUM_THREADS;
+  size_t index;
+
+  for (index = 0; index < NUM_SIZES; ++index)
+    {
+      if (passed[other][index])
+	{
+	  if (!check (passed[other][index], sizes[index], other))
+	    {
+	      error ("block was overwritten by another thread", sizes[index]);
+	    }
+	  free (passed[other][index]);
+	}
+    }
+  test_malloc (id);
+  return 0;
+}
+
+/*
+ * Run several rounds of threads that allocate blocks, exit, and
+ * then have their blocks freed by other threads that also exit.
+ */
+static void
+test_threads (void)
+{
+  pthread_t threads[NUM_THREADS];
+  int round, id;
+
+  for (round = 0; round < NUM_ROUNDS; ++round)
+    {
+      for (id = 0; id < NUM_THREADS; ++id)
+	{
+	  pthread_create (&threads[id], 0, allocate_thread, (void *)(long)id);
+	}
+      for (id = 0; id < NUM_THREADS; ++id)
+	{
+	  pthread_join (threads[id], 0);
+	}
+      for (id = 0; id < NUM_THREADS; ++id)
+	{
+	  pthread_create (&threads[id], 0, release_thread, (void *)(long)id);
+	}
+      for (id = 0; id < NUM_THREADS; ++id)
+	{
+	  pthread_join (threads[id], 0);
+	}
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  test_malloc (0);
+  test_calloc ();
+  test_realloc ();
+  test_threads ();
+  test_malloc (1);
+  return (errors != 0);
+}
@@ -0,0 +1,149 @@
+/*
+ * test_string.c - Test the string and memory functions.
+ *
+ * This file is part of the Portable.NET C library.
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Direct calls to "strchr", "memchr" and "memcmp" are inlined by the
+ * runtime engine.  Calls through these pointers run the library code.
+ */
+static char *(*call_strchr) (const char *, int) = strchr;
+static void *(*call_memchr) (const void *, int, size_t) = memchr;
+static int (*call_memcmp) (const void *, const void *, size_t) = memcmp;
+
+static int errors;
+
+static void
+error (const char *msg, const char *path)
+{
+  printf ("%s (%s)\n", msg, path);
+  ++errors;
+}
+
+static const char str[] = "hello";
+static const unsigned char bytes[] = {0x01, 0x7F, 0x80, 0xC3, 0xFF, 0x00};
+
+/*
+ * A null pointer that is passed with a zero length.  It is a variable
+ * so that it reaches the engine as a pointer and not as an integer.
+ */
+static const unsigned char *none = 0;
+
+/*
+ * Check the results of the functions, however they were called.
+ */
+static void
+check_strchr (char *result_h, char *result_end, char *result_none,
+	      const char *path)
+{
+  if (result_h != str)
+    {
+      error ("strchr did not find the first character", path);
+    }
+  if (result_end != str + 5)
+    {
+      error ("strchr did not find the terminator", path);
+    }
+  if (result_none != 0)
+    {
+      error ("strchr found a missing character", path);
+    }
+}
+
+static void
+check_memchr (void *result_80, void *result_neg, void *result_ff,
+	      void *result_short, void *result_empty, const char *path)
+{
+  if (result_80 != bytes + 2)
+    {
+      error ("memchr did not find 0x80", path);
+    }
+  if (result_neg != bytes + 3)
+    {
+      error ("memchr did not find a negative char", path);
+    }
+  if (result_ff != bytes + 4)
+    {
+      error ("memchr did not find 0xFF", path);
+    }
+  if (result_short != 0)
+    {
+      error ("memchr searched past the length", path);
+    }
+  if (result_empty != 0)
+    {
+      error ("memchr with zero length was not null", path);
+    }
+}
+
+static void
+check_memcmp (int result_high, int result_low, int result_equal,
+	      int result_empty, const char *path)
+{
+  if (result_high <= 0)
+    {
+      error ("memcmp did not compare 0x80 as unsigned", path);
+    }
+  if (result_low >= 0)
+    {
+      error ("memcmp did not compare 0xFF as unsigned", path);
+    }
+  if (result_equal != 0)
+    {
+      error ("memcmp did not find equal blocks", path);
+    }
+  if (result_empty != 0)
+    {
+      error ("memcmp with zero length was not zero", path);
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  check_strchr (strchr (str, 'h'), strchr (str, 0), strchr (str, 'z'),
+		"inline");
+  check_strchr (call_strchr (str, 'h'), call_strchr (str, 0),
+		call_strchr (str, 'z'), "library");
+
+  check_memchr (memchr (bytes, 0x80, sizeof (bytes)),
+		memchr (bytes, (char)0xC3, sizeof (bytes)),
+		memchr (bytes, 0xFF, sizeof (bytes)),
+		memchr (bytes, 0x80, 2),
+		memchr (none, 0x80, 0), "inline");
+  check_memchr (call_memchr (bytes, 0x80, sizeof (bytes)),
+		call_memchr (bytes, (char)0xC3, sizeof (bytes)),
+		call_memchr (bytes, 0xFF, sizeof (bytes)),
+		call_memchr (bytes, 0x80, 2),
+		call_memchr (none, 0x80, 0), "library");
+
+  check_memcmp (memcmp (bytes + 2, bytes, 1),
+		memcmp (bytes + 1, bytes + 4, 1),
+		memcmp (bytes, bytes, sizeof (bytes)),
+		memcmp (none, none, 0), "inline");
+  check_memcmp (call_memcmp (bytes + 2, bytes, 1),
+		call_memcmp (bytes + 1, bytes + 4, 1),
+		call_memcmp (bytes, bytes, sizeof (bytes)),
+		call_memcmp (none, none, 0), "library");
+
+  return (errors != 0);
+}
@@ -25,6 +25,7 @@ namespace System.Xml.Private
 using System;
 using System.IO;
 using System.Text;
+using System.Runtime.CompilerServices;
 
 internal class XmlParserInput : XmlParserInputBase
 {
@@ -149,6 +150,74 @@ internal class XmlParserInput : XmlParserInputBase
 				return true;
 			}
 
+	// Move to the next character, and then past any characters that
+	// follow it up to one of `stops', returning false on EOF.
+	public override bool NextChars(char[] stops)
+			{
+				if(!NextChar()) { return false; }
+				if(bufferPos < bufferLen)
+				{
+					// consume the rest of the run that is already buffered
+					int end = ScanChars(buffer, bufferPos, bufferLen, stops);
+					int len = end - bufferPos;
+					if(len > 0)
+					{
+						logger.Append(buffer, bufferPos, len);
+						linePosition += len;
+						bufferPos = end;
+						currChar = buffer[end - 1];
+					}
+				}
+				return true;
+			}
+
+	// Read a name, calling Error if there are no valid characters.
+	public override String ReadName()
+			{
+				if(bufferPos < bufferLen &&
+				   XmlCharInfo.IsNameInit(buffer[bufferPos]))
+				{
+					String name = ReadBufferedName();
+					if(name != null) { return name; }
+				}
+				return base.ReadName();
+			}
+
+	// Read a name token, calling Error if there are no valid characters.
+	public override String ReadNameToken()
+			{
+				if(bufferPos < bufferLen)
+				{
+					String name = ReadBufferedName();
+					if(name != null) { return name; }
+				}
+				return base.ReadNameToken();
+			}
+
+	// Read an ascii name that ends within the buffer, returning null
+	// if the name isn't entirely ascii or may continue past the end
+	// of the buffer.  The name is atomized directly from the buffer,
+	// so no string is created if it is already in the name table.
+	private String ReadBufferedName()
+			{
+				int end = ScanName(buffer, bufferPos, bufferLen);
+				int len = end - bufferPos;
+				if(len == 0 || end == bufferLen ||
+				   XmlCharInfo.IsNameChar(buffer[end]))
+				{
+					return null;
+				}
+				String name = nameTable.Add(buffer, bufferPos, len);
+				logger.Append(name);
+				linePosition += len;
+				bufferPos = end;
+				currChar = buffer[end - 1];
+
+				// leave the terminator in peekChar, as the slow path does
+				PeekChar();
+				return name;
+			}
+
 	// This is a hack for the double look-ahead in the subset reader.
 	internal bool ExtraPeekChar()
 			{
@@ -178,6 +247,17 @@ internal class XmlParserInput : XmlParserInputBase
 				return true;
 			}
 
+	// Get the index of the first character in the buffer range that
+	// is in `stops', or `end' if there is none.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static int ScanChars
+				(char[] buffer, int start, int end, char[] stops);
+
+	// Get the index of the first character in the buffer range that
+	// isn't an ascii name character, or `end' if there is none.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static int ScanName(char[] buffer, int start, int end);
+
 }; // class XmlParserInput
 
 }; // namespace System.Xml.Private
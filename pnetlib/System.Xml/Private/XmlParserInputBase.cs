@@ -29,7 +29,7 @@ internal abstract class XmlParserInputBase : XmlErrorProcessor
 {
 	// Internal state.
 	private EOFHandler eofHandler;
-	private XmlNameTable nameTable;
+	protected XmlNameTable nameTable;
 	protected LogManager logger;
 
 
@@ -105,6 +105,14 @@ internal abstract class XmlParserInputBase : XmlErrorProcessor
 	// Peek at the next character, returning false on EOF.
 	public abstract bool PeekChar();
 
+	// Move to the next character, and then past any characters that
+	// follow it up to one of `stops', returning false on EOF.  The
+	// stop characters must include '\r' and '\n'.
+	public virtual bool NextChars(char[] stops)
+			{
+				return NextChar();
+			}
+
 	// Read a name, calling Error if there are no valid characters.
 	public virtual String ReadName()
 			{
@@ -222,6 +230,13 @@ internal abstract class XmlParserInputBase : XmlErrorProcessor
 						logs[i].Append(s);
 					}
 				}
+		public void Append(char[] value, int startIndex, int count)
+				{
+					for(int i = 0; i <= top; ++i)
+					{
+						logs[i].Append(value, startIndex, count);
+					}
+				}
 
 		// Clear the log stack.
 		public void Clear()
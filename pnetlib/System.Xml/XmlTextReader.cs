@@ -60,6 +60,15 @@ public class XmlTextReader : XmlReader
 	private readonly Object xmlNSPrefix;
 	private readonly Object xmlCompareQuick;
 
+	// Characters that end a run of plain character data.  The first
+	// entry of the attribute value sets is replaced by the quote char.
+	private static readonly char[] textStops =
+				{'<', '&', '\r', '\n'};
+	private static readonly char[] commentStops = {'-', '\r', '\n'};
+	private static readonly char[] cdataStops = {']', '\r', '\n'};
+	private readonly char[] attributeStops;
+	private readonly char[] normalizeStops;
+
 
 	// Possible Document States.
 	private enum State
@@ -98,6 +107,9 @@ public class XmlTextReader : XmlReader
 				xmlSpaceName = nt.Add("xml:space");
 				xmlNSPrefix = nt.Add("xmlns");
 				xmlCompareQuick = nt.Add("xml");
+				attributeStops = new char[] {'"', '<', '&', '\r', '\n'};
+				normalizeStops =
+					new char[] {'"', '<', '&', '\r', '\n', '\t', ' '};
 
 				contextSupport = false;
 				hasRoot = true;
@@ -1014,6 +1026,10 @@ public class XmlTextReader : XmlReader
 				SegmentInfo seg;
 				XmlNameTable nt = context.NameTable;
 
+				// set the characters that end a run of text
+				char[] stops = attributeStops;
+				stops[0] = quoteChar;
+
 				// push the log onto the logger's log stack
 				input.Logger.Push(log);
 
@@ -1066,7 +1082,7 @@ public class XmlTextReader : XmlReader
 					}
 					else
 					{
-						input.NextChar();
+						input.NextChars(stops);
 					}
 				}
 
@@ -1103,6 +1119,10 @@ public class XmlTextReader : XmlReader
 				SegmentInfo seg;
 				XmlNameTable nt = context.NameTable;
 
+				// set the characters that end a run of text
+				char[] stops = normalizeStops;
+				stops[0] = quoteChar;
+
 				// push the log onto the logger's log stack
 				input.Logger.Push(log);
 
@@ -1159,7 +1179,7 @@ public class XmlTextReader : XmlReader
 					}
 					else
 					{
-						input.NextChar();
+						input.NextChars(stops);
 					}
 				}
 
@@ -1279,7 +1299,7 @@ public class XmlTextReader : XmlReader
 				input.Logger.Push(log);
 
 				// read until we've consumed all of the character data content
-				while(input.NextChar() && input.PeekChar())
+				while(input.NextChars(cdataStops) && input.PeekChar())
 				{
 					// check for the ']]' sequence
 					if(input.currChar == ']' && input.peekChar == ']')
@@ -1320,7 +1340,7 @@ public class XmlTextReader : XmlReader
 				input.Logger.Push(log);
 
 				// read until we consume all of the comment content
-				while(input.NextChar() && input.PeekChar())
+				while(input.NextChars(commentStops) && input.PeekChar())
 				{
 					// check for the '--' sequence
 					if(input.currChar == '-' && input.peekChar == '-')
@@ -2076,7 +2096,7 @@ public class XmlTextReader : XmlReader
 					}
 					else
 					{
-						input.NextChar();
+						input.NextChars(textStops);
 					}
 				}
 
@@ -100,11 +100,14 @@ namespace System.Text.RegularExpressions {
 
 	interface IMachine {
 		Match Scan (Regex regex, string text, int start, int end);
+		bool IsMatch (Regex regex, string text, int start, int end);
 	}
 
 	interface IMachineFactory {
 		IMachine NewInstance ();
 		IDictionary Mapping { get; set; }
+		Automaton Automaton { get; set; }
+		Prefilter Prefilter { get; set; }
 		int GroupCount { get; }
 	}
 
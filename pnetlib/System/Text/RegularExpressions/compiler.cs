@@ -89,7 +89,7 @@ namespace System.Text.RegularExpressions {
 		}
 		
 		public IMachine NewInstance () {
-			return new Interpreter (pattern);
+			return new Interpreter (pattern, automaton, prefilter);
 		}
 
 		public int GroupCount {
@@ -101,7 +101,19 @@ namespace System.Text.RegularExpressions {
 			set { mapping = value; }
 		}
 
+		public Automaton Automaton {
+			get { return automaton; }
+			set { automaton = value; }
+		}
+
+		public Prefilter Prefilter {
+			get { return prefilter; }
+			set { prefilter = value; }
+		}
+
 		private IDictionary mapping;
+		private Automaton automaton;
+		private Prefilter prefilter;
 		private ushort[] pattern;
 	}
 
@@ -126,10 +138,14 @@ namespace System.Text.RegularExpressions {
 		}
 
 		public IMachineFactory GetMachineFactory () {
+			return new InterpreterFactory (GetImage ());
+		}
+
+		public ushort[] GetImage () {
 			ushort[] image = new ushort[pgm.Count];
 			pgm.CopyTo (image);
 
-			return new InterpreterFactory (image);
+			return image;
 		}
 
 		public void EmitFalse () {
@@ -0,0 +1,629 @@
+//
+// assembly:	System
+// namespace:	System.Text.RegularExpressions
+// file:	dfa.cs
+//
+
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+using System;
+using System.Collections;
+using System.Threading;
+
+using RegularExpression = System.Text.RegularExpressions.Syntax.RegularExpression;
+using AnchorInfo = System.Text.RegularExpressions.Syntax.AnchorInfo;
+using Expression = System.Text.RegularExpressions.Syntax.Expression;
+
+namespace System.Text.RegularExpressions {
+
+	// Finite automaton for patterns that only use regular constructs,
+	// ie. no back references, lookaround, conditionals, balancing or
+	// non-backtracking groups.
+	//
+	// The NFA is built from the syntax tree by Expression.CompileAutomaton,
+	// and the DFA states are built from it lazily while scanning, so each
+	// character of the text is examined once. The automaton can only tell
+	// whether the text contains a match: the interpreter is still used to
+	// find where the match is and what the groups captured.
+	//
+	// Zero-width assertions are resolved when the character after them is
+	// seen, so a DFA state records the kind of the previous character. The
+	// \Z assertion needs to look two characters ahead, so it is only
+	// supported at the end of a pattern.
+	//
+	// Scans read the transition tables without taking the lock, so a page
+	// of transitions is never changed once it has been published: new
+	// transitions go into a copy of the page, which replaces the old one
+	// once it and the states it refers to have been completely built.
+
+	class Automaton {
+		public static Automaton Compile (RegularExpression re, RegexOptions options) {
+			if ((options & RegexOptions.RightToLeft) != 0)
+				return null;
+
+			// a plain string is found faster by the interpreter's
+			// substring search than by stepping through every character
+
+			AnchorInfo info = re.GetAnchorInfo (false);
+			if (info.IsSubstring && info.IsComplete)
+				return null;
+
+			Automaton aut = new Automaton ();
+			int accept = aut.AddState (NodeType.Accept);
+			int start = re.CompileAutomaton (aut, accept);
+			if (start < 0 || aut.IsFull)
+				return null;
+
+			aut.Finish (start);
+			if ((options & RegexOptions.Compiled) != 0)
+				aut.Expand ();
+
+			return aut;
+		}
+
+		// NFA construction
+
+		public bool IsFull {
+			get { return nodes.Count > MaxNodes; }
+		}
+
+		public int AddSplit () {
+			return AddState (NodeType.Split);
+		}
+
+		public void AddEpsilon (int from, int to) {
+			Node node = (Node)nodes[from];
+			if (node.targets == null)
+				node.targets = new ArrayList ();
+
+			node.targets.Add (to);
+		}
+
+		public int AddCharacter (char c, bool ignore, int next) {
+			PatternCompiler cmp = new PatternCompiler ();
+			cmp.EmitCharacter (c, false, ignore, false);
+			return AddTest (cmp.GetImage (), next);
+		}
+
+		public int AddClass (Expression expr, int next) {
+			PatternCompiler cmp = new PatternCompiler ();
+			expr.Compile (cmp, false);
+			ushort[] test = cmp.GetImage ();
+
+			// an empty class doesn't consume anything
+
+			if (test.Length == 0)
+				return next;
+
+			return AddTest (test, next);
+		}
+
+		public int AddPosition (Position pos, int next) {
+			switch (pos) {
+			case Position.Start: case Position.StartOfString:
+				uses_start = true;
+				uses_prev = true;
+				break;
+
+			case Position.StartOfLine:
+			case Position.Boundary: case Position.NonBoundary:
+				uses_prev = true;
+				break;
+
+			case Position.EndOfLine: case Position.EndOfString:
+				break;
+
+			case Position.End: {
+				// end, or before a final newline: the newline is
+				// consumed, which is only safe if nothing else follows
+
+				if (!IsFinal (next))
+					return -1;
+
+				int split = AddSplit ();
+				AddEpsilon (split, AddPosition (Position.EndOfString, next));
+				AddEpsilon (split, AddCharacter ('\n', false,
+					AddPosition (Position.EndOfString, next)));
+				return split;
+			}
+
+			default:
+				return -1;
+			}
+
+			int state = AddState (NodeType.Position);
+			Node node = (Node)nodes[state];
+			node.pos = pos;
+			node.next = next;
+			return state;
+		}
+
+		// scanning
+
+		public bool CanScan (int start, int end) {
+			// the interpreter's position anchor tries \A at the start of
+			// the string even when the scan starts later, and a scan
+			// after an empty match at the end may start past it
+			if (start > end)
+				return false;
+			return start == 0 || !uses_start;
+		}
+
+		public bool IsMatch (string text, int start, int end) {
+			State state = GetStartState (start == 0 ? KindNone : GetKind (text[start - 1]));
+			for (int ptr = start; ptr < end; ++ ptr) {
+				char c = text[ptr];
+				State[] page = state.pages[c >> 8];
+				State next = (page != null) ? page[c & 0xff] : null;
+				if (next == null)
+					next = Transition (state, c);
+
+				if (next == match_state)
+					return true;
+				if (next.nfa.Length == 0)
+					return false;
+
+				state = next;
+			}
+
+			if (state.accept < 0)
+				AcceptsAtEnd (state);
+
+			return state.accept > 0;
+		}
+
+		// private
+
+		private Automaton () {
+			nodes = new ArrayList ();
+			states = new Hashtable ();
+			start_states = new State[4];
+			match_state = new State (null, 0);
+		}
+
+		private int AddState (NodeType type) {
+			Node node = new Node ();
+			node.type = type;
+			node.next = -1;
+			nodes.Add (node);
+			return nodes.Count - 1;
+		}
+
+		private int AddTest (ushort[] test, int next) {
+			int state = AddState (NodeType.Test);
+			Node node = (Node)nodes[state];
+			node.test = test;
+			node.next = next;
+			return state;
+		}
+
+		// Determine if a state can only reach the accept state without
+		// consuming characters or testing positions.
+		private bool IsFinal (int state) {
+			bool[] seen = new bool[nodes.Count];
+			Stack pending = new Stack ();
+			pending.Push (state);
+			while (pending.Count > 0) {
+				int s = (int)pending.Pop ();
+				if (seen[s])
+					continue;
+
+				seen[s] = true;
+				Node node = (Node)nodes[s];
+				if (node.type == NodeType.Accept)
+					continue;
+
+				// a loop that is still being built has no targets yet
+
+				if (node.type != NodeType.Split || node.targets == null)
+					return false;
+
+				foreach (int target in node.targets)
+					pending.Push (target);
+			}
+
+			return true;
+		}
+
+		private void Finish (int start) {
+			this.start = start;
+			node_array = (Node[])nodes.ToArray (typeof (Node));
+			marks = new int[node_array.Length];
+			stack = new int[node_array.Length];
+			found = new int[node_array.Length];
+
+			// if every path begins with \A, then there is no point in
+			// trying to start a match anywhere else
+
+			anchored = IsAnchored (start);
+		}
+
+		private bool IsAnchored (int state) {
+			bool[] seen = new bool[node_array.Length];
+			Stack pending = new Stack ();
+			pending.Push (state);
+			while (pending.Count > 0) {
+				int s = (int)pending.Pop ();
+				if (seen[s])
+					continue;
+
+				seen[s] = true;
+				Node node = node_array[s];
+				switch (node.type) {
+				case NodeType.Position:
+					if (node.pos != Position.Start && node.pos != Position.StartOfString)
+						return false;
+					break;
+
+				case NodeType.Split:
+					if (node.targets != null) {
+						foreach (int target in node.targets)
+							pending.Push (target);
+					}
+					break;
+
+				default:
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Build the DFA states reachable on ASCII characters up front, so
+		// that most scans don't need to stop and extend the automaton.
+		private void Expand () {
+			Queue queue = new Queue ();
+			for (int kind = KindNone; kind <= KindOther; ++ kind) {
+				if (kind > KindNone && !uses_prev)
+					break;
+
+				queue.Enqueue (GetStartState (kind));
+			}
+
+			while (queue.Count > 0 && states.Count < MaxStates) {
+				State state = (State)queue.Dequeue ();
+				lock (this) {
+					State[] page = (State[])state.pages[0].Clone ();
+					for (int c = 0; c < 0x80; ++ c) {
+						if (page[c] != null)
+							continue;
+
+						State next = Step (state, (char)c);
+						page[c] = next;
+						if (next != match_state && next.nfa.Length > 0)
+							queue.Enqueue (next);
+					}
+
+					Publish (state, 0, page);
+				}
+			}
+		}
+
+		private State GetStartState (int prev) {
+			if (!uses_prev)
+				prev = KindNone;
+
+			State state = start_states[prev];
+			if (state == null) {
+				lock (this) {
+					state = Intern (new int[] { start }, prev);
+					Thread.MemoryBarrier ();
+					start_states[prev] = state;
+				}
+			}
+
+			return state;
+		}
+
+		// Compute the state that follows "state" on the character "c",
+		// and record it in the transition table.
+		private State Transition (State state, char c) {
+			lock (this) {
+				State next = Step (state, c);
+
+				State[] page = state.pages[c >> 8];
+				page = (page != null) ? (State[])page.Clone () : new State[256];
+				page[c & 0xff] = next;
+				Publish (state, c >> 8, page);
+
+				return next;
+			}
+		}
+
+		// Compute the state that follows "state" on the character "c".
+		// The lock must be held.
+		private State Step (State state, char c) {
+			int kind = GetKind (c);
+
+			int count = Closure (state, kind);
+			if (count < 0)
+				return match_state;
+
+			// step over the character, and then start a new match
+			// attempt at the next position
+
+			++ generation;
+			int n = 0;
+			for (int i = 0; i < count; ++ i) {
+				Node node = node_array[found[i]];
+				if (marks[node.next] != generation && IsMatchCharacter (node.test, c)) {
+					marks[node.next] = generation;
+					stack[n ++] = node.next;
+				}
+			}
+
+			if (!anchored && marks[start] != generation)
+				stack[n ++] = start;
+
+			int[] nfa = new int[n];
+			Array.Copy (stack, nfa, n);
+			Array.Sort (nfa);
+
+			if (states.Count >= MaxStates) {
+				states.Clear ();
+				start_states = new State[4];
+			}
+
+			return Intern (nfa, uses_prev ? kind : KindNone);
+		}
+
+		// Replace a page of the transition table with a complete copy.
+		private static void Publish (State state, int index, State[] page) {
+			Thread.MemoryBarrier ();
+			state.pages[index] = page;
+		}
+
+		private void AcceptsAtEnd (State state) {
+			lock (this) {
+				state.accept = (Closure (state, KindNone) < 0) ? 1 : 0;
+			}
+		}
+
+		// Collect the character tests that are reachable from a state
+		// without consuming anything, given the kind of the next character.
+		// Returns the number of tests in "found", or -1 if the accept state
+		// is reachable.
+		private int Closure (State state, int next) {
+			++ generation;
+			int count = 0;
+			int sp = 0;
+			foreach (int s in state.nfa) {
+				marks[s] = generation;
+				stack[sp ++] = s;
+			}
+
+			while (sp > 0) {
+				Node node = node_array[stack[-- sp]];
+				switch (node.type) {
+				case NodeType.Accept:
+					return -1;
+
+				case NodeType.Test:
+					found[count ++] = stack[sp];
+					break;
+
+				case NodeType.Position:
+					if (IsPosition (node.pos, state.prev, next))
+						Push (node.next, ref sp);
+					break;
+
+				case NodeType.Split:
+					if (node.targets != null) {
+						foreach (int target in node.targets)
+							Push (target, ref sp);
+					}
+					break;
+				}
+			}
+
+			return count;
+		}
+
+		private void Push (int s, ref int sp) {
+			if (marks[s] != generation) {
+				marks[s] = generation;
+				stack[sp ++] = s;
+			}
+		}
+
+		private State Intern (int[] nfa, int prev) {
+			char[] chars = new char[nfa.Length + 1];
+			chars[0] = (char)prev;
+			for (int i = 0; i < nfa.Length; ++ i)
+				chars[i + 1] = (char)nfa[i];
+
+			string key = new string (chars);
+			State state = (State)states[key];
+			if (state == null) {
+				state = new State (nfa, prev);
+				states[key] = state;
+			}
+
+			return state;
+		}
+
+		private static int GetKind (char c) {
+			if (c == '\n')
+				return KindNewline;
+			else if (CategoryUtils.IsCategory (Category.Word, c))
+				return KindWord;
+			else
+				return KindOther;
+		}
+
+		// Same as Interpreter.IsPosition, given the kinds of the
+		// characters either side of the position.
+		private static bool IsPosition (Position pos, int prev, int next) {
+			switch (pos) {
+			case Position.Start: case Position.StartOfString:
+				return prev == KindNone;
+
+			case Position.StartOfLine:
+				return prev == KindNone || prev == KindNewline;
+
+			case Position.EndOfLine:
+				return next == KindNone || next == KindNewline;
+
+			case Position.EndOfString:
+				return next == KindNone;
+
+			case Position.Boundary:
+				return (prev == KindWord) != (next == KindWord);
+
+			case Position.NonBoundary:
+				if (prev == KindNone && next == KindNone)
+					return false;
+
+				return (prev == KindWord) == (next == KindWord);
+
+			default:
+				return false;
+			}
+		}
+
+		// Same as Interpreter.EvalChar, applied to a single character.
+		private static bool IsMatchCharacter (ushort[] test, char c) {
+			int pc = 0;
+			bool multi = false;
+			if ((OpCode)(test[0] & 0x00ff) == OpCode.In) {
+				pc = 2;
+				multi = true;
+			}
+
+			// the first op determines case sensitivity
+
+			if (((OpFlags)(test[pc] & 0xff00) & OpFlags.IgnoreCase) != 0)
+				c = Char.ToLower (c);
+
+			bool negate;
+			do {
+				ushort word = test[pc ++];
+				OpCode op = (OpCode)(word & 0x00ff);
+				OpFlags flags = (OpFlags)(word & 0xff00);
+
+				negate = (flags & OpFlags.Negate) != 0;
+
+				switch (op) {
+				case OpCode.True:
+					return true;
+
+				case OpCode.False:
+					return false;
+
+				case OpCode.Character: {
+					if (c == (char)test[pc ++])
+						return !negate;
+					break;
+				}
+
+				case OpCode.Category: {
+					if (CategoryUtils.IsCategory ((Category)test[pc ++], c))
+						return !negate;
+					break;
+				}
+
+				case OpCode.Range: {
+					int lo = (char)test[pc ++];
+					int hi = (char)test[pc ++];
+					if (lo <= c && c <= hi)
+						return !negate;
+					break;
+				}
+
+				case OpCode.Set: {
+					int lo = (char)test[pc ++];
+					int len = (char)test[pc ++];
+					int bits = pc;
+					pc += len;
+
+					int i = (int)c - lo;
+					if (i < 0 || i >= len << 4)
+						break;
+
+					if ((test[bits + (i >> 4)] & (1 << (i & 0xf))) != 0)
+						return !negate;
+					break;
+				}
+				}
+			} while (multi);
+
+			return negate;
+		}
+
+		private const int MaxNodes = 4096;	// largest NFA, mainly for counted repeats
+		private const int MaxStates = 1000;	// DFA states before the cache is flushed
+
+		// kinds of character either side of a position
+
+		private const int KindNone = 0;		// start or end of the text
+		private const int KindNewline = 1;
+		private const int KindWord = 2;
+		private const int KindOther = 3;
+
+		private ArrayList nodes;		// NFA under construction
+		private Node[] node_array;		// NFA after construction
+		private int start;			// NFA start state
+		private bool anchored;			// all matches begin at \A
+		private bool uses_start;		// pattern contains \A
+		private bool uses_prev;			// assertions look at the previous character
+
+		private Hashtable states;		// DFA states, keyed by NFA states
+		private State[] start_states;		// start states, by previous character kind
+		private State match_state;		// transition target when a match is found
+
+		private int[] marks;			// scratch space for the closures
+		private int[] stack;
+		private int[] found;
+		private int generation;
+
+		private enum NodeType {
+			Split,				// epsilon transitions to targets
+			Test,				// consume a character that passes test
+			Position,			// zero-width assertion
+			Accept				// end of pattern
+		}
+
+		private class Node {
+			public NodeType type;
+			public ushort[] test;
+			public Position pos;
+			public int next;
+			public ArrayList targets;
+		}
+
+		private class State {
+			public State (int[] nfa, int prev) {
+				this.nfa = nfa;
+				this.prev = prev;
+				this.accept = -1;
+				this.pages = new State[256][];
+				this.pages[0] = new State[256];
+			}
+
+			public int[] nfa;		// NFA states before the next character
+			public int prev;		// kind of the previous character
+			public int accept;		// match at end of text: -1 if unknown
+			public State[][] pages;		// transitions, in pages of 256 characters
+		}
+	}
+}
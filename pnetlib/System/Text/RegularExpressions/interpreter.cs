@@ -35,8 +35,10 @@ using System.Globalization;
 namespace System.Text.RegularExpressions {
 
 	class Interpreter : IMachine {
-		public Interpreter (ushort[] program) {
+		public Interpreter (ushort[] program, Automaton automaton, Prefilter prefilter) {
 			this.program = program;
+			this.automaton = automaton;
+			this.prefilter = prefilter;
 			this.qs = null;
 
 			// process info block
@@ -56,6 +58,15 @@ namespace System.Text.RegularExpressions {
 		// IMachine implementation
 
 		public Match Scan (Regex regex, string text, int start, int end) {
+			// rule out texts without a match before backtracking over them
+
+			if (prefilter != null && !prefilter.IsCandidate (text, start, end))
+				return Match.Empty;
+
+			if (automaton != null && automaton.CanScan (start, end) &&
+			    !automaton.IsMatch (text, start, end))
+				return Match.Empty;
+
 			this.text = text;
 			this.text_end = end;
 			this.scan_ptr = start;
@@ -66,6 +77,16 @@ namespace System.Text.RegularExpressions {
 			return Match.Empty;
 		}
 
+		public bool IsMatch (Regex regex, string text, int start, int end) {
+			if (prefilter != null && !prefilter.IsCandidate (text, start, end))
+				return false;
+
+			if (automaton != null && automaton.CanScan (start, end))
+				return automaton.IsMatch (text, start, end);
+
+			return Scan (regex, text, start, end).Success;
+		}
+
 		// private methods
 
 		private void Reset () {
@@ -197,10 +218,19 @@ namespace System.Text.RegularExpressions {
 						// Anchor
 						//	True
 
+						bool skip_ahead = !anch_reverse && prefilter != null && prefilter.HasPrefixes;
 					
 						while ((anch_reverse && anch_ptr >= anch_begin) 
 						       || (!anch_reverse && anch_ptr <= anch_end)) {
 
+							// jump to the next place a match could start
+
+							if (skip_ahead) {
+								anch_ptr = prefilter.Search (text, anch_ptr, text_end);
+								if (anch_ptr < 0 || anch_ptr > anch_end)
+									break;
+							}
+
 							ptr = anch_ptr;
 							if (TryMatch (ref ptr, pc + skip))
 								goto Pass;
@@ -527,12 +557,14 @@ namespace System.Text.RegularExpressions {
 					pc += program[pc + 1];		// tail expression
 					ushort tail_word = program[pc];
 
-					int c1, c2;			// first character of tail operator
+					int c1;				// first character of tail operator
+					bool ignore;			// compare the tail without case
 					int coff;			// 0 or -1 depending on direction
 
 					OpCode tail_op = (OpCode)(tail_word & 0xff);
-					if (tail_op == OpCode.Character || tail_op == OpCode.String) {
-						OpFlags tail_flags = (OpFlags)(tail_word & 0xff00);
+					OpFlags tail_flags = (OpFlags)(tail_word & 0xff00);
+					if ((tail_op == OpCode.Character || tail_op == OpCode.String) &&
+					    (tail_flags & OpFlags.Negate) == 0) {
 
 						if (tail_op == OpCode.String)
 						{
@@ -548,10 +580,7 @@ namespace System.Text.RegularExpressions {
 						else
 							c1 = program[pc + 1];				// character
 						
-						if ((tail_flags & OpFlags.IgnoreCase) != 0)
-							c2 = Char.ToUpper ((char)c1);			// ignore case
-						else
-							c2 = c1;
+						ignore = (tail_flags & OpFlags.IgnoreCase) != 0;
 
 						if ((tail_flags & OpFlags.RightToLeft) != 0)
 							coff = -1;					// reverse
@@ -559,7 +588,8 @@ namespace System.Text.RegularExpressions {
 							coff = 0;
 					}
 					else {
-						c1 = c2 = -1;
+						c1 = -1;
+						ignore = false;
 						coff = 0;
 					}
 
@@ -572,7 +602,7 @@ namespace System.Text.RegularExpressions {
 						
 						while (true) {
 							int p = ptr + coff;
-							if ((c1 < 0 || (p >= 0 && p < text_end && (c1 == text[p] || c2 == text[p]))) &&
+							if ((c1 < 0 || (p >= 0 && p < text_end && c1 == (ignore ? Char.ToLower (text[p]) : text[p]))) &&
 							    Eval (Mode.Match, ref ptr, pc))
 								break;
 
@@ -593,7 +623,7 @@ namespace System.Text.RegularExpressions {
 						goto Pass;
 					}
 					else {
-						if (!Eval (Mode.Count, ref ptr, fast.Expression)) {
+						if (!fast.IsMaximum && !Eval (Mode.Count, ref ptr, fast.Expression)) {
 							fast = fast.Previous;
 							goto Fail;
 						}
@@ -606,7 +636,7 @@ namespace System.Text.RegularExpressions {
 
 						while (true) {
 							int p = ptr + coff;
-							if ((c1 < 0 || (p >= 0 && p < text_end && (c1 == text[p] || c2 == text[p]))) &&
+							if ((c1 < 0 || (p >= 0 && p < text_end && c1 == (ignore ? Char.ToLower (text[p]) : text[p]))) &&
 							    Eval (Mode.Match, ref ptr, pc))
 								break;
 
@@ -979,6 +1009,8 @@ namespace System.Text.RegularExpressions {
 		// interpreter attributes
 
 		private ushort[] program;		// regex program
+		private Automaton automaton;		// DFA for regular patterns, or null
+		private Prefilter prefilter;		// start position filter, or null
 		private int program_start;		// first instruction after info block
 		private string text;			// input text
 		private int text_end;			// end of input text (last character + 1)
@@ -789,7 +789,7 @@ namespace System.Text.RegularExpressions.Syntax {
 			/* assign min and max */
 			
 			min = n;
-			if (m > 0)
+			if (m >= 0)
 				max = m;
 			else
 				max = 0xffff;
@@ -0,0 +1,319 @@
+//
+// assembly:	System
+// namespace:	System.Text.RegularExpressions
+// file:	prefilter.cs
+//
+
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+using System;
+using System.Collections;
+
+using RegularExpression = System.Text.RegularExpressions.Syntax.RegularExpression;
+using AnchorInfo = System.Text.RegularExpressions.Syntax.AnchorInfo;
+using Literal = System.Text.RegularExpressions.Syntax.Literal;
+
+namespace System.Text.RegularExpressions {
+
+	// Cheap tests that rule out start positions before the interpreter
+	// tries them.
+	//
+	// Patterns without a fixed substring anchor are otherwise tried at
+	// every position of the text. The prefilter holds the literals that
+	// every match must start with, and skips to the next position where
+	// one of their first characters occurs with String.IndexOfAny. It
+	// also holds the longest literal that every match must contain, so
+	// texts without it are rejected with a single substring search.
+
+	class Prefilter {
+		public static Prefilter Compile (RegularExpression re, RegexOptions options) {
+			if ((options & RegexOptions.RightToLeft) != 0)
+				return null;
+
+			// the interpreter already searches for substring anchors
+
+			AnchorInfo info = re.GetAnchorInfo (false);
+			if (info.IsSubstring)
+				return null;
+
+			Prefilter filter = new Prefilter ();
+			filter.SetPrefixes (re.GetPrefixes ());
+
+			Literal lit = re.GetRequiredLiteral ();
+			if (lit != null) {
+				string str = lit.IgnoreCase ? lit.String.ToLower () : lit.String;
+				filter.required = new QuickSearch (str, lit.IgnoreCase);
+			}
+
+			// the interpreter tries \A at the start of the string even
+			// when the scan starts later
+
+			filter.from_start = info.IsPosition && info.Position == Position.StartOfString;
+
+			if (filter.prefixes == null && filter.required == null)
+				return null;
+
+			return filter;
+		}
+
+		// returns false if there can't be a match in the text between
+		// start and end.
+
+		public bool IsCandidate (string text, int start, int end) {
+			if (required == null)
+				return true;
+
+			if (from_start)
+				start = 0;
+
+			return required.Search (text, start, end - required.Length) >= 0;
+		}
+
+		public bool HasPrefixes {
+			get { return prefixes != null; }
+		}
+
+		// returns the first position from start where a match could
+		// begin, or -1 if there is none before end.
+
+		public int Search (string text, int start, int end) {
+			int ptr = start;
+			while (ptr < end) {
+				ptr = text.IndexOfAny (first, ptr, end - ptr);
+				if (ptr < 0)
+					break;
+
+				if (IsPrefix (text, ptr, end))
+					return ptr;
+
+				++ ptr;
+			}
+
+			return -1;
+		}
+
+		// private
+
+		private Prefilter () {
+		}
+
+		private void SetPrefixes (PrefixSet set) {
+			if (set == null || set.IsEmpty)
+				return;
+
+			// collect the first characters, with every character that
+			// lowers to them when ignoring case
+
+			bool ignore = set.IgnoreCase;
+			string[] strings = new string[set.Count];
+			ArrayList chars = new ArrayList ();
+			for (int i = 0; i < set.Count; ++ i) {
+				string str = ignore ? set[i].ToLower () : set[i];
+				char c = str[0];
+				if (ignore && c >= 0x80)
+					return;
+
+				AddCharacter (chars, c);
+				if (ignore && c >= 'a' && c <= 'z') {
+					AddCharacter (chars, (char)(c - 'a' + 'A'));
+					if (c == 'i')
+						AddCharacter (chars, '\u0130');	// capital I with dot
+					else if (c == 'k')
+						AddCharacter (chars, '\u212a');	// kelvin sign
+				}
+
+				strings[i] = str;
+			}
+
+			this.prefixes = strings;
+			this.first = (char[])chars.ToArray (typeof (char));
+			this.ignore = ignore;
+		}
+
+		private static void AddCharacter (ArrayList chars, char c) {
+			if (!chars.Contains (c))
+				chars.Add (c);
+		}
+
+		private bool IsPrefix (string text, int ptr, int end) {
+			foreach (string str in prefixes) {
+				if (ptr + str.Length > end)
+					continue;
+
+				int i = 1;
+				while (i < str.Length && str[i] == GetChar (text[ptr + i]))
+					++ i;
+
+				if (i == str.Length && str[0] == GetChar (text[ptr]))
+					return true;
+			}
+
+			return false;
+		}
+
+		private char GetChar (char c) {
+			return ignore ? Char.ToLower (c) : c;
+		}
+
+		private string[] prefixes;		// literals that start every match
+		private char[] first;			// first characters of the prefixes
+		private bool ignore;			// compare prefixes without case
+		private QuickSearch required;		// literal in every match, or null
+		private bool from_start;		// match may start before the scan
+	}
+
+	// The literals that every match of an expression starts with. An
+	// entry is complete when the expression matches exactly that string,
+	// so the expression that follows can extend it.
+
+	class PrefixSet {
+		public static PrefixSet Empty {
+			get {
+				PrefixSet set = new PrefixSet ();
+				set.Add (String.Empty, true);
+				return set;
+			}
+		}
+
+		public PrefixSet () {
+			strings = new ArrayList ();
+			complete = new ArrayList ();
+			ignore = false;
+		}
+
+		public int Count {
+			get { return strings.Count; }
+		}
+
+		public string this[int i] {
+			get { return (string)strings[i]; }
+		}
+
+		public bool IgnoreCase {
+			get { return ignore; }
+			set { ignore = value; }
+		}
+
+		// true if no entry can be extended
+
+		public bool IsFinished {
+			get { return !complete.Contains (true); }
+		}
+
+		// true if some match may start with anything at all
+
+		public bool IsEmpty {
+			get { return strings.Contains (String.Empty); }
+		}
+
+		public void Add (string str, bool complete) {
+			for (int i = 0; i < strings.Count; ++ i) {
+				if ((string)strings[i] == str && (bool)this.complete[i] == complete)
+					return;
+			}
+
+			strings.Add (str);
+			this.complete.Add (complete);
+		}
+
+		// marks every entry as incomplete, when nothing is known about
+		// what follows them
+
+		public PrefixSet Finish () {
+			PrefixSet set = new PrefixSet ();
+			set.ignore = ignore;
+			foreach (string str in strings)
+				set.Add (str, false);
+
+			return set;
+		}
+
+		public PrefixSet Concat (PrefixSet next) {
+			if (next == null)
+				return Finish ();
+
+			PrefixSet set = new PrefixSet ();
+			set.ignore = ignore || next.ignore;
+
+			for (int i = 0; i < strings.Count; ++ i) {
+				string str = (string)strings[i];
+				if (!(bool)complete[i]) {
+					set.Add (str, false);
+					continue;
+				}
+
+				for (int j = 0; j < next.strings.Count; ++ j) {
+					string cat = str + (string)next.strings[j];
+					if (cat.Length > MaxLength)
+						set.Add (cat.Substring (0, MaxLength), false);
+					else
+						set.Add (cat, (bool)next.complete[j]);
+				}
+			}
+
+			// too many combinations: keep what is known so far
+
+			if (set.Count > MaxCount)
+				return Finish ();
+
+			return set;
+		}
+
+		public PrefixSet Union (PrefixSet other) {
+			if (other == null)
+				return null;
+
+			PrefixSet set = new PrefixSet ();
+			set.ignore = ignore || other.ignore;
+			for (int i = 0; i < strings.Count; ++ i)
+				set.Add ((string)strings[i], (bool)complete[i]);
+			for (int i = 0; i < other.strings.Count; ++ i)
+				set.Add ((string)other.strings[i], (bool)other.complete[i]);
+
+			if (set.Count <= MaxCount)
+				return set;
+
+			// too many alternatives: fall back to the first characters
+
+			PrefixSet chars = new PrefixSet ();
+			chars.ignore = set.ignore;
+			foreach (string str in set.strings) {
+				if (str.Length == 0)
+					chars.Add (str, false);
+				else
+					chars.Add (str.Substring (0, 1), false);
+			}
+
+			if (chars.Count > MaxCount)
+				return null;
+
+			return chars;
+		}
+
+		private const int MaxCount = 16;	// maximum number of prefixes
+		private const int MaxLength = 16;	// maximum length of a prefix
+
+		private ArrayList strings;
+		private ArrayList complete;
+		private bool ignore;
+	}
+}
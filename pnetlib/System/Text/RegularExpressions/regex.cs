@@ -235,6 +235,8 @@ namespace System.Text.RegularExpressions {
 
 				this.machineFactory = cmp.GetMachineFactory ();
 				this.machineFactory.Mapping = mapping;
+				this.machineFactory.Automaton = Automaton.Compile (re, options);
+				this.machineFactory.Prefilter = Prefilter.Compile (re, options);
 				cache.Add (pattern, options, this.machineFactory);
 			} else {
 				this.group_count = this.machineFactory.GroupCount;
@@ -309,7 +311,7 @@ namespace System.Text.RegularExpressions {
 		}
 
 		public bool IsMatch (string input, int startat) {
-			return Match (input, startat).Success;
+			return CreateMachine ().IsMatch (this, input, startat, input.Length);
 		}
 
 		public Match Match (string input) {
@@ -71,6 +71,28 @@ namespace System.Text.RegularExpressions.Syntax {
 		public virtual bool IsComplex () {
 			return true;
 		}
+
+		// builds the automaton states for this expression, leading into
+		// the state "next", and returns the entry state. returns -1 if the
+		// expression can't be matched by an automaton.
+
+		public virtual int CompileAutomaton (Automaton aut, int next) {
+			return -1;
+		}
+
+		// returns the literals that every match of this expression
+		// starts with, or null if they aren't known.
+
+		public virtual PrefixSet GetPrefixes () {
+			return null;
+		}
+
+		// returns a literal that every match of this expression
+		// contains, or null if there is none.
+
+		public virtual Literal GetRequiredLiteral () {
+			return null;
+		}
 	}
 
 	// composite expressions
@@ -248,6 +270,36 @@ namespace System.Text.RegularExpressions.Syntax {
 
 			return comp | GetFixedWidth () <= 0;
 		}
+
+		public override int CompileAutomaton (Automaton aut, int next) {
+			for (int i = Expressions.Count - 1; i >= 0 && next >= 0; -- i)
+				next = Expressions[i].CompileAutomaton (aut, next);
+
+			return next;
+		}
+
+		public override PrefixSet GetPrefixes () {
+			PrefixSet set = PrefixSet.Empty;
+			foreach (Expression e in Expressions) {
+				if (set.IsFinished)
+					break;
+
+				set = set.Concat (e.GetPrefixes ());
+			}
+
+			return set;
+		}
+
+		public override Literal GetRequiredLiteral () {
+			Literal longest = null;
+			foreach (Expression e in Expressions) {
+				Literal lit = e.GetRequiredLiteral ();
+				if (lit != null && (longest == null || lit.String.Length > longest.String.Length))
+					longest = lit;
+			}
+
+			return longest;
+		}
 	}
 
 	class RegularExpression : Group {
@@ -360,6 +412,18 @@ namespace System.Text.RegularExpressions.Syntax {
 			cmp.ResolveLink(tail);
 		}
 
+		public override int CompileAutomaton (Automaton aut, int next) {
+			return -1;
+		}
+
+		public override PrefixSet GetPrefixes () {
+			return null;
+		}
+
+		public override Literal GetRequiredLiteral () {
+			return null;
+		}
+
 		private CapturingGroup balance;
 	}
 
@@ -379,6 +443,10 @@ namespace System.Text.RegularExpressions.Syntax {
 		public override bool IsComplex () {
 			return true;
 		}
+
+		public override int CompileAutomaton (Automaton aut, int next) {
+			return -1;
+		}
 	}
 
 	// repetition
@@ -463,6 +531,69 @@ namespace System.Text.RegularExpressions.Syntax {
 			return new AnchorInfo (this, width);
 		}
 
+		public override int CompileAutomaton (Automaton aut, int next) {
+			// optional iterations, or a loop if there is no maximum
+
+			if (max == 0xffff) {
+				int loop = aut.AddSplit ();
+				int body = Expression.CompileAutomaton (aut, loop);
+				if (body < 0)
+					return -1;
+
+				aut.AddEpsilon (loop, body);
+				aut.AddEpsilon (loop, next);
+				next = loop;
+			}
+			else {
+				for (int i = min; i < max; ++ i) {
+					int opt = aut.AddSplit ();
+					int body = Expression.CompileAutomaton (aut, next);
+					if (body < 0 || aut.IsFull)
+						return -1;
+
+					aut.AddEpsilon (opt, body);
+					aut.AddEpsilon (opt, next);
+					next = opt;
+				}
+			}
+
+			// required iterations
+
+			for (int i = 0; i < min; ++ i) {
+				next = Expression.CompileAutomaton (aut, next);
+				if (next < 0 || aut.IsFull)
+					return -1;
+			}
+
+			return next;
+		}
+
+		public override PrefixSet GetPrefixes () {
+			if (max == 0)
+				return PrefixSet.Empty;
+
+			PrefixSet set = Expression.GetPrefixes ();
+			if (set == null)
+				return null;
+
+			// another iteration may follow the first one
+
+			if (max > 1)
+				set = set.Finish ();
+
+			if (min == 0)
+				set = set.Union (PrefixSet.Empty);
+
+			return set;
+		}
+
+		public override Literal GetRequiredLiteral () {
+			if (min == 0)
+				return null;
+
+			return Expression.GetRequiredLiteral ();
+		}
+
 		private int min, max;
 		private bool lazy;
 	}
@@ -670,6 +801,34 @@ namespace System.Text.RegularExpressions.Syntax {
 
 			return comp | GetFixedWidth () <= 0;
 		}
+
+		public override int CompileAutomaton (Automaton aut, int next) {
+			int entry = aut.AddSplit ();
+			foreach (Expression e in Alternatives) {
+				int alt = e.CompileAutomaton (aut, next);
+				if (alt < 0)
+					return -1;
+
+				aut.AddEpsilon (entry, alt);
+			}
+
+			return entry;
+		}
+
+		public override PrefixSet GetPrefixes () {
+			PrefixSet set = null;
+			foreach (Expression e in Alternatives) {
+				PrefixSet alt = e.GetPrefixes ();
+				if (alt == null)
+					return null;
+
+				set = (set == null) ? alt : set.Union (alt);
+				if (set == null)
+					return null;
+			}
+
+			return set;
+		}
 	}
 
 	// terminal expressions
@@ -712,6 +871,27 @@ namespace System.Text.RegularExpressions.Syntax {
 			return false;
 		}
 
+		public override int CompileAutomaton (Automaton aut, int next) {
+			for (int i = str.Length - 1; i >= 0; -- i)
+				next = aut.AddCharacter (str[i], ignore, next);
+
+			return next;
+		}
+
+		public override PrefixSet GetPrefixes () {
+			PrefixSet set = new PrefixSet ();
+			set.Add (str, true);
+			set.IgnoreCase = ignore;
+			return set;
+		}
+
+		public override Literal GetRequiredLiteral () {
+			if (str.Length == 0)
+				return null;
+
+			return this;
+		}
+
 		private string str;
 		private bool ignore;
 	}
@@ -748,6 +928,14 @@ namespace System.Text.RegularExpressions.Syntax {
 			}
 		}
 
+		public override int CompileAutomaton (Automaton aut, int next) {
+			return aut.AddPosition (pos, next);
+		}
+
+		public override PrefixSet GetPrefixes () {
+			return PrefixSet.Empty;
+		}
+
 		private Position pos;
 	}
 
@@ -947,6 +1135,40 @@ namespace System.Text.RegularExpressions.Syntax {
 			return false;
 		}
 
+		public override int CompileAutomaton (Automaton aut, int next) {
+			return aut.AddClass (this, next);
+		}
+
+		public override PrefixSet GetPrefixes () {
+			if (negate)
+				return null;
+
+			for (int i = 0; i < pos_cats.Length; ++ i) {
+				if (pos_cats.Get (i) || neg_cats.Get (i))
+					return null;
+			}
+
+			// only small sets of characters are worth searching for
+
+			PrefixSet set = new PrefixSet ();
+			set.IgnoreCase = ignore;
+			foreach (Interval a in intervals) {
+				if (a.Size > MaxPrefixCharacters)
+					return null;
+
+				for (int c = a.low; c <= a.high; ++ c) {
+					set.Add (((char)c).ToString (), true);
+					if (set.Count > MaxPrefixCharacters)
+						return null;
+				}
+			}
+
+			if (set.Count == 0)
+				return null;
+
+			return set;
+		}
+
 		// private
 
 		private static double GetIntervalCost (Interval i) {
@@ -962,6 +1184,7 @@ namespace System.Text.RegularExpressions.Syntax {
 
 		private static Interval upper_case_characters = new Interval ((char)65, (char)90);
  		private const int distance_between_upper_and_lower_case = 32;
+		private const int MaxPrefixCharacters = 16;
 		private bool negate, ignore;
 		private BitArray pos_cats, neg_cats;
 		private IntervalCollection intervals;
@@ -44,6 +44,11 @@ internal sealed class CryptoMethods
 	public const int RSASign    = 11;
 	public const int RIPEMD160  = 12;
 
+	// Cipher modes for "EncryptBlocks" and "DecryptBlocks".
+	public const int ModeECB    = 0;
+	public const int ModeCBC    = 1;
+	public const int ModeCTR    = 2;
+
 	// Determine if a particular algorithm is supported.
 	[MethodImpl(MethodImplOptions.InternalCall)]
 	extern public static bool AlgorithmSupported(int algorithm);
@@ -66,6 +71,14 @@ internal sealed class CryptoMethods
 	[MethodImpl(MethodImplOptions.InternalCall)]
 	extern public static void HashFinal(IntPtr state, byte[] hash);
 
+	// Hash a batch of independent messages, stored in "buffer" at the
+	// given offsets and lengths.  The hashes are written one after the
+	// other to "hashes", which must be large enough to hold them all.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern public static void HashBatch(int algorithm, byte[] buffer,
+										int[] offsets, int[] lengths,
+										byte[] hashes);
+
 	// Free a hash context that is no longer required.
 	[MethodImpl(MethodImplOptions.InternalCall)]
 	extern public static void HashFree(IntPtr state);
@@ -108,6 +121,23 @@ internal sealed class CryptoMethods
 									  int inOffset, byte[] outBuffer,
 									  int outOffset);
 
+	// Encrypt a run of whole blocks in a particular cipher mode.  The
+	// IV is updated in place with the chaining value for the next run,
+	// or the next counter value in CTR mode.  CTR mode always runs the
+	// cipher forwards, so its state must come from "EncryptCreate".
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern public static void EncryptBlocks(IntPtr state, int mode,
+											byte[] iv, byte[] inBuffer,
+											int inOffset, byte[] outBuffer,
+											int outOffset, int count);
+
+	// Decrypt a run of whole blocks in a particular cipher mode.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern public static void DecryptBlocks(IntPtr state, int mode,
+											byte[] iv, byte[] inBuffer,
+											int inOffset, byte[] outBuffer,
+											int outOffset, int count);
+
 	// Free a symmetric block context.
 	[MethodImpl(MethodImplOptions.InternalCall)]
 	extern public static void SymmetricFree(IntPtr state);
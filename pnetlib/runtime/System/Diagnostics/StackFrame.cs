@@ -249,6 +249,15 @@ class StackFrame
 	[MethodImpl(MethodImplOptions.InternalCall)]
 	extern internal static PackedStackFrame[] GetExceptionStackTrace();
 
+	// Fill in the IL offsets within an exception stack trace.  The
+	// engine only records native offsets when an exception is thrown,
+	// because mapping them back to IL is expensive and most traces
+	// are never looked at.  Frames that are already resolved are
+	// left alone, so this may be called more than once.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern internal static void ResolveExceptionStackTrace
+				(PackedStackFrame[] trace);
+
 }; // class StackFrame
 
 }; // namespace System.Diagnostics
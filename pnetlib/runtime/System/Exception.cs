@@ -322,6 +322,10 @@ public class Exception
 	// Get the packed stack trace information from this exception.
 	internal PackedStackFrame[] GetPackedStackTrace()
 		{
+			if(stackTrace != null)
+			{
+				StackFrame.ResolveExceptionStackTrace(stackTrace);
+			}
 			return stackTrace;
 		}
 
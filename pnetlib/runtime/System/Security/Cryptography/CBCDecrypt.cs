@@ -49,7 +49,7 @@ internal sealed class CBCDecrypt
 				IntPtr state = transform.state;
 				byte[] tempBuffer = transform.tempBuffer;
 				int offset = outputOffset;
-				int index;
+				int index, size;
 
 				// Process a left-over block from last time.
 				if(transform.tempSize > 0 && inputCount > 0)
@@ -78,28 +78,23 @@ internal sealed class CBCDecrypt
 					}
 				}
 
-				// Process all of the blocks in the input, minus one.
-				while(inputCount > blockSize)
+				// Process all of the blocks in the input, minus one, in
+				// one call, which also leaves the next IV in "iv".
+				size = inputCount - (inputCount % blockSize);
+				if(size == inputCount)
 				{
-					// Decrypt the ciphertext to get the plaintext
-					// xor'ed with the IV.
-					CryptoMethods.Decrypt(state, inputBuffer, inputOffset,
-										  tempBuffer, 0);
-
-					// XOR the IV with the temporary buffer to get plaintext.
-					for(index = blockSize - 1; index >= 0; --index)
-					{
-						outputBuffer[offset + index] =
-							(byte)(iv[index] ^ tempBuffer[index]);
-					}
-
-					// Copy the original ciphertext to the IV.
-					Array.Copy(inputBuffer, inputOffset, iv, 0, blockSize);
-
-					// Advance to the next block.
-					inputOffset += blockSize;
-					inputCount -= blockSize;
-					offset += blockSize;
+					size -= blockSize;
+				}
+				if(size > 0)
+				{
+					CryptoMethods.DecryptBlocks
+						(state, CryptoMethods.ModeCBC, iv, inputBuffer,
+						 inputOffset, outputBuffer, offset, size);
+
+					// Advance past the blocks.
+					inputOffset += size;
+					inputCount -= size;
+					offset += size;
 				}
 
 				// Save the last block for next time.
@@ -38,32 +38,20 @@ internal sealed class CBCEncrypt
 							         int outputOffset)
 			{
 				int blockSize = transform.blockSize;
-				byte[] iv = transform.iv;
-				IntPtr state = transform.state;
-				int offset = outputOffset;
-				int index;
+				int size = inputCount - (inputCount % blockSize);
 
-				// Process all of the blocks in the input.
-				while(inputCount >= blockSize)
+				// Process all of the blocks in the input in one call,
+				// which also leaves the next IV in "transform.iv".
+				if(size > 0)
 				{
-					// XOR the plaintext with the IV.
-					for(index = blockSize - 1; index >= 0; --index)
-					{
-						iv[index] ^= inputBuffer[inputOffset + index];
-					}
-
-					// Encrypt the IV to get the ciphertext and the next IV.
-					CryptoMethods.Encrypt(state, iv, 0, iv, 0);
-					Array.Copy(iv, 0, outputBuffer, offset, blockSize);
-
-					// Advance to the next block.
-					inputOffset += blockSize;
-					inputCount -= blockSize;
-					offset += blockSize;
+					CryptoMethods.EncryptBlocks
+						(transform.state, CryptoMethods.ModeCBC, transform.iv,
+						 inputBuffer, inputOffset, outputBuffer,
+						 outputOffset, size);
 				}
 
 				// Finished.
-				return offset - outputOffset;
+				return size;
 			}
 
 	// Transform the final input block.
@@ -95,23 +83,10 @@ internal sealed class CBCEncrypt
 				outputBuffer = new byte [size];
 
 				// Process full blocks in the input.
-				while(inputCount >= blockSize)
-				{
-					// XOR the plaintext with the IV.
-					for(index = blockSize - 1; index >= 0; --index)
-					{
-						iv[index] ^= inputBuffer[inputOffset + index];
-					}
-
-					// Encrypt the IV to get the ciphertext and the next IV.
-					CryptoMethods.Encrypt(state, iv, 0, iv, 0);
-					Array.Copy(iv, 0, outputBuffer, offset, blockSize);
-
-					// Advance to the next block.
-					inputOffset += blockSize;
-					inputCount -= blockSize;
-					offset += blockSize;
-				}
+				offset = TransformBlock(transform, inputBuffer, inputOffset,
+										inputCount, outputBuffer, 0);
+				inputOffset += offset;
+				inputCount -= offset;
 
 				// Format and encrypt the final partial block.
 				if(transform.padding == PaddingMode.PKCS7)
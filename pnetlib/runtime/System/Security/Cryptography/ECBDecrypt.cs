@@ -49,7 +49,7 @@ internal sealed class ECBDecrypt
 				IntPtr state = transform.state;
 				byte[] tempBuffer = transform.tempBuffer;
 				int offset = outputOffset;
-				int index;
+				int index, size;
 				bool needPadding = (transform.padding != PaddingMode.None);
 
 				// Process a left-over block from last time.
@@ -70,17 +70,22 @@ internal sealed class ECBDecrypt
 
 				// Process all of the blocks in the input, minus one.
 				// If we don't need padding, then process all of the blocks.
-				while((needPadding && inputCount > blockSize) ||
-				      (!needPadding && inputCount >= blockSize))
+				size = inputCount - (inputCount % blockSize);
+				if(needPadding && size == inputCount)
+				{
+					size -= blockSize;
+				}
+				if(size > 0)
 				{
 					// Decrypt the ciphertext to get the plaintext.
-					CryptoMethods.Decrypt(state, inputBuffer, inputOffset,
-										  outputBuffer, offset);
-
-					// Advance to the next block.
-					inputOffset += blockSize;
-					inputCount -= blockSize;
-					offset += blockSize;
+					CryptoMethods.DecryptBlocks
+						(state, CryptoMethods.ModeECB, null,
+						 inputBuffer, inputOffset, outputBuffer, offset, size);
+
+					// Advance past the blocks.
+					inputOffset += size;
+					inputCount -= size;
+					offset += size;
 				}
 
 				// Save the last block for next time.
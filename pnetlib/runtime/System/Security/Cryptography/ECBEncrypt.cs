@@ -38,21 +38,19 @@ internal sealed class ECBEncrypt
 							         int outputOffset)
 			{
 				int blockSize = transform.blockSize;
-				IntPtr state = transform.state;
-				int offset = outputOffset;
+				int size = inputCount - (inputCount % blockSize);
 
-				// Process all of the blocks in the input.
-				while(inputCount >= blockSize)
+				// Process all of the blocks in the input in one call.
+				if(size > 0)
 				{
-					CryptoMethods.Encrypt(state, inputBuffer, inputOffset,
-										  outputBuffer, offset);
-					inputOffset += blockSize;
-					inputCount -= blockSize;
-					offset += blockSize;
+					CryptoMethods.EncryptBlocks
+						(transform.state, CryptoMethods.ModeECB, null,
+						 inputBuffer, inputOffset, outputBuffer,
+						 outputOffset, size);
 				}
 
 				// Finished.
-				return offset - outputOffset;
+				return size;
 			}
 
 	// Transform the final input block.
@@ -83,14 +81,10 @@ internal sealed class ECBEncrypt
 				outputBuffer = new byte [size];
 
 				// Process full blocks in the input.
-				while(inputCount >= blockSize)
-				{
-					CryptoMethods.Encrypt(state, inputBuffer, inputOffset,
-										  outputBuffer, offset);
-					inputOffset += blockSize;
-					inputCount -= blockSize;
-					offset += blockSize;
-				}
+				offset = TransformBlock(transform, inputBuffer, inputOffset,
+										inputCount, outputBuffer, 0);
+				inputOffset += offset;
+				inputCount -= offset;
 
 				// Format and encrypt the final partial block.
 				if(transform.padding == PaddingMode.PKCS7)
@@ -0,0 +1,142 @@
+/*
+ * HashBatch.cs - Implementation of the
+ *		"System.Security.Cryptography.HashBatch" class.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+namespace System.Security.Cryptography
+{
+
+#if CONFIG_CRYPTO
+
+using System;
+using Platform;
+
+// This is a private extension API, for hashing many small independent
+// messages with one call into the runtime engine.  The engine hashes
+// SHA-256 messages side by side where the processor allows it.
+
+[NonStandardExtra]
+public sealed class HashBatch
+{
+	// Cannot instantiate this class.
+	private HashBatch() {}
+
+	// Get the engine's identifier for a hash algorithm, or -1 if
+	// the algorithm is not one of the engine's own implementations.
+	private static int GetAlgorithm(HashAlgorithm alg)
+			{
+				Type type = alg.GetType();
+				if(type == typeof(MD5CryptoServiceProvider))
+				{
+					return CryptoMethods.MD5;
+				}
+				else if(type == typeof(SHA1CryptoServiceProvider) ||
+						type == typeof(SHA1Managed))
+				{
+					return CryptoMethods.SHA1;
+				}
+				else if(type == typeof(SHA256Managed))
+				{
+					return CryptoMethods.SHA256;
+				}
+				else if(type == typeof(SHA384Managed))
+				{
+					return CryptoMethods.SHA384;
+				}
+				else if(type == typeof(SHA512Managed))
+				{
+					return CryptoMethods.SHA512;
+				}
+				else if(type == typeof(RIPEMD160Managed))
+				{
+					return CryptoMethods.RIPEMD160;
+				}
+				return -1;
+			}
+
+	// Compute the hash values of the messages at the given offsets and
+	// lengths within "buffer".  The hash values are returned one after
+	// the other, "alg.HashSize / 8" bytes apart.
+	public static byte[] ComputeHashes(HashAlgorithm alg, byte[] buffer,
+									   int[] offsets, int[] lengths)
+			{
+				// Validate the parameters.
+				if(alg == null)
+				{
+					throw new ArgumentNullException("alg");
+				}
+				if(buffer == null)
+				{
+					throw new ArgumentNullException("buffer");
+				}
+				if(offsets == null)
+				{
+					throw new ArgumentNullException("offsets");
+				}
+				if(lengths == null)
+				{
+					throw new ArgumentNullException("lengths");
+				}
+				if(offsets.Length != lengths.Length)
+				{
+					throw new ArgumentException
+						(_("Arg_InvalidArrayRange"), "lengths");
+				}
+				int posn;
+				for(posn = 0; posn < offsets.Length; ++posn)
+				{
+					if(offsets[posn] < 0 || offsets[posn] > buffer.Length)
+					{
+						throw new ArgumentOutOfRangeException
+							("offsets", _("ArgRange_Array"));
+					}
+					if(lengths[posn] < 0 ||
+					   (buffer.Length - offsets[posn]) < lengths[posn])
+					{
+						throw new ArgumentException
+							(_("Arg_InvalidArrayRange"), "lengths");
+					}
+				}
+
+				// Hash all of the messages in the engine if we can.
+				int size = alg.HashSize / 8;
+				byte[] hashes = new byte [offsets.Length * size];
+				int algorithm = GetAlgorithm(alg);
+				if(algorithm != -1)
+				{
+					CryptoMethods.HashBatch
+						(algorithm, buffer, offsets, lengths, hashes);
+					return hashes;
+				}
+
+				// Hash the messages one at a time using the algorithm object.
+				byte[] hash;
+				for(posn = 0; posn < offsets.Length; ++posn)
+				{
+					hash = alg.ComputeHash(buffer, offsets[posn], lengths[posn]);
+					Array.Copy(hash, 0, hashes, posn * size, size);
+				}
+				return hashes;
+			}
+
+}; // class HashBatch
+
+#endif // CONFIG_CRYPTO
+
+}; // namespace System.Security.Cryptography
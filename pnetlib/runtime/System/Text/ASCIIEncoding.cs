@@ -22,6 +22,7 @@ namespace System.Text
 {
 
 using System;
+using System.Runtime.CompilerServices;
 
 [Serializable]
 public class ASCIIEncoding : Encoding
@@ -32,6 +33,29 @@ public class ASCIIEncoding : Encoding
 	// Constructor.
 	public ASCIIEncoding() : base(ASCII_CODE_PAGE) {}
 
+	// Convert characters into ASCII bytes, replacing anything
+	// outside the ASCII range with '?'.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static void InternalGetBytes
+				(char[] chars, int charIndex, int charCount,
+				 byte[] bytes, int byteIndex);
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static void InternalGetBytes
+				(String s, int charIndex, int charCount,
+				 byte[] bytes, int byteIndex);
+
+	// Convert ASCII bytes into characters, replacing anything
+	// outside the ASCII range with '?'.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static void InternalGetChars
+				(byte[] bytes, int byteIndex, int byteCount,
+				 char[] chars, int charIndex);
+
+	// Convert bytes into a string, passing high bytes through as-is.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static String InternalGetString
+				(byte[] bytes, int index, int count);
+
 	// Get the number of bytes needed to encode a character buffer.
 	public override int GetByteCount(char[] chars, int index, int count)
 			{
@@ -94,20 +118,7 @@ public class ASCIIEncoding : Encoding
 					throw new ArgumentException
 						(_("Arg_InsufficientSpace"));
 				}
-				int count = charCount;
-				char ch;
-				while(count-- > 0)
-				{
-					ch = chars[charIndex++];
-					if(ch < (char)0x80)
-					{
-						bytes[byteIndex++] = (byte)ch;
-					}
-					else
-					{
-						bytes[byteIndex++] = (byte)'?';
-					}
-				}
+				InternalGetBytes(chars, charIndex, charCount, bytes, byteIndex);
 				return charCount;
 			}
 
@@ -142,20 +153,7 @@ public class ASCIIEncoding : Encoding
 				{
 					throw new ArgumentException(_("Arg_InsufficientSpace"));
 				}
-				int count = charCount;
-				char ch;
-				while(count-- > 0)
-				{
-					ch = s[charIndex++];
-					if(ch < (char)0x80)
-					{
-						bytes[byteIndex++] = (byte)ch;
-					}
-					else
-					{
-						bytes[byteIndex++] = (byte)'?';
-					}
-				}
+				InternalGetBytes(s, charIndex, charCount, bytes, byteIndex);
 				return charCount;
 			}
 
@@ -210,20 +208,7 @@ public class ASCIIEncoding : Encoding
 				{
 					throw new ArgumentException(_("Arg_InsufficientSpace"));
 				}
-				int count = byteCount;
-				byte ch;
-				while(count-- > 0)
-				{
-					ch = bytes[byteIndex++];
-					if(ch < 0x80)
-					{
-						chars[charIndex++] = (char)ch;
-					}
-					else
-					{
-						chars[charIndex++] = '?';
-					}
-				}
+				InternalGetChars(bytes, byteIndex, byteCount, chars, charIndex);
 				return byteCount;
 			}
 
@@ -272,13 +257,7 @@ public class ASCIIEncoding : Encoding
 				{
 					return String.Empty;
 				}
-				String s = String.NewString(count);
-				int posn = 0;
-				while(count-- > 0)
-				{
-					s.SetChar(posn++, (char)(bytes[index++]));
-				}
-				return s;
+				return InternalGetString(bytes, index, count);
 			}
 	public override String GetString(byte[] bytes)
 			{
@@ -290,15 +269,7 @@ public class ASCIIEncoding : Encoding
 				{
 					return String.Empty;
 				}
-				int count = bytes.Length;
-				int posn = 0;
-				String s = String.NewString(count);
-				while(count-- > 0)
-				{
-					s.SetChar(posn, (char)(bytes[posn]));
-					++posn;
-				}
-				return s;
+				return InternalGetString(bytes, 0, bytes.Length);
 			}
 
 #if !ECMA_COMPAT
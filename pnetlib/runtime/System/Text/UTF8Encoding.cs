@@ -22,6 +22,7 @@ namespace System.Text
 {
 
 using System;
+using System.Runtime.CompilerServices;
 
 [Serializable]
 public class UTF8Encoding : Encoding
@@ -46,6 +47,28 @@ public class UTF8Encoding : Encoding
 				throwOnInvalid = throwOnInvalidBytes;
 			}
 
+	// Convert as many bytes as possible from UTF-8 into "chars",
+	// stopping at anything that needs special handling.  Returns the
+	// number of bytes converted, and advances "charIndex" past the
+	// characters.  If "chars" is null, they are counted but not stored.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static int InternalDecode
+				(byte[] bytes, int byteIndex, int byteCount,
+				 char[] chars, ref int charIndex);
+
+	// Convert as many characters as possible to UTF-8 in "bytes",
+	// stopping at anything that needs special handling.  Returns the
+	// number of characters converted, and advances "byteIndex" past
+	// the bytes.  If "bytes" is null, they are counted but not stored.
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static int InternalEncode
+				(char[] chars, int charIndex, int charCount,
+				 byte[] bytes, ref int byteIndex);
+	[MethodImpl(MethodImplOptions.InternalCall)]
+	extern private static int InternalEncode
+				(String s, int charIndex, int charCount,
+				 byte[] bytes, ref int byteIndex);
+
 	// Internal version of "GetByteCount" which can handle a rolling
 	// state between multiple calls to this method.
 	private static int InternalGetByteCount(char[] chars, int index,
@@ -72,8 +95,21 @@ public class UTF8Encoding : Encoding
 				char ch;
 				int length = 0;
 				uint pair = leftOver;
+				int used;
 				while(count > 0)
 				{
+					// Count as many bytes as possible in the engine.
+					if(pair == 0)
+					{
+						used = InternalEncode
+							(chars, index, count, null, ref length);
+						index += used;
+						count -= used;
+						if(count == 0)
+						{
+							break;
+						}
+					}
 					ch = chars[index];
 					if(pair == 0)
 					{
@@ -146,8 +182,17 @@ public class UTF8Encoding : Encoding
 				int count = s.Length;
 				int length = 0;
 				uint pair;
+				int used;
 				while(count > 0)
 				{
+					// Count as many bytes as possible in the engine.
+					used = InternalEncode(s, index, count, null, ref length);
+					index += used;
+					count -= used;
+					if(count == 0)
+					{
+						break;
+					}
 					ch = s[index++];
 					if(ch < '\u0080')
 					{
@@ -221,8 +266,22 @@ public class UTF8Encoding : Encoding
 				uint pair;
 				uint left = leftOver;
 				int posn = byteIndex;
+				int used;
 				while(charCount > 0)
 				{
+					// Convert as many characters as possible in the engine.
+					if(left == 0)
+					{
+						used = InternalEncode
+							(chars, charIndex, charCount, bytes, ref posn);
+						charIndex += used;
+						charCount -= used;
+						if(charCount == 0)
+						{
+							break;
+						}
+					}
+
 					// Fetch the next UTF-16 character pair value.
 					ch = chars[charIndex++];
 					--charCount;
@@ -367,12 +426,23 @@ public class UTF8Encoding : Encoding
 				int length = bytes.Length;
 				uint pair;
 				int posn = byteIndex;
+				int used;
 				while(charCount > 0)
 				{
+					// Convert as many characters as possible in the engine.
+					used = InternalEncode(s, charIndex, charCount,
+										  bytes, ref posn);
+					charIndex += used;
+					charCount -= used;
+					if(charCount == 0)
+					{
+						break;
+					}
+
 					// Fetch the next UTF-16 character pair value.
 					ch = s[charIndex++];
 					--charCount;
-					if(ch >= '\uD800' && ch <= '\uDBFF' && charCount > 1)
+					if(ch >= '\uD800' && ch <= '\uDBFF' && charCount > 0)
 					{
 						// This may be the start of a surrogate pair.
 						pair = (uint)(s[charIndex]);
@@ -476,8 +546,21 @@ public class UTF8Encoding : Encoding
 				uint leftBits = leftOverBits;
 				uint leftSoFar = (leftOverCount & (uint)0x0F);
 				uint leftSize = ((leftOverCount >> 4) & (uint)0x0F);
+				int used;
 				while(count > 0)
 				{
+					// Count as many characters as possible in the engine.
+					if(leftSize == 0)
+					{
+						used = InternalDecode
+							(bytes, index, count, null, ref length);
+						index += used;
+						count -= used;
+						if(count == 0)
+						{
+							break;
+						}
+					}
 					ch = (uint)(bytes[index++]);
 					--count;
 					if(leftSize == 0)
@@ -633,8 +716,22 @@ public class UTF8Encoding : Encoding
 				uint leftBits = leftOverBits;
 				uint leftSoFar = (leftOverCount & (uint)0x0F);
 				uint leftSize = ((leftOverCount >> 4) & (uint)0x0F);
+				int used;
 				while(byteCount > 0)
 				{
+					// Convert as many bytes as possible in the engine.
+					if(leftSize == 0)
+					{
+						used = InternalDecode
+							(bytes, byteIndex, byteCount, chars, ref posn);
+						byteIndex += used;
+						byteCount -= used;
+						if(byteCount == 0)
+						{
+							break;
+						}
+					}
+
 					// Fetch the next character from the byte buffer.
 					ch = (uint)(bytes[byteIndex++]);
 					--byteCount;
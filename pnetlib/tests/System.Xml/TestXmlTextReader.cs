@@ -282,4 +282,35 @@ public class TestXmlTextReader : TestCase
 				AssertEquals("CharReferenceAndEntityInAttr (4)", "b", xr.Name);
 				AssertEquals("CharReferenceAndEntityInAttr (5)", "C &xxx; D", xr.Value);
 			}
+
+	// Test names and character data that run across the input buffer.
+	public void TestXmlTextReaderLongRuns()
+			{
+				String name = new String('n', 1030);
+				String text = new String('t', 1500);
+				Reset(new StringReader
+					("<doc>\r\n<" + name + " a=\"" + text + "\">" + text +
+					 "</" + name + "><!--" + text + "--></doc>"));
+				xr.WhitespaceHandling = WhitespaceHandling.None;
+				AssertEquals("LongRuns (1)", XmlNodeType.Element, xr.MoveToContent());
+				AssertSame("LongRuns (2)", xr.NameTable.Get("doc"), xr.Name);
+				AssertEquals("LongRuns (3)", true, xr.Read());
+				AssertEquals("LongRuns (4)", name, xr.Name);
+				AssertEquals("LongRuns (5)", 2, xr.LineNumber);
+				AssertEquals("LongRuns (6)", true, xr.MoveToFirstAttribute());
+				AssertEquals("LongRuns (7)", text, xr.Value);
+				AssertEquals("LongRuns (8)", true, xr.Read());
+				AssertEquals("LongRuns (9)", XmlNodeType.Text, xr.NodeType);
+				AssertEquals("LongRuns (10)", text, xr.Value);
+				AssertEquals("LongRuns (11)", true, xr.Read());
+				AssertEquals("LongRuns (12)", XmlNodeType.EndElement, xr.NodeType);
+				AssertSame("LongRuns (13)", xr.NameTable.Get(name), xr.Name);
+				AssertEquals("LongRuns (14)", true, xr.Read());
+				AssertEquals("LongRuns (15)", XmlNodeType.Comment, xr.NodeType);
+				AssertEquals("LongRuns (16)", text, xr.Value);
+				AssertEquals("LongRuns (17)", true, xr.Read());
+				AssertEquals("LongRuns (18)", XmlNodeType.EndElement, xr.NodeType);
+				AssertEquals("LongRuns (19)", false, xr.Read());
+				Clear();
+			}
 }; // class TestXmlTextReader
@@ -39,6 +39,12 @@ public class TestSystem
 				suite.AddTest(SuiteDiagnostics.Suite());
 				fullSuite.AddTest(suite);
 
+			#if !ECMA_COMPAT
+				suite = new TestSuite("Regular Expression Tests");
+				suite.AddTests(typeof(TestRegex));
+				fullSuite.AddTest(suite);
+			#endif
+
 				return fullSuite;
 			}
 
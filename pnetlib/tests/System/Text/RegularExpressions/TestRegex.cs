@@ -0,0 +1,442 @@
+/*
+ * TestRegex.cs - Tests for the "System.Text.RegularExpressions.Regex" class.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+using CSUnit;
+using System;
+using System.Text.RegularExpressions;
+using System.Threading;
+
+#if !ECMA_COMPAT
+
+public class TestRegex : TestCase
+{
+	// Texts that the patterns are tried against.
+	private static readonly String[] texts = {
+		"",
+		"a",
+		"foo",
+		"FOO",
+		"xfoo",
+		"foox",
+		"foo bar",
+		"bar foo baz",
+		"bar\nfoo\nfoo",
+		"foo\n",
+		"foo\n\n",
+		"\nfoo",
+		"aaab",
+		"bbba",
+		"bbbb",
+		"ab ba aab",
+		"\u00e9t\u00e9 foo \u00e9",
+		"k\u212Ak K",
+		"i\u0130I\u0131",
+		"the quick brown fox jumps over the lazy dog"
+	};
+
+	// Texts that the prefix and required literal patterns are tried against.
+	private static readonly String[] literalTexts = {
+		"",
+		"c",
+		"abc",
+		"abcx",
+		"abcabcx",
+		"xabcy",
+		"xy",
+		"ababcdef",
+		"cdef",
+		"aab",
+		"aaab",
+		"aaaab",
+		"abab c",
+		"foobar",
+		"bar baz",
+		"fooba",
+		"kx Kx",
+		"\u212Ax",
+		"ix Ix",
+		"\u0130x",
+		"\u0131x",
+		"xk\u212Az",
+		"a1 b9 c5",
+		"zz b9"
+	};
+
+	// Constructor.
+	public TestRegex(String name)
+			: base(name)
+			{
+				// Nothing to do here.
+			}
+
+	// Set up for the tests.
+	protected override void Setup()
+			{
+				// Nothing to do here.
+			}
+
+	// Clean up after the tests.
+	protected override void Cleanup()
+			{
+				// Nothing to do here.
+			}
+
+	// Compare a pattern against the same pattern followed by an empty
+	// lookahead.  The DFA can't handle lookahead, so every match of the
+	// second pattern is found by the backtracking interpreter alone.
+	private static void Compare(String pattern, RegexOptions options,
+								String text, int startat)
+			{
+				Regex fast = new Regex(pattern, options);
+				Regex slow = new Regex("(?:" + pattern + ")(?=)", options);
+				String msg = "/" + pattern + "/ on \"" + text +
+							 "\" from " + startat.ToString();
+
+				AssertEquals(msg + " (IsMatch)",
+							 slow.IsMatch(text, startat),
+							 fast.IsMatch(text, startat));
+
+				Match expected = slow.Match(text, startat);
+				Match actual = fast.Match(text, startat);
+				AssertEquals(msg + " (Success)",
+							 expected.Success, actual.Success);
+				AssertEquals(msg + " (Index)", expected.Index, actual.Index);
+				AssertEquals(msg + " (Length)",
+							 expected.Length, actual.Length);
+			}
+
+	// Compare a pattern on all of the texts, from every start position,
+	// with and without "RegexOptions.Compiled", which builds the ASCII
+	// part of the DFA up front.
+	private static void Compare(String pattern, RegexOptions options)
+			{
+				foreach(String text in texts)
+				{
+					for(int startat = 0; startat <= text.Length; ++startat)
+					{
+						Compare(pattern, options, text, startat);
+						Compare(pattern, options | RegexOptions.Compiled,
+								text, startat);
+					}
+				}
+			}
+	private static void Compare(String pattern)
+			{
+				Compare(pattern, RegexOptions.None);
+			}
+
+	// Compare a pattern on the literal texts against the same pattern
+	// with an alternative that can never match.  Nothing is known about
+	// the prefixes or required literals of a lookahead, so the second
+	// pattern is matched without the prefilter or the DFA.
+	private static void CompareFilter(String pattern, RegexOptions options)
+			{
+				Regex fast = new Regex(pattern, options);
+				Regex slow = new Regex("(?:" + pattern + ")|(?!)", options);
+
+				foreach(String text in literalTexts)
+				{
+					for(int startat = 0; startat <= text.Length; ++startat)
+					{
+						String msg = "/" + pattern + "/ on \"" + text +
+									 "\" from " + startat.ToString();
+
+						AssertEquals(msg + " (IsMatch)",
+									 slow.IsMatch(text, startat),
+									 fast.IsMatch(text, startat));
+
+						Match expected = slow.Match(text, startat);
+						Match actual = fast.Match(text, startat);
+						AssertEquals(msg + " (Success)",
+									 expected.Success, actual.Success);
+						AssertEquals(msg + " (Index)",
+									 expected.Index, actual.Index);
+						AssertEquals(msg + " (Length)",
+									 expected.Length, actual.Length);
+					}
+				}
+			}
+	private static void CompareFilter(String pattern)
+			{
+				CompareFilter(pattern, RegexOptions.None);
+			}
+
+	// Test the start and end of string anchors.
+	public void TestRegexStringAnchors()
+			{
+				Compare(@"\Afo+");
+				Compare(@"\Afo+|bar");
+				Compare(@"fo+\z");
+				Compare(@"fo+\Z");
+				Compare(@"o+\Z");
+				Compare(@"\A\w*\Z");
+				Compare(@"^fo*$");
+				Compare(@"^$");
+
+				Assert("\\Z before a final newline",
+					   Regex.IsMatch("foo\n", @"foo\Z"));
+				Assert("\\Z before two newlines",
+					   !Regex.IsMatch("foo\n\n", @"foo\Z"));
+				Assert("\\A after the start",
+					   !new Regex(@"\Afoo").IsMatch("xfoo", 1));
+			}
+
+	// Test the line anchors in multiline mode.
+	public void TestRegexLineAnchors()
+			{
+				Regex regex;
+
+				Compare(@"^fo+$", RegexOptions.Multiline);
+				Compare(@"^fo+", RegexOptions.Multiline);
+				Compare(@"fo+$", RegexOptions.Multiline);
+				Compare(@"^$", RegexOptions.Multiline);
+				Compare(@"^\w+$", RegexOptions.Multiline);
+				Compare(@"o$\n^f", RegexOptions.Multiline);
+
+				regex = new Regex("^foo", RegexOptions.Multiline);
+				AssertEquals("^ after a newline", 4,
+							 regex.Match("bar\nfoo\nfoo", 1).Index);
+			}
+
+	// Test the word boundary assertions.
+	public void TestRegexBoundaries()
+			{
+				Compare(@"\bfo+\b");
+				Compare(@"\bfo+");
+				Compare(@"\Bfo+");
+				Compare(@"fo+\B");
+				Compare(@"\B");
+				Compare(@"\b");
+				Compare(@"\b\w+\b");
+				Compare(@"a+\b ");
+				Compare("\\bt\u00e9+\\b");
+
+				Assert("\\b inside a word",
+					   !Regex.IsMatch("xfoo", @"\bfoo\b"));
+				Assert("\\B inside a word",
+					   Regex.IsMatch("xfoo", @"\Bfoo"));
+			}
+
+	// Test matching without regard to case.
+	public void TestRegexIgnoreCase()
+			{
+								Compare("fo+", RegexOptions.IgnoreCase);
+				Compare("[a-f]o+", RegexOptions.IgnoreCase);
+				Compare("[^o]oo", RegexOptions.IgnoreCase);
+				Compare("k+", RegexOptions.IgnoreCase);
+				Compare("[i]+", RegexOptions.IgnoreCase);
+				Compare(@"\bFO+\b", RegexOptions.IgnoreCase);
+				Compare("^FO+$", RegexOptions.IgnoreCase |
+								 RegexOptions.Multiline);
+
+				Assert("upper case text",
+					   Regex.IsMatch("FOO", "fo+", RegexOptions.IgnoreCase));
+				Assert("upper case pattern",
+					   Regex.IsMatch("xfoo", "FO+", RegexOptions.IgnoreCase));
+			}
+
+	// Test a negated class that is followed by a member of its complement.
+	public void TestRegexNegatedClass()
+			{
+				Compare("[^a]*a");
+				Compare("[^a]+a");
+				Compare("[^a]*a", RegexOptions.IgnoreCase);
+				Compare("b[^a]*a");
+				Compare("[^ab]*(a|b)");
+
+				AssertEquals("[^a]*a", "bbba",
+							 Regex.Match("bbba", "[^a]*a").Value);
+				Assert("[^a]*a without a", !Regex.IsMatch("bbbb", "[^a]*a"));
+			}
+
+	// Test starting a search part of the way through the text.
+	public void TestRegexStartAt()
+			{
+				Regex regex;
+
+				Compare("fo+|bar");
+				Compare("o+");
+				Compare("(?:ab|a)*b");
+				Compare(".*");
+				Compare("a?");
+
+				regex = new Regex("foo");
+				AssertEquals("foo from 1", 8,
+							 regex.Match("foo bar foo", 1).Index);
+				Assert("foo from the end",
+					   !regex.IsMatch("foo bar foo", 11));
+
+				regex = new Regex("a*");
+				AssertEquals("empty match at the end", 4,
+							 regex.Match("aaab", 4).Index);
+			}
+
+	// Test the prefixes of alternatives, which are combined into one set.
+	public void TestRegexPrefixUnion()
+			{
+				CompareFilter("foo|bar|baz");
+				CompareFilter("(?:ab|cd)[ef]");
+				CompareFilter("(?:a|b)(?:c|b)");
+				CompareFilter("[abc]x|d");
+				CompareFilter("ab(?:c|)x|zz");
+				CompareFilter("(?:ab|a)(?:b|)c");
+				CompareFilter("a1|a2|a3|a4|a5|a6|a7|a8|a9|" +
+							  "b1|b2|b3|b4|b5|b6|b7|b8|b9");
+				CompareFilter("(?:a|b|c|d|e|f|g|h)(?:1|5|9|x)");
+				CompareFilter("(?i:ab)c|CD");
+
+				AssertEquals("union", 4,
+							 Regex.Match("bar baz", "baz|foo").Index);
+			}
+
+	// Test prefixes and required literals of repeats that may be empty.
+	public void TestRegexPrefixRepeat()
+			{
+				CompareFilter("a{0,3}b");
+				CompareFilter("(?:ab){0,2}c");
+				CompareFilter("(?:foo){0,1}bar");
+				CompareFilter("x{0}y");
+				CompareFilter("(?:abc){0,1}x");
+				CompareFilter("(?:ab){0,2}?c");
+				CompareFilter("a*b|c");
+
+				AssertEquals("{0,n}", "aaab",
+							 Regex.Match("aaaab", "a{0,3}b").Value);
+				AssertEquals("{0}", "y", Regex.Match("xy", "x{0}y").Value);
+			}
+
+	// Test ignore case prefixes, which must also find the characters
+	// that only lower to a prefix character.
+	public void TestRegexPrefixIgnoreCase()
+			{
+				CompareFilter("kx|zz", RegexOptions.IgnoreCase);
+				CompareFilter("k+z|ab", RegexOptions.IgnoreCase);
+				CompareFilter("ix|zz", RegexOptions.IgnoreCase);
+				CompareFilter("[ik]x|zz", RegexOptions.IgnoreCase);
+				CompareFilter("(?:k|i)x|zz", RegexOptions.IgnoreCase);
+				CompareFilter("(?i:k)x|ab");
+				CompareFilter("Kx|Ix", RegexOptions.IgnoreCase);
+				CompareFilter("KX|\u212Ax");
+				CompareFilter("xk|\u0130x", RegexOptions.IgnoreCase);
+
+				Assert("upper case prefix",
+					   Regex.IsMatch("Kx", "kx", RegexOptions.IgnoreCase));
+			}
+
+	// Test literals that every match must contain, including literals
+	// inside repeats.
+	public void TestRegexRequiredLiteral()
+			{
+				CompareFilter("a*(?:abc)+x");
+				CompareFilter("\\w*(?:abc){2}x");
+				CompareFilter("(?:ab|cd)+");
+				CompareFilter("\\w*x(?:abc)*y");
+				CompareFilter("[xy]*(?:a(bcd))+");
+				CompareFilter("[a-z]*(?:bc)+[a-z]");
+				CompareFilter("b*(?:xab+c)+");
+				CompareFilter("\\w+(?:ab)+c");
+				CompareFilter("[^x]*(?:ba)+r", RegexOptions.IgnoreCase);
+
+				AssertEquals("literal in a repeat", "abcabcx",
+							 Regex.Match("abcabcx", "(?:abc)+x").Value);
+				Assert("no literal", !Regex.IsMatch("abab c", "(?:abc)+"));
+			}
+
+	// Worker for "TestRegexThreads".
+	private sealed class Scanner
+	{
+		private Regex regex;
+		private String[] inputs;
+		private bool[] expected;
+		public bool failed;
+
+		public Scanner(Regex regex, String[] inputs, bool[] expected)
+				{
+					this.regex = regex;
+					this.inputs = inputs;
+					this.expected = expected;
+				}
+
+		public void Run()
+				{
+					for(int iter = 0; iter < 20; ++iter)
+					{
+						for(int posn = 0; posn < inputs.Length; ++posn)
+						{
+							if(regex.IsMatch(inputs[posn]) != expected[posn])
+							{
+								failed = true;
+							}
+						}
+					}
+				}
+	};
+
+	// Test scanning with a shared pattern from several threads, while
+	// the DFA is still being built.
+	public void TestRegexThreads()
+			{
+				String[] inputs = new String[64];
+				bool[] expected = new bool[inputs.Length];
+				Scanner[] scanners = new Scanner[4];
+				Thread[] threads = new Thread[scanners.Length];
+				Regex regex;
+				int posn;
+
+				// Use characters from many pages of the transition table
+				for(posn = 0; posn < inputs.Length; ++posn)
+				{
+					char ch = (char)(0x0100 * (posn + 1) + posn);
+					inputs[posn] = new String(ch, posn) +
+								   ((posn % 3) == 0 ? "xy" : "x") +
+								   new String(ch, 3);
+					expected[posn] = ((posn % 3) == 0);
+				}
+				regex = new Regex("[^x]*xy");
+
+				for(posn = 0; posn < scanners.Length; ++posn)
+				{
+					scanners[posn] = new Scanner(regex, inputs, expected);
+					threads[posn] = new Thread
+						(new ThreadStart(scanners[posn].Run));
+				}
+				try
+				{
+					for(posn = 0; posn < threads.Length; ++posn)
+					{
+						threads[posn].Start();
+					}
+				}
+				catch(NotSupportedException)
+				{
+					// The engine was built without thread support.
+					return;
+				}
+				for(posn = 0; posn < threads.Length; ++posn)
+				{
+					threads[posn].Join();
+					Assert("thread " + posn.ToString(),
+						   !scanners[posn].failed);
+				}
+			}
+
+}; // class TestRegex
+
+#endif // !ECMA_COMPAT
@@ -0,0 +1,168 @@
+/*
+ * TestStackTrace.cs - Tests for the "StackTrace" class.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+using CSUnit;
+using System;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+
+#if CONFIG_EXTENDED_DIAGNOSTICS
+
+public class TestStackTrace : TestCase
+{
+	// Constructor.
+	public TestStackTrace(String name)
+			: base(name)
+			{
+				// Nothing to do here.
+			}
+
+	// Set up for the tests.
+	protected override void Setup()
+			{
+				// Nothing to do here.
+			}
+
+	// Clean up after the tests.
+	protected override void Cleanup()
+			{
+				// Nothing to do here.
+			}
+
+	// Throw from one of two places, depending upon "which".
+	[MethodImpl(MethodImplOptions.NoInlining)]
+	private static void ThrowAt(int which)
+			{
+				if(which == 0)
+				{
+					throw new InvalidOperationException("first");
+				}
+				int total = 0;
+				for(int i = 0; i < which; ++i)
+				{
+					total += i;
+				}
+				throw new ArgumentException(total.ToString());
+			}
+
+	// Recurse "depth" times and then throw from the first place.
+	[MethodImpl(MethodImplOptions.NoInlining)]
+	private static int Recurse(int depth)
+			{
+				if(depth > 0)
+				{
+					return Recurse(depth - 1) + 1;
+				}
+				ThrowAt(0);
+				return 0;
+			}
+
+	// Get the stack trace for the exception thrown by "ThrowAt".
+	private static StackTrace TraceOf(int which)
+			{
+				try
+				{
+					ThrowAt(which);
+				}
+				catch(Exception e)
+				{
+					return new StackTrace(e);
+				}
+				return null;
+			}
+
+	// Check that a frame has a resolved IL offset and return it.
+	private static int Offset(StackTrace trace, int index, String msg)
+			{
+				StackFrame frame = trace.GetFrame(index);
+				AssertNotNull(msg + " frame", frame);
+				int offset = frame.GetILOffset();
+				Assert(msg + " offset " + offset.ToString(), offset >= 0);
+				return offset;
+			}
+
+	// Test the IL offsets in the trace of a thrown exception.
+	public void TestStackTraceILOffset()
+			{
+				StackTrace first = TraceOf(0);
+				StackTrace second = TraceOf(1);
+				AssertNotNull("first", first);
+				AssertNotNull("second", second);
+				Assert("first count", first.FrameCount >= 2);
+				Assert("second count", second.FrameCount >= 2);
+
+			#if CONFIG_REFLECTION
+				AssertEquals("first method", "ThrowAt",
+							 first.GetFrame(0).GetMethod().Name);
+				AssertEquals("caller method", "TraceOf",
+							 first.GetFrame(1).GetMethod().Name);
+			#endif
+
+				// The second throw comes later in "ThrowAt" than the first,
+				// and both traces pass through the same call in "TraceOf".
+				int throw1 = Offset(first, 0, "first throw");
+				int throw2 = Offset(second, 0, "second throw");
+				Assert("throw order", throw1 < throw2);
+				AssertEquals("call site", Offset(first, 1, "first call"),
+							 Offset(second, 1, "second call"));
+			}
+
+	// Test that every frame of a deeper trace is resolved consistently.
+	public void TestStackTraceILOffsetRecursive()
+			{
+				StackTrace trace = null;
+				try
+				{
+					Recurse(4);
+				}
+				catch(InvalidOperationException e)
+				{
+					trace = new StackTrace(e);
+				}
+				AssertNotNull("trace", trace);
+				Assert("count", trace.FrameCount >= 7);
+
+				// The throw matches the one seen from "TraceOf".
+				AssertEquals("throw", Offset(TraceOf(0), 0, "throw"),
+							 Offset(trace, 0, "throw"));
+
+				// The recursive calls all come from the same place, which
+				// differs from the call that leads to "ThrowAt".
+				int call = Offset(trace, 1, "call");
+				int recurse = Offset(trace, 2, "recurse");
+				Assert("distinct calls", call != recurse);
+				for(int index = 3; index <= 5; ++index)
+				{
+					AssertEquals("recurse " + index.ToString(), recurse,
+								 Offset(trace, index, "recurse"));
+				}
+
+			#if CONFIG_REFLECTION
+				for(int index = 1; index <= 5; ++index)
+				{
+					AssertEquals("method " + index.ToString(), "Recurse",
+								 trace.GetFrame(index).GetMethod().Name);
+				}
+			#endif
+			}
+
+}; // class TestStackTrace
+
+#endif // CONFIG_EXTENDED_DIAGNOSTICS
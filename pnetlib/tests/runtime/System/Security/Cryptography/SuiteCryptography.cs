@@ -38,6 +38,7 @@ public class SuiteCryptography
 				suite.AddTests(typeof(TestSHA256));
 				suite.AddTests(typeof(TestSHA384));
 				suite.AddTests(typeof(TestSHA512));
+				suite.AddTests(typeof(TestHashBatch));
 				suite.AddTests(typeof(TestRNG));
 			#endif
 				return suite;
@@ -0,0 +1,201 @@
+/*
+ * TestHashBatch.cs - Test the "HashBatch" class.
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+using CSUnit;
+using System;
+using System.Text;
+using System.Security.Cryptography;
+
+#if CONFIG_CRYPTO
+
+public class TestHashBatch : CryptoTestCase
+{
+
+	// Constructor.
+	public TestHashBatch(String name)
+			: base(name)
+			{
+				// Nothing to do here.
+			}
+
+	// A subclass that the engine does not know about, which
+	// must be hashed one message at a time.
+	private class SHA256Subclass : SHA256Managed
+	{
+		public SHA256Subclass() : base() {}
+	};
+
+	// Known SHA256 hash values for "abc" and "".
+	private static readonly byte[] shaExpectedABC =
+		{0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+		 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+		 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+	private static readonly byte[] shaExpectedEmpty =
+		{0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14,
+		 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+		 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c,
+		 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+
+	// Build a buffer of test data and split it into messages of
+	// different lengths, some of which span several blocks.
+	private static byte[] MakeMessages(out int[] offsets, out int[] lengths)
+			{
+				int count = 11;
+				int posn, offset;
+				offsets = new int [count];
+				lengths = new int [count];
+				offset = 0;
+				for(posn = 0; posn < count; ++posn)
+				{
+					offsets[posn] = offset;
+					lengths[posn] = (posn * 37) % 150;
+					offset += lengths[posn];
+				}
+				byte[] buffer = new byte [offset];
+				for(posn = 0; posn < offset; ++posn)
+				{
+					buffer[posn] = (byte)(posn * 7 + 3);
+				}
+				return buffer;
+			}
+
+	// Check a batch against hashing the messages one at a time.
+	private void RunBatch(String msg, HashAlgorithm alg)
+			{
+				int[] offsets;
+				int[] lengths;
+				byte[] buffer = MakeMessages(out offsets, out lengths);
+				int size = alg.HashSize / 8;
+				byte[] hashes = HashBatch.ComputeHashes
+					(alg, buffer, offsets, lengths);
+				AssertEquals(msg + " length", offsets.Length * size,
+							 hashes.Length);
+				int posn;
+				byte[] hash;
+				for(posn = 0; posn < offsets.Length; ++posn)
+				{
+					hash = alg.ComputeHash(buffer, offsets[posn], lengths[posn]);
+					if(!IdenticalBlock(hash, 0, hashes, posn * size, size))
+					{
+						Fail(msg + " hash " + posn.ToString() + " is wrong");
+					}
+				}
+			}
+
+	// Test the batch against known SHA256 hash values.
+	public void TestHashBatchSHA256Known()
+			{
+				byte[] buffer = Encoding.ASCII.GetBytes("xabcx");
+				int[] offsets = new int[] {1, 0, 5};
+				int[] lengths = new int[] {3, 0, 0};
+				byte[] hashes = HashBatch.ComputeHashes
+					(new SHA256Managed(), buffer, offsets, lengths);
+				AssertEquals("length", 96, hashes.Length);
+				Assert("abc", IdenticalBlock(shaExpectedABC, 0, hashes, 0, 32));
+				Assert("empty 1",
+					   IdenticalBlock(shaExpectedEmpty, 0, hashes, 32, 32));
+				Assert("empty 2",
+					   IdenticalBlock(shaExpectedEmpty, 0, hashes, 64, 32));
+			}
+
+	// Test batches for each of the algorithms in the engine.
+	public void TestHashBatchAlgorithms()
+			{
+				RunBatch("MD5", new MD5CryptoServiceProvider());
+				RunBatch("SHA1", new SHA1CryptoServiceProvider());
+				RunBatch("SHA256", new SHA256Managed());
+				RunBatch("SHA384", new SHA384Managed());
+				RunBatch("SHA512", new SHA512Managed());
+			}
+
+	// Test a batch for an algorithm that the engine does not know about.
+	public void TestHashBatchOther()
+			{
+				RunBatch("SHA256 subclass", new SHA256Subclass());
+			}
+
+	// Test an empty batch.
+	public void TestHashBatchEmpty()
+			{
+				byte[] hashes = HashBatch.ComputeHashes
+					(new SHA256Managed(), new byte [0], new int [0], new int [0]);
+				AssertEquals("length", 0, hashes.Length);
+			}
+
+	// Test that messages outside the buffer are rejected.
+	public void TestHashBatchRange()
+			{
+				SHA256Managed alg = new SHA256Managed();
+				byte[] buffer = new byte [16];
+				try
+				{
+					HashBatch.ComputeHashes
+						(alg, buffer, new int[] {17}, new int[] {0});
+					Fail("offset past the end");
+				}
+				catch(ArgumentOutOfRangeException)
+				{
+					// Success case.
+				}
+				try
+				{
+					HashBatch.ComputeHashes
+						(alg, buffer, new int[] {-1}, new int[] {1});
+					Fail("negative offset");
+				}
+				catch(ArgumentOutOfRangeException)
+				{
+					// Success case.
+				}
+				try
+				{
+					HashBatch.ComputeHashes
+						(alg, buffer, new int[] {8}, new int[] {9});
+					Fail("length past the end");
+				}
+				catch(ArgumentException)
+				{
+					// Success case.
+				}
+				try
+				{
+					HashBatch.ComputeHashes
+						(alg, buffer, new int[] {0, 4}, new int[] {1});
+					Fail("mismatched lengths");
+				}
+				catch(ArgumentException)
+				{
+					// Success case.
+				}
+				try
+				{
+					HashBatch.ComputeHashes(alg, null, new int [0], new int [0]);
+					Fail("null buffer");
+				}
+				catch(ArgumentNullException)
+				{
+					// Success case.
+				}
+			}
+
+}; // TestHashBatch
+
+#endif // CONFIG_CRYPTO
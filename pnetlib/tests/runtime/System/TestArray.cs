@@ -387,4 +387,145 @@ public class TestArray : TestCase
 				AssertEquals("Sort (8)", 104, list[2]);
 			}
 
+	// Helper methods for the counted loop tests.  These use the loop
+	// forms that the JIT recognizes, with the array in an argument.
+	private static int SumLoop(int[] a)
+			{
+				int sum = 0;
+				int i;
+				for(i = 0; i < a.Length; ++i)
+				{
+					sum += a[i];
+				}
+				return sum;
+			}
+	private static int SumForeach(int[] a)
+			{
+				int sum = 0;
+				foreach(int value in a)
+				{
+					sum += value;
+				}
+				return sum;
+			}
+	private static void FillLoop(int[] a, int start)
+			{
+				int i;
+				for(i = start; i < a.Length; ++i)
+				{
+					a[i] = i * 2;
+				}
+			}
+	private static int SumNext(int[] a)
+			{
+				int sum = 0;
+				int i;
+				for(i = 0; i < a.Length; ++i)
+				{
+					sum += a[i + 1];
+				}
+				return sum;
+			}
+	private static int SumOther(int[] a, int[] b)
+			{
+				int sum = 0;
+				int i;
+				for(i = 0; i < a.Length; ++i)
+				{
+					sum += b[i];
+				}
+				return sum;
+			}
+	private static int SumSkip(int[] a)
+			{
+				int sum = 0;
+				int i;
+				for(i = 0; i < a.Length; ++i)
+				{
+					if(i == 2)
+					{
+						i = a.Length;
+					}
+					sum += a[i];
+				}
+				return sum;
+			}
+	private static int SumReplace(int[] a, int[] b)
+			{
+				int sum = 0;
+				int i;
+				for(i = 0; i < a.Length; ++i)
+				{
+					if(i == 2)
+					{
+						a = b;
+					}
+					sum += a[i];
+				}
+				return sum;
+			}
+
+	// Test counted loops over arrays, whose bounds checks may be omitted.
+	public void TestArrayCountedLoop()
+			{
+				int[] a = new int [] {1, 2, 3, 4, 5};
+				int[] b = new int [] {10, 20, 30};
+
+				// Test loops that stay within the bounds.
+				AssertEquals("Loop (1)", 15, SumLoop(a));
+				AssertEquals("Loop (2)", 15, SumForeach(a));
+				AssertEquals("Loop (3)", 0, SumLoop(new int [0]));
+				FillLoop(a, 2);
+				AssertEquals("Loop (4)", 1 + 2 + 4 + 6 + 8, SumLoop(a));
+				FillLoop(a, 7);
+				AssertEquals("Loop (5)", 1 + 2 + 4 + 6 + 8, SumLoop(a));
+
+				// Test loops that index out of range, which must still throw.
+				try
+				{
+					SumNext(a);
+					Fail("Loop (6)");
+				}
+				catch(IndexOutOfRangeException)
+				{
+					// Test succeeded.
+				}
+				try
+				{
+					SumOther(a, b);
+					Fail("Loop (7)");
+				}
+				catch(IndexOutOfRangeException)
+				{
+					// Test succeeded.
+				}
+				try
+				{
+					SumSkip(a);
+					Fail("Loop (8)");
+				}
+				catch(IndexOutOfRangeException)
+				{
+					// Test succeeded.
+				}
+				try
+				{
+					SumReplace(a, new int [] {10, 20});
+					Fail("Loop (9)");
+				}
+				catch(IndexOutOfRangeException)
+				{
+					// Test succeeded.
+				}
+				try
+				{
+					SumLoop(null);
+					Fail("Loop (10)");
+				}
+				catch(NullReferenceException)
+				{
+					// Test succeeded.
+				}
+			}
+
 }; // class TestArray
@@ -601,6 +601,22 @@ public class TestString : TestCase
 		AssertEquals("fubar.IndexOfAny(c,21)",fubar.IndexOfAny(c,21),-1);
 		AssertEquals("fubar.IndexOfAny(c,2,5)",fubar.IndexOfAny(c,2,5),6);
 		AssertEquals("fubar.IndexOfAny(c,2,3)",fubar.IndexOfAny(c,2,3),-1);			
+
+		// long runs without a match, and more characters than are
+		// compared side by side
+		String lamb = new String('x', 40) + "lamb" + new String('y', 40);
+		char[] many = new char[] {'0','1','2','3','4','5','6','7','8','b'};
+		AssertEquals("lamb.IndexOfAny({'m','l'})",
+					 lamb.IndexOfAny(new char[] {'m','l'}),40);
+		AssertEquals("lamb.IndexOfAny({'m','l'},41)",
+					 lamb.IndexOfAny(new char[] {'m','l'},41),42);
+		AssertEquals("lamb.IndexOfAny(many)",lamb.IndexOfAny(many),43);
+		AssertEquals("lamb.IndexOfAny(many,0,43)",
+					 lamb.IndexOfAny(many,0,43),-1);
+		AssertEquals("lamb.IndexOfAny({'z'})",
+					 lamb.IndexOfAny(new char[] {'z'}),-1);
+		AssertEquals("lamb.IndexOfAny({'\\uFF79','y'})",
+					 lamb.IndexOfAny(new char[] {'\uFF79','y'}),44);
 	}
 
 	public void TestStringInsert()
@@ -28,6 +28,7 @@ public class SuiteText
 			{
 				TestSuite suite = new TestSuite("Text Tests");
 				suite.AddTests(typeof(TestStringBuilder));
+				suite.AddTests(typeof(TestUTF8Encoding));
 				return suite;
 			}
 
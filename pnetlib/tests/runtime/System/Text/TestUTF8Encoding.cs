@@ -0,0 +1,156 @@
+/*
+ * TestUTF8Encoding.cs - Test class for "System.Text.UTF8Encoding".
+ *
+ * Copyright (C) 2026  Free Software Foundation, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+using CSUnit;
+using System;
+using System.Text;
+
+public class TestUTF8Encoding : TestCase
+{
+	// Constructor.
+	public TestUTF8Encoding(String name)
+			: base(name)
+			{
+				// Nothing to do here.
+			}
+
+	// Set up for the tests.
+	protected override void Setup()
+			{
+				// Nothing to do here.
+			}
+
+	// Clean up after the tests.
+	protected override void Cleanup()
+			{
+				// Nothing to do here.
+			}
+
+	// Build a test string with long ASCII runs between other characters.
+	private static String MixedString()
+			{
+				StringBuilder builder = new StringBuilder();
+				int posn;
+				for(posn = 0; posn < 40; ++posn)
+				{
+					builder.Append("The quick brown fox jumps over the dog ");
+					builder.Append((char)(0x00A0 + posn));
+					builder.Append((char)(0x4E00 + posn));
+					builder.Append('\uD834');
+					builder.Append((char)(0xDD1E + posn));
+				}
+				return builder.ToString();
+			}
+
+	// Compare two byte arrays.
+	private void AssertBytes(String msg, byte[] expected, byte[] actual)
+			{
+				AssertEquals(msg + " (length)", expected.Length, actual.Length);
+				int posn;
+				for(posn = 0; posn < expected.Length; ++posn)
+				{
+					AssertEquals(msg + " (" + posn.ToString() + ")",
+								 expected[posn], actual[posn]);
+				}
+			}
+
+	// Test encoding and decoding strings with mixed content.
+	public void TestUTF8EncodingRoundTrip()
+			{
+				UTF8Encoding enc = new UTF8Encoding();
+				String s = MixedString();
+				byte[] bytes = enc.GetBytes(s);
+				AssertEquals("GetByteCount (String)",
+							 bytes.Length, enc.GetByteCount(s));
+				AssertEquals("GetByteCount (char[])", bytes.Length,
+							 enc.GetByteCount(s.ToCharArray()));
+				AssertEquals("GetCharCount", s.Length, enc.GetCharCount(bytes));
+				AssertEquals("GetString", s, enc.GetString(bytes));
+				AssertBytes("GetBytes (char[])", bytes,
+							enc.GetBytes(s.ToCharArray()));
+			}
+
+	// Test the handling of unusual input.
+	public void TestUTF8EncodingSpecial()
+			{
+				UTF8Encoding enc = new UTF8Encoding();
+
+				// Byte order marks are dropped when decoding.
+				AssertEquals("BOM", "ab",
+							 enc.GetString(new byte [] {(byte)'a', 0xEF, 0xBB,
+							 							0xBF, (byte)'b'}));
+
+				// Invalid bytes in the middle of a run are skipped.
+				AssertEquals("Invalid", "abc",
+							 enc.GetString(new byte [] {(byte)'a', 0x80,
+							 							(byte)'b', 0xC3,
+														(byte)'c'}));
+
+				// Unpaired surrogates are written out as-is.
+				AssertBytes("Unpaired", new byte [] {0x61, 0xED, 0xA0, 0x80,
+													 0x62},
+							enc.GetBytes("a\uD800b"));
+
+				// A surrogate start at the end of a string.
+				AssertBytes("Trailing", new byte [] {0x61, 0xED, 0xA0, 0x80},
+							enc.GetBytes("a\uD800"));
+				AssertBytes("Trailing pair",
+							new byte [] {0x61, 0xF0, 0x9D, 0x84, 0x9E},
+							enc.GetBytes("a\uD834\uDD1E"));
+			}
+
+	// Test decoding when a character is split across calls.
+	public void TestUTF8EncodingDecoder()
+			{
+				UTF8Encoding enc = new UTF8Encoding();
+				String s = MixedString();
+				byte[] bytes = enc.GetBytes(s);
+				Decoder decoder = enc.GetDecoder();
+				char[] chars = new char [s.Length];
+				int posn = 0;
+				int charPosn = 0;
+				int len;
+				while(posn < bytes.Length)
+				{
+					len = bytes.Length - posn;
+					if(len > 7)
+					{
+						len = 7;
+					}
+					charPosn += decoder.GetChars
+						(bytes, posn, len, chars, charPosn);
+					posn += len;
+				}
+				AssertEquals("Decoder", s, new String(chars, 0, charPosn));
+			}
+
+	// Test the ASCII encoding, which shares the same helper routines.
+	public void TestUTF8EncodingASCII()
+			{
+				ASCIIEncoding enc = new ASCIIEncoding();
+				AssertBytes("GetBytes",
+							new byte [] {0x61, 0x3F, 0x62, 0x3F},
+							enc.GetBytes("a\u00E9b\u4E00"));
+				AssertEquals("GetChars", "a?b",
+							 new String(enc.GetChars
+							 	(new byte [] {0x61, 0xE9, 0x62})));
+			}
+
+}; // class TestUTF8Encoding
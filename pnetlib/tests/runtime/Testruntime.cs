@@ -45,6 +45,7 @@ public class Testruntime
 				suite.AddTest(SuiteEmit.Suite());
 #endif // CONFIG_REFLECTION_EMIT
 				suite.AddTest(SuiteReflection.Suite());
+				suite.AddTest(SuiteDiagnostics.Suite());
 				return suite;
 			}
 
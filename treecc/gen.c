@@ -634,8 +634,12 @@ static void GenerateNonVirtual(TreeCCContext *context,
 	else
 	{
 		AssignTriggerPosns(context, oper);
-		GenerateMultiSwitch(context, stream, nonVirt, oper,
-							oper->sortedCases, 0, 1, oper->params, 0);
+		if(!(nonVirt->genTable) ||
+		   !(*(nonVirt->genTable))(context, stream, oper))
+		{
+			GenerateMultiSwitch(context, stream, nonVirt, oper,
+								oper->sortedCases, 0, 1, oper->params, 0);
+		}
 	}
 
 	/* Output the exit point for the operation */
@@ -103,6 +103,13 @@ typedef struct
 	void (*genEnd)(TreeCCContext *context, TreeCCStream *stream,
 				   TreeCCOperation *oper);
 
+	/* Generate a dispatch table for a multi-trigger operation, indexed
+	   by the positions of the triggers.  Returns zero if the language
+	   cannot use a table for the operation, to fall back to "switch".
+	   May be NULL if the language never uses dispatch tables */
+	int (*genTable)(TreeCCContext *context, TreeCCStream *stream,
+					TreeCCOperation *oper);
+
 } TreeCCNonVirtual;
 
 /*
@@ -22,6 +22,7 @@
 #include "input.h"
 #include "info.h"
 #include "gen.h"
+#include "errors.h"
 
 #ifdef	__cplusplus
 extern	"C" {
@@ -38,6 +39,8 @@ static void DefineNodeNumbers(TreeCCContext *context,
 	{
 		TreeCCStreamPrint(stream, "#define %s_kind %d\n",
 						  node->name, node->number);
+		TreeCCStreamPrint(stream, "#define %s_last_kind__ %d\n",
+						  node->name, node->lastNumber);
 	}
 }
 
@@ -519,7 +522,11 @@ static void OutputHelpers(TreeCCContext *context)
 			context->yy_replacement);
 	TreeCCStreamPrint(stream, "#endif\n\n");
 
-	/* yyisa macro */
+	/* yyisa macro: node types are numbered in preorder, so a node is
+	   an instance of a type if its kind is in the type's range.  Node
+	   types that extend a read-only hierarchy are numbered after it,
+	   but not always above every kind of the library that owns it, so
+	   any kind above the range needs the vtable walk */
 	TreeCCStreamPrint(stream, "#ifndef %sisa\n", context->yy_replacement);
 	TreeCCStreamPrint(stream,
 			"extern int %sisa__(const void *vtable__, int kind__);\n",
@@ -528,7 +535,15 @@ static void OutputHelpers(TreeCCContext *context)
 			"#define %sisa(node__,type__) \\\n",
    			context->yy_replacement);
 	TreeCCStreamPrint(stream,
-		"\t(%sisa__((node__)->vtable__, (type__##_kind)))\n",
+		"\t((unsigned int)(%skind(node__) - (type__##_kind)) <= \\\n",
+		context->yy_replacement);
+	TreeCCStreamPrint(stream,
+		"\t (unsigned int)((type__##_last_kind__) - (type__##_kind)) || \\\n");
+	TreeCCStreamPrint(stream,
+		"\t (%skind(node__) > (type__##_last_kind__) && \\\n",
+		context->yy_replacement);
+	TreeCCStreamPrint(stream,
+		"\t  %sisa__((node__)->vtable__, (type__##_kind))))\n",
 		context->yy_replacement);
 	TreeCCStreamPrint(stream, "#endif\n\n");
 
@@ -1575,6 +1590,276 @@ static void C_GenEnd(TreeCCContext *context, TreeCCStream *stream,
 	/* Nothing to do here for C and C++ */
 }
 
+/*
+ * Maximum number of entries in the dispatch table for a multi-trigger
+ * operation.  Larger operations are dispatched with nested switches.
+ */
+#define	C_MAX_TABLE_SIZE	4096
+
+/*
+ * Output the parameter types for a case function pointer.
+ */
+static void CFuncPtrParams(TreeCCStream *stream, TreeCCOperation *oper)
+{
+	TreeCCParam *param;
+	int needComma;
+	TreeCCStreamPrint(stream, ")(");
+	param = oper->params;
+	needComma = 0;
+	while(param != 0)
+	{
+		if(needComma)
+		{
+			TreeCCStreamPrint(stream, ", ");
+		}
+		TreeCCStreamPrint(stream, "%s", param->type);
+		needComma = 1;
+		param = param->next;
+	}
+	if(!needComma)
+	{
+		TreeCCStreamPrint(stream, "void");
+	}
+	TreeCCStreamPrint(stream, ")");
+}
+
+/*
+ * Output the name of a parameter within an operation's entry point.
+ */
+static void CParamName(TreeCCContext *context, TreeCCStream *stream,
+					   TreeCCParam *param, int num)
+{
+	if(param->name)
+	{
+		TreeCCStreamPrint(stream, "%s", param->name);
+	}
+	else
+	{
+		TreeCCStreamPrint(stream, "P%d__", num);
+	}
+	if((param->flags & TREECC_PARAM_TRIGGER) != 0 &&
+	   !IsEnumType(context, param->type))
+	{
+		TreeCCStreamPrint(stream, "__");
+	}
+}
+
+/*
+ * Map the kind offsets of the node types under a trigger type
+ * to their offsets in an operation's "sortedCases" array.
+ */
+static void MapPositions(TreeCCNode *node, int base,
+						 int *map, int multiplier)
+{
+	map[node->number - base] = node->position * multiplier;
+	node = node->firstChild;
+	while(node != 0)
+	{
+		MapPositions(node, base, map, multiplier);
+		node = node->nextSibling;
+	}
+}
+
+/*
+ * Generate a dispatch table for a multi-trigger operation.  The table
+ * is indexed by the offsets of the trigger kinds from the kinds of the
+ * trigger types, which are dense because node types are numbered in
+ * preorder.
+ */
+static int C_GenTable(TreeCCContext *context, TreeCCStream *stream,
+					  TreeCCOperation *oper)
+{
+	TreeCCParam *param;
+	TreeCCNode *type;
+	TreeCCOperationCase *operCase;
+	int size, multiplier;
+	int level, num, posn;
+	int *map, start, index, rest;
+	int isVoid;
+
+	/* Inline operations need the case code in the function body,
+	   and C++ node types are classes, not C structures */
+	if((oper->flags & TREECC_OPER_INLINE) != 0 ||
+	   context->language != TREECC_LANG_C)
+	{
+		return 0;
+	}
+
+	/* Bail out if the table would be too big, or if a trigger type
+	   extends a read-only hierarchy and so its kinds are not dense */
+	size = 1;
+	num = 0;
+	param = oper->params;
+	while(param != 0)
+	{
+		if((param->flags & TREECC_PARAM_TRIGGER) != 0)
+		{
+			type = TreeCCNodeFindByType(context, param->type);
+			if(!type || (type->lastNumber - type->number + 1) != param->size)
+			{
+				return 0;
+			}
+			if(param->size > (C_MAX_TABLE_SIZE / size))
+			{
+				return 0;
+			}
+			size *= param->size;
+			num += param->size;
+		}
+		param = param->next;
+	}
+
+	/* Map the kind offsets for each trigger to "sortedCases" offsets */
+	if((map = (int *)malloc(sizeof(int) * num)) == 0)
+	{
+		TreeCCOutOfMemory(context->input);
+	}
+	start = 0;
+	multiplier = 1;
+	param = oper->params;
+	while(param != 0)
+	{
+		if((param->flags & TREECC_PARAM_TRIGGER) != 0)
+		{
+			type = TreeCCNodeFindByType(context, param->type);
+			MapPositions(type, type->number, map + start, multiplier);
+			start += param->size;
+			multiplier *= param->size;
+		}
+		param = param->next;
+	}
+
+	/* Output the table of case functions */
+	isVoid = !strcmp(oper->returnType, "void");
+	TreeCCStreamPrint(stream, "\tstatic %s (*const table__[%d]",
+					  oper->returnType, size);
+	CFuncPtrParams(stream, oper);
+	TreeCCStreamPrint(stream, " = {\n");
+	for(posn = 0; posn < size; ++posn)
+	{
+		/* Split the table index into kind offsets for the triggers */
+		index = 0;
+		start = 0;
+		rest = posn;
+		param = oper->params;
+		while(param != 0)
+		{
+			if((param->flags & TREECC_PARAM_TRIGGER) != 0)
+			{
+				index += map[start + (rest % param->size)];
+				rest /= param->size;
+				start += param->size;
+			}
+			param = param->next;
+		}
+		operCase = oper->sortedCases[index];
+		if(operCase)
+		{
+			TreeCCStreamPrint(stream, "\t\t(%s (*", oper->returnType);
+			CFuncPtrParams(stream, oper);
+			TreeCCStreamPrint(stream, ")%s_%d__,\n",
+							  oper->name, operCase->number);
+		}
+		else
+		{
+			TreeCCStreamPrint(stream, "\t\t0,\n");
+		}
+	}
+	TreeCCStreamPrint(stream, "\t};\n");
+	free(map);
+	TreeCCStreamPrint(stream, "\tunsigned int index__;\n");
+	TreeCCStreamPrint(stream, "\tunsigned int posn__;\n");
+
+	/* Compute the index from the trigger positions, checking that
+	   each is in range for its trigger type */
+	param = oper->params;
+	num = 1;
+	level = 0;
+	multiplier = 1;
+	while(param != 0)
+	{
+		if((param->flags & TREECC_PARAM_TRIGGER) != 0)
+		{
+			type = TreeCCNodeFindByType(context, param->type);
+			Indent(stream, level + 1);
+			TreeCCStreamPrint(stream, "%s = (unsigned int)(",
+							  (level == 0 ? "index__" : "posn__"));
+			CParamName(context, stream, param, num);
+			if((type->flags & TREECC_NODE_ENUM) != 0)
+			{
+				/* Enumerated values follow the position of the type */
+				TreeCCStreamPrint(stream, ") + 1;\n");
+			}
+			else if(context->kind_in_vtable)
+			{
+				TreeCCStreamPrint(stream, "->vtable__->kind__ - %s_kind);\n",
+								  type->name);
+			}
+			else
+			{
+				TreeCCStreamPrint(stream, "->kind__ - %s_kind);\n",
+								  type->name);
+			}
+			Indent(stream, level + 1);
+			TreeCCStreamPrint(stream, "if(%s < %d)\n",
+							  (level == 0 ? "index__" : "posn__"),
+							  param->size);
+			Indent(stream, level + 1);
+			TreeCCStreamPrint(stream, "{\n");
+			if(level != 0)
+			{
+				Indent(stream, level + 2);
+				TreeCCStreamPrint(stream, "index__ += posn__ * %d;\n",
+								  multiplier);
+			}
+			multiplier *= param->size;
+			++level;
+		}
+		if(!(param->name))
+		{
+			++num;
+		}
+		param = param->next;
+	}
+
+	/* Call the case function for the index, if there is one */
+	Indent(stream, level + 1);
+	TreeCCStreamPrint(stream, "if(table__[index__] != 0)\n");
+	Indent(stream, level + 1);
+	TreeCCStreamPrint(stream, "{\n");
+	Indent(stream, level + 2);
+	if(!isVoid)
+	{
+		TreeCCStreamPrint(stream, "return ");
+	}
+	TreeCCStreamPrint(stream, "(*(table__[index__]))(");
+	param = oper->params;
+	num = 1;
+	while(param != 0)
+	{
+		CParamName(context, stream, param, num);
+		if(!(param->name))
+		{
+			++num;
+		}
+		param = param->next;
+		if(param != 0)
+		{
+			TreeCCStreamPrint(stream, ", ");
+		}
+	}
+	TreeCCStreamPrint(stream, ");\n");
+	Indent(stream, level + 1);
+	TreeCCStreamPrint(stream, "}\n");
+	while(level > 0)
+	{
+		Indent(stream, level);
+		TreeCCStreamPrint(stream, "}\n");
+		--level;
+	}
+	return 1;
+}
+
 /*
  * Table of non-virtual code generation functions.
  */
@@ -1593,6 +1878,7 @@ TreeCCNonVirtual const TreeCCNonVirtualFuncsC = {
 	C_GenEndSwitch,
 	C_GenExit,
 	C_GenEnd,
+	C_GenTable,
 };
 
 /*
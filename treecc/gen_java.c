@@ -1230,6 +1230,7 @@ TreeCCNonVirtual const TreeCCNonVirtualFuncsJava = {
 	Java_GenEndSwitch,
 	Java_GenExit,
 	Java_GenEnd,
+	0,
 };
 
 /*
@@ -1327,6 +1327,7 @@ TreeCCNonVirtual const TreeCCNonVirtualFuncsPHP = {
 	PHP_GenEndSwitch,
 	PHP_GenExit,
 	PHP_GenEnd,
+	0,
 };
 
  
@@ -707,7 +707,8 @@ static TreeCCNonVirtual const TreeCCNonVirtualFuncsPython = {
 	PythonGenEndCase,
 	PythonGenEndSwitch,
 	PythonGenExit,
-	PythonGenEnd
+	PythonGenEnd,
+	0
 };
 
 /*
@@ -1187,6 +1187,7 @@ TreeCCNonVirtual const TreeCCNonVirtualFuncsRuby = {
 	Ruby_GenEndSwitch,
 	Ruby_GenExit,
 	Ruby_GenEnd,
+	0,
 };
 
 void TreeCCGenerateRuby(TreeCCContext *context)
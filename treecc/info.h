@@ -51,6 +51,7 @@ typedef struct _tagTreeCCOperationCase	TreeCCOperationCase;
 #define	TREECC_NODE_TYPEDEF			4
 #define	TREECC_NODE_ENUM			8
 #define	TREECC_NODE_ENUM_VALUE		16
+#define	TREECC_NODE_READONLY		32
 #define	TREECC_NODE_MARK(n)			(0x100 << (n))
 #define	TREECC_NODE_MARK_BITS		0xFF00
 
@@ -104,6 +105,7 @@ struct _tagTreeCCNode
 	char		   *name;		/* Name of this node type */
 	int				flags;		/* Node flags */
 	int				number;		/* Number associated with this node type */
+	int				lastNumber;	/* Number of the last descendant node type */
 	int				position;	/* Position within the tree for operations */
 	char		   *filename;	/* File that defines the node type */
 	long			linenum;	/* Line where the node type is defined */
@@ -242,6 +244,9 @@ typedef struct _tagTreeCCContext
 	/* Current node type number */
 	int				nodeNumber;
 
+	/* Nesting depth of read-only include files */
+	int				readOnlyDepth;
+
 	/* Output source language to use */
 	int				language;
 
@@ -307,6 +312,8 @@ TreeCCNode *TreeCCNodeFindByType(TreeCCContext *context, const char *name);
 
 /*
  * Validate the node type hierarchy to ensure that everything is defined.
+ * This also numbers the node types in preorder, so that the numbers for
+ * a node type and its descendants form a contiguous range.
  */
 void TreeCCNodeValidate(TreeCCContext *context);
 
@@ -124,6 +124,7 @@ TreeCCNode *TreeCCNodeCreate(TreeCCContext *context, long linenum,
 			parentNode->name = parent;
 			parentNode->flags = TREECC_NODE_UNDEFINED;
 			parentNode->number = (context->nodeNumber)++;
+			parentNode->lastNumber = parentNode->number;
 			parentNode->filename = context->input->filename;
 			parentNode->linenum = linenum;
 			parentNode->fields = 0;
@@ -142,6 +143,12 @@ TreeCCNode *TreeCCNodeCreate(TreeCCContext *context, long linenum,
 		parentNode = 0;
 	}
 
+	/* Mark node types that come from read-only include files */
+	if(context->readOnlyDepth > 0)
+	{
+		flags |= TREECC_NODE_READONLY;
+	}
+
 	/* Find or create the current node */
 	node = TreeCCNodeFind(context, name);
 	if(node)
@@ -190,6 +197,7 @@ TreeCCNode *TreeCCNodeCreate(TreeCCContext *context, long linenum,
 		node->name = name;
 		node->flags = flags;
 		node->number = (context->nodeNumber)++;
+		node->lastNumber = node->number;
 		node->filename = context->input->filename;
 		node->linenum = linenum;
 		node->fields = 0;
@@ -282,6 +290,132 @@ TreeCCNode *TreeCCNodeFindByType(TreeCCContext *context, const char *name)
 	return 0;
 }
 
+/*
+ * Determine if a node type was declared in a read-only include file.
+ */
+#define	IsReadOnlyNode(node)	(((node)->flags & TREECC_NODE_READONLY) != 0)
+
+/*
+ * Number a node type and its descendants in preorder.  Descendants that
+ * differ in read-only status are numbered separately.
+ */
+static int NumberNodes(TreeCCNode *node, int number)
+{
+	TreeCCNode *child;
+
+	/* Number this node */
+	node->number = number++;
+
+	/* Number the children */
+	child = node->firstChild;
+	while(child != 0)
+	{
+		if(IsReadOnlyNode(child) == IsReadOnlyNode(node))
+		{
+			number = NumberNodes(child, number);
+		}
+		child = child->nextSibling;
+	}
+
+	/* Record the end of the range for this node's subtree */
+	node->lastNumber = number - 1;
+	return number;
+}
+
+/*
+ * Compare two nodes by the order in which they were declared.
+ */
+static int DeclCompare(const void *e1, const void *e2)
+{
+	TreeCCNode *node1 = *((TreeCCNode **)e1);
+	TreeCCNode *node2 = *((TreeCCNode **)e2);
+	if(node1->number < node2->number)
+	{
+		return -1;
+	}
+	else if(node1->number > node2->number)
+	{
+		return 1;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+/*
+ * Number all node types in preorder.  Node types from read-only include
+ * files are numbered first, so that they get the same numbers as in the
+ * output files that were generated for them, and the node types that
+ * extend them are numbered after.
+ */
+static void NumberAllNodes(TreeCCContext *context)
+{
+	unsigned int hash;
+	TreeCCNode *node;
+	TreeCCNode **roots;
+	int numNodes;
+	int numRoots;
+	int readOnly;
+	int posn;
+	int number;
+
+	/* Count the nodes and find the lowest number in use,
+	   which is where "%option base" started the allocation */
+	numNodes = 0;
+	number = context->nodeNumber;
+	for(hash = 0; hash < TREECC_HASH_SIZE; ++hash)
+	{
+		node = context->nodeHash[hash];
+		while(node != 0)
+		{
+			++numNodes;
+			if(node->number < number)
+			{
+				number = node->number;
+			}
+			node = node->nextHash;
+		}
+	}
+	if(!numNodes)
+	{
+		return;
+	}
+	if((roots = (TreeCCNode **)malloc(sizeof(TreeCCNode *) * numNodes)) == 0)
+	{
+		TreeCCOutOfMemory(context->input);
+	}
+
+	/* Number the read-only hierarchies, and then the others */
+	for(readOnly = 1; readOnly >= 0; --readOnly)
+	{
+		/* Collect the roots of the hierarchies in declaration order */
+		numRoots = 0;
+		for(hash = 0; hash < TREECC_HASH_SIZE; ++hash)
+		{
+			node = context->nodeHash[hash];
+			while(node != 0)
+			{
+				if(IsReadOnlyNode(node) == readOnly &&
+				   (!(node->parent) ||
+				    IsReadOnlyNode(node->parent) != readOnly))
+				{
+					roots[numRoots++] = node;
+				}
+				node = node->nextHash;
+			}
+		}
+		qsort(roots, numRoots, sizeof(TreeCCNode *), DeclCompare);
+
+		/* Number each hierarchy in turn */
+		for(posn = 0; posn < numRoots; ++posn)
+		{
+			number = NumberNodes(roots[posn], number);
+		}
+	}
+	free(roots);
+}
+
 void TreeCCNodeValidate(TreeCCContext *context)
 {
 	unsigned int hash;
@@ -291,6 +425,10 @@ void TreeCCNodeValidate(TreeCCContext *context)
 	int len;
 	int typeCheck = (context->language == TREECC_LANG_C ||
 					 context->language == TREECC_LANG_CPP);
+
+	/* Number the node types so that each subtree has a contiguous range */
+	NumberAllNodes(context);
+
 	for(hash = 0; hash < TREECC_HASH_SIZE; ++hash)
 	{
 		node = context->nodeHash[hash];
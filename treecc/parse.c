@@ -1396,7 +1396,15 @@ void TreeCCParse(TreeCCContext *context)
 						TreeCCOpen(newInput, context->input->progname,
 								   file, includeFile);
 						context->input = newInput;
+						if(readOnly)
+						{
+							++(context->readOnlyDepth);
+						}
 						TreeCCParse(context);
+						if(readOnly)
+						{
+							--(context->readOnlyDepth);
+						}
 						context->input = origInput;
 						TreeCCClose(newInput, 1);
 						free(newInput);
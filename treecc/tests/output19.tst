@@ -0,0 +1,43 @@
+// test dispatch tables for multi-trigger non-virtual operations
+
+%enum type_code =
+{
+	int_type,
+	float_type
+}
+
+%node expression %abstract %typedef =
+{
+	%nocreate type_code type;
+}
+
+%node binary expression %abstract =
+{
+	expression *expr1;
+	expression *expr2;
+}
+
+%node intnum expression =
+{
+	int num;
+}
+
+%node plus binary
+%node minus binary
+
+%operation int coerce([expression *e], [type_code type], int flags) = {-1}
+
+coerce(expression, type_code)
+{
+	return 0;
+}
+
+coerce(binary, float_type)
+{
+	return flags;
+}
+
+coerce(intnum, int_type)
+{
+	return e->num;
+}
@@ -0,0 +1,12 @@
+// test "yyisa" for node types that extend a read-only inclusion
+
+%include %readonly "output20.inc"
+
+%header "app.h"
+%output "app.c"
+
+%node attr_identifier identifier
+%node qualified_identifier identifier =
+{
+	expression *left;
+}